@@ -0,0 +1,235 @@
+/**
+ * @file Arduino.cpp
+ * @brief Reloj, pines y puerto serial simulados
+ * @author Tu Nombre
+ * @date 2024
+ */
+
+#include "Arduino.h"
+
+/// Reloj simulado en nanosegundos
+static unsigned long long tiempoActual = 0;
+
+/// Tiempo que el sketch pasó en esperas
+static unsigned long long tiempoBloqueado = 0;
+
+/// Nivel de cada pin
+static int nivelesPines[TOTAL_PINES_SIMULADOS];
+
+SerialSimulado Serial;
+
+/**
+ * @brief Comprueba que un número de pin exista
+ * @param pin Número de pin
+ * @return true si está en rango
+ */
+static bool pinValido(int pin)
+{
+    return pin >= 0 && pin < TOTAL_PINES_SIMULADOS;
+}
+
+void PlacaSimulada::avanzar(unsigned long long nanosegundos)
+{
+    tiempoActual += nanosegundos;
+    Serial.actualizar(tiempoActual);
+}
+
+void PlacaSimulada::bloquear(unsigned long long nanosegundos)
+{
+    tiempoBloqueado += nanosegundos;
+    avanzar(nanosegundos);
+}
+
+unsigned long long PlacaSimulada::obtenerTiempo()
+{
+    return tiempoActual;
+}
+
+unsigned long long PlacaSimulada::obtenerTiempoBloqueado()
+{
+    return tiempoBloqueado;
+}
+
+void PlacaSimulada::fijarPin(int pin, int nivel)
+{
+    if (pinValido(pin))
+    {
+        nivelesPines[pin] = nivel;
+    }
+}
+
+int PlacaSimulada::leerPin(int pin)
+{
+    return pinValido(pin) ? nivelesPines[pin] : LOW;
+}
+
+unsigned long millis()
+{
+    return (unsigned long)(tiempoActual / 1000000ULL);
+}
+
+unsigned long micros()
+{
+    return (unsigned long)(tiempoActual / 1000ULL);
+}
+
+void delay(unsigned long milisegundos)
+{
+    PlacaSimulada::bloquear(milisegundos * 1000000ULL);
+}
+
+void pinMode(int pin, int modo)
+{
+    if (modo == INPUT_PULLUP)
+    {
+        PlacaSimulada::fijarPin(pin, HIGH);
+    }
+}
+
+int digitalRead(int pin)
+{
+    return PlacaSimulada::leerPin(pin);
+}
+
+void digitalWrite(int pin, int nivel)
+{
+    PlacaSimulada::fijarPin(pin, nivel);
+}
+
+SerialSimulado::SerialSimulado()
+    : inicioCola(0), bytesEnCola(0), finLinea(0), nanosegundosPorByte(0), velocidad(0),
+      capturados(nullptr), instantes(nullptr), totalCapturados(0), capacidadCaptura(0),
+      cambiosVelocidad(0)
+{
+}
+
+SerialSimulado::~SerialSimulado()
+{
+    std::free(capturados);
+    std::free(instantes);
+}
+
+void SerialSimulado::begin(long baudios)
+{
+    velocidad = (baudios > 0) ? baudios : 9600;
+    nanosegundosPorByte = 10000000000ULL / (unsigned long long)velocidad;
+    cambiosVelocidad++;
+}
+
+void SerialSimulado::end()
+{
+    flush();
+    velocidad = 0;
+}
+
+int SerialSimulado::availableForWrite()
+{
+    return CAPACIDAD_TX_SIMULADA - bytesEnCola;
+}
+
+size_t SerialSimulado::write(byte dato)
+{
+    encolar(dato);
+    return 1;
+}
+
+size_t SerialSimulado::write(const byte* datos, size_t cantidad)
+{
+    for (size_t i = 0; i < cantidad; i++)
+    {
+        encolar(datos[i]);
+    }
+    return cantidad;
+}
+
+void SerialSimulado::flush()
+{
+    if (finLinea > tiempoActual)
+    {
+        PlacaSimulada::bloquear(finLinea - tiempoActual);
+    }
+}
+
+void SerialSimulado::encolar(byte dato)
+{
+    if (velocidad == 0)
+    {
+        return;
+    }
+
+    // Buffer lleno: HardwareSerial espera a que salga el primer byte
+    if (bytesEnCola == CAPACIDAD_TX_SIMULADA)
+    {
+        PlacaSimulada::bloquear(finBytes[inicioCola] - tiempoActual);
+    }
+
+    unsigned long long inicio = (finLinea > tiempoActual) ? finLinea : tiempoActual;
+    finLinea = inicio + nanosegundosPorByte;
+
+    int posicion = (inicioCola + bytesEnCola) % CAPACIDAD_TX_SIMULADA;
+    bytesCola[posicion] = dato;
+    finBytes[posicion] = finLinea;
+    bytesEnCola++;
+}
+
+void SerialSimulado::actualizar(unsigned long long ahora)
+{
+    while (bytesEnCola > 0 && finBytes[inicioCola] <= ahora)
+    {
+        capturar(bytesCola[inicioCola], finBytes[inicioCola]);
+        inicioCola = (inicioCola + 1) % CAPACIDAD_TX_SIMULADA;
+        bytesEnCola--;
+    }
+}
+
+void SerialSimulado::capturar(byte dato, unsigned long long instante)
+{
+    if (totalCapturados == capacidadCaptura)
+    {
+        size_t nuevaCapacidad = (capacidadCaptura == 0) ? 4096 : capacidadCaptura * 2;
+        char* nuevosBytes = (char*)std::realloc(capturados, nuevaCapacidad);
+        if (nuevosBytes == nullptr)
+        {
+            return;
+        }
+        capturados = nuevosBytes;
+
+        unsigned long long* nuevosInstantes =
+            (unsigned long long*)std::realloc(instantes, nuevaCapacidad * sizeof(unsigned long long));
+        if (nuevosInstantes == nullptr)
+        {
+            return;
+        }
+        instantes = nuevosInstantes;
+        capacidadCaptura = nuevaCapacidad;
+    }
+
+    capturados[totalCapturados] = (char)dato;
+    instantes[totalCapturados] = instante;
+    totalCapturados++;
+}
+
+const char* SerialSimulado::obtenerCaptura() const
+{
+    return capturados;
+}
+
+const unsigned long long* SerialSimulado::obtenerInstantes() const
+{
+    return instantes;
+}
+
+size_t SerialSimulado::obtenerBytesCapturados() const
+{
+    return totalCapturados;
+}
+
+int SerialSimulado::obtenerCambiosVelocidad() const
+{
+    return cambiosVelocidad;
+}
+
+long SerialSimulado::obtenerVelocidad() const
+{
+    return velocidad;
+}
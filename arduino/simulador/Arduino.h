@@ -0,0 +1,286 @@
+/**
+ * @file Arduino.h
+ * @brief Sustituto mínimo del núcleo de Arduino para compilar el sketch en el host
+ * @author Tu Nombre
+ * @date 2024
+ * 
+ * Cubre lo que usa arduino/sketch.ino: PROGMEM, millis(), pines
+ * digitales y el objeto Serial. El reloj es simulado y solo avanza
+ * cuando el programa anfitrión lo pide o cuando el sketch bloquea
+ * (delay(), escribir con el buffer lleno, flush() o end() con bytes
+ * pendientes); ese tiempo se acumula como tiempo bloqueado.
+ * 
+ * El puerto tiene un buffer de transmisión de 63 bytes, como el
+ * HardwareSerial de AVR, y la línea lo vacía a 10 bits por byte
+ * (8N1). Los bytes que salen se capturan con su instante.
+ */
+
+#ifndef ARDUINO_SIMULADO_H
+#define ARDUINO_SIMULADO_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+typedef uint8_t byte;
+
+#define PROGMEM
+
+#define LOW 0
+#define HIGH 1
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#define LED_BUILTIN 13
+
+/// Bytes que admite el buffer de transmisión vacío
+const int CAPACIDAD_TX_SIMULADA = 63;
+
+/// Pines digitales simulados
+const int TOTAL_PINES_SIMULADOS = 20;
+
+/**
+ * @brief Lee un byte de memoria de programa
+ * @param direccion Dirección del byte
+ * @return Byte leído
+ */
+inline uint8_t pgm_read_byte(const void* direccion)
+{
+    return *(const uint8_t*)direccion;
+}
+
+/**
+ * @brief Copia bytes desde memoria de programa
+ * @param destino Buffer en RAM
+ * @param origen Bytes en PROGMEM
+ * @param cantidad Bytes a copiar
+ * @return destino
+ */
+inline void* memcpy_P(void* destino, const void* origen, size_t cantidad)
+{
+    return std::memcpy(destino, origen, cantidad);
+}
+
+/**
+ * @brief Longitud de un texto en memoria de programa
+ * @param texto Texto terminado en '\0'
+ * @return Caracteres del texto
+ */
+inline size_t strlen_P(const char* texto)
+{
+    return std::strlen(texto);
+}
+
+/**
+ * @brief Milisegundos simulados desde el arranque
+ * @return Tiempo en milisegundos
+ */
+unsigned long millis();
+
+/**
+ * @brief Microsegundos simulados desde el arranque
+ * @return Tiempo en microsegundos
+ */
+unsigned long micros();
+
+/**
+ * @brief Avanza el reloj como tiempo bloqueado
+ * @param milisegundos Duración de la espera
+ */
+void delay(unsigned long milisegundos);
+
+/**
+ * @brief Configura un pin (INPUT_PULLUP lo deja en alto)
+ * @param pin Número de pin
+ * @param modo INPUT, OUTPUT o INPUT_PULLUP
+ */
+void pinMode(int pin, int modo);
+
+/**
+ * @brief Lee el nivel de un pin
+ * @param pin Número de pin
+ * @return LOW o HIGH
+ */
+int digitalRead(int pin);
+
+/**
+ * @brief Fija el nivel de un pin
+ * @param pin Número de pin
+ * @param nivel LOW o HIGH
+ */
+void digitalWrite(int pin, int nivel);
+
+/**
+ * @class SerialSimulado
+ * @brief Puerto serial con buffer de transmisión y línea temporizada
+ */
+class SerialSimulado
+{
+private:
+    unsigned long long finBytes[CAPACIDAD_TX_SIMULADA];  ///< Instante en que termina de salir cada byte en cola
+    byte bytesCola[CAPACIDAD_TX_SIMULADA];               ///< Bytes en cola
+    int inicioCola;                                      ///< Primer byte en cola
+    int bytesEnCola;                                     ///< Bytes en cola
+    unsigned long long finLinea;                         ///< Instante en que la línea queda libre
+    unsigned long long nanosegundosPorByte;              ///< Duración de un byte (10 bits)
+    long velocidad;                                      ///< Baudios (0 = cerrado)
+
+    char* capturados;                                    ///< Bytes que salieron por la línea
+    unsigned long long* instantes;                       ///< Instante de salida de cada byte
+    size_t totalCapturados;                              ///< Bytes capturados
+    size_t capacidadCaptura;                             ///< Capacidad de los buffers de captura
+    int cambiosVelocidad;                                ///< Llamadas a begin()
+
+    /**
+     * @brief Pone un byte en cola, esperando si el buffer está lleno
+     * @param dato Byte a transmitir
+     */
+    void encolar(byte dato);
+
+    /**
+     * @brief Agrega un byte a la captura
+     * @param dato Byte transmitido
+     * @param instante Momento en que terminó de salir
+     */
+    void capturar(byte dato, unsigned long long instante);
+
+public:
+    /**
+     * @brief Constructor de un puerto cerrado
+     */
+    SerialSimulado();
+
+    /**
+     * @brief Destructor que libera la captura
+     */
+    ~SerialSimulado();
+
+    SerialSimulado(const SerialSimulado&) = delete;
+    SerialSimulado& operator=(const SerialSimulado&) = delete;
+
+    /**
+     * @brief Abre el puerto
+     * @param baudios Velocidad de la línea
+     */
+    void begin(long baudios);
+
+    /**
+     * @brief Cierra el puerto tras vaciar el buffer (puede bloquear)
+     */
+    void end();
+
+    /**
+     * @brief Bytes que pueden escribirse sin bloquear
+     * @return Espacio libre en el buffer de transmisión
+     */
+    int availableForWrite();
+
+    /**
+     * @brief Escribe un byte (bloquea si el buffer está lleno)
+     * @param dato Byte a transmitir
+     * @return 1
+     */
+    size_t write(byte dato);
+
+    /**
+     * @brief Escribe varios bytes (bloquea si no caben)
+     * @param datos Bytes a transmitir
+     * @param cantidad Número de bytes
+     * @return cantidad
+     */
+    size_t write(const byte* datos, size_t cantidad);
+
+    /**
+     * @brief Espera a que salga el último byte (puede bloquear)
+     */
+    void flush();
+
+    /**
+     * @brief Mueve a la captura los bytes que ya salieron
+     * @param ahora Instante simulado actual
+     */
+    void actualizar(unsigned long long ahora);
+
+    /**
+     * @brief Acceso a los bytes transmitidos
+     * @return Bytes capturados (no terminados en '\0')
+     */
+    const char* obtenerCaptura() const;
+
+    /**
+     * @brief Acceso a los instantes de salida
+     * @return Nanosegundos simulados en que terminó cada byte capturado
+     */
+    const unsigned long long* obtenerInstantes() const;
+
+    /**
+     * @brief Obtiene la cantidad de bytes capturados
+     * @return Bytes transmitidos hasta ahora
+     */
+    size_t obtenerBytesCapturados() const;
+
+    /**
+     * @brief Obtiene las veces que se abrió el puerto
+     * @return Llamadas a begin()
+     */
+    int obtenerCambiosVelocidad() const;
+
+    /**
+     * @brief Obtiene la velocidad actual
+     * @return Baudios (0 si está cerrado)
+     */
+    long obtenerVelocidad() const;
+};
+
+/// Puerto serial del sketch
+extern SerialSimulado Serial;
+
+/**
+ * @class PlacaSimulada
+ * @brief Control del reloj y de los pines desde el programa anfitrión
+ */
+class PlacaSimulada
+{
+public:
+    /**
+     * @brief Avanza el reloj sin contarlo como bloqueo
+     * @param nanosegundos Tiempo transcurrido
+     */
+    static void avanzar(unsigned long long nanosegundos);
+
+    /**
+     * @brief Avanza el reloj por una espera del sketch
+     * @param nanosegundos Tiempo bloqueado
+     */
+    static void bloquear(unsigned long long nanosegundos);
+
+    /**
+     * @brief Obtiene el reloj simulado
+     * @return Nanosegundos desde el arranque
+     */
+    static unsigned long long obtenerTiempo();
+
+    /**
+     * @brief Obtiene el tiempo total que el sketch pasó bloqueado
+     * @return Nanosegundos bloqueados
+     */
+    static unsigned long long obtenerTiempoBloqueado();
+
+    /**
+     * @brief Fija el nivel de una entrada desde fuera de la placa
+     * @param pin Número de pin
+     * @param nivel LOW o HIGH
+     */
+    static void fijarPin(int pin, int nivel);
+
+    /**
+     * @brief Consulta el nivel de un pin
+     * @param pin Número de pin
+     * @return LOW o HIGH
+     */
+    static int leerPin(int pin);
+};
+
+#endif // ARDUINO_SIMULADO_H
@@ -7,7 +7,8 @@
  * @details
  * Este programa implementa el lado transmisor del protocolo PRT-7,
  * enviando paquetes de tipo LOAD (L) y MAP (M) a través del puerto
- * serial a 9600 baudios.
+ * serial a 9600 baudios. Cada ciclo termina con una trama explícita
+ * de fin de mensaje (F).
  * 
  * El protocolo PRT-7 utiliza un sistema de cifrado César dinámico
  * donde los paquetes MAP modifican el offset de cifrado para los
@@ -21,9 +22,46 @@
  * @section conexion Configuración
  * - Velocidad: 9600 baudios
  * - Formato: 8N1 (8 bits, sin paridad, 1 bit de parada)
- * - Delay entre paquetes: 1000ms
+ * - Ritmo a 9600 baudios: TRAMAS_POR_SEGUNDO (1 trama por segundo)
+ * 
+ * @section planificador Planificación
+ * loop() nunca espera: en cada vuelta un planificador cooperativo
+ * basado en millis() ejecuta las tareas que vencieron. Los cuerpos
+ * de las tramas están precalculados en memoria de programa
+ * (PROGMEM); cuando le toca a una trama se copia a un buffer de
+ * salida con su sufijo, y al puerto solo se escriben los bytes que
+ * Serial.availableForWrite() admite sin bloquear. Los avisos de
+ * consola siguen el mismo camino.
+ * 
+ * @section perfil Perfil rápido
+ * Con PERFIL_RAPIDO activo el transmisor anuncia a 9600 baudios la
+ * línea "#PRT7,PERFIL,<baud>,<flujo>,<rafaga>", cambia a la velocidad
+ * anunciada y envía TRAMAS_POR_SEGUNDO_PERFIL tramas por segundo
+ * (0 = tan rápido como lo permita la línea), opcionalmente en
+ * ráfagas de TRAMAS_POR_RAFAGA tramas. El decodificador adopta el
+ * perfil al recibir el anuncio.
+ * 
+ * El control de flujo se hace por software: una trama solo empieza
+ * mientras el pin PIN_CTS, cableado a la salida RTS del adaptador
+ * serial del host, esté en nivel bajo.
+ * 
+ * @section integridad Integridad
+ * Con HABILITAR_INTEGRIDAD cada trama lleva el sufijo ",<seq>*<CRC>"
+ * (secuencia 0-255 y CRC-8 de polinomio 0x07 en hexadecimal) y cada
+ * INTERVALO_SINCRONIZACION tramas se envía "S,<rotacion>" con la
+ * rotación absoluta del disco, para que el receptor se recupere de
+ * una trama MAP perdida. El sufijo se calcula al enviar, así que la
+ * secuencia continúa de un ciclo al siguiente.
+ * 
+ * @section simulador Simulación en el host
+ * El programa también compila como C++ corriente contra el
+ * Arduino.h de arduino/simulador, que simula el reloj y el puerto
+ * serial; herramientas/simulador_transmisor lo usa para medir en
+ * Linux el ritmo de tramas y los bloqueos del bucle.
  */
 
+#include <Arduino.h>
+
 // =====================================================
 // CONSTANTES DE CONFIGURACIÓN
 // =====================================================
@@ -31,82 +69,174 @@
 /// Velocidad de comunicación serial (baudios)
 const long VELOCIDAD_SERIAL = 9600;
 
-/// Retardo entre transmisión de paquetes (milisegundos)
-const int RETARDO_PAQUETES = 1000;
+/// Tramas por segundo a VELOCIDAD_SERIAL (0 = velocidad de línea)
+const long TRAMAS_POR_SEGUNDO = 1;
 
 /// Retardo adicional al inicio para estabilización
-const int RETARDO_INICIAL = 2000;
+const unsigned long RETARDO_INICIAL = 2000;
 
-// =====================================================
-// ESTRUCTURA DE DATOS PARA SECUENCIA
-// =====================================================
+/// Pausa entre el mensaje de bienvenida y la primera trama
+const unsigned long PAUSA_ANTES_TRANSMISION = 2000;
 
-/**
- * @struct PaqueteTransmision
- * @brief Estructura que representa un paquete a transmitir
- */
-struct PaqueteTransmision
-{
-    char tipo;        ///< Tipo de paquete: 'L' (Load) o 'M' (Map)
-    char caracter;    ///< Carácter para paquetes tipo L
-    int rotacion;     ///< Valor de rotación para paquetes tipo M
-    bool esValido;    ///< Indica si el paquete es válido
-};
+/// Pausa entre ciclos con transmisión continua (milisegundos)
+const unsigned long PAUSA_ENTRE_CICLOS = 5000;
+
+/// Anunciar y usar el perfil rápido tras el encabezado
+const bool PERFIL_RAPIDO = true;
+
+/// Velocidad del perfil rápido (1 Mbaud es exacto con reloj de 16 MHz)
+const long VELOCIDAD_PERFIL = 1000000;
+
+/// Tramas por segundo con el perfil rápido (0 = velocidad de línea)
+const long TRAMAS_POR_SEGUNDO_PERFIL = 0;
+
+/// Esperar permiso del host (RTS/CTS) antes de cada trama
+const bool CONTROL_FLUJO_PERFIL = false;
+
+/// Pin conectado a la salida RTS del host (activo en nivel bajo)
+const int PIN_CTS = 7;
+
+/// Tramas enviadas seguidas antes de una pausa (0 = sin pausas)
+const int TRAMAS_POR_RAFAGA = 0;
+
+/// Pausa entre ráfagas (milisegundos)
+const unsigned long PAUSA_ENTRE_RAFAGAS = 10;
+
+/// Tiempo que se deja al host para reconfigurar su puerto
+const unsigned long RETARDO_CAMBIO_PERFIL = 100;
+
+/// Margen para que el último byte salga del registro de desplazamiento
+const unsigned long MARGEN_VACIADO = 3;
+
+/// Añadir secuencia y CRC a cada trama
+const bool HABILITAR_INTEGRIDAD = true;
+
+/// Tramas entre dos sincronizaciones absolutas (0 = nunca)
+const int INTERVALO_SINCRONIZACION = 8;
+
+/// Periodo del parpadeo del LED integrado (milisegundos)
+const unsigned long PERIODO_LATIDO = 500;
+
+/// Buffer de salida: una trama B completa, su sufijo y una trama S
+const int LONGITUD_SALIDA = 160;
 
 // =====================================================
-// SECUENCIA DE TRANSMISIÓN PREDEFINIDA
+// SECUENCIA DE TRANSMISIÓN PRECALCULADA
 // =====================================================
 
 /**
- * @brief Secuencia de paquetes que generan el mensaje "HOLA MUNDO"
+ * @brief Cuerpos de las tramas que generan el mensaje "HOLA MUNDO"
  * 
- * La secuencia utiliza rotaciones para cifrar parte del mensaje:
- * - "HOL" sin cifrado
+ * Con rotación r el receptor decodifica la letra 'A'+p como la letra
+ * 'A'+(p+r)%26, de modo que con rotación +2 se envía la letra dos
+ * posiciones antes de la deseada:
+ * - "HOL" sin rotación
  * - Rotación +2
- * - "A " con cifrado +2 (se envía como si fuera sin cifrar, pero el receptor lo interpreta)
- * - "MUND" con cifrado +2
+ * - "A MUND" enviado como "Y KSLB" (el espacio no se cifra)
  * - Rotación -2 para restaurar
- * - "O" sin cifrado
+ * - "O" sin rotación
+ * 
+ * Una trama por línea, sin sufijo. El espacio solo llega íntegro con
+ * HABILITAR_INTEGRIDAD: sin sufijo el receptor recorta los espacios
+ * al final de la línea. Para otros mensajes las líneas pueden
+ * generarse con herramientas/codificador (sin --integridad).
  */
-const int TOTAL_PAQUETES = 15;
-
-/// Array con la secuencia completa de paquetes
-PaqueteTransmision secuenciaPaquetes[TOTAL_PAQUETES] = {
+const char TRAMAS_MENSAJE[] PROGMEM =
     // Mensaje inicial: "HOL"
-    {'L', 'H', 0, true},   // H -> H
-    {'L', 'O', 0, true},   // O -> O
-    {'L', 'L', 0, true},   // L -> L
-    
+    "L,H\n"
+    "L,O\n"
+    "L,L\n"
+
     // Rotación del disco +2
-    {'M', 0, 2, true},
-    
-    // Mensaje cifrado: "A MUND"
-    // Aquí enviamos los caracteres que, con rotación +2, 
-    // producen el mensaje deseado
-    {'L', 'A', 0, true},   // A+2 = C, pero en el rotor da 'A' interpretado como 'C'
-    {'L', ' ', 0, true},   // Espacio (no se cifra)
-    {'L', 'W', 0, true},   // W+2 = Y (resultado deseado: M)
-    {'L', 'S', 0, true},   // S+2 = U
-    {'L', 'L', 0, true},   // L+2 = N
-    {'L', 'B', 0, true},   // B+2 = D
-    {'L', 'M', 0, true},   // M+2 = O
-    
+    "M,2\n"
+
+    // Mensaje rotado: "A MUND"
+    "L,Y\n"    // Y+2 = A
+    "L, \n"    // Espacio (no se cifra)
+    "L,K\n"    // K+2 = M
+    "L,S\n"    // S+2 = U
+    "L,L\n"    // L+2 = N
+    "L,B\n"    // B+2 = D
+
     // Restaurar rotación
-    {'M', 0, -2, true},
-    
+    "M,-2\n"
+
     // Mensaje final: "O"
-    {'L', 'O', 0, true},   // O -> O
-    
-    // Paquete de finalización (indicador de fin)
-    {'M', 0, -1, true}
+    "L,O\n"
+
+    // Paquete de finalización (trama explícita de fin)
+    "F,0\n";
+
+/// Bytes de la secuencia precalculada
+const int LONGITUD_MENSAJE = sizeof(TRAMAS_MENSAJE) - 1;
+
+/// Mensaje de inicio
+const char TEXTO_BIENVENIDA[] PROGMEM =
+    "========================================\n"
+    "  Transmisor PRT-7 v1.0\n"
+    "  Arduino - Protocolo Rotatorio\n"
+    "========================================\n"
+    "\n"
+    "Sistema iniciado correctamente.\n"
+    "Velocidad: 9600 baudios\n";
+
+/// Encabezado del resumen de cada ciclo
+const char TEXTO_FIN_CICLO[] PROGMEM =
+    "\n"
+    "========================================\n";
+
+/// CRC-8 (polinomio 0x07) de cada nibble: dos consultas por byte
+const byte TABLA_CRC[16] PROGMEM = {
+    0x00, 0x07, 0x0E, 0x09, 0x1C, 0x1B, 0x12, 0x15,
+    0x38, 0x3F, 0x36, 0x31, 0x24, 0x23, 0x2A, 0x2D
+};
+
+// =====================================================
+// ESTRUCTURAS DEL PLANIFICADOR
+// =====================================================
+
+/**
+ * @enum EstadoTransmisor
+ * @brief Etapas que recorre el transmisor sin bloquear
+ */
+enum EstadoTransmisor
+{
+    ESTADO_ESPERA_INICIAL,    ///< Estabilización tras el arranque
+    ESTADO_BIENVENIDA,        ///< Mensaje de inicio y pausa previa
+    ESTADO_ANUNCIO,           ///< Enviando el anuncio del perfil rápido
+    ESTADO_VACIADO,           ///< Esperando a que salga el último byte
+    ESTADO_CAMBIO_VELOCIDAD,  ///< Dando tiempo al host para cambiar de velocidad
+    ESTADO_TRANSMISION,       ///< Enviando las tramas del ciclo
+    ESTADO_FIN_CICLO,         ///< Resumen del ciclo y pausa
+    ESTADO_DETENIDO           ///< Transmisión terminada
+};
+
+/**
+ * @struct Tarea
+ * @brief Tarea del planificador cooperativo
+ */
+struct Tarea
+{
+    void (*ejecutar)(unsigned long ahora);  ///< Trabajo corto que nunca espera
+    unsigned long periodo;                  ///< Milisegundos entre ejecuciones (0 = cada vuelta)
+    unsigned long ultimaEjecucion;          ///< Instante de la última ejecución
 };
 
 // =====================================================
 // VARIABLES GLOBALES
 // =====================================================
 
-/// Índice del paquete actual en la secuencia
-int indicePaqueteActual = 0;
+/// Etapa actual del transmisor
+EstadoTransmisor estadoTransmisor = ESTADO_ESPERA_INICIAL;
+
+/// Instante en que empezó la etapa actual
+unsigned long inicioEstado = 0;
+
+/// Posición de la próxima trama dentro de TRAMAS_MENSAJE
+int posicionMensaje = 0;
+
+/// Tramas de la secuencia (sin contar las de sincronización)
+int totalTramas = 0;
 
 /// Contador de ciclos de transmisión completados
 int ciclosCompletados = 0;
@@ -114,178 +244,450 @@ int ciclosCompletados = 0;
 /// Flag para modo de transmisión continua
 bool transmisionContinua = false;
 
+/// Pausa entre ciclos con transmisión continua
+unsigned long pausaEntreCiclos = PAUSA_ENTRE_CICLOS;
+
+/// Indica si ya se cambió al perfil rápido
+bool perfilRapidoActivo = false;
+
+/// Tramas por segundo a 9600 baudios (0 = velocidad de línea)
+long ritmoLento = TRAMAS_POR_SEGUNDO;
+
+/// Tramas por segundo con el perfil rápido (0 = velocidad de línea)
+long ritmoPerfil = TRAMAS_POR_SEGUNDO_PERFIL;
+
+/// Instante (micros) a partir del cual puede salir la próxima trama
+unsigned long proximaTrama = 0;
+
+/// Tramas enviadas en la ráfaga actual
+int tramasEnRafaga = 0;
+
+/// Número de secuencia de la próxima trama
+byte secuenciaTrama = 0;
+
+/// Rotación absoluta que tiene el disco del receptor
+int rotacionAcumulada = 0;
+
+/// Tramas enviadas desde la última sincronización
+int tramasDesdeSincronizacion = 0;
+
+/// Bytes que admite el buffer serial vacío (para saber cuándo se vació)
+int capacidadSerial = 0;
+
+/// Texto en PROGMEM pendiente de enviar (sale antes que el buffer de salida)
+const char* textoPendiente = nullptr;
+
+/// Bytes de textoPendiente que faltan por enviar
+int bytesTextoPendiente = 0;
+
+/// Buffer de salida en RAM
+char salida[LONGITUD_SALIDA];
+
+/// Bytes ocupados en el buffer de salida
+int longitudSalida = 0;
+
+/// Bytes del buffer de salida ya entregados al puerto
+int enviadosSalida = 0;
+
+/// Estado del LED de latido
+bool ledEncendido = false;
+
 // =====================================================
 // FUNCIONES DE TRANSMISIÓN
 // =====================================================
 
 /**
- * @brief Transmite un paquete de tipo LOAD (carga de carácter)
- * @param c Carácter a transmitir
- * 
- * Formato de salida: "L,<carácter>\n"
- * Ejemplo: "L,A\n"
+ * @brief Calcula el CRC-8 (polinomio 0x07) de un texto
+ * @param texto Bytes a proteger
+ * @param longitud Número de bytes
+ * @return Suma de control
  */
-void transmitirPaqueteLoad(char c)
+byte calcularCrc(const char* texto, int longitud)
 {
-    Serial.print("L,");
-    Serial.println(c);
+    byte crc = 0;
+    for (int i = 0; i < longitud; i++)
+    {
+        byte dato = (byte)texto[i];
+        crc = (byte)(crc << 4) ^ pgm_read_byte(&TABLA_CRC[(crc ^ dato) >> 4]);
+        crc = (byte)(crc << 4) ^ pgm_read_byte(&TABLA_CRC[((crc >> 4) ^ dato) & 0x0F]);
+    }
+    return crc;
 }
 
 /**
- * @brief Transmite un paquete de tipo MAP (rotación)
- * @param valor Cantidad de posiciones a rotar (puede ser negativo)
+ * @brief Completa una trama con su sufijo de control y salto de línea
+ * @param trama Cuerpo de la trama (ej: "M,5"), seguido de espacio libre
+ * @param longitud Bytes del cuerpo
+ * @return Bytes totales de la trama
  * 
- * Formato de salida: "M,<valor>\n"
- * Ejemplos: "M,5\n", "M,-3\n"
+ * Con HABILITAR_INTEGRIDAD añade ",<seq>*<CRC>"; si no, solo el
+ * salto de línea.
  */
-void transmitirPaqueteMap(int valor)
+int completarTrama(char* trama, int longitud)
 {
-    Serial.print("M,");
-    Serial.println(valor);
+    if (HABILITAR_INTEGRIDAD)
+    {
+        static const char HEXADECIMAL[] = "0123456789ABCDEF";
+        longitud += snprintf(&trama[longitud], 6, ",%u", (unsigned)secuenciaTrama);
+        byte crc = calcularCrc(trama, longitud);
+        secuenciaTrama++;
+
+        trama[longitud++] = '*';
+        trama[longitud++] = HEXADECIMAL[crc >> 4];
+        trama[longitud++] = HEXADECIMAL[crc & 0x0F];
+    }
+    trama[longitud++] = '\n';
+    return longitud;
+}
+
+/**
+ * @brief Indica si ya se entregó al puerto todo lo pendiente
+ * @return true si no quedan bytes por escribir
+ */
+bool salidaLibre()
+{
+    return bytesTextoPendiente == 0 && enviadosSalida == longitudSalida;
 }
 
 /**
- * @brief Transmite un paquete según su estructura
- * @param paquete Estructura con los datos del paquete
+ * @brief Encola un aviso de consola
+ * @param textoProgmem Texto en PROGMEM, o nullptr
+ * @param textoRam Texto en RAM que sale a continuación (se copia), o nullptr
  */
-void transmitirPaquete(const PaqueteTransmision& paquete)
+void encolarTexto(const char* textoProgmem, const char* textoRam)
 {
-    if (!paquete.esValido)
+    textoPendiente = textoProgmem;
+    bytesTextoPendiente = (textoProgmem != nullptr) ? (int)strlen_P(textoProgmem) : 0;
+    longitudSalida = 0;
+    enviadosSalida = 0;
+
+    if (textoRam != nullptr)
     {
-        return;
+        longitudSalida = snprintf(salida, sizeof(salida), "%s", textoRam);
+        if (longitudSalida >= (int)sizeof(salida))
+        {
+            longitudSalida = sizeof(salida) - 1;
+        }
     }
-    
-    if (paquete.tipo == 'L' || paquete.tipo == 'l')
+}
+
+/**
+ * @brief Copia la próxima trama precalculada al buffer de salida
+ * 
+ * Añade el sufijo de control y, si toca, una trama de
+ * sincronización detrás.
+ */
+void encolarSiguienteTrama()
+{
+    // Cuerpo desde PROGMEM hasta el salto de línea
+    int longitud = 0;
+    char caracter;
+    while ((caracter = (char)pgm_read_byte(&TRAMAS_MENSAJE[posicionMensaje++])) != '\n')
+    {
+        if (longitud < LONGITUD_SALIDA - 32)
+        {
+            salida[longitud++] = caracter;
+        }
+    }
+    char tipo = salida[0];
+
+    // Seguir la rotación del receptor para las sincronizaciones
+    if (tipo == 'M' || tipo == 'm')
     {
-        transmitirPaqueteLoad(paquete.caracter);
+        salida[longitud] = '\0';
+        int valor = atoi(&salida[2]);
+        rotacionAcumulada = ((rotacionAcumulada + valor) % 26 + 26) % 26;
     }
-    else if (paquete.tipo == 'M' || paquete.tipo == 'm')
+    longitud = completarTrama(salida, longitud);
+
+    // Sincronización periódica; la trama F ya cierra el mensaje
+    if (HABILITAR_INTEGRIDAD && INTERVALO_SINCRONIZACION > 0 && tipo != 'F' && tipo != 'f')
     {
-        transmitirPaqueteMap(paquete.rotacion);
+        tramasDesdeSincronizacion++;
+        if (tramasDesdeSincronizacion >= INTERVALO_SINCRONIZACION)
+        {
+            tramasDesdeSincronizacion = 0;
+            int cuerpo = snprintf(&salida[longitud], 8, "S,%d", rotacionAcumulada);
+            longitud += completarTrama(&salida[longitud], cuerpo);
+        }
     }
+
+    longitudSalida = longitud;
+    enviadosSalida = 0;
+}
+
+/**
+ * @brief Indica si el host permite transmitir
+ * @return false solo con control de flujo activo y el pin CTS en alto
+ */
+bool hayPermisoEnvio()
+{
+    return !(perfilRapidoActivo && CONTROL_FLUJO_PERFIL) || digitalRead(PIN_CTS) == LOW;
+}
+
+/**
+ * @brief Indica si ya corresponde enviar la siguiente trama
+ * @return true si el ritmo configurado lo permite
+ * 
+ * Se compara con micros() para que los ritmos altos no queden
+ * redondeados al milisegundo.
+ */
+bool tramaVencida()
+{
+    return (long)(micros() - proximaTrama) >= 0;
 }
 
 /**
- * @brief Muestra información de diagnóstico sobre el paquete transmitido
- * @param numeroPaquete Número de paquete en la secuencia
- * @param paquete Datos del paquete transmitido
+ * @brief Programa la siguiente trama y aplica las pausas entre ráfagas
+ * 
+ * Con ritmo fijo cada trama vence un periodo después de la
+ * anterior, así que si la línea se retrasa las atrasadas salen
+ * seguidas; con ritmo 0 vence de inmediato.
  */
-void mostrarInfoDiagnostico(int numeroPaquete, const PaqueteTransmision& paquete)
+void contarTramaEnviada()
 {
-    Serial.print("# Paquete ");
-    Serial.print(numeroPaquete + 1);
-    Serial.print("/");
-    Serial.print(TOTAL_PAQUETES);
-    Serial.print(" - Tipo: ");
-    Serial.print(paquete.tipo);
-    
-    if (paquete.tipo == 'L')
+    long ritmo = perfilRapidoActivo ? ritmoPerfil : ritmoLento;
+    if (ritmo > 0)
     {
-        Serial.print(", Caracter: '");
-        Serial.print(paquete.caracter);
-        Serial.println("'");
+        proximaTrama += 1000000UL / (unsigned long)ritmo;
     }
     else
     {
-        Serial.print(", Rotacion: ");
-        Serial.println(paquete.rotacion);
+        proximaTrama = micros();
+    }
+
+    if (perfilRapidoActivo && TRAMAS_POR_RAFAGA > 0)
+    {
+        tramasEnRafaga++;
+        if (tramasEnRafaga >= TRAMAS_POR_RAFAGA)
+        {
+            tramasEnRafaga = 0;
+            proximaTrama = micros() + PAUSA_ENTRE_RAFAGAS * 1000UL;
+        }
     }
 }
 
-// =====================================================
-// FUNCIONES DE ARDUINO
-// =====================================================
+/**
+ * @brief Pasa a otra etapa
+ * @param nuevoEstado Etapa siguiente
+ * @param ahora Instante actual (millis)
+ */
+void cambiarEstado(EstadoTransmisor nuevoEstado, unsigned long ahora)
+{
+    estadoTransmisor = nuevoEstado;
+    inicioEstado = ahora;
+}
 
 /**
- * @brief Configuración inicial del Arduino
+ * @brief Comienza un ciclo de transmisión de la secuencia
+ * @param ahora Instante actual (millis)
+ */
+void iniciarCiclo(unsigned long ahora)
+{
+    posicionMensaje = 0;
+    tramasEnRafaga = 0;
+    proximaTrama = micros();
+    cambiarEstado(ESTADO_TRANSMISION, ahora);
+}
+
+/**
+ * @brief Encola el anuncio del perfil rápido
  * 
- * Inicializa el puerto serial y muestra mensaje de bienvenida.
- * Se ejecuta una sola vez al inicio.
+ * El anuncio es la última línea que viaja a la velocidad inicial.
  */
-void setup() 
+void anunciarPerfilRapido()
 {
-    // Inicializar comunicación serial
-    Serial.begin(VELOCIDAD_SERIAL);
-    
-    // Esperar estabilización de la conexión
-    delay(RETARDO_INICIAL);
-    
-    // Mensaje de inicio
-    Serial.println("========================================");
-    Serial.println("  Transmisor PRT-7 v1.0");
-    Serial.println("  Arduino - Protocolo Rotatorio");
-    Serial.println("========================================");
-    Serial.println();
-    Serial.println("Sistema iniciado correctamente.");
-    Serial.println("Velocidad: 9600 baudios");
-    Serial.print("Total de paquetes: ");
-    Serial.println(TOTAL_PAQUETES);
-    Serial.println();
-    Serial.println("Iniciando transmision en 2 segundos...");
-    Serial.println();
-    
-    delay(2000);
+    char anuncio[48];
+    snprintf(anuncio, sizeof(anuncio), "#PRT7,PERFIL,%ld,%d,%d\n",
+             VELOCIDAD_PERFIL, CONTROL_FLUJO_PERFIL ? 1 : 0, TRAMAS_POR_RAFAGA);
+    encolarTexto(nullptr, anuncio);
 }
 
 /**
- * @brief Bucle principal de ejecución
+ * @brief Reabre el puerto a la velocidad del perfil rápido
  * 
- * Transmite secuencialmente todos los paquetes de la secuencia.
- * Al finalizar, puede reiniciar o detenerse según configuración.
+ * Solo se llama con el anuncio ya fuera de la línea, así que
+ * Serial.end() no tiene nada que esperar.
  */
-void loop() 
+void cambiarVelocidad()
 {
-    // Verificar si quedan paquetes por transmitir
-    if (indicePaqueteActual < TOTAL_PAQUETES)
+    Serial.end();
+    Serial.begin(VELOCIDAD_PERFIL);
+    if (CONTROL_FLUJO_PERFIL)
     {
-        // Obtener paquete actual
-        PaqueteTransmision paqueteActual = secuenciaPaquetes[indicePaqueteActual];
-        
-        // Transmitir paquete
-        transmitirPaquete(paqueteActual);
-        
-        // Avanzar al siguiente paquete
-        indicePaqueteActual++;
-        
-        // Esperar antes del siguiente paquete
-        delay(RETARDO_PAQUETES);
+        pinMode(PIN_CTS, INPUT_PULLUP);
     }
-    else
+}
+
+// =====================================================
+// TAREAS DEL PLANIFICADOR
+// =====================================================
+
+/**
+ * @brief Entrega al puerto serial los bytes que caben sin bloquear
+ * @param ahora Instante actual (sin uso)
+ */
+void tareaSalida(unsigned long ahora)
+{
+    (void)ahora;
+    int libres = Serial.availableForWrite();
+
+    // Primero el texto en PROGMEM, en tramos copiados a la pila
+    while (libres > 0 && bytesTextoPendiente > 0)
     {
-        // Secuencia completada
-        ciclosCompletados++;
-        
-        Serial.println();
-        Serial.println("========================================");
-        Serial.print("Transmision completada. Ciclo #");
-        Serial.println(ciclosCompletados);
-        Serial.println("========================================");
-        Serial.println();
-        
-        if (transmisionContinua)
+        byte tramo[16];
+        int cantidad = (libres < bytesTextoPendiente) ? libres : bytesTextoPendiente;
+        if (cantidad > (int)sizeof(tramo))
         {
-            // Reiniciar para transmisión continua
-            Serial.println("Reiniciando transmision en 5 segundos...");
-            Serial.println();
-            delay(5000);
-            indicePaqueteActual = 0;
+            cantidad = sizeof(tramo);
         }
-        else
+        memcpy_P(tramo, textoPendiente, cantidad);
+        Serial.write(tramo, cantidad);
+        textoPendiente += cantidad;
+        bytesTextoPendiente -= cantidad;
+        libres -= cantidad;
+    }
+
+    if (libres > 0 && enviadosSalida < longitudSalida)
+    {
+        int cantidad = longitudSalida - enviadosSalida;
+        if (cantidad > libres)
         {
-            // Detener transmisión
-            Serial.println("Transmision finalizada.");
-            Serial.println("Sistema en espera.");
-            Serial.println();
-            
-            // Bucle infinito (detener)
-            while(1)
+            cantidad = libres;
+        }
+        Serial.write((const byte*)&salida[enviadosSalida], cantidad);
+        enviadosSalida += cantidad;
+    }
+}
+
+/**
+ * @brief Avanza el transmisor por sus etapas
+ * @param ahora Instante actual (millis)
+ * 
+ * Cada etapa comprueba su condición y retorna; las esperas son
+ * comparaciones con millis().
+ */
+void tareaTransmisor(unsigned long ahora)
+{
+    switch (estadoTransmisor)
+    {
+    case ESTADO_ESPERA_INICIAL:
+        if (ahora - inicioEstado >= RETARDO_INICIAL)
+        {
+            char resumen[96];
+            snprintf(resumen, sizeof(resumen),
+                     "Total de paquetes: %d\n\nIniciando transmision en 2 segundos...\n\n", totalTramas);
+            encolarTexto(TEXTO_BIENVENIDA, resumen);
+            cambiarEstado(ESTADO_BIENVENIDA, ahora);
+        }
+        break;
+
+    case ESTADO_BIENVENIDA:
+        if (salidaLibre() && ahora - inicioEstado >= PAUSA_ANTES_TRANSMISION)
+        {
+            if (PERFIL_RAPIDO)
+            {
+                anunciarPerfilRapido();
+                cambiarEstado(ESTADO_ANUNCIO, ahora);
+            }
+            else
             {
-                delay(1000);
+                iniciarCiclo(ahora);
             }
         }
+        break;
+
+    case ESTADO_ANUNCIO:
+        if (salidaLibre() && Serial.availableForWrite() >= capacidadSerial)
+        {
+            cambiarEstado(ESTADO_VACIADO, ahora);
+        }
+        break;
+
+    case ESTADO_VACIADO:
+        if (ahora - inicioEstado >= MARGEN_VACIADO)
+        {
+            cambiarVelocidad();
+            capacidadSerial = Serial.availableForWrite();
+            cambiarEstado(ESTADO_CAMBIO_VELOCIDAD, ahora);
+        }
+        break;
+
+    case ESTADO_CAMBIO_VELOCIDAD:
+        if (ahora - inicioEstado >= RETARDO_CAMBIO_PERFIL)
+        {
+            perfilRapidoActivo = true;
+            iniciarCiclo(ahora);
+        }
+        break;
+
+    case ESTADO_TRANSMISION:
+        if (!salidaLibre())
+        {
+            break;
+        }
+        if (posicionMensaje >= LONGITUD_MENSAJE)
+        {
+            // Secuencia completada
+            ciclosCompletados++;
+            char resumen[LONGITUD_SALIDA];
+            snprintf(resumen, sizeof(resumen),
+                     "Transmision completada. Ciclo #%d\n"
+                     "========================================\n\n%s",
+                     ciclosCompletados,
+                     transmisionContinua ? "Reiniciando transmision...\n\n"
+                                         : "Transmision finalizada.\nSistema en espera.\n\n");
+            encolarTexto(TEXTO_FIN_CICLO, resumen);
+            cambiarEstado(ESTADO_FIN_CICLO, ahora);
+        }
+        else if (hayPermisoEnvio() && tramaVencida())
+        {
+            encolarSiguienteTrama();
+            contarTramaEnviada();
+        }
+        break;
+
+    case ESTADO_FIN_CICLO:
+        if (!salidaLibre())
+        {
+            break;
+        }
+        if (!transmisionContinua)
+        {
+            cambiarEstado(ESTADO_DETENIDO, ahora);
+        }
+        else if (ahora - inicioEstado >= pausaEntreCiclos)
+        {
+            iniciarCiclo(ahora);
+        }
+        break;
+
+    case ESTADO_DETENIDO:
+        break;
     }
 }
 
+/**
+ * @brief Hace parpadear el LED integrado mientras el bucle gira
+ * @param ahora Instante actual (sin uso)
+ */
+void tareaLatido(unsigned long ahora)
+{
+    (void)ahora;
+    ledEncendido = !ledEncendido;
+    digitalWrite(LED_BUILTIN, ledEncendido ? HIGH : LOW);
+}
+
+/// Tareas en orden de ejecución: la salida se vacía antes de encolar más
+Tarea tareas[] = {
+    { tareaSalida, 0, 0 },
+    { tareaTransmisor, 0, 0 },
+    { tareaLatido, PERIODO_LATIDO, 0 }
+};
+
+/// Número de tareas del planificador
+const int TOTAL_TAREAS = sizeof(tareas) / sizeof(tareas[0]);
+
 // =====================================================
 // FUNCIONES DE CONFIGURACIÓN ALTERNATIVA
 // =====================================================
@@ -294,7 +696,7 @@ void loop()
  * @brief Secuencia alternativa: mensaje "HOLA WORLD"
  * 
  * Para usar esta secuencia, reemplaza el contenido de
- * secuenciaPaquetes[] en la sección de configuración.
+ * TRAMAS_MENSAJE[] en la sección de configuración.
  */
 void configurarSecuenciaAlternativa()
 {
@@ -305,11 +707,79 @@ void configurarSecuenciaAlternativa()
 
 /**
  * @brief Habilita transmisión continua
+ * @param pausaMilisegundos Pausa entre el fin de un ciclo y el siguiente
  * 
  * Llama a esta función en setup() si deseas que el Arduino
  * transmita el mensaje repetidamente.
  */
-void habilitarTransmisionContinua()
+void habilitarTransmisionContinua(unsigned long pausaMilisegundos)
 {
     transmisionContinua = true;
-}
\ No newline at end of file
+    pausaEntreCiclos = pausaMilisegundos;
+}
+
+/**
+ * @brief Cambia el ritmo de tramas
+ * @param tramasPorSegundoLento Ritmo a VELOCIDAD_SERIAL (0 = velocidad de línea)
+ * @param tramasPorSegundoPerfil Ritmo con el perfil rápido (0 = velocidad de línea)
+ */
+void configurarRitmo(long tramasPorSegundoLento, long tramasPorSegundoPerfil)
+{
+    ritmoLento = tramasPorSegundoLento;
+    ritmoPerfil = tramasPorSegundoPerfil;
+}
+
+// =====================================================
+// FUNCIONES DE ARDUINO
+// =====================================================
+
+/**
+ * @brief Configuración inicial del Arduino
+ * 
+ * Inicializa el puerto serial y el planificador. Se ejecuta una
+ * sola vez al inicio; las esperas de arranque corren en loop().
+ */
+void setup()
+{
+    // Inicializar comunicación serial
+    Serial.begin(VELOCIDAD_SERIAL);
+    capacidadSerial = Serial.availableForWrite();
+    pinMode(LED_BUILTIN, OUTPUT);
+
+    // Contar las tramas de la secuencia precalculada
+    totalTramas = 0;
+    for (int i = 0; i < LONGITUD_MENSAJE; i++)
+    {
+        if (pgm_read_byte(&TRAMAS_MENSAJE[i]) == '\n')
+        {
+            totalTramas++;
+        }
+    }
+
+    unsigned long ahora = millis();
+    for (int i = 0; i < TOTAL_TAREAS; i++)
+    {
+        tareas[i].ultimaEjecucion = ahora;
+    }
+    cambiarEstado(ESTADO_ESPERA_INICIAL, ahora);
+}
+
+/**
+ * @brief Bucle principal de ejecución
+ * 
+ * Ejecuta las tareas cuyo periodo venció. Ninguna espera, así que
+ * una vuelta dura microsegundos y el ritmo de tramas solo depende
+ * de la configuración y de la velocidad de la línea.
+ */
+void loop()
+{
+    unsigned long ahora = millis();
+    for (int i = 0; i < TOTAL_TAREAS; i++)
+    {
+        if (ahora - tareas[i].ultimaEjecucion >= tareas[i].periodo)
+        {
+            tareas[i].ultimaEjecucion = ahora;
+            tareas[i].ejecutar(ahora);
+        }
+    }
+}
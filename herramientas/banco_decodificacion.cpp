@@ -0,0 +1,367 @@
+/**
+ * @file banco_decodificacion.cpp
+ * @brief Banco de rendimiento del núcleo de decodificación PRT-7
+ * @author Tu Nombre
+ * @date 2024
+ *
+ * Genera en memoria un flujo sintético con la mezcla de tramas de un
+ * transmisor real (letras, rotaciones, rotores dirigidos y
+ * sincronizaciones, con o sin sufijo de integridad) y lo decodifica
+ * varias veces con SesionDecodificacion. Informa de la mejor
+ * repetición en tramas por segundo.
+ *
+ * Sirve tanto para medir como para entrenar las compilaciones
+ * guiadas por perfil (ver scripts/pgo.sh).
+ *
+ * Con --archivo=RUTA el flujo se guarda además como archivo de
+ * tramas (ver ArchivadorTramas) y se compara con el texto: tamaño,
+ * mejor tiempo de decodificación en paralelo (incluida la lectura
+ * del archivo) y huella del mensaje.
+ */
+
+#include "SesionDecodificacion.h"
+#include "ControlIntegridad.h"
+#include "ArchivadorTramas.h"
+#include "DecodificadorArchivo.h"
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+
+/**
+ * @class GeneradorCarga
+ * @brief Flujo PRT-7 sintético y reproducible
+ */
+class GeneradorCarga
+{
+private:
+    char* flujo;             ///< Bytes generados
+    long long capacidad;     ///< Tamaño reservado
+    long long longitud;      ///< Bytes ocupados
+    int tramas;              ///< Tramas generadas
+    unsigned int estado;     ///< Estado del generador pseudoaleatorio
+    int secuencia;           ///< Número de secuencia de la siguiente trama
+    int rotacion;            ///< Rotación acumulada del rotor 0
+    bool conIntegridad;      ///< Agregar ",<seq>*<CRC>" a cada trama
+
+    /**
+     * @brief Siguiente valor pseudoaleatorio (LCG de Numerical Recipes)
+     * @param limite Cota superior exclusiva
+     * @return Valor en [0, limite)
+     */
+    int aleatorio(int limite)
+    {
+        estado = estado * 1664525u + 1013904223u;
+        return (int)((estado >> 8) % (unsigned int)limite);
+    }
+
+    /**
+     * @brief Agrega una trama al flujo
+     * @param cuerpo Texto de la trama sin sufijo ni salto de línea
+     */
+    void agregarTrama(const char* cuerpo)
+    {
+        char linea[64];
+        int escritos;
+        if (conIntegridad)
+        {
+            char conSecuencia[48];
+            int base = std::snprintf(conSecuencia, sizeof(conSecuencia), "%s,%d", cuerpo, secuencia);
+            secuencia = (secuencia + 1) % 256;
+            escritos = std::snprintf(linea, sizeof(linea), "%s*%02X\n", conSecuencia,
+                                     ControlIntegridad::calcularCrc(conSecuencia, base));
+        }
+        else
+        {
+            escritos = std::snprintf(linea, sizeof(linea), "%s\n", cuerpo);
+        }
+
+        if (longitud + escritos > capacidad)
+        {
+            capacidad *= 2;
+            char* ampliado = new char[capacidad];
+            std::memcpy(ampliado, flujo, longitud);
+            delete[] flujo;
+            flujo = ampliado;
+        }
+        std::memcpy(flujo + longitud, linea, escritos);
+        longitud += escritos;
+        tramas++;
+    }
+
+public:
+    /**
+     * @brief Genera el flujo completo
+     * @param cantidadTramas Tramas a generar (aproximadamente)
+     * @param semilla Semilla del generador
+     * @param integridad true para agregar el sufijo de integridad
+     */
+    GeneradorCarga(int cantidadTramas, unsigned int semilla, bool integridad)
+    {
+        capacidad = 1 << 16;
+        flujo = new char[capacidad];
+        longitud = 0;
+        tramas = 0;
+        estado = semilla;
+        secuencia = 0;
+        rotacion = 0;
+        conIntegridad = integridad;
+
+        char cuerpo[32];
+        while (tramas < cantidadTramas)
+        {
+            int sorteo = aleatorio(100);
+            if (sorteo < 85)
+            {
+                std::snprintf(cuerpo, sizeof(cuerpo), "L,%c", 'A' + aleatorio(26));
+            }
+            else if (sorteo < 93)
+            {
+                int giro = aleatorio(51) - 25;
+                rotacion = ((rotacion + giro) % 26 + 26) % 26;
+                std::snprintf(cuerpo, sizeof(cuerpo), "M,%d", giro);
+            }
+            else if (sorteo < 97)
+            {
+                int giro = aleatorio(51) - 25;
+                rotacion = ((rotacion + giro) % 26 + 26) % 26;
+                std::snprintf(cuerpo, sizeof(cuerpo), "R,0,%d", giro);
+            }
+            else
+            {
+                std::snprintf(cuerpo, sizeof(cuerpo), "S,%d", rotacion);
+            }
+            agregarTrama(cuerpo);
+        }
+    }
+
+    ~GeneradorCarga()
+    {
+        delete[] flujo;
+    }
+
+    const char* obtenerFlujo() const
+    {
+        return flujo;
+    }
+
+    long long obtenerLongitud() const
+    {
+        return longitud;
+    }
+
+    int obtenerTramas() const
+    {
+        return tramas;
+    }
+
+    GeneradorCarga(const GeneradorCarga&) = delete;
+    GeneradorCarga& operator=(const GeneradorCarga&) = delete;
+};
+
+/**
+ * @brief Huella de un texto (djb2), la misma que se calcula sobre el mensaje
+ * @param texto Caracteres
+ * @param longitud Cantidad de caracteres
+ * @return Huella
+ */
+static unsigned long calcularHuella(const char* texto, long long longitud)
+{
+    unsigned long huella = 5381;
+    for (long long i = 0; i < longitud; i++)
+    {
+        huella = huella * 33 + (unsigned char)texto[i];
+    }
+    return huella;
+}
+
+/**
+ * @brief Archiva el flujo y mide su decodificación por bloques
+ * @param carga Flujo sintético
+ * @param ruta Archivo de tramas a crear
+ * @param integridad true si el flujo lleva sufijo de integridad
+ * @param repeticiones Decodificaciones a medir
+ * @param hilos Hilos del decodificador (0 = todos)
+ * @param longitudReferencia Longitud del mensaje decodificado desde el texto
+ * @param huellaReferencia Huella del mensaje decodificado desde el texto
+ * @param segundosTexto Mejor tiempo de decodificación del texto
+ * @return false si no se pudo archivar o el mensaje no coincide
+ */
+static bool compararArchivo(const GeneradorCarga& carga, const char* ruta, bool integridad,
+                            int repeticiones, int hilos, int longitudReferencia,
+                            unsigned long huellaReferencia, double segundosTexto)
+{
+    PoliticaFinalizacion* politica = crearPoliticaFinalizacion("continuo");
+    bool archivado;
+    {
+        SesionDecodificacion sesion(politica, 1, false, integridad);
+        ArchivadorTramas archivador(ruta, &sesion, nullptr);
+        sesion.establecerObservador(&archivador);
+        sesion.decodificarBloque(carga.obtenerFlujo(), (int)carga.obtenerLongitud());
+        archivado = archivador.cerrar();
+    }
+    delete politica;
+    if (!archivado)
+    {
+        std::cerr << "ERROR: no se pudo escribir " << ruta << std::endl;
+        return false;
+    }
+
+    char* texto = new char[longitudReferencia > 0 ? longitudReferencia : 1];
+    double mejorSegundos = 0.0;
+    long long bytesArchivo = 0;
+    int bloques = 0;
+    bool coincide = true;
+
+    for (int repeticion = 0; repeticion < repeticiones; repeticion++)
+    {
+        // La lectura del archivo cuenta: el texto también habría que leerlo
+        std::chrono::steady_clock::time_point inicio = std::chrono::steady_clock::now();
+        DecodificadorArchivo decodificador(ruta);
+        long long caracteres = decodificador.estaOperativo()
+            ? decodificador.decodificar(texto, hilos) : -1;
+        double segundos = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - inicio).count();
+
+        if (caracteres != longitudReferencia ||
+            calcularHuella(texto, caracteres) != huellaReferencia)
+        {
+            coincide = false;
+        }
+        bytesArchivo = decodificador.obtenerBytesArchivo();
+        bloques = decodificador.obtenerBloques();
+        if (repeticion == 0 || segundos < mejorSegundos)
+        {
+            mejorSegundos = segundos;
+        }
+    }
+    delete[] texto;
+
+    std::cout << "Archivo: " << bytesArchivo << " bytes en " << bloques << " bloques ("
+              << 100.0 * bytesArchivo / carga.obtenerLongitud() << "% del texto)" << std::endl;
+    std::cout << "Mejor decodificacion del archivo: " << mejorSegundos * 1000.0 << " ms ("
+              << segundosTexto / mejorSegundos << "x el texto)" << std::endl;
+
+    if (!coincide)
+    {
+        std::cerr << "ERROR: el archivo no reproduce el mensaje del texto" << std::endl;
+    }
+    return coincide;
+}
+
+/**
+ * @brief Punto de entrada del banco
+ * @param argc Cantidad de argumentos
+ * @param argv Argumentos: [--tramas=N] [--repeticiones=K] [--semilla=S]
+ *             [--integridad] [--rotores=N] [--archivo=RUTA] [--hilos=N]
+ * @return 0 si la decodificación coincidió en todas las repeticiones
+ */
+int main(int argc, char* argv[])
+{
+    int cantidadTramas = 2000000;
+    int repeticiones = 5;
+    unsigned int semilla = 7;
+    bool integridad = false;
+    int cantidadRotores = 1;
+    const char* rutaArchivo = nullptr;
+    int hilos = 0;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (std::strncmp(argv[i], "--tramas=", 9) == 0)
+            cantidadTramas = std::atoi(argv[i] + 9);
+        else if (std::strncmp(argv[i], "--repeticiones=", 15) == 0)
+            repeticiones = std::atoi(argv[i] + 15);
+        else if (std::strncmp(argv[i], "--semilla=", 10) == 0)
+            semilla = (unsigned int)std::strtoul(argv[i] + 10, nullptr, 10);
+        else if (std::strcmp(argv[i], "--integridad") == 0)
+            integridad = true;
+        else if (std::strncmp(argv[i], "--rotores=", 10) == 0)
+            cantidadRotores = std::atoi(argv[i] + 10);
+        else if (std::strncmp(argv[i], "--archivo=", 10) == 0)
+            rutaArchivo = argv[i] + 10;
+        else if (std::strncmp(argv[i], "--hilos=", 8) == 0)
+            hilos = std::atoi(argv[i] + 8);
+        else
+        {
+            std::cerr << "Opcion desconocida: " << argv[i] << std::endl;
+            return 1;
+        }
+    }
+    if (cantidadTramas < 1 || repeticiones < 1)
+    {
+        std::cerr << "--tramas y --repeticiones deben ser positivos" << std::endl;
+        return 1;
+    }
+    if (rutaArchivo != nullptr && cantidadRotores != 1)
+    {
+        std::cerr << "--archivo solo admite un rotor" << std::endl;
+        return 1;
+    }
+
+    GeneradorCarga carga(cantidadTramas, semilla, integridad);
+    PoliticaFinalizacion* politica = crearPoliticaFinalizacion("continuo");
+
+    double mejorSegundos = 0.0;
+    int longitudReferencia = -1;
+    unsigned long huellaReferencia = 0;
+    bool coincide = true;
+
+    for (int repeticion = 0; repeticion < repeticiones; repeticion++)
+    {
+        SesionDecodificacion sesion(politica, cantidadRotores, false, integridad);
+
+        std::chrono::steady_clock::time_point inicio = std::chrono::steady_clock::now();
+        sesion.decodificarBloque(carga.obtenerFlujo(), (int)carga.obtenerLongitud());
+        double segundos = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - inicio).count();
+
+        // Huella del mensaje: todas las repeticiones deben coincidir
+        unsigned long huella = 5381;
+        const MensajeDecodificado& mensaje = sesion.obtenerMensaje();
+        for (IteradorMensaje iterador = mensaje.iteradorInicio(); iterador.esValido(); iterador.avanzar())
+        {
+            huella = huella * 33 + (unsigned char)iterador.obtenerCaracter();
+        }
+
+        if (longitudReferencia < 0)
+        {
+            longitudReferencia = mensaje.obtenerLongitud();
+            huellaReferencia = huella;
+        }
+        else if (mensaje.obtenerLongitud() != longitudReferencia || huella != huellaReferencia)
+        {
+            coincide = false;
+        }
+
+        if (repeticion == 0 || segundos < mejorSegundos)
+        {
+            mejorSegundos = segundos;
+        }
+    }
+
+    delete politica;
+
+    std::cout << "Tramas: " << carga.obtenerTramas() << " (" << carga.obtenerLongitud()
+              << " bytes" << (integridad ? ", con integridad" : "") << ")" << std::endl;
+    std::cout << "Mensaje: " << longitudReferencia << " caracteres, huella "
+              << std::hex << huellaReferencia << std::dec << std::endl;
+    std::cout << "Mejor repeticion: " << mejorSegundos * 1000.0 << " ms" << std::endl;
+    std::cout << "MB/s: " << (long long)(carga.obtenerLongitud() / mejorSegundos / 1e6) << std::endl;
+    std::cout << "tramas/s: " << (long long)(carga.obtenerTramas() / mejorSegundos) << std::endl;
+
+    if (!coincide)
+    {
+        std::cerr << "ERROR: las repeticiones no produjeron el mismo mensaje" << std::endl;
+        return 1;
+    }
+
+    if (rutaArchivo != nullptr &&
+        !compararArchivo(carga, rutaArchivo, integridad, repeticiones, hilos,
+                         longitudReferencia, huellaReferencia, mejorSegundos))
+    {
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,308 @@
+/**
+ * @file codificador.cpp
+ * @brief Genera tramas PRT-7 a partir de texto claro
+ * @author Tu Nombre
+ * @date 2024
+ * 
+ * Cada línea de la entrada estándar es un mensaje: se codifica con
+ * PlanificadorTramas según la política indicada y se cierra con una
+ * trama F (salvo con --sin-fin). Las tramas salen por la salida
+ * estándar y el resumen por la de errores, de modo que el resultado
+ * puede enviarse tal cual a un puerto o a decodificador --escuchar.
+ * 
+ * Con --sintetico=MB no se lee la entrada: se codifican mensajes
+ * pseudoaleatorios de palabras, se informa del rendimiento del
+ * planificador y se comprueba que SesionDecodificacion recupere el
+ * texto exacto. Sirve para producir cargas de prueba realistas.
+ */
+
+#include "PlanificadorTramas.h"
+#include "SesionDecodificacion.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+/**
+ * @brief Lee una línea completa, sin el salto final
+ * @param entrada Archivo de lectura
+ * @param buffer Buffer de la línea (se amplía si hace falta)
+ * @param capacidad Tamaño del buffer
+ * @return Caracteres de la línea, o -1 al final de la entrada
+ */
+static long leerLinea(std::FILE* entrada, char** buffer, size_t* capacidad)
+{
+    size_t longitud = 0;
+    bool leido = false;
+    while (std::fgets(*buffer + longitud, (int)(*capacidad - longitud), entrada) != nullptr)
+    {
+        leido = true;
+        longitud += std::strlen(*buffer + longitud);
+        if (longitud > 0 && (*buffer)[longitud - 1] == '\n')
+            break;
+
+        if (longitud + 1 == *capacidad)
+        {
+            char* ampliado = new char[*capacidad * 2];
+            std::memcpy(ampliado, *buffer, longitud + 1);
+            delete[] *buffer;
+            *buffer = ampliado;
+            *capacidad *= 2;
+        }
+    }
+    if (!leido)
+        return -1;
+
+    while (longitud > 0 && ((*buffer)[longitud - 1] == '\n' || (*buffer)[longitud - 1] == '\r'))
+    {
+        longitud--;
+    }
+    return (long)longitud;
+}
+
+/**
+ * @brief Genera un mensaje de palabras pseudoaleatorias
+ * @param destino Buffer del mensaje
+ * @param longitud Caracteres aproximados del mensaje
+ * @param estado Estado del generador (LCG de Numerical Recipes)
+ * @return Caracteres escritos (nunca más de longitud + 12)
+ * 
+ * Mayúsculas con algún número y signo de puntuación; el mensaje
+ * termina en letra o punto, como los de un transmisor real.
+ */
+static size_t generarMensaje(char* destino, size_t longitud, unsigned int* estado)
+{
+    size_t escritos = 0;
+    while (escritos < longitud)
+    {
+        if (escritos > 0)
+            destino[escritos++] = ' ';
+
+        *estado = *estado * 1664525u + 1013904223u;
+        unsigned int azar = *estado >> 8;
+        int letras = 2 + (int)(azar % 8);
+        bool numero = (azar >> 4) % 16 == 0;
+        for (int indice = 0; indice < letras; indice++)
+        {
+            *estado = *estado * 1664525u + 1013904223u;
+            unsigned int valor = *estado >> 8;
+            destino[escritos++] = numero ? (char)('0' + valor % 10) : (char)('A' + valor % 26);
+        }
+        if ((azar >> 8) % 12 == 0)
+            destino[escritos++] = ((azar >> 12) % 2 == 0) ? ',' : '.';
+    }
+    return escritos;
+}
+
+/**
+ * @brief Codifica un mensaje y lo cierra
+ * @param planificador Planificador en uso
+ * @param texto Mensaje claro
+ * @param longitud Caracteres del mensaje
+ * @param salida Buffer de tramas (se amplía si hace falta)
+ * @param capacidad Tamaño del buffer de salida
+ * @param cerrarMensaje Agregar la trama F
+ * @return Bytes escritos, o -1 si el mensaje no puede enviarse
+ */
+static long codificarMensaje(PlanificadorTramas& planificador, const char* texto, size_t longitud,
+                             char** salida, size_t* capacidad, bool cerrarMensaje)
+{
+    size_t necesaria = planificador.calcularCapacidadNecesaria(longitud) + 16;
+    if (necesaria > *capacidad)
+    {
+        delete[] *salida;
+        *capacidad = necesaria;
+        *salida = new char[*capacidad];
+    }
+
+    long escritos = planificador.codificar(texto, longitud, *salida, *capacidad);
+    if (escritos >= 0 && cerrarMensaje)
+    {
+        escritos += planificador.cerrar(*salida + escritos, *capacidad - (size_t)escritos);
+    }
+    return escritos;
+}
+
+/**
+ * @brief Modo sintético: codifica, mide y verifica con el decodificador
+ * @param planificador Planificador en uso
+ * @param megabytes Texto claro a generar
+ * @param cableado Cableado del disco del receptor, o nullptr
+ * @param integridad true si las tramas llevan sufijo
+ * @param cerrarMensajes Agregar una trama F a cada mensaje
+ * @return 0 si el decodificador recuperó el texto
+ */
+static int ejecutarSintetico(PlanificadorTramas& planificador, long megabytes, const char* cableado,
+                             bool integridad, bool cerrarMensajes)
+{
+    size_t total = (size_t)megabytes * 1000000;
+    char* texto = new char[total + 16];
+    int* longitudes = new int[total / 40 + 2];
+    int mensajes = 0;
+    unsigned int estado = 7;
+    size_t generado = 0;
+    while (generado < total)
+    {
+        estado = estado * 1664525u + 1013904223u;
+        size_t deseado = 40 + (estado >> 8) % 360;
+        if (deseado > total - generado)
+            deseado = total - generado;
+        size_t longitud = generarMensaje(texto + generado, deseado, &estado);
+        longitudes[mensajes++] = (int)longitud;
+        generado += longitud;
+    }
+
+    size_t capacidadFlujo = generado * 2 + 64;
+    char* flujo = new char[capacidadFlujo];
+    size_t longitudFlujo = 0;
+    size_t capacidadMensaje = 0;
+    char* tramasMensaje = nullptr;
+
+    std::chrono::steady_clock::time_point inicio = std::chrono::steady_clock::now();
+    size_t posicion = 0;
+    for (int indice = 0; indice < mensajes; indice++)
+    {
+        long escritos = codificarMensaje(planificador, texto + posicion, (size_t)longitudes[indice],
+                                         &tramasMensaje, &capacidadMensaje, cerrarMensajes);
+        if (escritos < 0)
+        {
+            std::cerr << "Mensaje " << indice + 1 << ": no puede enviarse con esta politica" << std::endl;
+            return 1;
+        }
+        if (longitudFlujo + (size_t)escritos > capacidadFlujo)
+        {
+            capacidadFlujo = (longitudFlujo + (size_t)escritos) * 2;
+            char* ampliado = new char[capacidadFlujo];
+            std::memcpy(ampliado, flujo, longitudFlujo);
+            delete[] flujo;
+            flujo = ampliado;
+        }
+        std::memcpy(flujo + longitudFlujo, tramasMensaje, (size_t)escritos);
+        longitudFlujo += (size_t)escritos;
+        posicion += (size_t)longitudes[indice];
+    }
+    double segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+
+    std::fwrite(flujo, 1, longitudFlujo, stdout);
+    std::fflush(stdout);
+
+    // El decodificador debe devolver exactamente el texto generado
+    PoliticaFinalizacion* politicaFin = crearPoliticaFinalizacion("continuo");
+    SesionDecodificacion sesion(politicaFin, 1, false, integridad);
+    if (cableado != nullptr)
+    {
+        sesion.obtenerDisco() = DiscoRotatorio(cableado);
+    }
+    sesion.decodificarBloque(flujo, (int)longitudFlujo);
+    const MensajeDecodificado& mensaje = sesion.obtenerMensaje();
+    bool coincide = ((size_t)mensaje.obtenerLongitud() == generado);
+    size_t indice = 0;
+    for (IteradorMensaje iterador = mensaje.iteradorInicio(); coincide && iterador.esValido();
+         iterador.avanzar())
+    {
+        coincide = (iterador.obtenerCaracter() == texto[indice++]);
+    }
+
+    std::cerr << "Mensajes: " << mensajes << ", texto: " << generado << " bytes, tramas: "
+              << planificador.obtenerTramas() << " (" << planificador.obtenerRotaciones()
+              << " rotaciones), salida: " << longitudFlujo << " bytes" << std::endl;
+    std::fprintf(stderr, "Bytes por caracter: %.3f\n", (double)longitudFlujo / (double)generado);
+    std::fprintf(stderr, "Codificacion: %.1f ms, %.1f MB/s de texto, %.1f MB/s de tramas\n",
+                 segundos * 1000.0, generado / segundos / 1e6, longitudFlujo / segundos / 1e6);
+    std::cerr << "Verificacion: " << (coincide ? "el decodificador recupera el texto"
+                                               : "ERROR, el texto decodificado difiere") << std::endl;
+
+    delete politicaFin;
+    delete[] tramasMensaje;
+    delete[] flujo;
+    delete[] longitudes;
+    delete[] texto;
+    return coincide ? 0 : 1;
+}
+
+/**
+ * @brief Punto de entrada del codificador
+ * @param argc Cantidad de argumentos
+ * @param argv Argumentos: [--bloque=N] [--rotar=N] [--clave=TEXTO]
+ *             [--integridad] [--sincronizar=N] [--cableado=PERM]
+ *             [--sin-fin] [--sintetico=MB]
+ * @return 0 si todos los mensajes se codificaron
+ */
+int main(int argc, char* argv[])
+{
+    PoliticaCodificacion politica;
+    const char* cableado = nullptr;
+    bool cerrarMensajes = true;
+    long sintetico = 0;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (std::strncmp(argv[i], "--bloque=", 9) == 0)
+            politica.longitudMaximaBloque = std::atoi(argv[i] + 9);
+        else if (std::strncmp(argv[i], "--rotar=", 8) == 0)
+            politica.letrasPorRotacion = std::atoi(argv[i] + 8);
+        else if (std::strncmp(argv[i], "--clave=", 8) == 0)
+            politica.clave = argv[i] + 8;
+        else if (std::strcmp(argv[i], "--integridad") == 0)
+            politica.incluirIntegridad = true;
+        else if (std::strncmp(argv[i], "--sincronizar=", 14) == 0)
+            politica.intervaloSincronizacion = std::atoi(argv[i] + 14);
+        else if (std::strncmp(argv[i], "--cableado=", 11) == 0)
+            cableado = argv[i] + 11;
+        else if (std::strcmp(argv[i], "--sin-fin") == 0)
+            cerrarMensajes = false;
+        else if (std::strncmp(argv[i], "--sintetico=", 12) == 0)
+            sintetico = std::atol(argv[i] + 12);
+        else
+        {
+            std::cerr << "Opcion desconocida: " << argv[i] << std::endl;
+            return 1;
+        }
+    }
+
+    PlanificadorTramas planificador(politica, cableado);
+    if (sintetico > 0)
+    {
+        return ejecutarSintetico(planificador, sintetico, cableado, politica.incluirIntegridad,
+                                 cerrarMensajes);
+    }
+
+    size_t capacidadLinea = 4096;
+    char* linea = new char[capacidadLinea];
+    size_t capacidadSalida = 0;
+    char* salida = nullptr;
+    long numeroLinea = 0;
+    long long bytesTexto = 0;
+    long long bytesSalida = 0;
+    int resultado = 0;
+
+    long longitud = leerLinea(stdin, &linea, &capacidadLinea);
+    while (longitud >= 0)
+    {
+        numeroLinea++;
+        long escritos = codificarMensaje(planificador, linea, (size_t)longitud,
+                                         &salida, &capacidadSalida, cerrarMensajes);
+        if (escritos < 0)
+        {
+            std::cerr << "Linea " << numeroLinea << ": el caracter "
+                      << planificador.obtenerPosicionError() + 1
+                      << " no puede enviarse con esta politica" << std::endl;
+            resultado = 1;
+            break;
+        }
+        std::fwrite(salida, 1, (size_t)escritos, stdout);
+        bytesTexto += longitud;
+        bytesSalida += escritos;
+        longitud = leerLinea(stdin, &linea, &capacidadLinea);
+    }
+    std::fflush(stdout);
+
+    std::cerr << "Mensajes: " << numeroLinea << ", texto: " << bytesTexto << " bytes, tramas: "
+              << planificador.obtenerTramas() << " (" << planificador.obtenerRotaciones()
+              << " rotaciones), salida: " << bytesSalida << " bytes" << std::endl;
+
+    delete[] salida;
+    delete[] linea;
+    return resultado;
+}
@@ -0,0 +1,242 @@
+/**
+ * @file latencia_anillo.cpp
+ * @brief Banco de latencia del anillo de eventos en memoria compartida
+ * @author Tu Nombre
+ * @date 2024
+ * 
+ * Un proceso decodifica tramas L y M de una en una, separadas por un
+ * intervalo fijo, y publica los eventos con PublicadorEventos. Un
+ * proceso hijo los consume con LectorAnillo en espera activa y mide
+ * dos latencias por evento:
+ * 
+ * - trama -> consumidor: desde que la trama se entrega a la sesión
+ *   (análisis, decodificación y publicación incluidos);
+ * - publicación -> consumidor: solo el paso por el anillo.
+ * 
+ * Ambos procesos usan CLOCK_MONOTONIC, así que los instantes son
+ * comparables. Conviene fijar cada proceso a un núcleo distinto
+ * (taskset) para medir el costo entre núcleos.
+ */
+
+#include "PublicadorEventos.h"
+#include "LectorAnillo.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/**
+ * @struct EstadoCompartido
+ * @brief Inicio de la memoria anónima compartida entre escritor y lector
+ * 
+ * En la línea de caché siguiente van los instantes de entrega de
+ * cada trama, fuera del anillo para no alterar lo que se mide.
+ */
+struct EstadoCompartido
+{
+    std::atomic<int> lectorListo;      ///< 1 si el hijo abrió el anillo, -1 si falló
+};
+
+/// Desplazamiento de los instantes de entrega dentro de la memoria compartida
+static const size_t INICIO_ENTREGAS = 64;
+
+/**
+ * @brief Muestra los percentiles de una serie de latencias
+ * @param titulo Nombre de la serie
+ * @param latencias Latencias en ns (se ordenan)
+ * @param cantidad Elementos de la serie
+ */
+static void mostrarPercentiles(const char* titulo, unsigned long long* latencias, long cantidad)
+{
+    if (cantidad == 0)
+    {
+        std::cout << titulo << ": sin muestras" << std::endl;
+        return;
+    }
+    std::sort(latencias, latencias + cantidad);
+    std::printf("%-24s p50 %6llu ns  p90 %6llu ns  p99 %6llu ns  p99.9 %7llu ns  max %8llu ns\n",
+                titulo,
+                latencias[cantidad * 50 / 100],
+                latencias[cantidad * 90 / 100],
+                latencias[cantidad * 99 / 100],
+                latencias[cantidad * 999 / 1000],
+                latencias[cantidad - 1]);
+}
+
+/**
+ * @brief Proceso lector: consume hasta el evento 'X' y muestra las latencias
+ * @param nombre Nombre del anillo
+ * @param estado Memoria compartida con el escritor
+ * @param entregas Instante de entrega de cada trama
+ * @param tramas Tramas que enviará el escritor
+ * @return Código de salida del proceso hijo
+ */
+static int consumir(const char* nombre, EstadoCompartido* estado,
+                    const unsigned long long* entregas, long tramas)
+{
+    LectorAnillo lector(nombre);
+    if (!lector.estaOperativo())
+    {
+        std::cerr << "No se pudo abrir el anillo " << nombre << std::endl;
+        estado->lectorListo.store(-1, std::memory_order_release);
+        return 1;
+    }
+    estado->lectorListo.store(1, std::memory_order_release);
+
+    unsigned long long* desdeTrama = new unsigned long long[tramas];
+    unsigned long long* desdePublicacion = new unsigned long long[tramas];
+    long muestras = 0;
+    bool terminado = false;
+    EventoDecodificado eventos[64];
+
+    while (!terminado)
+    {
+        int leidos = lector.leer(eventos, 64);
+        unsigned long long ahora = instanteAnillo();
+        for (int indice = 0; indice < leidos; indice++)
+        {
+            const EventoDecodificado& evento = eventos[indice];
+            if (evento.tipo == 'X')
+            {
+                terminado = true;
+                break;
+            }
+            if ((long)evento.secuencia < tramas)
+            {
+                desdeTrama[muestras] = ahora - entregas[evento.secuencia];
+                desdePublicacion[muestras] = ahora - evento.instante;
+                muestras++;
+            }
+        }
+    }
+
+    std::cout << "Eventos consumidos: " << muestras << ", perdidos: "
+              << lector.obtenerPerdidos() << std::endl;
+    mostrarPercentiles("trama -> consumidor", desdeTrama, muestras);
+    mostrarPercentiles("publicacion -> consumidor", desdePublicacion, muestras);
+
+    delete[] desdeTrama;
+    delete[] desdePublicacion;
+    return 0;
+}
+
+/**
+ * @brief Punto de entrada del banco
+ * @param argc Cantidad de argumentos
+ * @param argv Argumentos: [--tramas=N] [--intervalo=NS] [--ranuras=N]
+ * @return 0 si el lector terminó correctamente
+ */
+int main(int argc, char* argv[])
+{
+    long tramas = 200000;
+    long intervalo = 2000;
+    unsigned int ranuras = CAPACIDAD_ANILLO;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (std::strncmp(argv[i], "--tramas=", 9) == 0)
+            tramas = std::atol(argv[i] + 9);
+        else if (std::strncmp(argv[i], "--intervalo=", 12) == 0)
+            intervalo = std::atol(argv[i] + 12);
+        else if (std::strncmp(argv[i], "--ranuras=", 10) == 0)
+            ranuras = (unsigned int)std::strtoul(argv[i] + 10, nullptr, 10);
+        else
+        {
+            std::cerr << "Opcion desconocida: " << argv[i] << std::endl;
+            return 1;
+        }
+    }
+    if (tramas < 1 || intervalo < 0)
+    {
+        std::cerr << "--tramas debe ser positivo e --intervalo no negativo" << std::endl;
+        return 1;
+    }
+
+    // Con un solo núcleo lector y escritor se turnan: se mide el planificador
+    if (sysconf(_SC_NPROCESSORS_ONLN) < 2)
+    {
+        std::cout << "Aviso: un solo nucleo disponible; las latencias incluyen "
+                  << "el reparto de tiempo del planificador." << std::endl;
+    }
+
+    char nombre[64];
+    std::snprintf(nombre, sizeof(nombre), "/prt7_latencia_%d", (int)getpid());
+    AnilloEventos anillo(nombre, ranuras);
+    if (!anillo.estaOperativo())
+    {
+        std::cerr << "No se pudo crear el anillo " << nombre << std::endl;
+        return 1;
+    }
+
+    size_t bytesEstado = INICIO_ENTREGAS + (size_t)tramas * sizeof(unsigned long long);
+    void* memoria = mmap(nullptr, bytesEstado, PROT_READ | PROT_WRITE,
+                         MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (memoria == MAP_FAILED)
+    {
+        std::cerr << "No se pudo reservar la memoria compartida" << std::endl;
+        return 1;
+    }
+    EstadoCompartido* estado = new (memoria) EstadoCompartido;
+    estado->lectorListo.store(0, std::memory_order_relaxed);
+    unsigned long long* entregas = (unsigned long long*)((char*)memoria + INICIO_ENTREGAS);
+
+    std::cout.flush();
+    pid_t hijo = fork();
+    if (hijo == 0)
+    {
+        // Sin destructores: el anillo es del proceso padre
+        int codigo = consumir(nombre, estado, entregas, tramas);
+        std::cout.flush();
+        std::_Exit(codigo);
+    }
+
+    while (estado->lectorListo.load(std::memory_order_acquire) == 0)
+    {
+    }
+    if (estado->lectorListo.load(std::memory_order_relaxed) < 0)
+    {
+        waitpid(hijo, nullptr, 0);
+        munmap(memoria, bytesEstado);
+        return 1;
+    }
+
+    PoliticaFinalizacion* politica = crearPoliticaFinalizacion("trama");
+    SesionDecodificacion sesion(politica, 1, false, false);
+    PublicadorEventos publicador(&anillo, nullptr);
+    sesion.establecerObservador(&publicador);
+
+    // Una trama por evento: cada 50 letras, una rotación
+    char linea[8];
+    for (long indice = 0; indice < tramas; indice++)
+    {
+        int longitud;
+        if (indice % 50 == 49)
+            longitud = std::snprintf(linea, sizeof(linea), "M,1\n");
+        else
+            longitud = std::snprintf(linea, sizeof(linea), "L,%c\n", (char)('A' + indice % 26));
+
+        unsigned long long entrega = instanteAnillo();
+        entregas[indice] = entrega;
+        sesion.decodificarBloque(linea, longitud);
+
+        while (instanteAnillo() - entrega < (unsigned long long)intervalo)
+        {
+        }
+    }
+    sesion.decodificarBloque("F,0\n", 4);
+
+    int resultado = 1;
+    waitpid(hijo, &resultado, 0);
+    std::cout << "Tramas publicadas: " << tramas << ", intervalo: " << intervalo
+              << " ns, ranuras: " << anillo.obtenerCapacidad() << std::endl;
+
+    delete politica;
+    munmap(memoria, bytesEstado);
+    return (WIFEXITED(resultado) && WEXITSTATUS(resultado) == 0) ? 0 : 1;
+}
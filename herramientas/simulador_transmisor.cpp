@@ -0,0 +1,247 @@
+/**
+ * @file simulador_transmisor.cpp
+ * @brief Ejecuta el sketch del transmisor en el host y mide su temporización
+ * @author Tu Nombre
+ * @date 2024
+ * 
+ * Compila arduino/sketch.ino contra el Arduino.h simulado, llama a
+ * setup() y a loop() como lo haría el núcleo de Arduino (con un
+ * coste fijo por vuelta) y al final:
+ * - informa del ritmo de tramas dentro de cada ciclo y del tiempo
+ *   que el bucle pasó bloqueado, que debe ser cero;
+ * - decodifica lo que salió por la línea con SesionDecodificacion
+ *   y comprueba que el mensaje sea "HOLA MUNDO" repetido, sin tramas
+ *   perdidas ni corruptas. Los avisos de consola que empiezan por
+ *   "S" o "R" ("Sistema...", "Reiniciando...") cuentan como tramas
+ *   malformadas; se informan pero no son un fallo.
+ */
+
+#include "Arduino.h"
+#include "sketch.ino"
+
+#include "SesionDecodificacion.h"
+#include "ControlIntegridad.h"
+#include <iostream>
+#include <iomanip>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+/// Coste simulado de una vuelta de loop() en nanosegundos
+static const unsigned long long NANOSEGUNDOS_POR_VUELTA = 8000;
+
+/// Mensaje que produce la secuencia del sketch
+static const char MENSAJE_ESPERADO[] = "HOLA MUNDO";
+
+/**
+ * @class ObservadorCiclos
+ * @brief Cuenta las tramas de fin decodificadas
+ */
+class ObservadorCiclos : public ObservadorSesion
+{
+private:
+    int ciclos;  ///< Tramas F ejecutadas
+
+public:
+    ObservadorCiclos() : ciclos(0)
+    {
+    }
+
+    void alEjecutarPaquete(const PaqueteBase& paquete, int paquetesRecibidos)
+    {
+        (void)paquetesRecibidos;
+        if (paquete.obtenerTipo() == 'F')
+        {
+            ciclos++;
+        }
+    }
+
+    int obtenerCiclos() const
+    {
+        return ciclos;
+    }
+};
+
+/**
+ * @brief Mide el ritmo de las tramas dentro de los ciclos capturados
+ * @param captura Bytes que salieron por la línea
+ * @param instantes Instante de salida de cada byte (nanosegundos)
+ * @param cantidad Bytes capturados
+ * @param mejorRitmo Recibe el mayor ritmo de un ciclo (tramas/s)
+ * @param peorRitmo Recibe el menor ritmo de un ciclo (tramas/s)
+ * @return Ciclos completos medidos
+ * 
+ * Un ciclo va del final de su primera trama al final de su trama F.
+ * Las tramas S salen pegadas a otra trama y no cuentan, como
+ * tampoco las líneas que no son tramas (avisos, anuncio de perfil).
+ */
+static int medirCiclos(const char* captura, const unsigned long long* instantes, size_t cantidad,
+                       double* mejorRitmo, double* peorRitmo)
+{
+    int ciclos = 0;
+    int tramasCiclo = 0;
+    unsigned long long inicioCiclo = 0;
+    size_t inicioLinea = 0;
+
+    for (size_t i = 0; i < cantidad; i++)
+    {
+        if (captura[i] != '\n')
+        {
+            continue;
+        }
+
+        bool esTrama = (i - inicioLinea >= 2) && captura[inicioLinea + 1] == ',' &&
+                       std::strchr("LMFRB", captura[inicioLinea]) != nullptr;
+        if (esTrama)
+        {
+            if (tramasCiclo == 0)
+            {
+                inicioCiclo = instantes[i];
+            }
+            tramasCiclo++;
+
+            if (captura[inicioLinea] == 'F' && tramasCiclo > 1)
+            {
+                double ritmo = (tramasCiclo - 1) * 1e9 / (double)(instantes[i] - inicioCiclo);
+                if (ciclos == 0 || ritmo > *mejorRitmo)
+                {
+                    *mejorRitmo = ritmo;
+                }
+                if (ciclos == 0 || ritmo < *peorRitmo)
+                {
+                    *peorRitmo = ritmo;
+                }
+                ciclos++;
+                tramasCiclo = 0;
+            }
+        }
+        inicioLinea = i + 1;
+    }
+    return ciclos;
+}
+
+/**
+ * @brief Punto de entrada del simulador
+ * @param argc Cantidad de argumentos
+ * @param argv Argumentos: [--segundos=N] [--ritmo=N] [--continuo=MS]
+ * @return 0 si el bucle nunca bloqueó y el mensaje se decodificó íntegro
+ */
+int main(int argc, char* argv[])
+{
+    double segundos = 20.0;
+    long ritmo = TRAMAS_POR_SEGUNDO_PERFIL;
+    long pausaContinua = -1;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (std::strncmp(argv[i], "--segundos=", 11) == 0)
+            segundos = std::atof(argv[i] + 11);
+        else if (std::strncmp(argv[i], "--ritmo=", 8) == 0)
+            ritmo = std::atol(argv[i] + 8);
+        else if (std::strncmp(argv[i], "--continuo=", 11) == 0)
+            pausaContinua = std::atol(argv[i] + 11);
+        else
+        {
+            std::cerr << "Opcion desconocida: " << argv[i] << std::endl;
+            return 1;
+        }
+    }
+    if (segundos <= 0.0 || ritmo < 0)
+    {
+        std::cerr << "--segundos debe ser positivo y --ritmo no negativo" << std::endl;
+        return 1;
+    }
+
+    // Configuración que el sketch haría en setup()
+    configurarRitmo(TRAMAS_POR_SEGUNDO, ritmo);
+    if (pausaContinua >= 0)
+    {
+        habilitarTransmisionContinua((unsigned long)pausaContinua);
+    }
+
+    unsigned long long limite = (unsigned long long)(segundos * 1e9);
+    unsigned long long bloqueoMaximo = 0;
+    long long vueltas = 0;
+
+    setup();
+    while (PlacaSimulada::obtenerTiempo() < limite)
+    {
+        unsigned long long antes = PlacaSimulada::obtenerTiempo();
+        loop();
+        unsigned long long bloqueo = PlacaSimulada::obtenerTiempo() - antes;
+        if (bloqueo > bloqueoMaximo)
+        {
+            bloqueoMaximo = bloqueo;
+        }
+        PlacaSimulada::avanzar(NANOSEGUNDOS_POR_VUELTA);
+        vueltas++;
+    }
+
+    const char* captura = Serial.obtenerCaptura();
+    size_t bytesCapturados = Serial.obtenerBytesCapturados();
+
+    double mejorRitmo = 0.0;
+    double peorRitmo = 0.0;
+    int ciclosMedidos = medirCiclos(captura, Serial.obtenerInstantes(), bytesCapturados,
+                                    &mejorRitmo, &peorRitmo);
+
+    // Decodificar la línea como lo haría el host
+    PoliticaFinalizacion* politica = crearPoliticaFinalizacion("continuo");
+    ObservadorCiclos observador;
+    bool mensajeCorrecto;
+    int longitudMensaje;
+    int perdidas;
+    int corruptas;
+    int malformadas;
+    {
+        SesionDecodificacion sesion(politica, 1, false, HABILITAR_INTEGRIDAD);
+        sesion.establecerObservador(&observador);
+        if (bytesCapturados > 0)
+        {
+            sesion.decodificarBloque(captura, (int)bytesCapturados);
+        }
+
+        const MensajeDecodificado& mensaje = sesion.obtenerMensaje();
+        longitudMensaje = mensaje.obtenerLongitud();
+        int largoEsperado = (int)std::strlen(MENSAJE_ESPERADO);
+        // El último ciclo puede haber quedado a medias al agotar el tiempo
+        int ciclos = observador.obtenerCiclos();
+        mensajeCorrecto = ciclos > 0 && longitudMensaje >= ciclos * largoEsperado &&
+                          longitudMensaje <= (ciclos + 1) * largoEsperado;
+        for (int i = 0; i < longitudMensaje && mensajeCorrecto; i++)
+        {
+            mensajeCorrecto = mensaje.obtenerEn(i) == MENSAJE_ESPERADO[i % largoEsperado];
+        }
+
+        perdidas = sesion.obtenerIntegridad().obtenerTramasPerdidas();
+        corruptas = sesion.obtenerIntegridad().obtenerTramasCorruptas();
+        malformadas = sesion.obtenerTramasMalformadas();
+    }
+    delete politica;
+
+    unsigned long long bloqueado = PlacaSimulada::obtenerTiempoBloqueado();
+
+    std::cout << "Tiempo simulado: " << segundos << " s (" << vueltas << " vueltas de loop)" << std::endl;
+    std::cout << "Bytes transmitidos: " << bytesCapturados
+              << " (aperturas del puerto: " << Serial.obtenerCambiosVelocidad() << ")" << std::endl;
+    std::cout << "Ciclos decodificados: " << observador.obtenerCiclos()
+              << ", mensaje de " << longitudMensaje << " caracteres"
+              << (mensajeCorrecto ? " correcto" : " INCORRECTO") << std::endl;
+    if (ciclosMedidos > 0)
+    {
+        std::cout << std::fixed << std::setprecision(1)
+                  << "Ritmo dentro del ciclo: " << peorRitmo << " - " << mejorRitmo
+                  << " tramas/s" << std::endl;
+    }
+    std::cout << "Tramas perdidas: " << perdidas << ", corruptas: " << corruptas
+              << ", malformadas (avisos incluidos): " << malformadas << std::endl;
+    std::cout << "Bloqueo maximo por vuelta: " << bloqueoMaximo / 1000 << " us, total: "
+              << bloqueado / 1000 << " us" << std::endl;
+
+    if (bloqueado > 0 || !mensajeCorrecto || perdidas > 0 || corruptas > 0)
+    {
+        std::cerr << "ERROR: el transmisor bloqueo o la linea no se decodifico integra" << std::endl;
+        return 1;
+    }
+    return 0;
+}
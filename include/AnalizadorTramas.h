@@ -0,0 +1,161 @@
+/**
+ * @file AnalizadorTramas.h
+ * @brief Análisis de las líneas de texto del protocolo PRT-7
+ * @author Tu Nombre
+ * @date 2024
+ * 
+ * Convierte las líneas recibidas en paquetes listos para ejecutar.
+ * Las funciones auxiliares más usadas se definen en la cabecera para
+ * que el compilador pueda integrarlas en el bucle de decodificación.
+ */
+
+#ifndef ANALIZADOR_TRAMAS_H
+#define ANALIZADOR_TRAMAS_H
+
+class PaqueteBase;
+
+/**
+ * @brief Elimina espacios en blanco al inicio de una cadena
+ * @param texto Cadena a procesar
+ * @return Índice del primer carácter no blanco
+ */
+inline int eliminarEspaciosIniciales(const char* texto)
+{
+    int indice = 0;
+    while (texto[indice] == ' ' || texto[indice] == '\t')
+    {
+        indice++;
+    }
+    return indice;
+}
+
+/**
+ * @brief Busca la posición de un carácter en una cadena
+ * @param texto Cadena donde buscar
+ * @param objetivo Carácter a buscar
+ * @return Índice del carácter, o -1 si no se encuentra
+ */
+inline int buscarCaracter(const char* texto, char objetivo)
+{
+    int indice = 0;
+    while (texto[indice] != '\0')
+    {
+        if (texto[indice] == objetivo)
+        {
+            return indice;
+        }
+        indice++;
+    }
+    return -1;
+}
+
+/**
+ * @brief Convierte una cadena a número entero (similar a atoi)
+ * @param texto Cadena numérica a convertir
+ * @return Valor entero
+ */
+inline int convertirAEntero(const char* texto)
+{
+    int resultado = 0;
+    int signo = 1;
+    int indice = 0;
+    
+    // Manejar signo
+    if (texto[0] == '-')
+    {
+        signo = -1;
+        indice = 1;
+    }
+    else if (texto[0] == '+')
+    {
+        indice = 1;
+    }
+    
+    // Convertir dígitos
+    while (texto[indice] >= '0' && texto[indice] <= '9')
+    {
+        resultado = resultado * 10 + (texto[indice] - '0');
+        indice++;
+    }
+    
+    return resultado * signo;
+}
+
+/**
+ * @brief Indica si una cadena es un entero decimal completo
+ * @param texto Cadena a validar
+ * @return true si es un signo opcional seguido solo de dígitos
+ * 
+ * convertirAEntero() se detiene en el primer carácter que no es
+ * dígito y devuelve 0 para una cadena vacía; esta comprobación
+ * separa un 0 escrito de un valor ilegible.
+ */
+inline bool esEnteroDecimal(const char* texto)
+{
+    int indice = (texto[0] == '-' || texto[0] == '+') ? 1 : 0;
+    if (texto[indice] < '0' || texto[indice] > '9')
+    {
+        return false;
+    }
+    while (texto[indice] >= '0' && texto[indice] <= '9')
+    {
+        indice++;
+    }
+    return texto[indice] == '\0';
+}
+
+/**
+ * @brief Indica si una letra inicial corresponde a un tipo de trama
+ * @param tipo Primer carácter de la línea
+ * @return true para L, M, F, R, S y B (en mayúscula o minúscula)
+ */
+inline bool esTipoTrama(char tipo)
+{
+    switch (tipo)
+    {
+        case 'L': case 'l':
+        case 'M': case 'm':
+        case 'F': case 'f':
+        case 'R': case 'r':
+        case 'S': case 's':
+        case 'B': case 'b':
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief Elimina espacios y saltos de línea al final de una cadena
+ * @param texto Cadena a modificar (se modifica in-place)
+ */
+void eliminarEspaciosFinales(char* texto);
+
+/**
+ * @brief Analiza y crea un paquete desde una línea del protocolo
+ * @param lineaTexto Línea recibida (formato: "L,X" o "M,N")
+ * @return Puntero al paquete creado, o nullptr si hay error
+ * 
+ * Formatos válidos:
+ * - "L,A" -> Paquete de carácter con 'A'
+ * - "M,5" -> Paquete de rotación +5
+ * - "M,-3" -> Paquete de rotación -3
+ * - "F,0" -> Paquete de fin de mensaje
+ * - "R,1,4" -> Paquete de rotación +4 dirigido al rotor 1
+ * - "S,7" -> Paquete de sincronización en la rotación +7 ("S,x" es inválido)
+ * - "B,HOLA" -> Paquete de bloque con "HOLA" (cada letra como una trama L)
+ */
+PaqueteBase* analizarPaquete(const char* lineaTexto);
+
+/**
+ * @brief Interpreta el anuncio de perfil del transmisor
+ * @param lineaTexto Línea recibida
+ * @param velocidad Recibe los baudios anunciados
+ * @param controlFlujo Recibe si el transmisor respeta RTS/CTS
+ * @param rafaga Recibe cuántas tramas envía seguidas (0 = sin pausas)
+ * @return true si la línea es un anuncio "#PRT7,PERFIL,<baud>,<flujo>,<rafaga>"
+ */
+bool analizarAnuncioPerfil(const char* lineaTexto, long* velocidad, 
+                           bool* controlFlujo, int* rafaga);
+
+#endif // ANALIZADOR_TRAMAS_H
@@ -0,0 +1,157 @@
+/**
+ * @file AnilloEventos.h
+ * @brief Anillo de eventos decodificados en memoria compartida
+ * @author Tu Nombre
+ * @date 2024
+ * 
+ * El decodificador publica cada carácter y cada suceso de trama en
+ * un anillo de ranuras de 32 bytes dentro de un objeto de memoria
+ * compartida POSIX. Los lectores de otros procesos lo recorren sin
+ * candados ni llamadas al sistema: cada ranura lleva su número de
+ * secuencia y se valida como un seqlock. El escritor nunca espera;
+ * un lector demasiado lento pierde eventos y lo detecta.
+ * 
+ * Disposición del objeto compartido: una CabeceraAnillo (dos líneas
+ * de caché) seguida de 'capacidad' ranuras RanuraAnillo.
+ */
+
+#ifndef ANILLO_EVENTOS_H
+#define ANILLO_EVENTOS_H
+
+#include <atomic>
+
+/// Versión de la disposición en memoria
+const unsigned int VERSION_ANILLO = 1;
+
+/// Ranuras por defecto (potencia de dos): 2 MiB de eventos
+const unsigned int CAPACIDAD_ANILLO = 65536;
+
+/// Secuencia de una ranura que el escritor está sobrescribiendo
+const unsigned long long RANURA_OCUPADA = ~0ULL;
+
+/**
+ * @struct EventoDecodificado
+ * @brief Suceso publicado, tal como lo recibe un lector
+ * 
+ * Tipos: 'L' carácter (caracter = resultado, valor = cifrado; una
+ * trama B produce uno por carácter), 'M' rotación, 'R' rotor dirigido, 'S' sincronización y 'F' fin
+ * de mensaje (valor de la trama); 'H' hueco (valor = tramas
+ * perdidas), 'Y' resincronización (valor = rotación nueva), 'C'
+ * ciclo repetido (valor = repeticiones) y 'X' transmisión completa
+ * (valor = 1 si fue por inactividad).
+ */
+struct EventoDecodificado
+{
+    unsigned long long secuencia;  ///< Número del evento, desde 0
+    unsigned long long instante;   ///< Reloj monotónico al publicar (ns)
+    int paquete;                   ///< Tramas ejecutadas hasta el evento
+    int valor;                     ///< Dato del evento según el tipo
+    char tipo;                     ///< Clase de evento
+    char caracter;                 ///< Carácter decodificado (solo 'L')
+};
+
+/**
+ * @struct CabeceraAnillo
+ * @brief Inicio del objeto compartido
+ * 
+ * El contador de publicados ocupa su propia línea de caché para que
+ * los lectores que lo consultan no compitan con los datos fijos.
+ */
+struct CabeceraAnillo
+{
+    char marca[8];                              ///< "PRT7ANI"
+    unsigned int version;                       ///< VERSION_ANILLO
+    unsigned int capacidad;                     ///< Ranuras (potencia de dos)
+    alignas(64) std::atomic<unsigned long long> publicados;  ///< Eventos publicados
+};
+
+/**
+ * @struct RanuraAnillo
+ * @brief Evento dentro del anillo
+ * 
+ * Todas las palabras son atómicas para que la lectura concurrente
+ * con una sobrescritura esté definida; en x86 y ARM64 las cargas y
+ * almacenamientos relajados cuestan lo mismo que los normales.
+ */
+struct RanuraAnillo
+{
+    std::atomic<unsigned long long> secuencia;  ///< Evento + 1, 0 si vacía, o RANURA_OCUPADA
+    std::atomic<unsigned long long> instante;   ///< EventoDecodificado::instante
+    std::atomic<unsigned long long> numeros;    ///< paquete (32 bits bajos) y valor (altos)
+    std::atomic<unsigned long long> simbolos;   ///< tipo (byte 0) y caracter (byte 1)
+};
+
+/**
+ * @brief Reloj con el que se marcan los eventos
+ * @return Nanosegundos de CLOCK_MONOTONIC, común a todos los procesos
+ */
+unsigned long long instanteAnillo();
+
+/**
+ * @class AnilloEventos
+ * @brief Lado escritor del anillo
+ * 
+ * Crea el objeto de memoria compartida y lo elimina al destruirse.
+ * Admite un único escritor. Solo disponible en sistemas POSIX.
+ */
+class AnilloEventos
+{
+private:
+    char nombre[64];              ///< Nombre del objeto ("/prt7")
+    CabeceraAnillo* cabecera;     ///< Inicio de la proyección (nullptr si falló)
+    RanuraAnillo* ranuras;        ///< Ranuras tras la cabecera
+    unsigned long long mascara;   ///< capacidad - 1
+    unsigned long long siguiente; ///< Secuencia del próximo evento
+    unsigned long long tamano;    ///< Bytes proyectados
+
+public:
+    /**
+     * @brief Constructor que crea y proyecta el objeto compartido
+     * @param nombreObjeto Nombre POSIX, con '/' inicial
+     * @param capacidadRanuras Ranuras; se redondea a potencia de dos
+     * 
+     * Un objeto previo con el mismo nombre se reemplaza.
+     */
+    AnilloEventos(const char* nombreObjeto, unsigned int capacidadRanuras);
+
+    /**
+     * @brief Destructor que desproyecta y elimina el objeto
+     */
+    ~AnilloEventos();
+
+    /**
+     * @brief Verifica si el anillo está proyectado
+     * @return true si puede publicarse
+     */
+    bool estaOperativo() const;
+
+    /**
+     * @brief Publica un evento
+     * @param tipo Clase de evento
+     * @param caracter Carácter decodificado ('L') o '\0'
+     * @param valor Dato del evento
+     * @param paquete Tramas ejecutadas hasta el evento
+     * 
+     * Marca la ranura como ocupada, escribe el evento y publica su
+     * secuencia con semántica release; nunca bloquea.
+     */
+    void publicar(char tipo, char caracter, int valor, int paquete);
+
+    /**
+     * @brief Obtiene los eventos publicados
+     * @return Número de eventos
+     */
+    unsigned long long obtenerPublicados() const;
+
+    /**
+     * @brief Obtiene la capacidad efectiva
+     * @return Ranuras del anillo
+     */
+    unsigned int obtenerCapacidad() const;
+
+    // El anillo es dueño de su proyección: no se permite copiarlo
+    AnilloEventos(const AnilloEventos&) = delete;
+    AnilloEventos& operator=(const AnilloEventos&) = delete;
+};
+
+#endif // ANILLO_EVENTOS_H
@@ -0,0 +1,240 @@
+/**
+ * @file ArchivadorTramas.h
+ * @brief Archivo comprimido de tramas PRT-7, decodificable por bloques
+ * @author Tu Nombre
+ * @date 2024
+ * 
+ * Formato del archivo (binario, orden de bytes nativo): una
+ * cabecera CabeceraArchivo seguida de bloques, cada uno con su
+ * CabeceraBloqueArchivo y su cuerpo. El archivo no guarda líneas
+ * sino las tramas que la sesión ejecutó, ya verificadas: las líneas
+ * de consola, las tramas descartadas y los sufijos ",<seq>*<CRC>"
+ * no se conservan.
+ * 
+ * El cuerpo de un bloque es una serie de tramos de tramas del mismo
+ * tipo. Cada tramo empieza con un byte (tipo << 5 | cantidad - 1),
+ * así que el tipo solo se escribe cuando cambia, seguido de la carga
+ * de cada trama:
+ * - L: el byte transportado
+ * - B: la longitud (un byte) y los bytes transportados
+ * - M y S: el valor en varint zigzag
+ * - R: el rotor en varint y el giro en varint zigzag
+ * - F: nada
+ * 
+ * La cabecera de cada bloque lleva la rotación del disco al empezar
+ * y al terminar, y cuántos caracteres produce. Con ella cada bloque
+ * se decodifica sin los anteriores y su salida tiene una posición
+ * conocida de antemano (ver DecodificadorArchivo).
+ */
+
+#ifndef ARCHIVADOR_TRAMAS_H
+#define ARCHIVADOR_TRAMAS_H
+
+#include "SesionDecodificacion.h"
+#include <cstdio>
+
+/// Tramas por bloque: bloques pequeños reparten mejor el trabajo entre hilos
+const int TRAMAS_POR_BLOQUE_ARCHIVO = 16384;
+
+/// Tramas que admite un tramo del cuerpo de un bloque
+const int MAXIMO_TRAMO_ARCHIVO = 32;
+
+/**
+ * @enum CodigoTramaArchivo
+ * @brief Tipo de trama en los 3 bits altos del byte de tramo
+ */
+enum CodigoTramaArchivo
+{
+    ARCHIVO_CARACTER = 0,       ///< Trama L
+    ARCHIVO_BLOQUE = 1,         ///< Trama B
+    ARCHIVO_ROTACION = 2,       ///< Trama M
+    ARCHIVO_SINCRONIZACION = 3, ///< Trama S
+    ARCHIVO_ROTOR = 4,          ///< Trama R
+    ARCHIVO_FIN = 5             ///< Trama F
+};
+
+/**
+ * @struct CabeceraArchivo
+ * @brief Cabecera del archivo de tramas
+ */
+struct CabeceraArchivo
+{
+    char marca[8];              ///< "PRT7ARC" terminado en '\0'
+    unsigned int version;       ///< Versión del formato (1)
+    unsigned int bloques;       ///< Bloques del archivo
+    long long tramas;           ///< Tramas archivadas
+    long long caracteres;       ///< Caracteres que produce la decodificación
+};
+
+/**
+ * @struct CabeceraBloqueArchivo
+ * @brief Cabecera de cada bloque
+ */
+struct CabeceraBloqueArchivo
+{
+    unsigned int bytesCuerpo;       ///< Bytes del cuerpo que sigue
+    unsigned int tramas;            ///< Tramas del bloque
+    unsigned int caracteres;        ///< Caracteres que produce el bloque
+    unsigned char rotacionInicial;  ///< Rotación del disco antes de la primera trama
+    unsigned char rotacionFinal;    ///< Rotación del disco tras la última trama
+    unsigned short reservado;       ///< Sin uso, a cero
+};
+
+/**
+ * @class ArchivadorTramas
+ * @brief Observador de sesión que escribe las tramas ejecutadas en un archivo
+ * 
+ * Como PublicadorEventos, se intercala delante de otro observador y
+ * le reenvía todas las notificaciones. La rotación del disco se lee
+ * de la sesión tras cada trama, así que el archivo refleja también
+ * un estado restaurado de una instantánea.
+ * 
+ * Solo sirve para sesiones de un disco: con cadena de rotores o con
+ * deduplicación la sesión no ejecuta (o no notifica) todas las
+ * tramas sobre el disco. Un ciclo repetido deja el archivador fuera
+ * de servicio.
+ */
+class ArchivadorTramas : public ObservadorSesion
+{
+private:
+    std::FILE* archivo;           ///< Archivo de destino
+    SesionDecodificacion* sesion; ///< Sesión observada (para leer la rotación)
+    ObservadorSesion* siguiente;  ///< Observador al que se reenvía (o nullptr)
+    bool operativo;               ///< Sin errores de escritura
+
+    unsigned char* cuerpo;        ///< Cuerpo del bloque en construcción
+    size_t capacidadCuerpo;       ///< Tamaño reservado para el cuerpo
+    size_t bytesCuerpo;           ///< Bytes ocupados del cuerpo
+    size_t inicioTramo;           ///< Posición del byte del tramo abierto
+    int tipoTramo;                ///< Código del tramo abierto (-1 si no hay)
+    int tramasTramo;              ///< Tramas del tramo abierto
+
+    CabeceraBloqueArchivo bloque; ///< Cabecera del bloque en construcción
+    CabeceraArchivo cabecera;     ///< Totales del archivo
+    int rotacionVigente;          ///< Rotación del disco tras la última trama
+
+    /**
+     * @brief Garantiza espacio en el cuerpo
+     * @param cantidad Bytes que se van a agregar
+     * @return false si no se pudo ampliar
+     */
+    bool reservarCuerpo(size_t cantidad);
+
+    /**
+     * @brief Agrega un entero en varint zigzag
+     * @param valor Entero con signo
+     */
+    void agregarEntero(int valor);
+
+    /**
+     * @brief Cuenta una trama en el tramo de su tipo (lo abre si hace falta)
+     * @param codigo Tipo de la trama
+     */
+    void abrirTrama(int codigo);
+
+    /**
+     * @brief Escribe el bloque en construcción y empieza otro
+     */
+    void cerrarBloque();
+
+public:
+    /**
+     * @brief Constructor que crea (o trunca) el archivo
+     * @param ruta Archivo de destino
+     * @param sesionObservada Sesión de un disco cuyas tramas se archivan
+     * @param observadorSiguiente Observador al que reenviar, o nullptr
+     */
+    ArchivadorTramas(const char* ruta, SesionDecodificacion* sesionObservada,
+                     ObservadorSesion* observadorSiguiente);
+
+    /**
+     * @brief Destructor que cierra el archivo
+     */
+    ~ArchivadorTramas();
+
+    /**
+     * @brief Indica si el archivo se está escribiendo
+     * @return false si no se pudo crear, falló una escritura o se perdieron tramas
+     */
+    bool estaOperativo() const;
+
+    /**
+     * @brief Escribe el último bloque y los totales
+     * @return false si el archivo no quedó completo
+     * 
+     * Después no se archivan más tramas.
+     */
+    bool cerrar();
+
+    /**
+     * @brief Obtiene las tramas archivadas
+     * @return Tramas recibidas hasta ahora
+     */
+    long long obtenerTramas() const;
+
+    /**
+     * @brief Obtiene los bloques escritos
+     * @return Bloques completos en el archivo
+     */
+    int obtenerBloques() const;
+
+    /**
+     * @brief Archiva la trama y la reenvía
+     * @param paquete Paquete ejecutado
+     * @param paquetesRecibidos Tramas ejecutadas hasta ahora
+     */
+    void alEjecutarPaquete(const PaqueteBase& paquete, int paquetesRecibidos);
+
+    /**
+     * @brief Reenvía el descarte
+     * @param linea Texto de la línea
+     * @param corrupta true si falló el CRC
+     */
+    void alDescartarLinea(const char* linea, bool corrupta);
+
+    /**
+     * @brief Reenvía el hueco de secuencia
+     * @param tramasPerdidas Tramas que faltan en la secuencia
+     */
+    void alDetectarHueco(int tramasPerdidas);
+
+    /**
+     * @brief Reenvía la resincronización
+     * @param rotacionPrevia Rotación antes de la trama
+     * @param rotacionActual Rotación sincronizada
+     * @param caracteresAfectados Letras decodificadas con la rotación errónea
+     */
+    void alResincronizar(int rotacionPrevia, int rotacionActual, int caracteresAfectados);
+
+    /**
+     * @brief Reenvía el anuncio de perfil
+     * @param velocidad Baudios anunciados
+     * @param controlFlujo true si el transmisor respeta RTS/CTS
+     * @param rafaga Tramas por ráfaga
+     * @return Lo que decida el observador siguiente (false sin él)
+     */
+    bool alAnunciarPerfil(long velocidad, bool controlFlujo, int rafaga);
+
+    /**
+     * @brief Deja el archivador fuera de servicio y reenvía
+     * @param texto Caracteres del ciclo
+     * @param longitud Cantidad de caracteres
+     * @param repeticiones Veces que se recibió el ciclo
+     * 
+     * Las tramas del ciclo repetido no se notificaron, así que el
+     * archivo ya no reproduciría el mensaje.
+     */
+    void alRepetirCiclo(const char* texto, int longitud, int repeticiones);
+
+    /**
+     * @brief Reenvía el fin de la transmisión
+     * @param porInactividad true si terminó por falta de datos
+     */
+    void alCompletarTransmision(bool porInactividad);
+
+    // El archivador es dueño del archivo y del cuerpo en construcción
+    ArchivadorTramas(const ArchivadorTramas&) = delete;
+    ArchivadorTramas& operator=(const ArchivadorTramas&) = delete;
+};
+
+#endif // ARCHIVADOR_TRAMAS_H
@@ -0,0 +1,129 @@
+/**
+ * @file BitacoraEstado.h
+ * @brief Bitácora incremental del estado de decodificación
+ * @author Tu Nombre
+ * @date 2024
+ * 
+ * Guarda instantáneas del desplazamiento del disco, del número de
+ * tramas procesadas y de la cola del mensaje en un archivo de solo
+ * anexado. Si el decodificador se reinicia a mitad de transmisión,
+ * la bitácora permite reanudar sin esperar a que el transmisor
+ * repita el ciclo completo.
+ */
+
+#ifndef BITACORA_ESTADO_H
+#define BITACORA_ESTADO_H
+
+#include <cstdio>
+
+class MensajeDecodificado;
+class DiscoRotatorio;
+
+/**
+ * @struct CabeceraInstantanea
+ * @brief Cabecera binaria de cada registro de la bitácora
+ * 
+ * Cada registro solo contiene los caracteres agregados desde la
+ * instantánea anterior, por lo que escribirlo cuesta lo mismo sin
+ * importar la longitud total del mensaje.
+ */
+struct CabeceraInstantanea
+{
+    unsigned int marca;          ///< Identificador de registro ('P7SN')
+    int desplazamiento;          ///< Rotación del disco al guardar
+    int paquetesRecibidos;       ///< Tramas procesadas al guardar
+    int longitudMensaje;         ///< Longitud total del mensaje al guardar
+    int longitudCola;            ///< Caracteres nuevos que siguen a la cabecera
+    unsigned int suma;           ///< Suma de verificación de cabecera y cola
+};
+
+/**
+ * @class BitacoraEstado
+ * @brief Escritor y lector de instantáneas incrementales
+ * 
+ * Cada registro se entrega al sistema operativo en cuanto se
+ * escribe, así que sobrevive a la muerte del proceso (Ctrl+C,
+ * SIGKILL, un fallo). Lo que se agrupa es el fsync, que solo protege
+ * ante un corte de energía o un fallo del sistema: el archivo se
+ * sincroniza con el disco cada cierto número de registros, o de
+ * forma explícita con sincronizar().
+ */
+class BitacoraEstado
+{
+private:
+    char rutaArchivo[256];           ///< Ruta del archivo de bitácora
+    std::FILE* archivo;              ///< Archivo abierto en modo anexado
+    int caracteresPersistidos;       ///< Longitud de mensaje ya guardada
+    int registrosPendientes;         ///< Registros entregados al sistema sin fsync
+    int registrosPorSincronizacion;  ///< Tamaño del lote de fsync
+
+    /**
+     * @brief Calcula la suma de verificación de un registro
+     * @param cabecera Cabecera con el campo suma ignorado
+     * @param cola Caracteres que acompañan a la cabecera
+     * @return Suma FNV-1a de 32 bits
+     */
+    static unsigned int calcularSuma(const CabeceraInstantanea& cabecera, const char* cola);
+
+    /**
+     * @brief Recorta un registro final incompleto
+     * @param longitudValida Bytes válidos al inicio del archivo
+     */
+    void recortarArchivo(long longitudValida);
+
+public:
+    /**
+     * @brief Constructor que recuerda la ruta de la bitácora
+     * @param ruta Archivo donde se anexan las instantáneas
+     * @param registrosPorLote Registros escritos entre dos fsync
+     */
+    BitacoraEstado(const char* ruta, int registrosPorLote);
+
+    /**
+     * @brief Destructor que sincroniza y cierra el archivo
+     */
+    ~BitacoraEstado();
+
+    /**
+     * @brief Reconstruye el estado guardado por una ejecución anterior
+     * @param mensaje Mensaje vacío donde se anexan los caracteres
+     * @param disco Disco recién construido que se rotará
+     * @return Tramas procesadas según la última instantánea, o 0
+     * 
+     * Aplica los registros en orden y se detiene en el primero que
+     * esté incompleto o corrupto, recortándolo para que los nuevos
+     * registros se anexen a continuación del último válido.
+     */
+    int restaurar(MensajeDecodificado* mensaje, DiscoRotatorio* disco);
+
+    /**
+     * @brief Anexa una instantánea con los cambios desde la anterior
+     * @param mensaje Mensaje actual
+     * @param disco Disco actual
+     * @param paquetesRecibidos Tramas procesadas hasta el momento
+     * @return true si el registro se escribió correctamente
+     */
+    bool registrar(const MensajeDecodificado& mensaje, const DiscoRotatorio& disco,
+                   int paquetesRecibidos);
+
+    /**
+     * @brief Fuerza la escritura de los registros pendientes al disco
+     */
+    void sincronizar();
+
+    /**
+     * @brief Elimina la bitácora tras una transmisión terminada
+     * 
+     * Una transmisión completa no debe reanudarse en la siguiente
+     * ejecución, por lo que el archivo se cierra y se borra.
+     */
+    void descartar();
+
+    /**
+     * @brief Verifica si la bitácora puede escribirse
+     * @return true si el archivo está abierto
+     */
+    bool estaOperativa() const;
+};
+
+#endif // BITACORA_ESTADO_H
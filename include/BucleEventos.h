@@ -0,0 +1,166 @@
+/**
+ * @file BucleEventos.h
+ * @brief Bucle de eventos basado en epoll para entradas no bloqueantes
+ * @author Tu Nombre
+ * @date 2024
+ * 
+ * Sustituye la espera activa sobre el puerto por un bucle dirigido
+ * por eventos: el proceso duerme en el núcleo hasta que llegan bytes
+ * o vence el tiempo de inactividad de alguna fuente, de modo que un
+ * recolector con muchos puertos silenciosos casi no consume CPU.
+ */
+
+#ifndef BUCLE_EVENTOS_H
+#define BUCLE_EVENTOS_H
+
+#include <csignal>
+
+/**
+ * @class FuenteEventos
+ * @brief Interfaz de una entrada atendida por el bucle de eventos
+ * 
+ * Cada fuente implementa las etapas de su canal: leer los bytes
+ * disponibles, entramarlos, decodificarlos y emitir el resultado.
+ */
+class FuenteEventos
+{
+public:
+    /**
+     * @brief Obtiene el descriptor que se vigila
+     * @return Descriptor de archivo no bloqueante
+     */
+    virtual int obtenerDescriptor() const = 0;
+
+    /**
+     * @brief Atiende el descriptor cuando tiene datos disponibles
+     * @return false si la fuente debe retirarse del bucle
+     */
+    virtual bool alRecibirDatos() = 0;
+
+    /**
+     * @brief Tiempo sin datos tras el cual avisar a la fuente
+     * @return Milisegundos, o -1 si la fuente no usa inactividad
+     */
+    virtual long obtenerLimiteInactividad() const
+    {
+        return -1;
+    }
+
+    /**
+     * @brief Aviso de que la fuente lleva el límite sin recibir datos
+     * @param milisegundosInactivo Tiempo desde el último dato
+     * @return false si la fuente debe retirarse del bucle
+     */
+    virtual bool alAgotarInactividad(long milisegundosInactivo)
+    {
+        (void)milisegundosInactivo;
+        return true;
+    }
+
+    /**
+     * @brief Destructor virtual para liberar fuentes derivadas
+     */
+    virtual ~FuenteEventos() {}
+};
+
+/**
+ * @struct RegistroFuente
+ * @brief Estado interno del bucle para cada fuente registrada
+ */
+struct RegistroFuente
+{
+    FuenteEventos* fuente;        ///< Fuente atendida (nullptr si se retiró)
+    int descriptor;               ///< Descriptor registrado en epoll
+    long long ultimaActividad;    ///< Instante del último dato (ms monotónicos)
+};
+
+/**
+ * @class BucleEventos
+ * @brief Despachador de eventos de lectura e inactividad
+ * 
+ * Solo disponible en Linux (epoll); en otras plataformas
+ * estaOperativo() devuelve false. El bucle no es dueño de las
+ * fuentes: quien las registra debe liberarlas.
+ */
+class BucleEventos
+{
+private:
+    int descriptorEpoll;          ///< Instancia de epoll
+    RegistroFuente** registros;   ///< Fuentes registradas
+    int cantidadRegistros;        ///< Fuentes en el arreglo
+    int capacidadRegistros;       ///< Tamaño del arreglo
+    volatile std::sig_atomic_t detenido;  ///< Solicitud de salida del bucle
+
+    /**
+     * @brief Obtiene el reloj monotónico en milisegundos
+     * @return Milisegundos desde un origen arbitrario
+     */
+    static long long instanteActual();
+
+    /**
+     * @brief Calcula cuánto puede dormir el bucle
+     * @param ahora Instante actual
+     * @return Milisegundos hasta el próximo vencimiento, o -1 si ninguno
+     */
+    int calcularEspera(long long ahora) const;
+
+    /**
+     * @brief Libera los registros de fuentes ya retiradas
+     */
+    void purgarRetiradas();
+
+public:
+    /**
+     * @brief Constructor que crea la instancia de epoll
+     */
+    BucleEventos();
+
+    /**
+     * @brief Destructor que cierra epoll y libera los registros
+     */
+    ~BucleEventos();
+
+    /**
+     * @brief Registra una fuente para lectura
+     * @param fuente Fuente a vigilar
+     * @param disparoPorFlanco true para epoll en modo edge-triggered
+     * @return false si no pudo registrarse
+     * 
+     * Con disparo por flanco la fuente debe leer hasta agotar el
+     * descriptor en cada aviso.
+     */
+    bool agregarFuente(FuenteEventos* fuente, bool disparoPorFlanco);
+
+    /**
+     * @brief Retira una fuente del bucle
+     * @param fuente Fuente registrada previamente
+     * 
+     * Es seguro llamarlo desde dentro de un aviso de la propia fuente.
+     */
+    void eliminarFuente(FuenteEventos* fuente);
+
+    /**
+     * @brief Atiende eventos hasta detener() o hasta quedarse sin fuentes
+     */
+    void ejecutar();
+
+    /**
+     * @brief Solicita la salida de ejecutar()
+     * 
+     * Puede llamarse desde un manejador de señales: epoll_wait()
+     * vuelve con EINTR y el bucle termina antes de volver a esperar.
+     */
+    void detener();
+
+    /**
+     * @brief Verifica si el bucle puede usarse en esta plataforma
+     * @return true si epoll está disponible
+     */
+    bool estaOperativo() const;
+
+    // El bucle es dueño de su instancia de epoll: no se permite copiarlo
+    BucleEventos(const BucleEventos&) = delete;
+    BucleEventos& operator=(const BucleEventos&) = delete;
+};
+
+#endif // BUCLE_EVENTOS_H
@@ -0,0 +1,162 @@
+/**
+ * @file CacheCiclos.h
+ * @brief Reconocimiento de los ciclos que repite un transmisor
+ * @author Tu Nombre
+ * @date 2024
+ * 
+ * El transmisor repite la misma secuencia de tramas ciclo tras ciclo,
+ * cada uno cerrado con una trama F. La caché guarda la huella de cada
+ * ciclo distinto y reconoce las repeticiones mientras llegan, de modo
+ * que no hace falta decodificar ni almacenar otra vez sus caracteres.
+ */
+
+#ifndef CACHE_CICLOS_H
+#define CACHE_CICLOS_H
+
+/**
+ * @struct CicloConocido
+ * @brief Ciclo distinto ya decodificado
+ * 
+ * La huella de cada prefijo se calcula con un hash polinómico sobre
+ * las tramas: prefijos[i] resume las tramas 0..i, de modo que un
+ * ciclo entrante se compara trama a trama en O(1).
+ */
+struct CicloConocido
+{
+    unsigned long long* prefijos;  ///< Huella acumulada tras cada trama
+    int cantidadTramas;            ///< Tramas del ciclo (incluida la F)
+    int capacidadTramas;           ///< Huellas que caben en prefijos
+    char* texto;                   ///< Caracteres que produjo el ciclo
+    int longitudTexto;             ///< Caracteres ocupados
+    int capacidadTexto;            ///< Caracteres que caben en texto
+    int desplazamientoInicial;     ///< Rotación del disco al comenzar
+    int repeticiones;              ///< Veces que se recibió (1 = solo la original)
+};
+
+/**
+ * @class CacheCiclos
+ * @brief Huellas de los ciclos distintos y especulación sobre el ciclo en curso
+ * 
+ * Al comenzar un ciclo, todos los ciclos conocidos que partieron de
+ * la misma rotación son candidatos. Cada trama recibida descarta los
+ * candidatos cuya huella difiere; mientras quede alguno, la sesión
+ * puede omitir las tramas L porque su resultado ya se conoce. Si
+ * todos fallan, la caché entrega los caracteres del prefijo omitido
+ * para que el mensaje quede igual que sin especulación.
+ */
+class CacheCiclos
+{
+private:
+    CicloConocido** ciclos;       ///< Ciclos distintos registrados
+    int cantidadCiclos;           ///< Ciclos ocupados
+    int maximoCiclos;             ///< Ciclos distintos que se recuerdan
+    int maximoTramas;             ///< Tramas por ciclo a partir de las cuales no se recuerda
+
+    CicloConocido* enCurso;       ///< Ciclo que se decodifica normalmente
+    bool enCursoValido;           ///< false si el ciclo en curso excedió maximoTramas
+    unsigned long long huella;    ///< Huella acumulada del ciclo en curso
+    int tramasCiclo;              ///< Tramas recibidas del ciclo en curso
+
+    int* candidatos;              ///< Índices de los ciclos que siguen coincidiendo
+    int cantidadCandidatos;       ///< Candidatos vivos
+    int caracteresOmitidos;       ///< Tramas L omitidas en el ciclo en curso
+
+    int repeticionesTotales;      ///< Ciclos reconocidos como repetidos
+    long long omitidosTotales;    ///< Caracteres que no se decodificaron
+
+    /**
+     * @brief Crea un ciclo vacío
+     * @return Ciclo sin tramas ni texto
+     */
+    static CicloConocido* crearCiclo();
+
+    /**
+     * @brief Libera un ciclo
+     * @param ciclo Ciclo a liberar
+     */
+    static void liberarCiclo(CicloConocido* ciclo);
+
+    /**
+     * @brief Agrega una huella al ciclo en curso respetando maximoTramas
+     * @param valor Huella acumulada tras la trama
+     */
+    void anotarPrefijo(unsigned long long valor);
+
+public:
+    /**
+     * @brief Constructor
+     * @param ciclosMaximos Ciclos distintos que se recuerdan
+     * @param tramasMaximas Longitud máxima de un ciclo recordado
+     */
+    CacheCiclos(int ciclosMaximos, int tramasMaximas);
+
+    /**
+     * @brief Destructor que libera los ciclos registrados
+     */
+    ~CacheCiclos();
+
+    /**
+     * @brief Comienza un ciclo nuevo
+     * @param desplazamiento Rotación del disco al comenzar
+     */
+    void iniciarCiclo(int desplazamiento);
+
+    /**
+     * @brief Incorpora una trama al ciclo en curso
+     * @param texto Trama sin espacios ni sufijo de integridad
+     * @param pendientes Recibe los caracteres a agregar al mensaje si la
+     *        especulación acaba de fallar (o nullptr)
+     * @param cantidadPendientes Recibe cuántos son
+     * @return true si algún ciclo conocido sigue coincidiendo
+     */
+    bool registrarTrama(const char* texto, const char** pendientes, int* cantidadPendientes);
+
+    /**
+     * @brief Anota un carácter decodificado fuera de especulación
+     * @param caracter Carácter agregado al mensaje
+     */
+    void registrarCaracter(char caracter);
+
+    /**
+     * @brief Anota una trama L omitida durante la especulación
+     */
+    void omitirCaracter();
+
+    /**
+     * @brief Cierra el ciclo en curso tras su trama F
+     * @return Ciclo conocido que se repitió, o nullptr si era nuevo
+     * 
+     * Un ciclo nuevo se recuerda si cabe en la caché.
+     */
+    const CicloConocido* cerrarCiclo();
+
+    /**
+     * @brief Indica si el ciclo en curso coincide con alguno conocido
+     * @return true mientras haya candidatos
+     */
+    bool estaEspeculando() const;
+
+    /**
+     * @brief Obtiene los ciclos distintos recordados
+     * @return Número de ciclos
+     */
+    int obtenerCiclosDistintos() const;
+
+    /**
+     * @brief Obtiene los ciclos reconocidos como repetidos
+     * @return Número de repeticiones
+     */
+    int obtenerRepeticiones() const;
+
+    /**
+     * @brief Obtiene los caracteres que no fue necesario decodificar
+     * @return Caracteres omitidos
+     */
+    long long obtenerCaracteresOmitidos() const;
+
+    // La caché es dueña de sus ciclos: no se permite copiarla
+    CacheCiclos(const CacheCiclos&) = delete;
+    CacheCiclos& operator=(const CacheCiclos&) = delete;
+};
+
+#endif // CACHE_CICLOS_H
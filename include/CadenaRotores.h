@@ -0,0 +1,114 @@
+/**
+ * @file CadenaRotores.h
+ * @brief Cadena de varios discos rotatorios con avance tipo odómetro
+ * @author Tu Nombre
+ * @date 2024
+ * 
+ * Extiende el cifrado de un solo disco a una cadena de discos al
+ * estilo de una máquina Enigma. Cada carácter atraviesa todos los
+ * discos en orden, pero la permutación efectiva se mantiene en una
+ * sola tabla compuesta para que decodificar siga costando una sola
+ * lectura indexada.
+ */
+
+#ifndef CADENA_ROTORES_H
+#define CADENA_ROTORES_H
+
+#include "DiscoRotatorio.h"
+
+/**
+ * @class CadenaRotores
+ * @brief Conjunto ordenado de discos con tabla de traducción compuesta
+ * 
+ * El rotor 0 es el disco original del protocolo (alfabeto A-Z) y es
+ * el que giran las tramas MAP. Los rotores siguientes usan cableados
+ * propios y se controlan con tramas "R,<rotor>,<n>".
+ * 
+ * Con el avance activado, el rotor 0 avanza una posición tras cada
+ * letra decodificada y, al completar una vuelta, arrastra al rotor
+ * siguiente como un odómetro. La tabla compuesta solo se recalcula
+ * cuando algún rotor gira: si solo cambia el rotor 0 se reutiliza la
+ * composición ya calculada de los rotores posteriores.
+ */
+class CadenaRotores
+{
+private:
+    DiscoRotatorio** rotores;              ///< Arreglo de discos de la cadena
+    int cantidadRotores;                   ///< Número de discos
+    bool avanceAutomatico;                 ///< Avance tipo odómetro activo
+    unsigned char composicionPosterior[26];///< Rotores 1..n-1 aplicados a A-Z
+    unsigned char tablaCompuesta[256];     ///< Traducción efectiva de la cadena
+
+    /**
+     * @brief Recalcula la composición de los rotores 1..n-1
+     * 
+     * Costo proporcional a 26 por la cantidad de rotores; solo se
+     * invoca cuando gira alguno de esos rotores.
+     */
+    void recomponerPosterior();
+
+    /**
+     * @brief Recalcula la tabla compuesta a partir del rotor 0
+     * 
+     * Costo de 26 consultas, independiente del número de rotores.
+     */
+    void recomponerTabla();
+
+    /**
+     * @brief Avanza el rotor 0 y propaga el acarreo a los siguientes
+     */
+    void avanzar();
+
+public:
+    /**
+     * @brief Constructor que crea la cadena de discos
+     * @param cantidad Número de rotores (se limita al rango [1, 6])
+     * @param avanzar true para activar el avance tipo odómetro
+     * 
+     * El rotor 0 usa el alfabeto ordenado y los siguientes usan los
+     * cableados históricos I-V de la máquina Enigma.
+     */
+    CadenaRotores(int cantidad, bool avanzar);
+
+    /**
+     * @brief Destructor que libera todos los discos
+     */
+    ~CadenaRotores();
+
+    /**
+     * @brief Gira un rotor concreto de la cadena
+     * @param indice Rotor a girar (0 es el disco principal)
+     * @param desplazamiento Posiciones a girar (+ o -)
+     * @return false si el índice no existe
+     */
+    bool girarRotor(int indice, int desplazamiento);
+
+    /**
+     * @brief Decodifica un carácter atravesando toda la cadena
+     * @param caracterOriginal Carácter recibido
+     * @return Carácter decodificado
+     * 
+     * Si el avance está activo, las letras hacen avanzar la cadena
+     * después de ser decodificadas.
+     */
+    char obtenerCifrado(char caracterOriginal);
+
+    /**
+     * @brief Obtiene la cantidad de rotores
+     * @return Número de discos en la cadena
+     */
+    int obtenerCantidadRotores() const;
+
+    /**
+     * @brief Obtiene la rotación de un rotor
+     * @param indice Rotor consultado
+     * @return Desplazamiento del rotor, o 0 si el índice no existe
+     */
+    int obtenerDesplazamiento(int indice) const;
+
+    // La cadena es dueña de sus discos: no se permite copiarla
+    CadenaRotores(const CadenaRotores&) = delete;
+    CadenaRotores& operator=(const CadenaRotores&) = delete;
+};
+
+#endif // CADENA_ROTORES_H
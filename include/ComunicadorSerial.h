@@ -1,16 +1,19 @@
 /**
  * @file ComunicadorSerial.h
- * @brief Interfaz de comunicación serial para Windows
+ * @brief Interfaz de comunicación serial para Windows y POSIX
  * @author Tu Nombre
  * @date 2024
  * 
  * Proporciona una abstracción para la comunicación con puertos
- * seriales COM, permitiendo leer datos del Arduino.
+ * seriales COM (Windows) o dispositivos tty (Linux), permitiendo
+ * leer datos del Arduino.
  */
 
 #ifndef COMUNICADOR_SERIAL_H
 #define COMUNICADOR_SERIAL_H
 
+#include "Transporte.h"
+
 #ifdef _WIN32
 #include <windows.h>
 #endif
@@ -20,28 +23,38 @@
  * @brief Manejador de comunicación serial para protocolo PRT-7
  * 
  * Encapsula la lógica de bajo nivel para abrir, configurar
- * y leer desde un puerto serial en Windows.
+ * y leer desde un puerto serial. En Windows se usa la API Win32;
+ * en sistemas POSIX el puerto se abre en modo no bloqueante para
+ * que pueda integrarse en un bucle de eventos.
  */
-class ComunicadorSerial
+class ComunicadorSerial : public Transporte
 {
 private:
 #ifdef _WIN32
     HANDLE manejadorPuerto;  ///< Handle del puerto COM en Windows
+#else
+    int descriptorPuerto;    ///< Descriptor del dispositivo tty en POSIX
 #endif
     bool conexionActiva;     ///< Estado de la conexión
+    long velocidadActual;    ///< Baudios configurados
+    bool controlFlujo;       ///< Control de flujo RTS/CTS activo
+    bool bajaLatencia;       ///< Lecturas sin temporizadores entre bytes
     
     /**
      * @brief Configura los parámetros del puerto serial
      * @return true si la configuración fue exitosa
      * 
-     * Establece: 9600 baud, 8 bits, sin paridad, 1 bit de parada
+     * Establece la velocidad actual (9600 baud al abrir), 8 bits,
+     * sin paridad, 1 bit de parada, el control de flujo elegido y
+     * los tiempos de lectura del modo activo.
      */
     bool configurarParametros();
 
 public:
     /**
      * @brief Constructor que abre y configura el puerto
-     * @param nombrePuerto Nombre del puerto (ej: "COM3")
+     * @param nombrePuerto Nombre del puerto (ej: "COM3", "ttyUSB0"
+     *                     o una ruta absoluta como "/dev/pts/4")
      * 
      * Intenta abrir el puerto especificado y aplicar la
      * configuración estándar del protocolo PRT-7.
@@ -69,6 +82,67 @@ public:
      * @return true si el puerto está abierto y funcional
      */
     bool estaOperativo();
+
+    /**
+     * @brief Lee los bytes disponibles sin esperar a una línea completa
+     * @param destino Buffer donde se copian los bytes
+     * @param capacidad Tamaño del buffer
+     * @return Bytes leídos, 0 si no había datos, -1 si el puerto falló
+     * 
+     * En POSIX nunca bloquea; en Windows espera como máximo los
+     * timeouts configurados en el puerto.
+     */
+    int leerDisponible(char* destino, int capacidad);
+
+    /**
+     * @brief Obtiene el descriptor del puerto para un bucle de eventos
+     * @return Descriptor POSIX, o -1 si no existe (Windows o puerto cerrado)
+     */
+    int obtenerDescriptor() const;
+
+    /**
+     * @brief Cambia el perfil de transporte del puerto abierto
+     * @param velocidad Baudios (9600 a 2000000)
+     * @param usarControlFlujo true para activar RTS/CTS por hardware
+     * @return false si el sistema no admite la velocidad o el cambio falla
+     * 
+     * Descarta los bytes pendientes de entrada, que llegaron con el
+     * perfil anterior.
+     */
+    bool configurarPerfil(long velocidad, bool usarControlFlujo);
+
+    /**
+     * @brief Obtiene la velocidad configurada
+     * @return Baudios actuales
+     */
+    long obtenerVelocidad() const;
+
+    /**
+     * @brief Configura el puerto para leerlo en espera activa
+     * @return false si el puerto rechazó la configuración
+     * 
+     * En Windows las lecturas vuelven al instante con lo disponible,
+     * en lugar de esperar los timeouts de 50/200 ms. En POSIX el
+     * puerto ya es no bloqueante con VMIN=1/VTIME=0; en Linux se pide
+     * además ASYNC_LOW_LATENCY al controlador, que en adaptadores USB
+     * acorta el temporizador de entrega (los dispositivos que no lo
+     * admiten, como un pty, lo ignoran). Se conserva tras
+     * configurarPerfil().
+     */
+    bool activarBajaLatencia();
+
+    /**
+     * @brief Busca la velocidad a la que transmite el otro extremo
+     * @param primeraLinea Recibe la primera línea reconocida
+     * @param tamanioBuffer Tamaño de primeraLinea
+     * @return Velocidad detectada, o 0 si ninguna produjo tramas legibles
+     * 
+     * Prueba las velocidades conocidas de mayor a menor y acepta la
+     * primera con la que llega una línea con forma de trama PRT-7
+     * ("X,...") o un anuncio de perfil ("#PRT7,..."). La línea se
+     * devuelve para que no se pierda.
+     */
+    long detectarVelocidad(char* primeraLinea, int tamanioBuffer);
 };
 
 #endif // COMUNICADOR_SERIAL_H
@@ -0,0 +1,132 @@
+/**
+ * @file ContabilidadMemoria.h
+ * @brief Contabilidad de la memoria usada por cada estructura
+ * @author Tu Nombre
+ * @date 2024
+ * 
+ * Las estructuras anotan cada bloque que piden al sistema y cada
+ * bloque que devuelven, con sus bytes reales (incluidos enlaces y
+ * encabezados) y la cantidad de nodos. Se puede consultar el uso
+ * actual y el máximo alcanzado en cualquier momento.
+ */
+
+#ifndef CONTABILIDAD_MEMORIA_H
+#define CONTABILIDAD_MEMORIA_H
+
+#include <atomic>
+#include <cstddef>
+
+/**
+ * @enum CategoriaMemoria
+ * @brief Estructura a la que se atribuye la memoria
+ */
+enum CategoriaMemoria
+{
+    MEMORIA_DISCO,            ///< Anillos, tablas de traducción y cadenas de rotores
+    MEMORIA_MENSAJE,          ///< Fragmentos del mensaje decodificado
+    MEMORIA_PAQUETES,         ///< Lotes de las reservas de paquetes
+    MEMORIA_ENTRADA_SALIDA,   ///< Buffers de lectura, entramado y captura
+    MEMORIA_CACHE,            ///< Ciclos recordados por la deduplicación
+    TOTAL_CATEGORIAS_MEMORIA  ///< Cantidad de categorías
+};
+
+/**
+ * @struct ContadorMemoria
+ * @brief Uso actual y máximo de una categoría
+ */
+struct ContadorMemoria
+{
+    std::atomic<long long> bytes;      ///< Bytes pedidos y no devueltos
+    std::atomic<long long> picoBytes;  ///< Máximo de bytes alcanzado
+    std::atomic<long long> nodos;      ///< Nodos o bloques vivos
+    std::atomic<long long> picoNodos;  ///< Máximo de nodos alcanzado
+};
+
+/**
+ * @class ContabilidadMemoria
+ * @brief Registro global del uso de memoria por categoría
+ * 
+ * Solo se anotan las peticiones al sistema (nodos, lotes, buffers),
+ * no cada paquete que la reserva recicla, así que el costo no
+ * depende del ritmo de tramas. Los contadores son atómicos porque
+ * varias sesiones pueden decodificar en hilos distintos.
+ */
+class ContabilidadMemoria
+{
+private:
+    static ContadorMemoria contadores[TOTAL_CATEGORIAS_MEMORIA];  ///< Uso por categoría
+    static ContadorMemoria total;                                 ///< Uso de todas las categorías
+
+    /**
+     * @brief Eleva un máximo si el valor nuevo lo supera
+     * @param pico Máximo a actualizar
+     * @param valor Valor observado
+     */
+    static void actualizarPico(std::atomic<long long>& pico, long long valor);
+
+public:
+    /**
+     * @brief Anota memoria pedida al sistema
+     * @param categoria Estructura que la usa
+     * @param bytes Bytes pedidos
+     * @param nodos Nodos o bloques que representan
+     */
+    static void registrarReserva(CategoriaMemoria categoria, size_t bytes, int nodos);
+
+    /**
+     * @brief Anota memoria devuelta al sistema
+     * @param categoria Estructura que la usaba
+     * @param bytes Bytes devueltos
+     * @param nodos Nodos o bloques que representaban
+     */
+    static void registrarLiberacion(CategoriaMemoria categoria, size_t bytes, int nodos);
+
+    /**
+     * @brief Obtiene los bytes en uso
+     * @param categoria Estructura consultada
+     * @return Bytes pedidos y no devueltos
+     */
+    static long long obtenerBytes(CategoriaMemoria categoria);
+
+    /**
+     * @brief Obtiene el máximo de bytes en uso
+     * @param categoria Estructura consultada
+     * @return Bytes en el momento de mayor uso
+     */
+    static long long obtenerPicoBytes(CategoriaMemoria categoria);
+
+    /**
+     * @brief Obtiene los nodos vivos
+     * @param categoria Estructura consultada
+     * @return Nodos o bloques en uso
+     */
+    static long long obtenerNodos(CategoriaMemoria categoria);
+
+    /**
+     * @brief Obtiene el máximo de nodos vivos
+     * @param categoria Estructura consultada
+     * @return Nodos en el momento de mayor uso
+     */
+    static long long obtenerPicoNodos(CategoriaMemoria categoria);
+
+    /**
+     * @brief Obtiene los bytes en uso de todas las categorías
+     * @return Bytes pedidos y no devueltos
+     */
+    static long long obtenerBytesTotales();
+
+    /**
+     * @brief Obtiene el máximo de bytes en uso entre todas las categorías
+     * @return Bytes en el momento de mayor uso conjunto
+     */
+    static long long obtenerPicoBytesTotales();
+
+    /**
+     * @brief Obtiene el nombre de una categoría para los informes
+     * @param categoria Estructura consultada
+     * @return Nombre legible
+     */
+    static const char* obtenerNombre(CategoriaMemoria categoria);
+};
+
+#endif // CONTABILIDAD_MEMORIA_H
@@ -0,0 +1,149 @@
+/**
+ * @file ControlIntegridad.h
+ * @brief Verificación de secuencia y suma de control de las tramas
+ * @author Tu Nombre
+ * @date 2024
+ * 
+ * Las tramas pueden llevar un sufijo opcional ",<seq>*<CRC>": un
+ * número de secuencia de 0 a 255 y un CRC-8 en hexadecimal de todo
+ * lo anterior al '*'. Por ejemplo "L,A,17*3C".
+ */
+
+#ifndef CONTROL_INTEGRIDAD_H
+#define CONTROL_INTEGRIDAD_H
+
+/**
+ * @enum ResultadoIntegridad
+ * @brief Veredicto sobre una línea recibida
+ */
+enum ResultadoIntegridad
+{
+    INTEGRIDAD_SIN_SUFIJO,  ///< La trama no trae sufijo de control
+    INTEGRIDAD_VALIDA,      ///< Sufijo presente y CRC correcto
+    INTEGRIDAD_CORRUPTA     ///< CRC incorrecto o sufijo obligatorio ausente
+};
+
+/**
+ * @class ControlIntegridad
+ * @brief Detecta tramas perdidas o dañadas y mide su efecto
+ * 
+ * Tras cualquier pérdida el disco podría estar girado de más o de
+ * menos, así que cada letra decodificada a partir de ese momento se
+ * cuenta como incierta. La siguiente trama de sincronización resuelve
+ * la duda: si el disco no coincidía, esas letras pasan a contarse
+ * como afectadas.
+ * 
+ * En cuanto llega la primera trama con sufijo válido, el sufijo se
+ * vuelve obligatorio: una trama sin él solo puede ser una trama dañada.
+ */
+class ControlIntegridad
+{
+private:
+    bool exigirSufijo;           ///< Rechazar tramas sin sufijo de control
+    int secuenciaEsperada;       ///< Próximo número de secuencia (-1 al inicio)
+    int ultimoHueco;             ///< Tramas perdidas antes de la última verificada
+    int corruptasPendientes;     ///< Tramas corruptas desde la última verificada
+    bool sincronizacionIncierta; ///< Hubo pérdidas desde la última sincronización
+    int caracteresInciertos;     ///< Letras decodificadas sin sincronización confirmada
+
+    int tramasVerificadas;       ///< Tramas con CRC correcto
+    int tramasCorruptas;         ///< Tramas descartadas por CRC
+    int tramasPerdidas;          ///< Tramas que faltan según la secuencia
+    int caracteresAfectados;     ///< Letras decodificadas con el disco desfasado
+    int resincronizaciones;      ///< Sincronizaciones que corrigieron el disco
+
+public:
+    /**
+     * @brief Constructor
+     * @param sufijoObligatorio true para tratar como corruptas las
+     *                          tramas sin sufijo de control
+     */
+    ControlIntegridad(bool sufijoObligatorio);
+
+    /**
+     * @brief Verifica y retira el sufijo de control de una línea
+     * @param linea Línea recibida; si trae sufijo se trunca antes de él
+     * @return Veredicto sobre la línea
+     * 
+     * Con un CRC válido compara la secuencia con la esperada; las
+     * tramas que falten se consultan con obtenerUltimoHueco(). Las
+     * tramas corruptas recibidas desde la última válida se descuentan
+     * del hueco, porque sí llegaron aunque no se pudieran usar.
+     */
+    ResultadoIntegridad verificar(char* linea);
+
+    /**
+     * @brief Obtiene cuántas tramas faltaban antes de la última verificada
+     * @return 0 si la secuencia era la esperada
+     */
+    int obtenerUltimoHueco() const;
+
+    /**
+     * @brief Registra una letra decodificada
+     * 
+     * Solo cuenta si hubo pérdidas desde la última sincronización.
+     */
+    void registrarCaracter();
+
+    /**
+     * @brief Registra una trama de sincronización aplicada
+     * @param desplazamientoPrevio Rotación del disco antes de aplicarla
+     * @param desplazamientoSincronizado Rotación anunciada por el transmisor
+     * @return Letras dadas por afectadas en esta sincronización
+     */
+    int registrarSincronizacion(int desplazamientoPrevio, int desplazamientoSincronizado);
+
+    /**
+     * @brief Indica si el disco puede estar desfasado
+     * @return true si hubo pérdidas sin sincronizar después
+     */
+    bool estaIncierto() const;
+
+    /**
+     * @brief Obtiene las letras decodificadas desde la última pérdida
+     * @return Letras pendientes de confirmar por una sincronización
+     */
+    int obtenerCaracteresInciertos() const;
+
+    /**
+     * @brief Obtiene las tramas con CRC correcto
+     * @return Número de tramas verificadas
+     */
+    int obtenerTramasVerificadas() const;
+
+    /**
+     * @brief Obtiene las tramas descartadas por CRC
+     * @return Número de tramas corruptas
+     */
+    int obtenerTramasCorruptas() const;
+
+    /**
+     * @brief Obtiene las tramas que faltaron según la secuencia
+     * @return Número de tramas perdidas
+     */
+    int obtenerTramasPerdidas() const;
+
+    /**
+     * @brief Obtiene las letras decodificadas con el disco desfasado
+     * @return Número de letras afectadas
+     */
+    int obtenerCaracteresAfectados() const;
+
+    /**
+     * @brief Obtiene las sincronizaciones que corrigieron el disco
+     * @return Número de resincronizaciones
+     */
+    int obtenerResincronizaciones() const;
+
+    /**
+     * @brief Calcula el CRC-8 (polinomio 0x07) de un texto
+     * @param texto Bytes a proteger
+     * @param longitud Número de bytes
+     * @return Suma de control
+     * 
+     * Es el mismo cálculo que hace el transmisor en el sketch.
+     */
+    static unsigned char calcularCrc(const char* texto, int longitud);
+};
+
+#endif // CONTROL_INTEGRIDAD_H
@@ -0,0 +1,115 @@
+/**
+ * @file DecodificadorArchivo.h
+ * @brief Decodificación en paralelo de archivos creados por ArchivadorTramas
+ * @author Tu Nombre
+ * @date 2024
+ */
+
+#ifndef DECODIFICADOR_ARCHIVO_H
+#define DECODIFICADOR_ARCHIVO_H
+
+#include "ArchivadorTramas.h"
+#include "DiscoRotatorio.h"
+#include <cstddef>
+
+/**
+ * @class DecodificadorArchivo
+ * @brief Lee un archivo de tramas y lo decodifica bloque a bloque
+ * 
+ * Al abrir se carga el archivo y se recorren solo las cabeceras de
+ * bloque para fijar dónde empieza cada cuerpo y en qué posición del
+ * mensaje cae su primer carácter. Los bloques son independientes
+ * (cada uno trae la rotación inicial del disco), así que varios
+ * hilos los toman en orden y escriben directamente en su tramo del
+ * destino. Las letras se traducen desde los bytes del cuerpo sin
+ * rearmar las tramas de texto.
+ */
+class DecodificadorArchivo
+{
+private:
+    unsigned char* datos;          ///< Contenido completo del archivo
+    size_t longitudDatos;          ///< Bytes del archivo
+    CabeceraArchivo cabecera;      ///< Cabecera leída al abrir
+    size_t* inicioBloques;         ///< Posición de la cabecera de cada bloque
+    long long* salidaBloques;      ///< Primer carácter de cada bloque en el mensaje
+    int rotacionFinal;             ///< Rotación del disco tras la última trama
+    bool valido;                   ///< El archivo es un archivo de tramas íntegro
+
+    /**
+     * @brief Decodifica un bloque
+     * @param indice Bloque a decodificar
+     * @param destino Inicio del mensaje completo
+     * @param disco Disco de trabajo del hilo
+     * @return false si el cuerpo no coincide con su cabecera
+     */
+    bool decodificarBloque(int indice, char* destino, DiscoRotatorio* disco) const;
+
+public:
+    /**
+     * @brief Constructor que carga el archivo y valida sus cabeceras
+     * @param ruta Archivo de tramas
+     */
+    DecodificadorArchivo(const char* ruta);
+
+    /**
+     * @brief Destructor que libera el contenido cargado
+     */
+    ~DecodificadorArchivo();
+
+    /**
+     * @brief Indica si el archivo se cargó correctamente
+     * @return false si no existe, no es un archivo de tramas o está truncado
+     */
+    bool estaOperativo() const;
+
+    /**
+     * @brief Comprueba si un archivo es un archivo de tramas
+     * @param ruta Archivo a examinar
+     * @return true si empieza con la marca "PRT7ARC"
+     */
+    static bool esArchivoTramas(const char* ruta);
+
+    /**
+     * @brief Decodifica todo el archivo
+     * @param destino Buffer de al menos obtenerCaracteres() bytes
+     * @param hilos Hilos a usar (0 = los que tenga el equipo)
+     * @return Caracteres escritos, o -1 si un bloque está dañado
+     */
+    long long decodificar(char* destino, int hilos) const;
+
+    /**
+     * @brief Obtiene el número de bloques
+     * @return Bloques del archivo
+     */
+    int obtenerBloques() const;
+
+    /**
+     * @brief Obtiene el número de tramas archivadas
+     * @return Tramas de todos los bloques
+     */
+    long long obtenerTramas() const;
+
+    /**
+     * @brief Obtiene la longitud del mensaje decodificado
+     * @return Caracteres que produce decodificar()
+     */
+    long long obtenerCaracteres() const;
+
+    /**
+     * @brief Obtiene el tamaño del archivo
+     * @return Bytes leídos del disco
+     */
+    long long obtenerBytesArchivo() const;
+
+    /**
+     * @brief Obtiene la rotación del disco al terminar el archivo
+     * @return Rotación en [0, 26)
+     */
+    int obtenerRotacionFinal() const;
+
+    // El decodificador es dueño del contenido cargado
+    DecodificadorArchivo(const DecodificadorArchivo&) = delete;
+    DecodificadorArchivo& operator=(const DecodificadorArchivo&) = delete;
+};
+
+#endif // DECODIFICADOR_ARCHIVO_H
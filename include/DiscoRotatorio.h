@@ -11,6 +11,8 @@
 #ifndef DISCO_ROTATORIO_H
 #define DISCO_ROTATORIO_H
 
+#include <cstddef>
+
 /**
  * @struct ElementoDisco
  * @brief Nodo de la lista circular para el disco de cifrado
@@ -32,12 +34,26 @@ struct ElementoDisco
  * Esta clase implementa una lista circular doblemente enlazada que
  * contiene el alfabeto A-Z. La rotación del disco cambia el mapeo
  * entre caracteres, simulando un cifrado César con offset dinámico.
+ * 
+ * Al construirse, el disco recorre su propia lista para generar una
+ * tabla de traducción de 256 entradas por cada rotación posible.
+ * Girar solo selecciona la tabla activa, y decodificar un byte es
+ * una única lectura indexada sin ramificaciones.
+ * 
+ * Como el disco es dueño de sus nodos y tablas, no admite copia
+ * implícita: se mueve en O(1) o se duplica con clonar().
  */
 class DiscoRotatorio
 {
 private:
-    ElementoDisco* posicionCero;  ///< Puntero a la posición de referencia actual
+    ElementoDisco* posicionCero;  ///< Primer elemento del cableado (fijo tras construir)
     int tamanoAlfabeto;           ///< Tamaño del alfabeto (26 letras)
+    int desplazamientoActual;     ///< Rotación acumulada en [0, tamanoAlfabeto)
+    char cableado[27];            ///< Letras del disco en orden, desde 'A'
+    unsigned char (*tablasTraduccion)[256];  ///< Una tabla por rotación posible
+    const unsigned char* tablaActiva;        ///< Tabla de la rotación actual
+
+    static const unsigned char tablaIdentidad[256];  ///< Tabla de un disco vacío o movido
 
 public:
     /**
@@ -48,6 +64,17 @@ public:
      */
     DiscoRotatorio();
 
+    /**
+     * @brief Constructor para un disco con cableado propio
+     * @param cableadoDisco Permutación de las 26 letras mayúsculas
+     * 
+     * La letra en la posición i del cableado ocupa el nodo i del
+     * disco, de modo que con rotación cero 'A' se traduce como
+     * cableadoDisco[0]. Si el texto no es una permutación válida
+     * se usa el alfabeto ordenado.
+     */
+    explicit DiscoRotatorio(const char* cableadoDisco);
+
     /**
      * @brief Destructor que libera toda la memoria del disco
      * 
@@ -55,13 +82,40 @@ public:
      */
     ~DiscoRotatorio();
 
+    /**
+     * @brief Constructor de movimiento
+     * @param otro Disco cuyos nodos y tablas se transfieren
+     * 
+     * El disco de origen queda vacío: no gira y traduce cada byte a
+     * sí mismo (tabla identidad), hasta recibir una nueva asignación
+     * por movimiento.
+     */
+    DiscoRotatorio(DiscoRotatorio&& otro);
+
+    /**
+     * @brief Asignación por movimiento
+     * @param otro Disco cuyos nodos y tablas se transfieren
+     * @return Referencia a este disco
+     */
+    DiscoRotatorio& operator=(DiscoRotatorio&& otro);
+
+    /**
+     * @brief Crea un disco independiente con la misma rotación
+     * @return Nuevo disco con el mismo cableado y la rotación actual
+     */
+    DiscoRotatorio clonar() const;
+
+    // Copiar compartiría los nodos y provocaría una doble liberación
+    DiscoRotatorio(const DiscoRotatorio&) = delete;
+    DiscoRotatorio& operator=(const DiscoRotatorio&) = delete;
+
     /**
      * @brief Rota el disco un número específico de posiciones
      * @param desplazamiento Cantidad de posiciones a rotar
      *                       (positivo: sentido horario, negativo: antihorario)
      * 
-     * Mueve el puntero posicionCero, cambiando así el mapeo
-     * de todos los caracteres subsecuentes.
+     * Selecciona la tabla de la nueva rotación, cambiando así el
+     * mapeo de todos los caracteres subsecuentes. No recorre la lista.
      */
     void girar(int desplazamiento);
 
@@ -70,18 +124,76 @@ public:
      * @param caracterOriginal Carácter a cifrar
      * @return Carácter cifrado según la posición actual del disco
      * 
-     * Encuentra la posición relativa del carácter en el disco
-     * y devuelve el carácter mapeado según la rotación actual.
+     * Consulta la tabla de la rotación actual. Las minúsculas
+     * conservan su caso y los caracteres no alfabéticos no cambian.
+     * Se define en la cabecera para que el compilador pueda
+     * integrarla en el bucle de decodificación.
+     */
+    char obtenerCifrado(char caracterOriginal) const
+    {
+        return (char)tablaActiva[(unsigned char)caracterOriginal];
+    }
+
+    /**
+     * @brief Decodifica un bloque de bytes con la rotación actual
+     * @param origen Bytes recibidos
+     * @param destino Buffer de salida (puede coincidir con origen)
+     * @param cantidad Número de bytes a traducir
      */
-    char obtenerCifrado(char caracterOriginal);
+    void traducir(const char* origen, char* destino, size_t cantidad) const;
+
+    /**
+     * @brief Obtiene la rotación acumulada del disco
+     * @return Desplazamiento actual normalizado a [0, 26)
+     * 
+     * Permite guardar el estado del disco y restaurarlo más tarde
+     * con girar() sobre un disco recién construido.
+     */
+    int obtenerDesplazamiento() const;
+
+    /**
+     * @brief Lleva el disco a una rotación absoluta
+     * @param desplazamiento Rotación deseada (se normaliza a [0, 26))
+     * 
+     * Usado por las tramas de sincronización: activa directamente la
+     * tabla de esa rotación en vez de acumular giros relativos, de
+     * modo que un error anterior deja de propagarse.
+     */
+    void establecerDesplazamiento(int desplazamiento);
 
 private:
+    /**
+     * @brief Inicializa el estado común a todos los constructores
+     * @param cableadoDisco Permutación de letras, o nullptr para A-Z
+     */
+    void inicializar(const char* cableadoDisco);
+
     /**
      * @brief Construye la lista circular inicial
      * 
-     * Método auxiliar privado que crea y enlaza los 26 nodos.
+     * Método auxiliar privado que crea y enlaza los 26 nodos
+     * siguiendo el cableado del disco.
      */
     void construirDisco();
+
+    /**
+     * @brief Genera las tablas de traducción de todas las rotaciones
+     * 
+     * Recorre la lista circular desde cada posición de partida, por
+     * lo que las tablas reflejan siempre el contenido real del disco.
+     */
+    void construirTablas();
+
+    /**
+     * @brief Libera nodos y tablas dejando el disco vacío
+     */
+    void liberarDisco();
+
+    /**
+     * @brief Toma los recursos de otro disco y lo deja vacío
+     * @param otro Disco de origen
+     */
+    void transferirDesde(DiscoRotatorio& otro);
 };
 
 #endif // DISCO_ROTATORIO_H
@@ -0,0 +1,92 @@
+/**
+ * @file EnsambladorLineas.h
+ * @brief Separación de un flujo de bytes en líneas del protocolo
+ * @author Tu Nombre
+ * @date 2024
+ * 
+ * Etapa de entramado del decodificador: recibe bloques de bytes de
+ * cualquier tamaño, tal como llegan del puerto, y entrega las líneas
+ * completas sin volver a copiarlas.
+ */
+
+#ifndef ENSAMBLADOR_LINEAS_H
+#define ENSAMBLADOR_LINEAS_H
+
+/**
+ * @class EnsambladorLineas
+ * @brief Buffer que acumula bytes y extrae líneas terminadas en '\n'
+ * 
+ * Las líneas se devuelven como punteros al interior del buffer y
+ * siguen siendo válidas hasta la siguiente llamada a agregar().
+ * Los retornos de carro se descartan y las líneas vacías se omiten.
+ */
+class EnsambladorLineas
+{
+private:
+    char* almacen;          ///< Bytes recibidos pendientes de entramar
+    int capacidad;          ///< Tamaño del almacén
+    int inicioPendiente;    ///< Primer byte aún no entregado
+    int finDatos;           ///< Posición tras el último byte recibido
+    int lineasDescartadas;  ///< Líneas que excedieron la capacidad
+
+public:
+    /**
+     * @brief Constructor
+     * @param tamanoMaximo Longitud máxima de línea más datos en tránsito
+     */
+    EnsambladorLineas(int tamanoMaximo);
+
+    /**
+     * @brief Destructor que libera el almacén
+     */
+    ~EnsambladorLineas();
+
+    /**
+     * @brief Obtiene espacio libre para leer directamente en el almacén
+     * @param disponible Recibe los bytes que caben en el espacio devuelto
+     * @return Puntero donde el lector puede escribir
+     * 
+     * Permite leer del puerto sin copias intermedias; tras leer hay
+     * que llamar a confirmar() con la cantidad realmente escrita.
+     */
+    char* reservarEspacio(int* disponible);
+
+    /**
+     * @brief Registra bytes escritos tras reservarEspacio()
+     * @param cantidad Bytes escritos
+     */
+    void confirmar(int cantidad);
+
+    /**
+     * @brief Copia un bloque de bytes al almacén
+     * @param datos Bytes recibidos
+     * @param cantidad Número de bytes
+     */
+    void agregar(const char* datos, int cantidad);
+
+    /**
+     * @brief Extrae la siguiente línea completa
+     * @return Línea terminada en '\0', o nullptr si no hay ninguna completa
+     */
+    char* extraerLinea();
+
+    /**
+     * @brief Descarta los bytes recibidos que aún no forman línea
+     * 
+     * Se usa al cambiar el perfil del puerto, cuando lo pendiente
+     * se recibió con la configuración anterior.
+     */
+    void descartarPendiente();
+
+    /**
+     * @brief Obtiene cuántas líneas se descartaron por ser demasiado largas
+     * @return Número de líneas descartadas
+     */
+    int obtenerLineasDescartadas() const;
+
+    // El ensamblador es dueño de su almacén: no se permite copiarlo
+    EnsambladorLineas(const EnsambladorLineas&) = delete;
+    EnsambladorLineas& operator=(const EnsambladorLineas&) = delete;
+};
+
+#endif // ENSAMBLADOR_LINEAS_H
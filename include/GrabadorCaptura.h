@@ -0,0 +1,159 @@
+/**
+ * @file GrabadorCaptura.h
+ * @brief Grabación de los bytes crudos recibidos por el puerto
+ * @author Tu Nombre
+ * @date 2024
+ * 
+ * Formato del archivo de captura (binario, orden de bytes nativo):
+ * una cabecera CabeceraCaptura de 64 bytes seguida de registros de
+ * 12 bytes (instante en ns de 8 bytes, puerto y longitud de 2 bytes
+ * cada uno) con los bytes recibidos a continuación. Los instantes
+ * son de un reloj monótono y solo importan sus diferencias.
+ */
+
+#ifndef GRABADOR_CAPTURA_H
+#define GRABADOR_CAPTURA_H
+
+#include <cstdio>
+
+/// Bytes de la cabecera de cada registro
+const int TAMANO_CABECERA_REGISTRO = 12;
+
+/// Carga máxima de un registro (cabe en la longitud de 16 bits)
+const int MAXIMA_CARGA_REGISTRO = 65535;
+
+/// Tiempo máximo que un bloque completo espera en el lote
+const long INTERVALO_VACIADO_CAPTURA_MS = 1000;
+
+/**
+ * @struct CabeceraCaptura
+ * @brief Cabecera del archivo de captura
+ */
+struct CabeceraCaptura
+{
+    char marca[8];              ///< "PRT7CAP" terminado en '\0'
+    unsigned int version;       ///< Versión del formato (1)
+    unsigned int reservado;     ///< Sin uso, a cero
+    char nombrePuerto[48];      ///< Puerto de origen de la captura
+};
+
+/**
+ * @class GrabadorCaptura
+ * @brief Escritor de solo anexado por lotes alineados
+ * 
+ * Los registros se acumulan en un lote de memoria alineada a 4096
+ * bytes y se escriben en bloques completos, al llenarse el lote o
+ * con vaciarPeriodico(). Así el archivo puede abrirse con O_DIRECT
+ * (cuando el sistema de archivos lo admite) sin pasar por la caché
+ * de páginas; la cola sin alinear se escribe al cerrar.
+ * 
+ * Con reservarRegistro() y confirmarRegistro() el lector del puerto
+ * escribe directamente dentro del lote, sin copia intermedia.
+ */
+class GrabadorCaptura
+{
+private:
+    char* lote;                 ///< Lote de escritura alineado
+    int capacidadLote;          ///< Tamaño del lote (múltiplo de 4096)
+    int ocupado;                ///< Bytes del lote pendientes de escribir
+#ifdef _WIN32
+    std::FILE* archivo;         ///< Archivo de captura
+#else
+    int descriptor;             ///< Descriptor del archivo de captura
+#endif
+    bool accesoDirecto;         ///< El archivo se abrió con O_DIRECT
+    bool operativo;             ///< Sin errores de escritura
+    long long bytesEscritos;    ///< Bytes enviados al archivo
+    unsigned long long ultimoVaciado;  ///< Instante del último vaciarPeriodico() efectivo
+    int registrosGrabados;      ///< Registros confirmados
+
+    /**
+     * @brief Escribe un tramo del lote en el archivo
+     * @param cantidad Bytes desde el inicio del lote
+     * @return false si la escritura falló
+     */
+    bool escribirLote(int cantidad);
+
+public:
+    /**
+     * @brief Constructor que crea (o trunca) el archivo de captura
+     * @param ruta Archivo de destino
+     * @param nombrePuerto Puerto de origen, guardado en la cabecera
+     * @param intentarDirecto true para abrir con O_DIRECT si es posible
+     */
+    GrabadorCaptura(const char* ruta, const char* nombrePuerto, bool intentarDirecto);
+
+    /**
+     * @brief Destructor que escribe lo pendiente y cierra el archivo
+     */
+    ~GrabadorCaptura();
+
+    /**
+     * @brief Indica si la captura se está grabando
+     * @return false si no se pudo abrir o falló una escritura
+     */
+    bool estaOperativo() const;
+
+    /**
+     * @brief Obtiene espacio para la carga del siguiente registro
+     * @param disponible Recibe los bytes que caben
+     * @return Puntero dentro del lote donde escribir la carga
+     */
+    char* reservarRegistro(int* disponible);
+
+    /**
+     * @brief Cierra el registro reservado con el instante actual
+     * @param cantidad Bytes escritos en la carga (0 descarta el registro)
+     * @param puerto Identificador del puerto de origen
+     */
+    void confirmarRegistro(int cantidad, unsigned short puerto);
+
+    /**
+     * @brief Copia un bloque de bytes como un registro
+     * @param datos Bytes recibidos
+     * @param cantidad Número de bytes
+     * @param puerto Identificador del puerto de origen
+     */
+    void registrar(const char* datos, int cantidad, unsigned short puerto);
+
+    /**
+     * @brief Escribe los bloques completos acumulados en el lote
+     * @return false si la escritura falló
+     */
+    bool vaciar();
+
+    /**
+     * @brief Escribe los bloques completos si venció el intervalo de vaciado
+     * @return false si la escritura falló
+     * 
+     * Con un enlace lento el lote tardaría minutos en llenarse. Llamado
+     * tras cada lectura, un bloque completo no espera en memoria más
+     * de INTERVALO_VACIADO_CAPTURA_MS mientras sigan llegando datos;
+     * cuando dejan de llegar, quien lee debe llamar a vaciar().
+     */
+    bool vaciarPeriodico();
+
+    /**
+     * @brief Obtiene el número de registros grabados
+     * @return Registros confirmados
+     */
+    int obtenerRegistros() const;
+
+    /**
+     * @brief Obtiene los bytes escritos en el archivo
+     * @return Bytes enviados al sistema hasta ahora
+     */
+    long long obtenerBytesEscritos() const;
+
+    /**
+     * @brief Obtiene el instante del reloj monótono
+     * @return Nanosegundos desde un origen arbitrario
+     */
+    static unsigned long long instanteActual();
+
+    // El grabador es dueño del archivo y del lote
+    GrabadorCaptura(const GrabadorCaptura&) = delete;
+    GrabadorCaptura& operator=(const GrabadorCaptura&) = delete;
+};
+
+#endif // GRABADOR_CAPTURA_H
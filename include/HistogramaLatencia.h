@@ -0,0 +1,93 @@
+/**
+ * @file HistogramaLatencia.h
+ * @brief Histograma de latencias con percentiles
+ * @author Tu Nombre
+ * @date 2024
+ */
+
+#ifndef HISTOGRAMA_LATENCIA_H
+#define HISTOGRAMA_LATENCIA_H
+
+/// Latencias (ns) que tienen una cubeta propia
+const int LATENCIAS_EXACTAS = 64;
+
+/// Cubetas por cada potencia de dos por encima de las exactas (~3% de error)
+const int CUBETAS_POR_OCTAVA = 32;
+
+/// Cubetas totales: exactas más las octavas de 2^6 a 2^63
+const int TOTAL_CUBETAS_LATENCIA = LATENCIAS_EXACTAS + (64 - 6) * CUBETAS_POR_OCTAVA;
+
+/**
+ * @class HistogramaLatencia
+ * @brief Cuenta latencias en cubetas logarítmicas de ancho fijo relativo
+ * 
+ * Registrar es O(1) y no reserva memoria, así que puede hacerse en
+ * el camino medido. Los percentiles se devuelven como el límite
+ * superior de su cubeta; el máximo es exacto.
+ */
+class HistogramaLatencia
+{
+private:
+    unsigned long long cuentas[TOTAL_CUBETAS_LATENCIA]; ///< Muestras por cubeta
+    unsigned long long muestras;                        ///< Muestras registradas
+    unsigned long long maximo;                          ///< Mayor latencia registrada
+    unsigned long long suma;                            ///< Suma para la media
+
+    /**
+     * @brief Cubeta de una latencia
+     * @param nanosegundos Latencia
+     * @return Índice en cuentas
+     */
+    static int obtenerCubeta(unsigned long long nanosegundos);
+
+    /**
+     * @brief Mayor latencia que cae en una cubeta
+     * @param cubeta Índice en cuentas
+     * @return Límite superior en ns
+     */
+    static unsigned long long obtenerLimiteCubeta(int cubeta);
+
+public:
+    /**
+     * @brief Constructor de un histograma vacío
+     */
+    HistogramaLatencia();
+
+    /**
+     * @brief Registra una muestra
+     * @param nanosegundos Latencia medida
+     */
+    void registrar(unsigned long long nanosegundos);
+
+    /**
+     * @brief Descarta todas las muestras
+     */
+    void reiniciar();
+
+    /**
+     * @brief Obtiene un percentil
+     * @param fraccion Fracción de muestras por debajo (0.5, 0.99, 0.999...)
+     * @return Latencia en ns, o 0 sin muestras
+     */
+    unsigned long long obtenerPercentil(double fraccion) const;
+
+    /**
+     * @brief Obtiene la cantidad de muestras
+     * @return Muestras registradas
+     */
+    unsigned long long obtenerMuestras() const;
+
+    /**
+     * @brief Obtiene la mayor latencia
+     * @return Latencia en ns
+     */
+    unsigned long long obtenerMaximo() const;
+
+    /**
+     * @brief Obtiene la latencia media
+     * @return Latencia en ns, o 0 sin muestras
+     */
+    unsigned long long obtenerMedia() const;
+};
+
+#endif // HISTOGRAMA_LATENCIA_H
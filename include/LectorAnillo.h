@@ -0,0 +1,86 @@
+/**
+ * @file LectorAnillo.h
+ * @brief Lado lector del anillo de eventos en memoria compartida
+ * @author Tu Nombre
+ * @date 2024
+ * 
+ * Pensado para los procesos que consumen el resultado de la
+ * decodificación: se enlaza con prt7_anillo y se consulta con
+ * leer() tan a menudo como se quiera, sin llamadas al sistema.
+ */
+
+#ifndef LECTOR_ANILLO_H
+#define LECTOR_ANILLO_H
+
+#include "AnilloEventos.h"
+
+/**
+ * @class LectorAnillo
+ * @brief Consumidor independiente de un anillo de eventos
+ * 
+ * Cada lector lleva su propia posición; varios lectores pueden
+ * recorrer el mismo anillo a la vez. Si el escritor da una vuelta
+ * completa por delante, el lector salta a la mitad más reciente del
+ * anillo y suma los eventos que se perdió.
+ */
+class LectorAnillo
+{
+private:
+    const CabeceraAnillo* cabecera;    ///< Inicio de la proyección (nullptr si falló)
+    const RanuraAnillo* ranuras;       ///< Ranuras tras la cabecera
+    unsigned long long capacidad;      ///< Ranuras del anillo
+    unsigned long long esperado;       ///< Secuencia del próximo evento a leer
+    unsigned long long perdidos;       ///< Eventos sobrescritos antes de leerlos
+    unsigned long long tamano;         ///< Bytes proyectados
+
+    /**
+     * @brief Reubica la lectura tras quedar una vuelta por detrás
+     */
+    void recuperarAtraso();
+
+public:
+    /**
+     * @brief Constructor que proyecta un anillo existente
+     * @param nombreObjeto Nombre POSIX con el que lo creó el escritor
+     * 
+     * La lectura comienza en el próximo evento que se publique.
+     */
+    LectorAnillo(const char* nombreObjeto);
+
+    /**
+     * @brief Destructor que desproyecta el anillo
+     */
+    ~LectorAnillo();
+
+    /**
+     * @brief Verifica si el anillo se proyectó y es de versión conocida
+     * @return true si puede leerse
+     */
+    bool estaOperativo() const;
+
+    /**
+     * @brief Copia los eventos nuevos
+     * @param destino Arreglo donde se copian
+     * @param maximo Eventos que caben en destino
+     * @return Eventos copiados (0 si no hay nuevos)
+     */
+    int leer(EventoDecodificado* destino, int maximo);
+
+    /**
+     * @brief Obtiene los eventos perdidos por leer demasiado lento
+     * @return Número de eventos
+     */
+    unsigned long long obtenerPerdidos() const;
+
+    /**
+     * @brief Obtiene los eventos publicados hasta ahora por el escritor
+     * @return Número de eventos
+     */
+    unsigned long long obtenerPublicados() const;
+
+    // El lector es dueño de su proyección: no se permite copiarlo
+    LectorAnillo(const LectorAnillo&) = delete;
+    LectorAnillo& operator=(const LectorAnillo&) = delete;
+};
+
+#endif // LECTOR_ANILLO_H
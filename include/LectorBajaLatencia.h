@@ -0,0 +1,140 @@
+/**
+ * @file LectorBajaLatencia.h
+ * @brief Hilo lector en espera activa para el modo de baja latencia
+ * @author Tu Nombre
+ * @date 2024
+ * 
+ * En el modo normal el proceso duerme en el bucle de eventos hasta
+ * que el núcleo avisa que hay bytes; despertar cuesta decenas de
+ * microsegundos. En baja latencia un hilo fijado a un núcleo lee el
+ * descriptor no bloqueante sin pausa y pasa cada lectura, con el
+ * instante en que volvió read(), a un anillo de un productor y un
+ * consumidor. El hilo decodificador lo vacía también en espera
+ * activa, de modo que ninguno de los dos duerme. Cada hilo ocupa un
+ * núcleo entero mientras dura la sesión; si ambos comparten núcleo,
+ * cada vuelta vacía cede el procesador para que el otro avance.
+ */
+
+#ifndef LECTOR_BAJA_LATENCIA_H
+#define LECTOR_BAJA_LATENCIA_H
+
+#include "Transporte.h"
+#include <atomic>
+#include <thread>
+
+/// Lecturas que caben en el anillo (potencia de dos)
+const unsigned int TRAMOS_LECTOR = 256;
+
+/// Bytes que admite una lectura
+const int CAPACIDAD_TRAMO_LECTOR = 512;
+
+/**
+ * @struct TramoLectura
+ * @brief Bytes devueltos por una lectura del transporte
+ */
+struct TramoLectura
+{
+    long long instante;                   ///< Instante de la lectura (ns, reloj monótono)
+    int longitud;                         ///< Bytes leídos
+    char datos[CAPACIDAD_TRAMO_LECTOR];   ///< Bytes leídos
+};
+
+/**
+ * @class LectorBajaLatencia
+ * @brief Lee un transporte desde un hilo propio y entrega las lecturas por un anillo
+ * 
+ * El hilo lector es el único que escribe en el anillo y el hilo que
+ * llama a siguienteTramo() el único que lee, así que basta con un
+ * índice atómico por lado, cada uno en su propia línea de caché.
+ */
+class LectorBajaLatencia
+{
+private:
+    Transporte* transporte;       ///< Medio de entrada (no bloqueante)
+    int nucleoLector;             ///< Núcleo del hilo lector (-1 = sin fijar)
+    bool ceder;                   ///< Ceder el procesador en cada vuelta vacía
+    TramoLectura* tramos;         ///< Anillo de lecturas
+    std::thread hilo;             ///< Hilo lector
+    bool iniciado;                ///< El hilo está en marcha
+
+    alignas(64) std::atomic<unsigned int> escritos;  ///< Lecturas publicadas (productor)
+    alignas(64) std::atomic<unsigned int> leidos;    ///< Lecturas consumidas (consumidor)
+    alignas(64) std::atomic<bool> detenido;          ///< Solicitud de salida del hilo
+    std::atomic<bool> cerrado;                       ///< El transporte terminó o falló
+    std::atomic<int> arranque;                       ///< 1 fijado al núcleo, -1 falló, 0 pendiente
+    std::atomic<long long> esperasAnilloLleno;       ///< Vueltas con el anillo lleno
+
+    /**
+     * @brief Cuerpo del hilo lector
+     */
+    void leer();
+
+public:
+    /**
+     * @brief Constructor que reserva el anillo
+     * @param medio Transporte a leer (debe devolver 0 sin datos, no bloquear)
+     * @param nucleo Núcleo al que fijar el hilo lector (-1 = sin fijar)
+     * @param cederAlEsperar true si lector y decodificador comparten núcleo
+     */
+    LectorBajaLatencia(Transporte* medio, int nucleo, bool cederAlEsperar);
+
+    /**
+     * @brief Destructor que detiene el hilo y libera el anillo
+     */
+    ~LectorBajaLatencia();
+
+    /**
+     * @brief Arranca el hilo lector
+     * @return false si no se pudo reservar el anillo o fijar el núcleo del lector
+     */
+    bool iniciar();
+
+    /**
+     * @brief Detiene el hilo lector y espera a que termine
+     */
+    void detener();
+
+    /**
+     * @brief Primera lectura pendiente (solo desde el hilo consumidor)
+     * @return Lectura, o nullptr si el anillo está vacío
+     * 
+     * La lectura sigue siendo válida hasta liberarTramo().
+     */
+    const TramoLectura* siguienteTramo();
+
+    /**
+     * @brief Devuelve al lector la lectura obtenida con siguienteTramo()
+     */
+    void liberarTramo();
+
+    /**
+     * @brief Indica si el transporte terminó
+     * @return true si el lector ya no publicará más lecturas
+     */
+    bool estaCerrado() const;
+
+    /**
+     * @brief Obtiene las vueltas que el lector esperó con el anillo lleno
+     * @return Esperas (el decodificador no daba abasto)
+     */
+    long long obtenerEsperasAnilloLleno() const;
+
+    /**
+     * @brief Fija el hilo que llama a un núcleo
+     * @param nucleo Índice del núcleo (-1 no cambia nada)
+     * @return false si el sistema rechazó la afinidad
+     */
+    static bool fijarNucleo(int nucleo);
+
+    /**
+     * @brief Reloj monótono con el que se marcan las lecturas
+     * @return Nanosegundos
+     */
+    static long long instanteActual();
+
+    // El lector es dueño del anillo y del hilo
+    LectorBajaLatencia(const LectorBajaLatencia&) = delete;
+    LectorBajaLatencia& operator=(const LectorBajaLatencia&) = delete;
+};
+
+#endif // LECTOR_BAJA_LATENCIA_H
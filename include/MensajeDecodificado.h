@@ -15,16 +15,70 @@
  * @struct FragmentoMensaje
  * @brief Nodo de la lista doblemente enlazada
  * 
- * Cada fragmento almacena un carácter del mensaje decodificado
- * y mantiene enlaces bidireccionales para navegación eficiente.
+ * Cada fragmento almacena un tramo contiguo de caracteres del
+ * mensaje decodificado y mantiene enlaces bidireccionales para
+ * navegación eficiente.
  */
 struct FragmentoMensaje
 {
-    char caracter;              ///< Carácter decodificado almacenado
+    char* caracteres;           ///< Caracteres almacenados en este fragmento
+    int cantidad;               ///< Caracteres ocupados
+    int capacidad;              ///< Caracteres que caben en el fragmento
     FragmentoMensaje* proximo;  ///< Puntero al siguiente fragmento
     FragmentoMensaje* previo;   ///< Puntero al fragmento anterior
 };
 
+/**
+ * @class IteradorMensaje
+ * @brief Recorrido carácter a carácter en ambos sentidos
+ * 
+ * Se obtiene con MensajeDecodificado::iteradorInicio() o
+ * iteradorFinal(). Deja de ser válido si el mensaje se modifica
+ * en una posición distinta de la que señala.
+ */
+class IteradorMensaje
+{
+private:
+    FragmentoMensaje* fragmento;  ///< Fragmento actual (nullptr al salir)
+    int desplazamiento;           ///< Posición dentro del fragmento
+
+public:
+    /**
+     * @brief Constructor
+     * @param inicial Fragmento de partida
+     * @param posicion Índice dentro del fragmento
+     */
+    IteradorMensaje(FragmentoMensaje* inicial, int posicion);
+
+    /**
+     * @brief Indica si el iterador señala un carácter
+     * @return false tras salir por cualquiera de los extremos
+     */
+    bool esValido() const;
+
+    /**
+     * @brief Obtiene el carácter señalado
+     * @return Carácter actual (solo si esValido())
+     */
+    char obtenerCaracter() const;
+
+    /**
+     * @brief Reemplaza el carácter señalado
+     * @param nuevoCaracter Carácter que lo sustituye
+     */
+    void establecerCaracter(char nuevoCaracter);
+
+    /**
+     * @brief Avanza al carácter siguiente
+     */
+    void avanzar();
+
+    /**
+     * @brief Retrocede al carácter anterior
+     */
+    void retroceder();
+};
+
 /**
  * @class MensajeDecodificado
  * @brief Contenedor secuencial para el mensaje descifrado
@@ -32,6 +86,20 @@ struct FragmentoMensaje
  * Implementa una lista doblemente enlazada que mantiene el orden
  * de llegada de los caracteres decodificados. Permite inserción
  * eficiente al final y recorrido completo para visualización.
+ * 
+ * Cada nodo guarda un tramo de caracteres cuya capacidad crece con
+ * la raíz cuadrada de la longitud del mensaje. Así tanto el número
+ * de nodos como el tamaño de cada uno son O(√n), y las operaciones
+ * por posición (consultar, insertar, eliminar, reemplazar) cuestan
+ * O(√n). Además se recuerda el último nodo modificado para que los
+ * accesos cercanos entre sí no vuelvan a recorrer la lista.
+ * 
+ * Las consultas const parten del cursor pero no lo mueven, así que
+ * varios hilos pueden leer a la vez un mensaje que nadie modifica.
+ * 
+ * El mensaje es dueño de sus fragmentos: no puede copiarse de forma
+ * implícita, pero sí moverse en tiempo constante (transfiriendo los
+ * nodos) o duplicarse de forma explícita con clonar().
  */
 class MensajeDecodificado
 {
@@ -39,6 +107,10 @@ private:
     FragmentoMensaje* inicio;    ///< Primer fragmento del mensaje
     FragmentoMensaje* final;     ///< Último fragmento del mensaje
     int longitudTotal;           ///< Cantidad de caracteres almacenados
+    int cantidadFragmentos;      ///< Número de nodos de la lista
+
+    FragmentoMensaje* fragmentoCursor;  ///< Último nodo modificado
+    int inicioCursor;                   ///< Posición del primer carácter del cursor
 
 public:
     /**
@@ -54,28 +126,168 @@ public:
      */
     ~MensajeDecodificado();
 
+    /**
+     * @brief Constructor de movimiento
+     * @param otro Mensaje cuyos fragmentos se transfieren
+     * 
+     * Transfiere la lista completa en O(1); el origen queda vacío.
+     */
+    MensajeDecodificado(MensajeDecodificado&& otro);
+
+    /**
+     * @brief Asignación por movimiento
+     * @param otro Mensaje cuyos fragmentos se transfieren
+     * @return Referencia a este mensaje
+     * 
+     * Libera los fragmentos propios y toma los del origen en O(1).
+     */
+    MensajeDecodificado& operator=(MensajeDecodificado&& otro);
+
+    /**
+     * @brief Crea una copia independiente del mensaje
+     * @return Nuevo mensaje con los mismos caracteres
+     * 
+     * Recorre la lista completa; es la única forma de copiar un mensaje.
+     */
+    MensajeDecodificado clonar() const;
+
+    // Copiar compartiría los nodos y provocaría una doble liberación
+    MensajeDecodificado(const MensajeDecodificado&) = delete;
+    MensajeDecodificado& operator=(const MensajeDecodificado&) = delete;
+
     /**
      * @brief Agrega un carácter al final del mensaje
      * @param nuevoCaracter Carácter a agregar
      * 
-     * Crea un nuevo nodo y lo enlaza al final de la lista,
-     * manteniendo la integridad de los enlaces bidireccionales.
+     * Escribe en el último fragmento y solo crea un nodo nuevo
+     * cuando este se llena, manteniendo la integridad de los
+     * enlaces bidireccionales. El caso frecuente (queda espacio)
+     * se define en la cabecera para poder integrarse.
      */
-    void agregarCaracter(char nuevoCaracter);
+    void agregarCaracter(char nuevoCaracter)
+    {
+        if (final == nullptr || final->cantidad == final->capacidad)
+        {
+            agregarEnFragmentoNuevo(nuevoCaracter);
+            return;
+        }
+        final->caracteres[final->cantidad++] = nuevoCaracter;
+        longitudTotal++;
+    }
 
     /**
-     * @brief Muestra el mensaje completo en la salida estándar
-     * 
-     * Recorre la lista desde el inicio hasta el final,
-     * imprimiendo cada carácter entre corchetes.
+     * @brief Inserta un carácter en una posición del mensaje
+     * @param posicion Índice donde quedará el carácter, en [0, longitud]
+     * @param nuevoCaracter Carácter a insertar
+     * @return false si la posición está fuera de rango
      */
-    void mostrarMensaje();
+    bool insertarEn(int posicion, char nuevoCaracter);
+
+    /**
+     * @brief Elimina el carácter de una posición
+     * @param posicion Índice del carácter, en [0, longitud)
+     * @return false si la posición está fuera de rango
+     */
+    bool eliminarEn(int posicion);
+
+    /**
+     * @brief Sustituye el carácter de una posición
+     * @param posicion Índice del carácter, en [0, longitud)
+     * @param nuevoCaracter Carácter que lo sustituye
+     * @return false si la posición está fuera de rango
+     */
+    bool reemplazarEn(int posicion, char nuevoCaracter);
+
+    /**
+     * @brief Consulta el carácter de una posición
+     * @param posicion Índice del carácter, en [0, longitud)
+     * @return Carácter almacenado, o '\0' si la posición no existe
+     */
+    char obtenerEn(int posicion) const;
+
+    /**
+     * @brief Obtiene un iterador al primer carácter
+     * @return Iterador (no válido si el mensaje está vacío)
+     */
+    IteradorMensaje iteradorInicio() const;
+
+    /**
+     * @brief Obtiene un iterador al último carácter
+     * @return Iterador (no válido si el mensaje está vacío)
+     */
+    IteradorMensaje iteradorFinal() const;
 
     /**
      * @brief Obtiene la longitud actual del mensaje
      * @return Número de caracteres almacenados
      */
     int obtenerLongitud() const;
+
+    /**
+     * @brief Copia un tramo de la parte final del mensaje
+     * @param posicion Índice del primer carácter a copiar
+     * @param destino Buffer donde se copiarán los caracteres
+     * @param cantidad Número máximo de caracteres a copiar
+     * @return Cantidad realmente copiada
+     * 
+     * Localiza la posición desde el extremo o el cursor más cercano
+     * y copia fragmento a fragmento.
+     */
+    int copiarDesde(int posicion, char* destino, int cantidad) const;
+
+private:
+    /**
+     * @brief Agrega un carácter cuando el último fragmento está lleno
+     * @param nuevoCaracter Carácter a agregar
+     */
+    void agregarEnFragmentoNuevo(char nuevoCaracter);
+
+    /**
+     * @brief Elimina todos los fragmentos y deja el mensaje vacío
+     */
+    void liberarFragmentos();
+
+    /**
+     * @brief Capacidad para los fragmentos que se creen a continuación
+     * @return Menor potencia de dos (mínimo 64) cuyo cuadrado cubre la longitud
+     */
+    int calcularCapacidad() const;
+
+    /**
+     * @brief Crea un fragmento vacío y lo enlaza tras otro
+     * @param anterior Fragmento previo, o nullptr para insertarlo al inicio
+     * @param capacidad Caracteres que podrá contener
+     * @return Fragmento creado
+     */
+    FragmentoMensaje* crearFragmento(FragmentoMensaje* anterior, int capacidad);
+
+    /**
+     * @brief Desenlaza y libera un fragmento
+     * @param fragmento Fragmento a eliminar
+     */
+    void eliminarFragmento(FragmentoMensaje* fragmento);
+
+    /**
+     * @brief Encuentra el fragmento que contiene una posición
+     * @param posicion Índice en [0, longitud)
+     * @param inicioFragmento Recibe la posición del primer carácter del fragmento
+     * @return Fragmento que contiene la posición
+     * 
+     * Parte del extremo o del cursor más cercano a la posición. Solo
+     * lee el cursor: actualizarlo es tarea de las operaciones que
+     * modifican el mensaje.
+     */
+    FragmentoMensaje* localizar(int posicion, int* inicioFragmento) const;
+
+    /**
+     * @brief Fusiona un fragmento con el siguiente si caben en media capacidad
+     * @param izquierdo Fragmento cuyo siguiente se considera
+     * @return Fragmento resultante, o nullptr si no se fusionaron
+     * 
+     * Los caracteres van al izquierdo si caben en su media capacidad,
+     * o si no al derecho; el fragmento que queda vacío se libera.
+     */
+    FragmentoMensaje* fusionarConSiguiente(FragmentoMensaje* izquierdo);
 };
 
 #endif // MENSAJE_DECODIFICADO_H
@@ -14,6 +14,7 @@
 // Forward declarations para evitar dependencias circulares
 class MensajeDecodificado;
 class DiscoRotatorio;
+class CadenaRotores;
 
 /**
  * @class PaqueteBase
@@ -36,6 +37,47 @@ public:
      */
     virtual void ejecutar(MensajeDecodificado* mensaje, DiscoRotatorio* disco) = 0;
 
+    /**
+     * @brief Ejecuta la acción del paquete sobre una cadena de rotores
+     * @param mensaje Puntero a la estructura donde se almacena el mensaje
+     * @param cadena Puntero a la cadena de discos de cifrado
+     * 
+     * Se usa cuando el decodificador trabaja con varios discos. Por
+     * defecto el paquete no tiene efecto sobre la cadena; los tipos
+     * que decodifican o giran discos deben redefinirlo.
+     */
+    virtual void ejecutarEnCadena(MensajeDecodificado* mensaje, CadenaRotores* cadena)
+    {
+        (void)mensaje;
+        (void)cadena;
+    }
+
+    /**
+     * @brief Obtiene la letra que identifica el tipo de trama
+     * @return Tipo de trama ('L', 'M', 'F', ...)
+     * 
+     * Permite a las políticas de finalización inspeccionar la trama
+     * ya analizada sin volver a recorrer la línea de texto original.
+     */
+    virtual char obtenerTipo() const = 0;
+
+    /**
+     * @brief Obtiene el valor transportado por la trama
+     * @return Valor numérico de la trama (carácter o desplazamiento)
+     */
+    virtual int obtenerValor() const = 0;
+
+    /**
+     * @brief Describe la trama y el efecto de su última ejecución
+     * @param destino Buffer donde se escribe el texto (terminado en '\0')
+     * @param capacidad Tamaño del buffer
+     * @return Caracteres escritos (sin contar el '\0')
+     * 
+     * Los paquetes no escriben en consola: quien los ejecuta decide
+     * si muestra esta descripción y dónde.
+     */
+    virtual int describir(char* destino, int capacidad) const = 0;
+
     /**
      * @brief Destructor virtual para permitir polimorfismo correcto
      * 
@@ -44,6 +86,20 @@ public:
      * un puntero a la clase base.
      */
     virtual ~PaqueteBase() {}
+
+protected:
+    /**
+     * @brief Ajusta el resultado de snprintf a lo realmente escrito
+     * @param escritos Valor devuelto por snprintf
+     * @param capacidad Tamaño del buffer
+     * @return Caracteres presentes en el buffer
+     */
+    static int ajustarDescripcion(int escritos, int capacidad)
+    {
+        if (escritos < 0 || capacidad <= 0)
+            return 0;
+        return (escritos < capacidad) ? escritos : capacidad - 1;
+    }
 };
 
 #endif // PAQUETE_BASE_H
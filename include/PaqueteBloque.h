@@ -0,0 +1,95 @@
+/**
+ * @file PaqueteBloque.h
+ * @brief Paquete de tipo BLOCK con varios caracteres por trama
+ * @author Tu Nombre
+ * @date 2024
+ * 
+ * Trama "B,<texto>" que equivale a una trama L por cada carácter del
+ * texto, todas con la rotación vigente. Ahorra el encabezado, el
+ * salto de línea y el sufijo de integridad de cada letra.
+ */
+
+#ifndef PAQUETE_BLOQUE_H
+#define PAQUETE_BLOQUE_H
+
+#include "PaqueteBase.h"
+#include "MensajeDecodificado.h"
+#include "DiscoRotatorio.h"
+#include "CadenaRotores.h"
+#include "ReservaBloques.h"
+
+/// Caracteres que admite una trama B (la línea cabe en el buffer del analizador)
+const int LONGITUD_MAXIMA_BLOQUE = 120;
+
+/**
+ * @class PaqueteBloque
+ * @brief Implementa un paquete de carga de bloque (tipo B)
+ * 
+ * El texto se decodifica de una vez con DiscoRotatorio::traducir().
+ * En una cadena de rotores cada carácter atraviesa la cadena por
+ * separado, de modo que el avance de los rotores es el mismo que
+ * con tramas L sueltas.
+ */
+class PaqueteBloque : public PaqueteBase, public ConReserva<PaqueteBloque, 16>
+{
+private:
+    char textoTransportado[LONGITUD_MAXIMA_BLOQUE + 1];  ///< Caracteres cifrados
+    char textoDecodificado[LONGITUD_MAXIMA_BLOQUE + 1];  ///< Resultado de la última ejecución
+    int longitud;                                        ///< Caracteres del bloque
+
+public:
+    /**
+     * @brief Constructor
+     * @param texto Caracteres recibidos (se copian)
+     * @param cantidad Número de caracteres, entre 1 y LONGITUD_MAXIMA_BLOQUE
+     */
+    PaqueteBloque(const char* texto, int cantidad);
+
+    /**
+     * @brief Decodifica el bloque y lo agrega al mensaje
+     * @param mensaje Mensaje donde se agregan los caracteres
+     * @param disco Disco que realiza la decodificación
+     */
+    void ejecutar(MensajeDecodificado* mensaje, DiscoRotatorio* disco);
+
+    /**
+     * @brief Decodifica el bloque atravesando la cadena de rotores
+     * @param mensaje Mensaje donde se agregan los caracteres
+     * @param cadena Cadena que realiza la decodificación
+     */
+    void ejecutarEnCadena(MensajeDecodificado* mensaje, CadenaRotores* cadena);
+
+    /**
+     * @brief Obtiene el tipo de la trama
+     * @return 'B'
+     */
+    char obtenerTipo() const;
+
+    /**
+     * @brief Obtiene el valor transportado
+     * @return Cantidad de caracteres del bloque
+     */
+    int obtenerValor() const;
+
+    /**
+     * @brief Obtiene los caracteres recibidos
+     * @return Texto cifrado terminado en '\0'
+     */
+    const char* obtenerTextoTransportado() const;
+
+    /**
+     * @brief Obtiene el resultado de la última ejecución
+     * @return Texto agregado al mensaje, terminado en '\0'
+     */
+    const char* obtenerTextoDecodificado() const;
+
+    /**
+     * @brief Describe la trama y el efecto de su última ejecución
+     * @param destino Buffer donde se escribe el texto
+     * @param capacidad Tamaño del buffer
+     * @return Caracteres escritos (sin contar el '\0')
+     */
+    int describir(char* destino, int capacidad) const;
+};
+
+#endif // PAQUETE_BLOQUE_H
@@ -14,6 +14,8 @@
 #include "PaqueteBase.h"
 #include "MensajeDecodificado.h"
 #include "DiscoRotatorio.h"
+#include "CadenaRotores.h"
+#include "ReservaBloques.h"
 
 /**
  * @class PaqueteCaracter
@@ -23,10 +25,11 @@
  * decodificado usando el disco rotatorio actual y luego
  * agregado al mensaje final.
  */
-class PaqueteCaracter : public PaqueteBase
+class PaqueteCaracter : public PaqueteBase, public ConReserva<PaqueteCaracter, 64>
 {
 private:
     char caracterTransportado;  ///< Carácter en formato cifrado
+    char caracterDecodificado;  ///< Resultado de la última ejecución
 
 public:
     /**
@@ -46,6 +49,39 @@ public:
      * 3. Muestra información de depuración en consola
      */
     void ejecutar(MensajeDecodificado* mensaje, DiscoRotatorio* disco);
+
+    /**
+     * @brief Decodifica el carácter atravesando la cadena de rotores
+     * @param mensaje Puntero al mensaje donde se agregará el carácter
+     * @param cadena Puntero a la cadena que realizará la decodificación
+     */
+    void ejecutarEnCadena(MensajeDecodificado* mensaje, CadenaRotores* cadena);
+
+    /**
+     * @brief Obtiene el tipo de la trama
+     * @return 'L'
+     */
+    char obtenerTipo() const;
+
+    /**
+     * @brief Obtiene el valor transportado
+     * @return Código del carácter transportado
+     */
+    int obtenerValor() const;
+
+    /**
+     * @brief Obtiene el resultado de la última ejecución
+     * @return Carácter agregado al mensaje
+     */
+    char obtenerCaracterDecodificado() const;
+
+    /**
+     * @brief Describe la trama y el efecto de su última ejecución
+     * @param destino Buffer donde se escribe el texto
+     * @param capacidad Tamaño del buffer
+     * @return Caracteres escritos (sin contar el '\0')
+     */
+    int describir(char* destino, int capacidad) const;
 };
 
 #endif // PAQUETE_CARACTER_H
@@ -0,0 +1,75 @@
+/**
+ * @file PaqueteFinalizacion.h
+ * @brief Paquete de tipo END para marcar el fin de un mensaje
+ * @author Tu Nombre
+ * @date 2024
+ * 
+ * Representa una trama explícita de fin de mensaje. Sustituye a la
+ * heurística anterior que interpretaba cualquier MAP negativo como
+ * indicador de finalización.
+ */
+
+#ifndef PAQUETE_FINALIZACION_H
+#define PAQUETE_FINALIZACION_H
+
+#include "PaqueteBase.h"
+#include "MensajeDecodificado.h"
+#include "DiscoRotatorio.h"
+#include "ReservaBloques.h"
+
+/**
+ * @class PaqueteFinalizacion
+ * @brief Implementa un paquete de fin de mensaje (tipo F)
+ * 
+ * No modifica el mensaje ni el disco. Su única función es señalar
+ * a la política de finalización activa que el transmisor terminó
+ * de enviar la secuencia actual.
+ */
+class PaqueteFinalizacion : public PaqueteBase, public ConReserva<PaqueteFinalizacion, 64>
+{
+private:
+    int codigoFinalizacion;  ///< Código opcional enviado con la trama
+
+public:
+    /**
+     * @brief Constructor que inicializa el paquete con su código
+     * @param codigo Valor recibido tras la coma (normalmente 0)
+     */
+    PaqueteFinalizacion(int codigo);
+
+    /**
+     * @brief Muestra el aviso de fin de mensaje
+     * @param mensaje Puntero al mensaje (no usado)
+     * @param disco Puntero al disco (no usado)
+     */
+    void ejecutar(MensajeDecodificado* mensaje, DiscoRotatorio* disco);
+
+    /**
+     * @brief Muestra el aviso de fin de mensaje en modo multi-rotor
+     * @param mensaje Puntero al mensaje (no usado)
+     * @param cadena Puntero a la cadena (no usada)
+     */
+    void ejecutarEnCadena(MensajeDecodificado* mensaje, CadenaRotores* cadena);
+
+    /**
+     * @brief Obtiene el tipo de la trama
+     * @return 'F'
+     */
+    char obtenerTipo() const;
+
+    /**
+     * @brief Obtiene el valor transportado
+     * @return Código de finalización
+     */
+    int obtenerValor() const;
+
+    /**
+     * @brief Describe la trama y el efecto de su última ejecución
+     * @param destino Buffer donde se escribe el texto
+     * @param capacidad Tamaño del buffer
+     * @return Caracteres escritos (sin contar el '\0')
+     */
+    int describir(char* destino, int capacidad) const;
+};
+
+#endif // PAQUETE_FINALIZACION_H
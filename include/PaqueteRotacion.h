@@ -14,6 +14,8 @@
 #include "PaqueteBase.h"
 #include "MensajeDecodificado.h"
 #include "DiscoRotatorio.h"
+#include "CadenaRotores.h"
+#include "ReservaBloques.h"
 
 /**
  * @class PaqueteRotacion
@@ -23,10 +25,11 @@
  * para modificar el estado del disco rotatorio. Cambia dinámicamente
  * el cifrado aplicado a los caracteres subsecuentes.
  */
-class PaqueteRotacion : public PaqueteBase
+class PaqueteRotacion : public PaqueteBase, public ConReserva<PaqueteRotacion, 64>
 {
 private:
     int cantidadRotacion;  ///< Desplazamiento a aplicar (+ o -)
+    bool aplicadoEnCadena; ///< La última ejecución giró una cadena
 
 public:
     /**
@@ -47,6 +50,33 @@ public:
      * 2. Muestra información de depuración en consola
      */
     void ejecutar(MensajeDecodificado* mensaje, DiscoRotatorio* disco);
+
+    /**
+     * @brief Gira el rotor principal (0) de la cadena
+     * @param mensaje Puntero al mensaje (no usado en rotación)
+     * @param cadena Puntero a la cadena de rotores
+     */
+    void ejecutarEnCadena(MensajeDecodificado* mensaje, CadenaRotores* cadena);
+
+    /**
+     * @brief Obtiene el tipo de la trama
+     * @return 'M'
+     */
+    char obtenerTipo() const;
+
+    /**
+     * @brief Obtiene el valor transportado
+     * @return Desplazamiento de la rotación
+     */
+    int obtenerValor() const;
+
+    /**
+     * @brief Describe la trama y el efecto de su última ejecución
+     * @param destino Buffer donde se escribe el texto
+     * @param capacidad Tamaño del buffer
+     * @return Caracteres escritos (sin contar el '\0')
+     */
+    int describir(char* destino, int capacidad) const;
 };
 
 #endif // PAQUETE_ROTACION_H
\ No newline at end of file
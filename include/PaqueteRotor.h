@@ -0,0 +1,85 @@
+/**
+ * @file PaqueteRotor.h
+ * @brief Paquete de tipo ROTOR para girar un disco concreto de la cadena
+ * @author Tu Nombre
+ * @date 2024
+ * 
+ * Trama "R,<rotor>,<n>" usada por los transmisores de varios discos
+ * para direccionar un rotor individual.
+ */
+
+#ifndef PAQUETE_ROTOR_H
+#define PAQUETE_ROTOR_H
+
+#include "PaqueteBase.h"
+#include "MensajeDecodificado.h"
+#include "DiscoRotatorio.h"
+#include "CadenaRotores.h"
+#include "ReservaBloques.h"
+
+/**
+ * @class PaqueteRotor
+ * @brief Implementa un paquete de rotación dirigida (tipo R)
+ * 
+ * En una cadena de rotores gira el disco indicado. Con un solo
+ * disco, la trama dirigida al rotor 0 equivale a una trama MAP y
+ * las dirigidas a otros rotores se ignoran.
+ */
+class PaqueteRotor : public PaqueteBase, public ConReserva<PaqueteRotor, 64>
+{
+private:
+    int indiceRotor;       ///< Rotor al que va dirigida la trama
+    int cantidadRotacion;  ///< Desplazamiento a aplicar (+ o -)
+    bool aplicadoEnCadena; ///< La última ejecución actuó sobre una cadena
+    bool rotorGirado;      ///< La última ejecución encontró el rotor
+
+public:
+    /**
+     * @brief Constructor
+     * @param rotor Índice del rotor (0 es el disco principal)
+     * @param grados Cantidad de posiciones a rotar
+     */
+    PaqueteRotor(int rotor, int grados);
+
+    /**
+     * @brief Aplica la trama con un único disco
+     * @param mensaje Puntero al mensaje (no usado)
+     * @param disco Disco principal, girado solo si el rotor es 0
+     */
+    void ejecutar(MensajeDecodificado* mensaje, DiscoRotatorio* disco);
+
+    /**
+     * @brief Gira el rotor indicado de la cadena
+     * @param mensaje Puntero al mensaje (no usado)
+     * @param cadena Cadena de rotores
+     */
+    void ejecutarEnCadena(MensajeDecodificado* mensaje, CadenaRotores* cadena);
+
+    /**
+     * @brief Obtiene el tipo de la trama
+     * @return 'R'
+     */
+    char obtenerTipo() const;
+
+    /**
+     * @brief Obtiene el valor transportado
+     * @return Desplazamiento de la rotación
+     */
+    int obtenerValor() const;
+
+    /**
+     * @brief Obtiene el rotor al que va dirigida la trama
+     * @return Índice del rotor
+     */
+    int obtenerIndiceRotor() const;
+
+    /**
+     * @brief Describe la trama y el efecto de su última ejecución
+     * @param destino Buffer donde se escribe el texto
+     * @param capacidad Tamaño del buffer
+     * @return Caracteres escritos (sin contar el '\0')
+     */
+    int describir(char* destino, int capacidad) const;
+};
+
+#endif // PAQUETE_ROTOR_H
@@ -0,0 +1,76 @@
+/**
+ * @file PaqueteSincronizacion.h
+ * @brief Paquete de tipo SYNC con la rotación absoluta del disco
+ * @author Tu Nombre
+ * @date 2024
+ * 
+ * Trama "S,<rotacion>" que el transmisor intercala periódicamente
+ * para que el receptor corrija el disco tras perder una trama MAP.
+ */
+
+#ifndef PAQUETE_SINCRONIZACION_H
+#define PAQUETE_SINCRONIZACION_H
+
+#include "PaqueteBase.h"
+#include "MensajeDecodificado.h"
+#include "DiscoRotatorio.h"
+#include "CadenaRotores.h"
+#include "ReservaBloques.h"
+
+/**
+ * @class PaqueteSincronizacion
+ * @brief Implementa un paquete de sincronización (tipo S)
+ * 
+ * A diferencia de MAP, no gira el disco de forma relativa: lo deja
+ * en la rotación indicada. En una cadena afecta al disco principal.
+ */
+class PaqueteSincronizacion : public PaqueteBase, public ConReserva<PaqueteSincronizacion, 64>
+{
+private:
+    int rotacionAbsoluta;  ///< Rotación que debe tener el disco
+    int rotacionAplicada;  ///< Rotación normalizada tras la última ejecución
+    bool aplicadoEnCadena; ///< La última ejecución actuó sobre una cadena
+
+public:
+    /**
+     * @brief Constructor
+     * @param rotacion Rotación absoluta anunciada por el transmisor
+     */
+    PaqueteSincronizacion(int rotacion);
+
+    /**
+     * @brief Lleva el disco a la rotación indicada
+     * @param mensaje Puntero al mensaje (no usado)
+     * @param disco Disco a sincronizar
+     */
+    void ejecutar(MensajeDecodificado* mensaje, DiscoRotatorio* disco);
+
+    /**
+     * @brief Lleva el disco principal de la cadena a la rotación indicada
+     * @param mensaje Puntero al mensaje (no usado)
+     * @param cadena Cadena de rotores
+     */
+    void ejecutarEnCadena(MensajeDecodificado* mensaje, CadenaRotores* cadena);
+
+    /**
+     * @brief Obtiene el tipo de la trama
+     * @return 'S'
+     */
+    char obtenerTipo() const;
+
+    /**
+     * @brief Obtiene el valor transportado
+     * @return Rotación absoluta
+     */
+    int obtenerValor() const;
+
+    /**
+     * @brief Describe la trama y el efecto de su última ejecución
+     * @param destino Buffer donde se escribe el texto
+     * @param capacidad Tamaño del buffer
+     * @return Caracteres escritos (sin contar el '\0')
+     */
+    int describir(char* destino, int capacidad) const;
+};
+
+#endif // PAQUETE_SINCRONIZACION_H
@@ -0,0 +1,267 @@
+/**
+ * @file PlanificadorTramas.h
+ * @brief Codificador PRT-7: del texto claro a la secuencia de tramas
+ * @author Tu Nombre
+ * @date 2024
+ * 
+ * Es la operación inversa de DiscoRotatorio::obtenerCifrado: dado un
+ * texto y una política, decide qué tramas L, B, M y S enviar para
+ * que el decodificador reconstruya exactamente ese texto con el
+ * menor número de bytes.
+ */
+
+#ifndef PLANIFICADOR_TRAMAS_H
+#define PLANIFICADOR_TRAMAS_H
+
+#include <cstddef>
+
+/**
+ * @struct PoliticaCodificacion
+ * @brief Restricciones que debe respetar la secuencia generada
+ */
+struct PoliticaCodificacion
+{
+    int longitudMaximaBloque;     ///< Caracteres por trama B (1 = solo tramas L)
+    int letrasPorRotacion;        ///< Letras seguidas con la misma rotación (0 = sin límite)
+    const char* clave;            ///< Rotaciones a recorrer ('A' = 0, ...), o nullptr
+    bool incluirIntegridad;       ///< Añadir ",<seq>*<CRC>" a cada trama
+    int intervaloSincronizacion;  ///< Tramas entre dos tramas S (0 = nunca)
+
+    /**
+     * @brief Política por defecto: bloques completos, sin rotaciones
+     *        obligatorias, sin sufijo y sin sincronizaciones
+     */
+    PoliticaCodificacion();
+};
+
+/**
+ * @class PlanificadorTramas
+ * @brief Genera tramas PRT-7 para un texto claro
+ * 
+ * Las letras se cifran con tablas inversas de las del disco, así que
+ * cualquier cableado válido produce tramas que DiscoRotatorio
+ * decodifica al texto original.
+ * 
+ * El plan minimiza los bytes por programación dinámica sobre los
+ * puntos de rotación: entre dos rotaciones caben como mucho
+ * letrasPorRotacion letras, y el tramo se cubre con el menor número
+ * de tramas B. Así una rotación obligatoria cae en un corte de
+ * bloque que ya hacía falta siempre que eso ahorre bytes. El giro hacia la rotación elegida
+ * usa el valor con signo de menos dígitos ("M,-1" en lugar de
+ * "M,25"). El coste de cada trama incluye su sufijo y la parte
+ * proporcional de las tramas S; la longitud variable del número de
+ * secuencia y de los giros de una clave no se modela.
+ * 
+ * Sin sufijo de integridad el receptor recorta los espacios finales
+ * de cada línea y toma "*XX" al final como un CRC, por lo que ningún
+ * bloque termina en espacio ni, si tiene más de dos caracteres, en
+ * '*' seguido de dos caracteres que podrían cifrarse como dígitos
+ * hexadecimales. Con sufijo esas restricciones no existen.
+ * 
+ * El estado (rotación del receptor, secuencia, letras desde la
+ * última rotación) se conserva entre llamadas, de modo que un texto
+ * puede codificarse por partes; cada parte cierra su último bloque.
+ */
+class PlanificadorTramas
+{
+private:
+    PoliticaCodificacion politica;        ///< Restricciones en uso
+    unsigned char inversas[26][256];      ///< Byte a enviar por rotación y carácter claro
+    bool esLetra[256];                    ///< Caracteres que dependen de la rotación
+    int rotacionesClave[64];              ///< Rotaciones tomadas de las letras de la clave
+    int longitudClave;                    ///< Rotaciones de la clave (0 sin clave)
+    int indiceClave;                      ///< Siguiente rotación de la clave
+    int rotacion;                         ///< Rotación del disco del receptor
+    int letrasDesdeRotacion;              ///< Letras enviadas con la rotación actual
+    bool rotacionPendiente;               ///< Girar antes de la próxima letra
+    int secuencia;                        ///< Número de secuencia de la próxima trama
+    int tramasDesdeSincronizacion;        ///< Tramas desde la última trama S
+    long long tramasEmitidas;             ///< Tramas escritas (incluidas M y S)
+    long long rotacionesEmitidas;         ///< Tramas M escritas
+    long posicionError;                   ///< Carácter que impidió codificar, o -1
+
+    long long costeBloque;                ///< Peso de una trama L o B sin su contenido
+    long long costeRotacion;              ///< Peso de una trama M
+
+    // Tablas de trabajo de la última llamada, indexadas por posición
+    unsigned char* tipoFin;               ///< Si un bloque puede terminar antes de cada posición
+    size_t* ultimoFinLibre;               ///< Último final válido para cualquier bloque
+    size_t* siguienteFinCorto;            ///< Próximo final que solo admite un bloque corto
+    size_t* letrasHasta;                  ///< Letras antes de cada posición
+    size_t* posicionLetras;               ///< Posición de cada letra
+    long long* costeDesde;                ///< Menor coste desde una rotación en cada posición
+    long long* costeCorte;                ///< Coste de cerrar un tramo en cada final libre
+    size_t* siguienteRotacion;            ///< Fin del tramo elegido desde cada posición
+    size_t* mejorDeGrupo;                 ///< Final de menor coste en cada grupo de posiciones
+    size_t* alcancesTramo;                ///< Alcance con 1, 2, ... bloques en el tramo evaluado
+    size_t capacidadTrabajo;              ///< Posiciones que admiten las tablas
+
+    /**
+     * @brief Agrega el sufijo y el salto de línea a una trama ya escrita
+     * @param trama Cuerpo de la trama (ej: "M,-3"), seguido de espacio libre
+     * @param longitudCuerpo Bytes del cuerpo
+     * @return Bytes totales de la trama
+     */
+    size_t completarTrama(char* trama, int longitudCuerpo);
+
+    /**
+     * @brief Escribe una trama S si toca según la política
+     * @param destino Posición de escritura
+     * @return Bytes escritos (0 si no tocaba)
+     */
+    size_t contarTrama(char* destino);
+
+    /**
+     * @brief Gira el receptor hacia la siguiente rotación del plan
+     * @param destino Posición de escritura
+     * @return Bytes escritos
+     */
+    size_t rotar(char* destino);
+
+    /**
+     * @brief Comprueba que el texto pueda enviarse con la política
+     * @param texto Texto claro
+     * @param longitud Caracteres del texto
+     * @return Posición del primer carácter imposible, o -1 si es válido
+     */
+    long validar(const char* texto, size_t longitud) const;
+
+    /**
+     * @brief Llena las tablas de trabajo para un texto
+     * @param texto Texto claro
+     * @param longitud Caracteres del texto
+     */
+    void prepararTablas(const char* texto, size_t longitud);
+
+    /**
+     * @brief Final más lejano que alcanza un bloque
+     * @param desde Inicio del bloque
+     * @param tope Posición que el bloque no puede pasar
+     * @return Fin del bloque, o desde si ningún bloque es posible
+     */
+    size_t avanzar(size_t desde, size_t tope) const;
+
+    /**
+     * @brief Fija el coste de cerrar un tramo en una posición
+     * @param posicion Final libre, menor que todos los ya fijados
+     * @param coste Coste desde esa posición, rotación incluida
+     */
+    void fijarCosteCorte(size_t posicion, long long coste);
+
+    /**
+     * @brief Busca el final de menor coste en un intervalo
+     * @param desde Primera posición
+     * @param hasta Última posición
+     * @return Posición elegida (la más lejana ante empate)
+     */
+    size_t buscarMejorCorte(size_t desde, size_t hasta) const;
+
+    /**
+     * @brief Busca el mejor fin para un tramo sin rotaciones
+     * @param inicio Primer carácter del tramo
+     * @param longitud Caracteres del texto
+     * @param presupuesto Letras que admite el tramo
+     * @param mejorFin Recibe la posición donde conviene terminar el tramo
+     * @return Coste del tramo más el del resto del texto
+     */
+    long long evaluarTramo(size_t inicio, size_t longitud, size_t presupuesto, size_t* mejorFin);
+
+    /**
+     * @brief Escribe las tramas L y B de un tramo sin rotaciones
+     * @param texto Texto claro
+     * @param inicio Primer carácter del tramo
+     * @param fin Posición siguiente al último carácter
+     * @param destino Posición de escritura
+     * @return Bytes escritos
+     */
+    size_t escribirTramo(const char* texto, size_t inicio, size_t fin, char* destino);
+
+    /**
+     * @brief Escribe un bloque como trama L o B
+     * @param texto Texto claro
+     * @param inicio Primer carácter del bloque
+     * @param fin Posición siguiente al último carácter
+     * @param destino Posición de escritura
+     * @return Bytes escritos
+     */
+    size_t escribirBloque(const char* texto, size_t inicio, size_t fin, char* destino);
+
+public:
+    /**
+     * @brief Constructor
+     * @param politicaCodificacion Restricciones de la secuencia
+     * @param cableadoDisco Cableado del disco del receptor, o nullptr para A-Z
+     * 
+     * Los valores fuera de rango se ajustan: el bloque queda entre 1
+     * y LONGITUD_MAXIMA_BLOQUE. De la clave se usan sus primeras 64
+     * letras; una clave sin letras se ignora. Con clave, la primera
+     * rotación se aplica antes de la primera letra.
+     */
+    PlanificadorTramas(const PoliticaCodificacion& politicaCodificacion, const char* cableadoDisco);
+
+    /**
+     * @brief Destructor que libera las tablas de trabajo
+     */
+    ~PlanificadorTramas();
+
+    // Las tablas de trabajo son propias de cada planificador
+    PlanificadorTramas(const PlanificadorTramas&) = delete;
+    PlanificadorTramas& operator=(const PlanificadorTramas&) = delete;
+
+    /**
+     * @brief Cota de bytes que puede producir un texto con esta política
+     * @param longitud Caracteres del texto
+     * @return Capacidad que debe tener el destino de codificar()
+     */
+    size_t calcularCapacidadNecesaria(size_t longitud) const;
+
+    /**
+     * @brief Codifica un texto claro
+     * @param texto Caracteres a transmitir (sin '\n', '\r' ni '\0')
+     * @param longitud Número de caracteres
+     * @param destino Buffer para las tramas, separadas por '\n'
+     * @param capacidad Tamaño del buffer (al menos calcularCapacidadNecesaria())
+     * @return Bytes escritos, o -1 si el texto no puede enviarse o no cabe
+     * 
+     * Ante un error no se escribe nada y el estado no cambia;
+     * obtenerPosicionError() indica el carácter responsable (-1 si
+     * el problema fue la capacidad).
+     */
+    long codificar(const char* texto, size_t longitud, char* destino, size_t capacidad);
+
+    /**
+     * @brief Escribe la trama de fin de mensaje
+     * @param destino Buffer para la trama
+     * @param capacidad Tamaño del buffer (al menos 16 bytes)
+     * @return Bytes escritos, o -1 si no caben
+     * 
+     * La rotación del receptor se conserva para el mensaje siguiente.
+     */
+    long cerrar(char* destino, size_t capacidad);
+
+    /**
+     * @brief Obtiene la rotación que tendrá el receptor
+     * @return Rotación en [0, 26)
+     */
+    int obtenerRotacion() const;
+
+    /**
+     * @brief Obtiene las tramas escritas hasta ahora
+     * @return Total de tramas, incluidas las de rotación y sincronización
+     */
+    long long obtenerTramas() const;
+
+    /**
+     * @brief Obtiene las tramas de rotación escritas
+     * @return Total de tramas M
+     */
+    long long obtenerRotaciones() const;
+
+    /**
+     * @brief Obtiene el carácter que hizo fallar la última codificación
+     * @return Índice dentro del texto, o -1 si no hubo error
+     */
+    long obtenerPosicionError() const;
+};
+
+#endif // PLANIFICADOR_TRAMAS_H
@@ -0,0 +1,160 @@
+/**
+ * @file PoliticaFinalizacion.h
+ * @brief Políticas intercambiables para detectar el fin de una transmisión
+ * @author Tu Nombre
+ * @date 2024
+ * 
+ * La detección de fin de mensaje se evalúa sobre el paquete ya
+ * analizado, de modo que no es necesario volver a recorrer cada
+ * línea recibida. Cada política decide de forma independiente
+ * cuándo termina la sesión de decodificación.
+ */
+
+#ifndef POLITICA_FINALIZACION_H
+#define POLITICA_FINALIZACION_H
+
+#include "PaqueteBase.h"
+
+/**
+ * @class PoliticaFinalizacion
+ * @brief Interfaz abstracta para los criterios de fin de transmisión
+ */
+class PoliticaFinalizacion
+{
+public:
+    /**
+     * @brief Evalúa una trama recién procesada
+     * @param paquete Paquete ya ejecutado
+     * @param paquetesRecibidos Total de paquetes procesados, incluido este
+     * @return true si la transmisión debe darse por terminada
+     */
+    virtual bool evaluarTrama(const PaqueteBase& paquete, int paquetesRecibidos) = 0;
+
+    /**
+     * @brief Evalúa un periodo sin datos en el puerto
+     * @param milisegundosInactivo Tiempo transcurrido desde la última trama
+     * @return true si la transmisión debe darse por terminada
+     * 
+     * Por defecto la inactividad nunca termina la transmisión.
+     */
+    virtual bool evaluarInactividad(long milisegundosInactivo)
+    {
+        (void)milisegundosInactivo;
+        return false;
+    }
+
+    /**
+     * @brief Indica cada cuánto debe consultarse la inactividad
+     * @return Milisegundos, o -1 si la política no depende del tiempo
+     * 
+     * Permite al bucle de eventos dormir sin límite cuando la
+     * política solo reacciona a tramas.
+     */
+    virtual long obtenerLimiteInactividad() const
+    {
+        return -1;
+    }
+
+    /**
+     * @brief Destructor virtual para liberar políticas derivadas
+     */
+    virtual ~PoliticaFinalizacion() {}
+};
+
+/**
+ * @class FinalizacionPorTrama
+ * @brief Termina al recibir una trama explícita de fin (F)
+ */
+class FinalizacionPorTrama : public PoliticaFinalizacion
+{
+public:
+    bool evaluarTrama(const PaqueteBase& paquete, int paquetesRecibidos);
+};
+
+/**
+ * @class FinalizacionPorInactividad
+ * @brief Termina cuando el puerto permanece sin tramas un tiempo dado
+ */
+class FinalizacionPorInactividad : public PoliticaFinalizacion
+{
+private:
+    long limiteMilisegundos;  ///< Inactividad máxima tolerada
+
+public:
+    /**
+     * @brief Constructor
+     * @param limite Milisegundos sin tramas antes de finalizar
+     */
+    FinalizacionPorInactividad(long limite);
+
+    bool evaluarTrama(const PaqueteBase& paquete, int paquetesRecibidos);
+    bool evaluarInactividad(long milisegundosInactivo);
+    long obtenerLimiteInactividad() const;
+};
+
+/**
+ * @class FinalizacionPorConteo
+ * @brief Termina tras procesar un número fijo de tramas
+ */
+class FinalizacionPorConteo : public PoliticaFinalizacion
+{
+private:
+    int totalEsperado;  ///< Cantidad de tramas que forman la transmisión
+
+public:
+    /**
+     * @brief Constructor
+     * @param total Número de tramas tras el cual se finaliza
+     */
+    FinalizacionPorConteo(int total);
+
+    bool evaluarTrama(const PaqueteBase& paquete, int paquetesRecibidos);
+};
+
+/**
+ * @class FinalizacionPorCentinela
+ * @brief Termina al recibir una trama concreta (tipo y valor exactos)
+ * 
+ * Reproduce de forma explícita el antiguo indicador "M,-1" sin
+ * confundirlo con rotaciones negativas legítimas.
+ */
+class FinalizacionPorCentinela : public PoliticaFinalizacion
+{
+private:
+    char tipoCentinela;   ///< Tipo de la trama centinela
+    int valorCentinela;   ///< Valor de la trama centinela
+
+public:
+    /**
+     * @brief Constructor
+     * @param tipo Tipo de trama esperado ('L', 'M', ...)
+     * @param valor Valor exacto que debe transportar
+     */
+    FinalizacionPorCentinela(char tipo, int valor);
+
+    bool evaluarTrama(const PaqueteBase& paquete, int paquetesRecibidos);
+};
+
+/**
+ * @class FinalizacionContinua
+ * @brief Nunca finaliza; decodifica flujos continuos indefinidamente
+ */
+class FinalizacionContinua : public PoliticaFinalizacion
+{
+public:
+    bool evaluarTrama(const PaqueteBase& paquete, int paquetesRecibidos);
+};
+
+/**
+ * @brief Crea una política a partir de su especificación textual
+ * @param especificacion Texto con formato "trama", "inactividad:MS",
+ *                       "conteo:N", "centinela:T,V" o "continuo"
+ * @return Política creada con new, o nullptr si el texto no es válido
+ * 
+ * MS y N deben ser enteros decimales positivos, sin sufijos. En
+ * "centinela:T,V" el valor V es un solo carácter para T = L y un
+ * entero decimal para los demás tipos.
+ */
+PoliticaFinalizacion* crearPoliticaFinalizacion(const char* especificacion);
+
+#endif // POLITICA_FINALIZACION_H
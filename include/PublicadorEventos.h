@@ -0,0 +1,93 @@
+/**
+ * @file PublicadorEventos.h
+ * @brief Observador de sesión que publica en un anillo compartido
+ * @author Tu Nombre
+ * @date 2024
+ */
+
+#ifndef PUBLICADOR_EVENTOS_H
+#define PUBLICADOR_EVENTOS_H
+
+#include "SesionDecodificacion.h"
+#include "AnilloEventos.h"
+
+/**
+ * @class PublicadorEventos
+ * @brief Traduce los sucesos de una sesión a eventos del anillo
+ * 
+ * Se intercala delante de otro observador (por ejemplo, el de
+ * consola) y le reenvía todas las notificaciones, de modo que
+ * publicar no cambia lo que la sesión informa por otros medios.
+ */
+class PublicadorEventos : public ObservadorSesion
+{
+private:
+    AnilloEventos* anillo;        ///< Destino de los eventos
+    ObservadorSesion* siguiente;  ///< Observador al que se reenvía (o nullptr)
+    int ultimoPaquete;            ///< Tramas ejecutadas al último evento de trama
+
+public:
+    /**
+     * @brief Constructor
+     * @param anilloEventos Anillo donde publicar (no se libera)
+     * @param observadorSiguiente Observador al que reenviar, o nullptr
+     */
+    PublicadorEventos(AnilloEventos* anilloEventos, ObservadorSesion* observadorSiguiente);
+
+    /**
+     * @brief Publica la trama ejecutada ('L' con su carácter decodificado)
+     * @param paquete Paquete ejecutado
+     * @param paquetesRecibidos Tramas ejecutadas hasta ahora
+     * 
+     * Una trama B se publica como un evento 'L' por carácter.
+     */
+    void alEjecutarPaquete(const PaqueteBase& paquete, int paquetesRecibidos);
+
+    /**
+     * @brief Reenvía el descarte; no se publica
+     * @param linea Texto de la línea
+     * @param corrupta true si falló el CRC
+     */
+    void alDescartarLinea(const char* linea, bool corrupta);
+
+    /**
+     * @brief Publica un evento 'H'
+     * @param tramasPerdidas Tramas que faltan en la secuencia
+     */
+    void alDetectarHueco(int tramasPerdidas);
+
+    /**
+     * @brief Publica un evento 'Y' con la rotación sincronizada
+     * @param rotacionPrevia Rotación antes de la trama
+     * @param rotacionActual Rotación sincronizada
+     * @param caracteresAfectados Letras decodificadas con la rotación errónea
+     */
+    void alResincronizar(int rotacionPrevia, int rotacionActual, int caracteresAfectados);
+
+    /**
+     * @brief Reenvía el anuncio de perfil; no se publica
+     * @param velocidad Baudios anunciados
+     * @param controlFlujo true si el transmisor respeta RTS/CTS
+     * @param rafaga Tramas por ráfaga
+     * @return Lo que decida el observador siguiente (false sin él)
+     */
+    bool alAnunciarPerfil(long velocidad, bool controlFlujo, int rafaga);
+
+    /**
+     * @brief Publica un evento 'C' con las repeticiones
+     * @param texto Caracteres del ciclo
+     * @param longitud Cantidad de caracteres
+     * @param repeticiones Veces que se recibió el ciclo
+     * 
+     * Los caracteres del ciclo ya se publicaron la primera vez.
+     */
+    void alRepetirCiclo(const char* texto, int longitud, int repeticiones);
+
+    /**
+     * @brief Publica un evento 'X'
+     * @param porInactividad true si terminó por falta de datos
+     */
+    void alCompletarTransmision(bool porInactividad);
+};
+
+#endif // PUBLICADOR_EVENTOS_H
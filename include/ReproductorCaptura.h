@@ -0,0 +1,66 @@
+/**
+ * @file ReproductorCaptura.h
+ * @brief Lectura de archivos creados por GrabadorCaptura
+ * @author Tu Nombre
+ * @date 2024
+ */
+
+#ifndef REPRODUCTOR_CAPTURA_H
+#define REPRODUCTOR_CAPTURA_H
+
+#include "GrabadorCaptura.h"
+#include <cstdio>
+
+/**
+ * @class ReproductorCaptura
+ * @brief Recorre los registros de una captura en orden
+ * 
+ * Un registro final incompleto (por ejemplo, si el grabador se
+ * interrumpió) se trata como el final de la captura.
+ */
+class ReproductorCaptura
+{
+private:
+    std::FILE* archivo;            ///< Archivo de captura
+    CabeceraCaptura cabecera;      ///< Cabecera leída al abrir
+    bool valido;                   ///< La cabecera es de una captura PRT-7
+
+public:
+    /**
+     * @brief Constructor que abre la captura y valida su cabecera
+     * @param ruta Archivo de captura
+     */
+    ReproductorCaptura(const char* ruta);
+
+    /**
+     * @brief Destructor que cierra el archivo
+     */
+    ~ReproductorCaptura();
+
+    /**
+     * @brief Indica si la captura se abrió correctamente
+     * @return false si no existe o no es una captura PRT-7
+     */
+    bool estaOperativo() const;
+
+    /**
+     * @brief Obtiene el puerto en el que se grabó la captura
+     * @return Nombre guardado en la cabecera
+     */
+    const char* obtenerNombrePuerto() const;
+
+    /**
+     * @brief Lee el siguiente registro
+     * @param destino Buffer para la carga (al menos MAXIMA_CARGA_REGISTRO bytes)
+     * @param instante Recibe el instante de recepción en ns
+     * @param puerto Recibe el identificador del puerto
+     * @return Bytes de carga, o -1 al final de la captura
+     */
+    int leerRegistro(char* destino, unsigned long long* instante, unsigned short* puerto);
+
+    // El reproductor es dueño del archivo
+    ReproductorCaptura(const ReproductorCaptura&) = delete;
+    ReproductorCaptura& operator=(const ReproductorCaptura&) = delete;
+};
+
+#endif // REPRODUCTOR_CAPTURA_H
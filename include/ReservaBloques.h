@@ -0,0 +1,196 @@
+/**
+ * @file ReservaBloques.h
+ * @brief Reserva de bloques de tamaño fijo con lista libre
+ * @author Tu Nombre
+ * @date 2024
+ * 
+ * Permite reciclar objetos que se crean y destruyen continuamente
+ * (como los paquetes del protocolo) sin acudir al asignador general
+ * en cada trama.
+ */
+
+#ifndef RESERVA_BLOQUES_H
+#define RESERVA_BLOQUES_H
+
+#include <cstddef>
+#include <new>
+
+/**
+ * @struct BloqueLibre
+ * @brief Nodo de la lista simplemente enlazada de bloques libres
+ * 
+ * Se superpone a la memoria de un bloque que no está en uso.
+ */
+struct BloqueLibre
+{
+    BloqueLibre* siguiente;  ///< Siguiente bloque disponible
+};
+
+/**
+ * @struct LoteBloques
+ * @brief Segmento de memoria pedido al sistema que contiene varios bloques
+ */
+struct LoteBloques
+{
+    LoteBloques* siguiente;  ///< Lote pedido anteriormente
+};
+
+/**
+ * @class ReservaBloques
+ * @brief Asignador de bloques de tamaño fijo
+ * 
+ * Los bloques devueltos se enlazan en una lista libre y se entregan
+ * de nuevo en la siguiente petición. Solo se pide memoria al sistema
+ * cuando la lista libre se agota, y siempre en lotes de varios
+ * bloques. No es segura entre hilos: cada reserva debe usarse desde
+ * el hilo que decodifica.
+ */
+class ReservaBloques
+{
+private:
+    size_t tamanoBloque;        ///< Bytes por bloque (alineados)
+    int bloquesPorLote;         ///< Bloques creados en cada lote
+    BloqueLibre* listaLibre;    ///< Bloques disponibles para reutilizar
+    LoteBloques* lotes;         ///< Lotes pedidos al sistema
+    int bloquesEnUso;           ///< Bloques entregados y no devueltos
+    int reservasSistema;        ///< Lotes pedidos al asignador general
+    ReservaBloques* siguienteReserva;  ///< Siguiente reserva viva del programa
+
+    static ReservaBloques* primeraReserva;  ///< Lista de todas las reservas vivas
+
+    /**
+     * @brief Pide un nuevo lote al sistema y lo agrega a la lista libre
+     */
+    void crearLote();
+
+    /**
+     * @brief Calcula los bytes de un lote, encabezado incluido
+     * @return Tamaño pedido al sistema por cada lote
+     */
+    size_t calcularTamanoLote() const;
+
+public:
+    /**
+     * @brief Constructor
+     * @param tamano Tamaño de cada bloque en bytes
+     * @param porLote Bloques que se crean cada vez que se agota la lista
+     */
+    ReservaBloques(size_t tamano, int porLote);
+
+    /**
+     * @brief Destructor que libera todos los lotes
+     */
+    ~ReservaBloques();
+
+    /**
+     * @brief Entrega un bloque libre
+     * @return Puntero a un bloque de tamanoBloque bytes
+     */
+    void* obtener();
+
+    /**
+     * @brief Devuelve un bloque a la lista libre
+     * @param bloque Puntero obtenido previamente con obtener()
+     */
+    void liberar(void* bloque);
+
+    /**
+     * @brief Obtiene el tamaño de bloque atendido por esta reserva
+     * @return Bytes por bloque, ya redondeados a la alineación de punteros
+     */
+    size_t obtenerTamanoBloque() const;
+
+    /**
+     * @brief Obtiene la cantidad de bloques actualmente entregados
+     * @return Bloques en uso
+     */
+    int obtenerBloquesEnUso() const;
+
+    /**
+     * @brief Obtiene cuántas veces se pidió memoria al sistema
+     * @return Número de lotes creados
+     */
+    int obtenerReservasSistema() const;
+
+    /**
+     * @brief Suma los lotes pedidos por todas las reservas del programa
+     * @return Lotes creados por las reservas vivas
+     * 
+     * Cada reserva se anota en una lista al construirse, así que un
+     * tipo de paquete nuevo entra en la cuenta sin tocar al llamador.
+     * Las reservas de ConReserva se crean con el primer objeto: un tipo
+     * que aún no se usó no tiene lotes que sumar.
+     */
+    static int obtenerReservasSistemaTotales();
+
+private:
+    // La reserva es dueña de sus lotes: no se permite copiarla
+    ReservaBloques(const ReservaBloques&);
+    ReservaBloques& operator=(const ReservaBloques&);
+};
+
+/**
+ * @class ConReserva
+ * @brief Base que hace que una clase se reserve desde su propia ReservaBloques
+ * @tparam T Clase que hereda de ConReserva<T, Lote>
+ * @tparam Lote Bloques que se crean cada vez que se agota la reserva
+ * 
+ * Cada T tiene una única reserva, creada en el primer new. Las
+ * clases derivadas de T de mayor tamaño se atienden con el asignador
+ * general, igual que su delete.
+ */
+template <class T, size_t Lote>
+class ConReserva
+{
+private:
+    /**
+     * @brief Reserva compartida por todos los objetos de T
+     * @return Reserva creada en el primer uso
+     */
+    static ReservaBloques& reserva()
+    {
+        static ReservaBloques reservaClase(sizeof(T), (int)Lote);
+        return reservaClase;
+    }
+
+public:
+    /**
+     * @brief Obtiene memoria para el objeto desde la reserva de T
+     * @param tamano Bytes solicitados por new
+     * @return Bloque reciclado de la reserva
+     */
+    static void* operator new(size_t tamano)
+    {
+        if (tamano != sizeof(T))
+        {
+            return ::operator new(tamano);
+        }
+        return reserva().obtener();
+    }
+
+    /**
+     * @brief Devuelve la memoria del objeto a la reserva de T
+     * @param bloque Memoria del objeto destruido
+     * @param tamano Tamaño del objeto destruido
+     */
+    static void operator delete(void* bloque, size_t tamano)
+    {
+        if (tamano != sizeof(T))
+        {
+            ::operator delete(bloque);
+            return;
+        }
+        reserva().liberar(bloque);
+    }
+
+    /**
+     * @brief Acceso de solo lectura a la reserva de T
+     * @return Reserva que recicla los objetos de T
+     */
+    static const ReservaBloques& obtenerReserva()
+    {
+        return reserva();
+    }
+};
+
+#endif // RESERVA_BLOQUES_H
@@ -0,0 +1,173 @@
+/**
+ * @file ServidorIngesta.h
+ * @brief Recepción de flujos PRT-7 por sockets TCP o Unix
+ * @author Tu Nombre
+ * @date 2024
+ * 
+ * Los servidores de terminales reenvían cada puerto serial como una
+ * conexión TCP. El servidor escucha en un socket no bloqueante,
+ * acepta todas las conexiones pendientes en cada aviso del bucle de
+ * eventos y entrega cada una como un Transporte independiente.
+ */
+
+#ifndef SERVIDOR_INGESTA_H
+#define SERVIDOR_INGESTA_H
+
+#include "Transporte.h"
+#include "BucleEventos.h"
+
+/// Buffer de recepción pedido al núcleo para cada conexión
+const int TAMANO_RECEPCION_SOCKET = 4 * 1024 * 1024;
+
+/**
+ * @class ConexionSocket
+ * @brief Conexión aceptada por el servidor de ingesta
+ * 
+ * El descriptor es no bloqueante, de modo que la conexión puede
+ * registrarse en el bucle con disparo por flanco y leerse hasta
+ * agotarla.
+ */
+class ConexionSocket : public Transporte
+{
+private:
+    int descriptor;      ///< Socket conectado
+    char origen[128];    ///< Dirección del otro extremo, para los mensajes
+
+public:
+    /**
+     * @brief Constructor que adopta un socket ya aceptado
+     * @param descriptorAceptado Socket no bloqueante
+     * @param descripcionOrigen Dirección del otro extremo
+     */
+    ConexionSocket(int descriptorAceptado, const char* descripcionOrigen);
+
+    /**
+     * @brief Destructor que cierra el socket
+     */
+    ~ConexionSocket();
+
+    /**
+     * @brief Lee los bytes disponibles del socket
+     * @param destino Buffer donde se copian los bytes
+     * @param capacidad Tamaño del buffer
+     * @return Bytes leídos, 0 si no había datos, -1 si el otro extremo cerró
+     */
+    int leerDisponible(char* destino, int capacidad);
+
+    /**
+     * @brief Obtiene el socket para el bucle de eventos
+     * @return Descriptor del socket, o -1 si se cerró
+     */
+    int obtenerDescriptor() const;
+
+    /**
+     * @brief Verifica el estado de la conexión
+     * @return true mientras el socket siga abierto
+     */
+    bool estaOperativo();
+
+    /**
+     * @brief Obtiene la dirección del otro extremo
+     * @return "IP:puerto" para TCP o la ruta del socket Unix
+     */
+    const char* obtenerOrigen() const;
+
+    // La conexión es dueña de su socket: no se permite copiarla
+    ConexionSocket(const ConexionSocket&) = delete;
+    ConexionSocket& operator=(const ConexionSocket&) = delete;
+};
+
+/**
+ * @class ReceptorConexiones
+ * @brief Interfaz de quien atiende las conexiones aceptadas
+ */
+class ReceptorConexiones
+{
+public:
+    /**
+     * @brief Aviso de una conexión nueva
+     * @param conexion Conexión aceptada; el receptor pasa a ser su dueño
+     */
+    virtual void alAceptarConexion(ConexionSocket* conexion) = 0;
+
+    /**
+     * @brief Destructor virtual para liberar receptores derivados
+     */
+    virtual ~ReceptorConexiones() {}
+};
+
+/**
+ * @class ServidorIngesta
+ * @brief Socket de escucha atendido por el bucle de eventos
+ * 
+ * Especificaciones admitidas: "tcp:PUERTO" (todas las interfaces),
+ * "tcp:DIRECCION:PUERTO" y "unix:/ruta". El buffer de recepción se
+ * agranda en el socket de escucha para que las conexiones lo hereden
+ * antes de negociar la ventana TCP. Solo disponible en Linux.
+ */
+class ServidorIngesta : public FuenteEventos
+{
+private:
+    int descriptorEscucha;        ///< Socket de escucha (-1 si falló)
+    char rutaUnix[108];           ///< Ruta a borrar al cerrar ("" si es TCP)
+    ReceptorConexiones* receptor; ///< Destino de las conexiones aceptadas
+    int conexionesAceptadas;      ///< Conexiones entregadas al receptor
+
+    /**
+     * @brief Abre el socket de escucha TCP
+     * @param direccion Dirección IPv4 local, o nullptr para todas
+     * @param puerto Puerto TCP
+     * @return false si no pudo abrirse
+     */
+    bool escucharTcp(const char* direccion, int puerto);
+
+    /**
+     * @brief Abre el socket de escucha Unix
+     * @param ruta Ruta del socket; un archivo previo se reemplaza
+     * @return false si no pudo abrirse
+     */
+    bool escucharUnix(const char* ruta);
+
+public:
+    /**
+     * @brief Constructor que abre el socket de escucha
+     * @param especificacion "tcp:[DIRECCION:]PUERTO" o "unix:/ruta"
+     * @param receptorConexiones Destino de las conexiones aceptadas
+     */
+    ServidorIngesta(const char* especificacion, ReceptorConexiones* receptorConexiones);
+
+    /**
+     * @brief Destructor que cierra el socket y borra la ruta Unix
+     */
+    ~ServidorIngesta();
+
+    /**
+     * @brief Verifica si el servidor está escuchando
+     * @return true si el socket de escucha está abierto
+     */
+    bool estaOperativo() const;
+
+    /**
+     * @brief Obtiene las conexiones aceptadas
+     * @return Número de conexiones
+     */
+    int obtenerConexionesAceptadas() const;
+
+    /**
+     * @brief Obtiene el socket de escucha para el bucle de eventos
+     * @return Descriptor del socket, o -1 si no se abrió
+     */
+    int obtenerDescriptor() const;
+
+    /**
+     * @brief Acepta todas las conexiones pendientes
+     * @return Siempre true: el servidor sigue escuchando
+     */
+    bool alRecibirDatos();
+
+    // El servidor es dueño de su socket: no se permite copiarlo
+    ServidorIngesta(const ServidorIngesta&) = delete;
+    ServidorIngesta& operator=(const ServidorIngesta&) = delete;
+};
+
+#endif // SERVIDOR_INGESTA_H
@@ -0,0 +1,352 @@
+/**
+ * @file SesionDecodificacion.h
+ * @brief Núcleo de decodificación de un canal PRT-7, sin entrada/salida
+ * @author Tu Nombre
+ * @date 2024
+ * 
+ * Reúne las etapas de entramado y decodificación de un canal: recibe
+ * bloques de bytes, los separa en líneas, verifica su integridad,
+ * ejecuta los paquetes y aplica la política de fin. No escribe en
+ * consola ni abre archivos; quien la usa recibe los sucesos a través
+ * de un ObservadorSesion.
+ */
+
+#ifndef SESION_DECODIFICACION_H
+#define SESION_DECODIFICACION_H
+
+#include "MensajeDecodificado.h"
+#include "DiscoRotatorio.h"
+#include "CadenaRotores.h"
+#include "ControlIntegridad.h"
+#include "EnsambladorLineas.h"
+#include "CacheCiclos.h"
+#include "PoliticaFinalizacion.h"
+#include "PaqueteBase.h"
+#include <chrono>
+
+/**
+ * @class ObservadorSesion
+ * @brief Receptor de los sucesos de una sesión de decodificación
+ * 
+ * Todas las notificaciones tienen una implementación vacía, de modo
+ * que cada cliente redefine solo las que le interesan.
+ */
+class ObservadorSesion
+{
+public:
+    /**
+     * @brief Un paquete se ejecutó sobre el estado de la sesión
+     * @param paquete Paquete ejecutado (describir() refleja su efecto)
+     * @param paquetesRecibidos Tramas ejecutadas hasta ahora, incluida esta
+     */
+    virtual void alEjecutarPaquete(const PaqueteBase& paquete, int paquetesRecibidos)
+    {
+        (void)paquete;
+        (void)paquetesRecibidos;
+    }
+
+    /**
+     * @brief Una línea con forma de trama no se pudo usar
+     * @param linea Texto de la línea
+     * @param corrupta true si falló el CRC, false si no se pudo analizar
+     */
+    virtual void alDescartarLinea(const char* linea, bool corrupta)
+    {
+        (void)linea;
+        (void)corrupta;
+    }
+
+    /**
+     * @brief La numeración de las tramas saltó
+     * @param tramasPerdidas Tramas que faltan en la secuencia
+     */
+    virtual void alDetectarHueco(int tramasPerdidas)
+    {
+        (void)tramasPerdidas;
+    }
+
+    /**
+     * @brief Una trama S corrigió la rotación del disco
+     * @param rotacionPrevia Rotación antes de la trama
+     * @param rotacionActual Rotación sincronizada
+     * @param caracteresAfectados Letras decodificadas con la rotación errónea
+     */
+    virtual void alResincronizar(int rotacionPrevia, int rotacionActual, int caracteresAfectados)
+    {
+        (void)rotacionPrevia;
+        (void)rotacionActual;
+        (void)caracteresAfectados;
+    }
+
+    /**
+     * @brief El transmisor anunció un perfil de transporte
+     * @param velocidad Baudios anunciados
+     * @param controlFlujo true si el transmisor respeta RTS/CTS
+     * @param rafaga Tramas por ráfaga (0 = sin pausas)
+     * @return true si el perfil se aplicó al medio de transporte
+     * 
+     * Al aplicarse, los bytes pendientes se descartan porque se
+     * recibieron con la configuración anterior.
+     */
+    virtual bool alAnunciarPerfil(long velocidad, bool controlFlujo, int rafaga)
+    {
+        (void)velocidad;
+        (void)controlFlujo;
+        (void)rafaga;
+        return false;
+    }
+
+    /**
+     * @brief Un ciclo completo coincidió con uno ya decodificado
+     * @param texto Caracteres que produjo el ciclo (no terminados en '\0')
+     * @param longitud Cantidad de caracteres
+     * @param repeticiones Veces que se recibió el ciclo, incluida la original
+     * 
+     * Las tramas del ciclo repetido no se notifican una a una y sus
+     * caracteres no se agregan otra vez al mensaje.
+     */
+    virtual void alRepetirCiclo(const char* texto, int longitud, int repeticiones)
+    {
+        (void)texto;
+        (void)longitud;
+        (void)repeticiones;
+    }
+
+    /**
+     * @brief La política de fin dio la transmisión por terminada
+     * @param porInactividad true si terminó por falta de datos
+     */
+    virtual void alCompletarTransmision(bool porInactividad)
+    {
+        (void)porInactividad;
+    }
+
+    /**
+     * @brief Destructor virtual para liberar observadores derivados
+     */
+    virtual ~ObservadorSesion() {}
+};
+
+/**
+ * @class SesionDecodificacion
+ * @brief Estado y etapas de decodificación de un canal
+ * 
+ * La sesión es dueña del mensaje, del disco (o de la cadena de
+ * rotores), del control de integridad y del ensamblador de líneas.
+ * La política de fin y el observador pertenecen a quien la crea.
+ */
+class SesionDecodificacion
+{
+private:
+    MensajeDecodificado mensaje;        ///< Mensaje en construcción
+    DiscoRotatorio disco;               ///< Disco de un solo rotor
+    CadenaRotores* cadena;              ///< Cadena de rotores (o nullptr)
+    ControlIntegridad integridad;       ///< Secuencia y CRC de las tramas
+    EnsambladorLineas ensamblador;      ///< Etapa de entramado
+    PoliticaFinalizacion* politicaFin;  ///< Criterio de fin de transmisión
+    ObservadorSesion observadorNulo;    ///< Observador usado por defecto
+    ObservadorSesion* observador;       ///< Receptor de los sucesos
+    CacheCiclos* cache;                 ///< Ciclos ya decodificados (o nullptr)
+
+    bool transmisionCompleta;           ///< La política dio la transmisión por terminada
+    int paquetesRecibidos;              ///< Tramas ejecutadas
+    int cambiosPerfil;                  ///< Perfiles aplicados durante la sesión
+    long long bytesRecibidos;           ///< Bytes entregados a la sesión
+    long long bytesUtiles;              ///< Bytes de tramas válidas
+    int tramasMalformadas;              ///< Tramas con tipo conocido que no se pudieron analizar
+    int lineasIgnoradas;                ///< Líneas que no son tramas (avisos, ruido)
+    std::chrono::steady_clock::time_point primeraTrama;  ///< Llegada de la primera trama válida
+    std::chrono::steady_clock::time_point ultimaTrama;   ///< Llegada de la última trama válida
+
+public:
+    /**
+     * @brief Constructor
+     * @param politica Criterio de fin (no se libera con la sesión)
+     * @param cantidadRotores Rotores de la cadena; con 1 y sin avance se usa el disco
+     * @param avanceRotores true para el avance tipo odómetro tras cada letra
+     * @param exigirIntegridad true si el sufijo ",<seq>*<CRC>" es obligatorio
+     */
+    SesionDecodificacion(PoliticaFinalizacion* politica, int cantidadRotores,
+                         bool avanceRotores, bool exigirIntegridad);
+
+    /**
+     * @brief Destructor que libera la cadena de rotores
+     */
+    ~SesionDecodificacion();
+
+    /**
+     * @brief Establece el receptor de los sucesos
+     * @param nuevoObservador Observador, o nullptr para no notificar
+     */
+    void establecerObservador(ObservadorSesion* nuevoObservador);
+
+    /**
+     * @brief Activa el reconocimiento de ciclos repetidos
+     * @param maximoCiclos Ciclos distintos que se recuerdan
+     * @param maximoTramas Longitud máxima, en tramas, de un ciclo recordado
+     * @return false con cadena de rotores (el avance depende de cada letra)
+     * 
+     * Cada ciclo termina en una trama F. Los ciclos idénticos a uno
+     * anterior, partiendo de la misma rotación, se reconocen mientras
+     * llegan: sus tramas L no se decodifican ni se almacenan y el
+     * observador recibe alRepetirCiclo() en su lugar.
+     */
+    bool activarDeduplicacion(int maximoCiclos, int maximoTramas);
+
+    /**
+     * @brief Acceso a la caché de ciclos
+     * @return Caché, o nullptr si la deduplicación no está activa
+     */
+    const CacheCiclos* obtenerCache() const;
+
+    /**
+     * @brief Etapa de decodificación: analiza y ejecuta una línea
+     * @param linea Línea sin salto de línea (se modifica in-place)
+     */
+    void procesarLinea(char* linea);
+
+    /**
+     * @brief Decodifica un bloque de bytes de cualquier tamaño
+     * @param datos Bytes recibidos
+     * @param cantidad Número de bytes
+     * 
+     * Reparte el bloque en tramos que quepan en el ensamblador y
+     * procesa las líneas completas tras cada tramo. Se detiene si
+     * la transmisión termina a mitad del bloque.
+     */
+    void decodificarBloque(const char* datos, int cantidad);
+
+    /**
+     * @brief Obtiene espacio para leer directamente en el ensamblador
+     * @param disponible Recibe los bytes que caben
+     * @return Puntero donde el lector puede escribir
+     * 
+     * Evita la copia de decodificarBloque(); tras leer hay que
+     * llamar a confirmarRecepcion().
+     */
+    char* reservarEspacio(int* disponible);
+
+    /**
+     * @brief Procesa los bytes escritos tras reservarEspacio()
+     * @param cantidad Bytes escritos
+     */
+    void confirmarRecepcion(int cantidad);
+
+    /**
+     * @brief Consulta a la política tras un periodo sin datos
+     * @param milisegundosInactivo Tiempo desde la última llegada
+     */
+    void procesarInactividad(long milisegundosInactivo);
+
+    /**
+     * @brief Indica si la política dio la transmisión por terminada
+     * @return true si no deben procesarse más datos
+     */
+    bool estaCompleta() const;
+
+    /**
+     * @brief Obtiene el límite de inactividad de la política
+     * @return Milisegundos, o -1 si no hay límite
+     */
+    long obtenerLimiteInactividad() const;
+
+    /**
+     * @brief Acceso al mensaje decodificado
+     * @return Mensaje de la sesión
+     */
+    MensajeDecodificado& obtenerMensaje();
+
+    /**
+     * @brief Acceso de solo lectura al mensaje decodificado
+     * @return Mensaje de la sesión
+     */
+    const MensajeDecodificado& obtenerMensaje() const;
+
+    /**
+     * @brief Acceso al disco de un solo rotor
+     * @return Disco de la sesión
+     */
+    DiscoRotatorio& obtenerDisco();
+
+    /**
+     * @brief Acceso a la cadena de rotores
+     * @return Cadena, o nullptr si se decodifica con un solo disco
+     */
+    const CadenaRotores* obtenerCadena() const;
+
+    /**
+     * @brief Acceso al control de integridad
+     * @return Contadores de secuencia y CRC
+     */
+    const ControlIntegridad& obtenerIntegridad() const;
+
+    /**
+     * @brief Obtiene las tramas ejecutadas
+     * @return Número de paquetes
+     */
+    int obtenerPaquetesRecibidos() const;
+
+    /**
+     * @brief Fija el contador de tramas al restaurar un estado guardado
+     * @param cantidad Tramas ya ejecutadas
+     */
+    void establecerPaquetesRecibidos(int cantidad);
+
+    /**
+     * @brief Obtiene los perfiles de transporte aplicados
+     * @return Número de cambios de perfil
+     */
+    int obtenerCambiosPerfil() const;
+
+    /**
+     * @brief Obtiene los bytes entregados a la sesión
+     * @return Bytes recibidos
+     */
+    long long obtenerBytesRecibidos() const;
+
+    /**
+     * @brief Obtiene los bytes que formaban tramas válidas
+     * @return Bytes útiles (incluido el salto de línea)
+     */
+    long long obtenerBytesUtiles() const;
+
+    /**
+     * @brief Obtiene las tramas que no se pudieron analizar
+     * @return Tramas malformadas, incluidas las que excedieron el ensamblador
+     */
+    int obtenerTramasMalformadas() const;
+
+    /**
+     * @brief Obtiene las líneas que no eran tramas
+     * @return Líneas ignoradas
+     */
+    int obtenerLineasIgnoradas() const;
+
+    /**
+     * @brief Tiempo entre la primera y la última trama válida
+     * @return Segundos (0 si hubo menos de dos tramas)
+     */
+    double obtenerSegundosActivos() const;
+
+    // La sesión es dueña de su estado: no se permite copiarla
+    SesionDecodificacion(const SesionDecodificacion&) = delete;
+    SesionDecodificacion& operator=(const SesionDecodificacion&) = delete;
+
+private:
+    /**
+     * @brief Procesa las líneas completas del ensamblador
+     */
+    void procesarLineasCompletas();
+
+    /**
+     * @brief Pasa una trama por la caché de ciclos
+     * @param texto Trama sin espacios ni sufijo de integridad
+     * @return true si la trama pertenece a un ciclo conocido
+     * 
+     * Si la especulación acaba de fallar, agrega al mensaje los
+     * caracteres que se habían omitido.
+     */
+    bool registrarEnCache(const char* texto);
+};
+
+#endif // SESION_DECODIFICACION_H
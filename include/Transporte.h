@@ -0,0 +1,65 @@
+/**
+ * @file Transporte.h
+ * @brief Interfaz común de los medios por los que llegan los bytes PRT-7
+ * @author Tu Nombre
+ * @date 2024
+ * 
+ * Un puerto serial y una conexión de red entregan lo mismo: un flujo
+ * de bytes sin delimitar. La sesión de decodificación solo necesita
+ * leer lo disponible, así que ambos medios se atienden igual desde el
+ * bucle de eventos.
+ */
+
+#ifndef TRANSPORTE_H
+#define TRANSPORTE_H
+
+/**
+ * @class Transporte
+ * @brief Flujo de entrada no bloqueante
+ */
+class Transporte
+{
+public:
+    /**
+     * @brief Lee los bytes disponibles sin esperar a una línea completa
+     * @param destino Buffer donde se copian los bytes
+     * @param capacidad Tamaño del buffer
+     * @return Bytes leídos, 0 si no había datos, -1 si el flujo terminó o falló
+     */
+    virtual int leerDisponible(char* destino, int capacidad) = 0;
+
+    /**
+     * @brief Obtiene el descriptor para un bucle de eventos
+     * @return Descriptor POSIX, o -1 si no existe
+     */
+    virtual int obtenerDescriptor() const = 0;
+
+    /**
+     * @brief Verifica el estado del flujo
+     * @return true si está abierto y funcional
+     */
+    virtual bool estaOperativo() = 0;
+
+    /**
+     * @brief Cambia el perfil de transporte anunciado por el transmisor
+     * @param velocidad Baudios
+     * @param usarControlFlujo true para activar RTS/CTS por hardware
+     * @return false si el medio no tiene perfil que cambiar
+     * 
+     * Por defecto no hace nada: en una conexión de red el perfil del
+     * enlace serial lo aplica el servidor de terminales.
+     */
+    virtual bool configurarPerfil(long velocidad, bool usarControlFlujo)
+    {
+        (void)velocidad;
+        (void)usarControlFlujo;
+        return false;
+    }
+
+    /**
+     * @brief Destructor virtual para liberar transportes derivados
+     */
+    virtual ~Transporte() {}
+};
+
+#endif // TRANSPORTE_H
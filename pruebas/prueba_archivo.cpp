@@ -0,0 +1,305 @@
+/**
+ * @file prueba_archivo.cpp
+ * @brief Ida y vuelta por un archivo de tramas y archivos dañados
+ * @author Tu Nombre
+ * @date 2024
+ * 
+ * Codifica un texto pseudoaleatorio con PlanificadorTramas (tramas L,
+ * B, M y S, con y sin sufijo de integridad, con avisos de consola y
+ * una línea corrupta intercalados), lo decodifica como texto mientras
+ * ArchivadorTramas lo guarda, y comprueba que DecodificadorArchivo
+ * reproduzca el mismo mensaje con uno y con varios hilos.
+ * 
+ * Después trunca el archivo en distintos puntos y altera sus
+ * cabeceras y cuerpos: cada copia debe rechazarse al abrirla o al
+ * decodificarla, nunca dar un mensaje de la longitud esperada. El
+ * formato no lleva suma de control, así que no se prueban los daños
+ * que solo cambian letras: un byte de letra sustituido, o una
+ * rotación inicial alterada cuando una trama S del mismo bloque
+ * devuelve el disco a su rotación antes del final.
+ */
+
+#include "ArchivadorTramas.h"
+#include "DecodificadorArchivo.h"
+#include "PlanificadorTramas.h"
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+/// Caracteres de texto claro por mensaje codificado
+static const int CARACTERES_POR_MENSAJE = 300;
+
+/// Mensajes del flujo: bastan para varios bloques del archivo
+static const int MENSAJES = 600;
+
+/// Estado del generador pseudoaleatorio (reproducible entre ejecuciones)
+static unsigned int semilla = 99u;
+
+/**
+ * @brief Generador congruencial lineal
+ * @param limite Cota superior exclusiva
+ * @return Número en [0, limite)
+ */
+static int aleatorio(int limite)
+{
+    semilla = semilla * 1103515245u + 12345u;
+    return (int)((semilla >> 8) % (unsigned int)limite);
+}
+
+/**
+ * @brief Genera el flujo de líneas a partir de mensajes aleatorios
+ * @param integridad true para agregar el sufijo ",<seq>*<CRC>"
+ * @param texto Recibe el texto claro de todos los mensajes
+ * @return Flujo PRT-7 con avisos de consola intercalados
+ */
+static std::string generarFlujo(bool integridad, std::string* texto)
+{
+    PoliticaCodificacion politica;
+    politica.longitudMaximaBloque = 6;
+    politica.letrasPorRotacion = 5;
+    politica.clave = "PRTSIETE";
+    politica.incluirIntegridad = integridad;
+    politica.intervaloSincronizacion = 40;
+    PlanificadorTramas planificador(politica, nullptr);
+
+    std::string flujo;
+    std::string tramas(planificador.calcularCapacidadNecesaria(CARACTERES_POR_MENSAJE), '\0');
+    for (int mensaje = 0; mensaje < MENSAJES; mensaje++)
+    {
+        char claro[CARACTERES_POR_MENSAJE];
+        for (int indice = 0; indice < CARACTERES_POR_MENSAJE; indice++)
+        {
+            int tipo = aleatorio(10);
+            if (tipo < 6)
+                claro[indice] = (char)('A' + aleatorio(26));
+            else if (tipo < 8)
+                claro[indice] = (char)('a' + aleatorio(26));
+            else
+                claro[indice] = ".,0123456789"[aleatorio(12)];
+        }
+        long escritos = planificador.codificar(claro, CARACTERES_POR_MENSAJE, &tramas[0], tramas.size());
+        if (escritos < 0)
+            return std::string();
+        flujo.append(tramas, 0, (size_t)escritos);
+        texto->append(claro, CARACTERES_POR_MENSAJE);
+
+        // Líneas que la sesión descarta y el archivo no debe conservar
+        if (mensaje % 50 == 0)
+            flujo += "Sistema listo\n";
+        if (mensaje % 120 == 7)
+            flujo += "L,A,0*00\n";
+    }
+    return flujo;
+}
+
+/**
+ * @brief Lee un archivo completo
+ * @param ruta Archivo a leer
+ * @return Contenido (vacío si no se pudo leer)
+ */
+static std::string leerArchivo(const char* ruta)
+{
+    std::string contenido;
+    std::FILE* archivo = std::fopen(ruta, "rb");
+    if (archivo == nullptr)
+        return contenido;
+    char buffer[65536];
+    size_t leidos;
+    while ((leidos = std::fread(buffer, 1, sizeof(buffer), archivo)) > 0)
+    {
+        contenido.append(buffer, leidos);
+    }
+    std::fclose(archivo);
+    return contenido;
+}
+
+/**
+ * @brief Escribe un archivo completo
+ * @param ruta Archivo a crear
+ * @param contenido Bytes a escribir
+ * @return false si falló la escritura
+ */
+static bool escribirArchivo(const char* ruta, const std::string& contenido)
+{
+    std::FILE* archivo = std::fopen(ruta, "wb");
+    if (archivo == nullptr)
+        return false;
+    bool escrito = contenido.empty() ||
+                   std::fwrite(contenido.data(), 1, contenido.size(), archivo) == contenido.size();
+    return (std::fclose(archivo) == 0) && escrito;
+}
+
+/**
+ * @brief Archiva un flujo y lo decodifica desde el archivo con varios hilos
+ * @param integridad true si el flujo lleva sufijo de integridad
+ * @param ruta Archivo de tramas a crear
+ * @return true si el archivo reproduce el mensaje del texto
+ */
+static bool probarIdaYVuelta(bool integridad, const char* ruta)
+{
+    std::string claro;
+    std::string flujo = generarFlujo(integridad, &claro);
+    if (flujo.empty())
+    {
+        std::printf("Integridad %s: el planificador rechazo un mensaje\n", integridad ? "si" : "no");
+        return false;
+    }
+
+    PoliticaFinalizacion* politica = crearPoliticaFinalizacion("continuo");
+    std::string referencia;
+    int rotacionTexto;
+    int bloques;
+    bool archivado;
+    {
+        SesionDecodificacion sesion(politica, 1, false, integridad);
+        ArchivadorTramas archivador(ruta, &sesion, nullptr);
+        sesion.establecerObservador(&archivador);
+        sesion.decodificarBloque(flujo.data(), (int)flujo.size());
+        archivado = archivador.cerrar();
+        bloques = archivador.obtenerBloques();
+
+        const MensajeDecodificado& mensaje = sesion.obtenerMensaje();
+        referencia.assign((size_t)mensaje.obtenerLongitud(), '\0');
+        if (!referencia.empty())
+            mensaje.copiarDesde(0, &referencia[0], mensaje.obtenerLongitud());
+        rotacionTexto = sesion.obtenerDisco().obtenerDesplazamiento();
+    }
+    delete politica;
+
+    bool correcto = archivado && bloques >= 3 && referencia == claro;
+    const int HILOS[] = { 1, 4, 0 };
+    for (int indice = 0; correcto && indice < (int)(sizeof(HILOS) / sizeof(HILOS[0])); indice++)
+    {
+        DecodificadorArchivo decodificador(ruta);
+        std::string salida((size_t)(decodificador.estaOperativo() ? decodificador.obtenerCaracteres() : 0), '\0');
+        long long caracteres = decodificador.estaOperativo()
+            ? decodificador.decodificar(salida.empty() ? nullptr : &salida[0], HILOS[indice]) : -1;
+        correcto = (caracteres == (long long)referencia.size() && salida == referencia &&
+                    decodificador.obtenerRotacionFinal() == rotacionTexto);
+    }
+
+    std::printf("Ida y vuelta, integridad %s: %zu caracteres en %d bloques -> %s\n",
+                integridad ? "si" : "no", referencia.size(), bloques, correcto ? "OK" : "FALLO");
+    return correcto;
+}
+
+/**
+ * @brief Comprueba que una copia dañada del archivo se rechace
+ * @param ruta Archivo temporal para la copia
+ * @param contenido Bytes de la copia
+ * @param longitudEsperada Caracteres del archivo íntegro
+ * @param descripcion Daño aplicado, para el informe
+ * @return true si la copia no se abre o su decodificación falla
+ */
+static bool probarRechazo(const char* ruta, const std::string& contenido,
+                          long long longitudEsperada, const char* descripcion)
+{
+    bool rechazado = false;
+    if (!escribirArchivo(ruta, contenido))
+    {
+        std::printf("%s: no se pudo escribir la copia\n", descripcion);
+        return false;
+    }
+
+    DecodificadorArchivo decodificador(ruta);
+    if (!decodificador.estaOperativo())
+    {
+        rechazado = true;
+    }
+    else
+    {
+        std::string salida((size_t)decodificador.obtenerCaracteres() + 1, '\0');
+        long long caracteres = decodificador.decodificar(&salida[0], 4);
+        rechazado = (caracteres < 0 || caracteres != longitudEsperada);
+    }
+    std::printf("%s: %s\n", descripcion, rechazado ? "OK" : "FALLO (aceptado)");
+    return rechazado;
+}
+
+/**
+ * @brief Trunca y altera un archivo íntegro
+ * @param ruta Archivo íntegro
+ * @param rutaDanada Archivo temporal para las copias
+ * @return true si todas las copias se rechazan
+ */
+static bool probarArchivosDanados(const char* ruta, const char* rutaDanada)
+{
+    std::string original = leerArchivo(ruta);
+    if (original.size() < sizeof(CabeceraArchivo) + 2 * sizeof(CabeceraBloqueArchivo))
+    {
+        std::printf("Archivo de %zu bytes: demasiado corto\n", original.size());
+        return false;
+    }
+
+    CabeceraArchivo cabecera;
+    std::memcpy(&cabecera, original.data(), sizeof(cabecera));
+    long long caracteres = cabecera.caracteres;
+
+    // Posiciones de las cabeceras de los dos primeros bloques
+    size_t primerBloque = sizeof(CabeceraArchivo);
+    CabeceraBloqueArchivo bloque;
+    std::memcpy(&bloque, original.data() + primerBloque, sizeof(bloque));
+    size_t segundoBloque = primerBloque + sizeof(bloque) + bloque.bytesCuerpo;
+    size_t cuerpoSegundo = segundoBloque + sizeof(CabeceraBloqueArchivo);
+
+    bool correcto = true;
+
+    // Truncados: sin cabecera completa, a mitad de una cabecera de bloque, a mitad de un cuerpo
+    const size_t cortes[] = { 0, sizeof(CabeceraArchivo) - 1, primerBloque + sizeof(bloque) / 2,
+                              primerBloque + sizeof(bloque) + bloque.bytesCuerpo / 2,
+                              original.size() / 2, original.size() - 1 };
+    for (int indice = 0; indice < (int)(sizeof(cortes) / sizeof(cortes[0])); indice++)
+    {
+        char descripcion[64];
+        std::snprintf(descripcion, sizeof(descripcion), "Truncado a %zu bytes", cortes[indice]);
+        correcto = probarRechazo(rutaDanada, original.substr(0, cortes[indice]),
+                                 caracteres, descripcion) && correcto;
+    }
+    correcto = probarRechazo(rutaDanada, original + '\0', caracteres, "Byte sobrante al final") && correcto;
+
+    std::string danado = original;
+    danado[0] = 'X';
+    correcto = probarRechazo(rutaDanada, danado, caracteres, "Marca alterada") && correcto;
+
+    danado = original;
+    CabeceraBloqueArchivo alterado = bloque;
+    alterado.bytesCuerpo += 1;
+    std::memcpy(&danado[primerBloque], &alterado, sizeof(alterado));
+    correcto = probarRechazo(rutaDanada, danado, caracteres, "Cuerpo del bloque 0 mas largo") && correcto;
+
+    danado = original;
+    alterado = bloque;
+    alterado.caracteres += 1;
+    std::memcpy(&danado[primerBloque], &alterado, sizeof(alterado));
+    correcto = probarRechazo(rutaDanada, danado, caracteres, "Caracteres del bloque 0 alterados") && correcto;
+
+    danado = original;
+    alterado = bloque;
+    alterado.rotacionFinal = (unsigned char)((alterado.rotacionFinal + 1) % 26);
+    std::memcpy(&danado[primerBloque], &alterado, sizeof(alterado));
+    correcto = probarRechazo(rutaDanada, danado, caracteres, "Rotacion final del bloque 0 alterada") && correcto;
+
+    danado = original;
+    danado[cuerpoSegundo] = (char)(0xE0 | (danado[cuerpoSegundo] & 0x1F));
+    correcto = probarRechazo(rutaDanada, danado, caracteres, "Tipo de tramo desconocido en el bloque 1") && correcto;
+
+    danado = original;
+    danado[cuerpoSegundo] = (char)(danado[cuerpoSegundo] ^ 0x01);
+    correcto = probarRechazo(rutaDanada, danado, caracteres, "Cantidad de tramo alterada en el bloque 1") && correcto;
+
+    return correcto;
+}
+
+int main()
+{
+    const char* ruta = "prueba_archivo.arc";
+    const char* rutaDanada = "prueba_archivo_danado.arc";
+
+    bool sinSufijo = probarIdaYVuelta(false, ruta);
+    bool conSufijo = probarIdaYVuelta(true, ruta);
+    bool danados = conSufijo && probarArchivosDanados(ruta, rutaDanada);
+
+    std::remove(ruta);
+    std::remove(rutaDanada);
+    return (sinSufijo && conSufijo && danados) ? 0 : 1;
+}
@@ -0,0 +1,172 @@
+/**
+ * @file prueba_asignaciones.cpp
+ * @brief Prueba de que la decodificación estable no usa el asignador general
+ * @author Tu Nombre
+ * @date 2024
+ * 
+ * Sustituye los operator new/delete globales por versiones que
+ * cuentan las llamadas. Tras calentar una SesionDecodificacion con
+ * todos los tipos de trama (L, M, R, S, B y F), decodifica un flujo
+ * largo y comprueba que las únicas reservas globales son los
+ * fragmentos nuevos del mensaje, que crece con el texto. Los paquetes
+ * salen de sus reservas de bloques, que ya tienen lotes libres.
+ */
+
+#include "SesionDecodificacion.h"
+#include "PoliticaFinalizacion.h"
+#include "ContabilidadMemoria.h"
+#include "ControlIntegridad.h"
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+/// Llamadas al operator new global desde el último reinicio
+static long long asignacionesGlobales = 0;
+
+void* operator new(std::size_t tamano)
+{
+    asignacionesGlobales++;
+    void* bloque = std::malloc(tamano > 0 ? tamano : 1);
+    if (bloque == nullptr)
+        throw std::bad_alloc();
+    return bloque;
+}
+
+void* operator new[](std::size_t tamano)
+{
+    return ::operator new(tamano);
+}
+
+void* operator new(std::size_t tamano, const std::nothrow_t&) noexcept
+{
+    asignacionesGlobales++;
+    return std::malloc(tamano > 0 ? tamano : 1);
+}
+
+void* operator new[](std::size_t tamano, const std::nothrow_t&) noexcept
+{
+    return ::operator new(tamano, std::nothrow);
+}
+
+void operator delete(void* bloque) noexcept
+{
+    std::free(bloque);
+}
+
+void operator delete[](void* bloque) noexcept
+{
+    std::free(bloque);
+}
+
+void operator delete(void* bloque, std::size_t) noexcept
+{
+    std::free(bloque);
+}
+
+void operator delete[](void* bloque, std::size_t) noexcept
+{
+    std::free(bloque);
+}
+
+void operator delete(void* bloque, const std::nothrow_t&) noexcept
+{
+    std::free(bloque);
+}
+
+void operator delete[](void* bloque, const std::nothrow_t&) noexcept
+{
+    std::free(bloque);
+}
+
+/// Ciclo del transmisor con todos los tipos de trama
+static const char* const CICLO_TRAMAS[] = {
+    "L,H", "M,3", "L,o", "R,0,-2", "B,HOLA MUNDO", "S,7", "L,!", "M,-30", "B,xyz", "F,0"
+};
+
+/// Tramas por ciclo
+static const int TRAMAS_CICLO = (int)(sizeof(CICLO_TRAMAS) / sizeof(CICLO_TRAMAS[0]));
+
+/**
+ * @brief Escribe un ciclo de tramas en un buffer
+ * @param destino Buffer de salida
+ * @param capacidad Tamaño del buffer
+ * @param conIntegridad true para agregar ",<seq>*<CRC>" a cada trama
+ * @param secuencia Número de secuencia de la primera trama (avanza)
+ * @return Bytes escritos
+ */
+static int escribirCiclo(char* destino, int capacidad, bool conIntegridad, int& secuencia)
+{
+    int longitud = 0;
+    for (int indice = 0; indice < TRAMAS_CICLO; indice++)
+    {
+        if (conIntegridad)
+        {
+            char conSecuencia[48];
+            int base = std::snprintf(conSecuencia, sizeof(conSecuencia), "%s,%d",
+                                     CICLO_TRAMAS[indice], secuencia);
+            secuencia = (secuencia + 1) % 256;
+            longitud += std::snprintf(destino + longitud, capacidad - longitud, "%s*%02X\n",
+                                      conSecuencia, ControlIntegridad::calcularCrc(conSecuencia, base));
+        }
+        else
+        {
+            longitud += std::snprintf(destino + longitud, capacidad - longitud, "%s\n",
+                                      CICLO_TRAMAS[indice]);
+        }
+    }
+    return longitud;
+}
+
+/**
+ * @brief Decodifica un flujo largo tras calentar la sesión y cuenta reservas
+ * @param nombre Nombre del caso para el informe
+ * @param conIntegridad true para tramas con sufijo de integridad
+ * @return true si no hubo reservas globales fuera del crecimiento del mensaje
+ */
+static bool probarDecodificacionEstable(const char* nombre, bool conIntegridad)
+{
+    const int ciclosCalentamiento = 64;
+    const int ciclosMedidos = 50000;
+
+    FinalizacionContinua politica;
+    SesionDecodificacion sesion(&politica, 1, false, conIntegridad);
+
+    char ciclo[512];
+    int secuencia = 0;
+    for (int indice = 0; indice < ciclosCalentamiento; indice++)
+    {
+        int longitud = escribirCiclo(ciclo, sizeof(ciclo), conIntegridad, secuencia);
+        sesion.decodificarBloque(ciclo, longitud);
+    }
+
+    long long tramasPrevias = sesion.obtenerPaquetesRecibidos();
+    long long fragmentosPrevios = ContabilidadMemoria::obtenerNodos(MEMORIA_MENSAJE);
+    asignacionesGlobales = 0;
+
+    for (int indice = 0; indice < ciclosMedidos; indice++)
+    {
+        // El ciclo se reescribe en el mismo buffer para avanzar la secuencia
+        int longitud = escribirCiclo(ciclo, sizeof(ciclo), conIntegridad, secuencia);
+        sesion.decodificarBloque(ciclo, longitud);
+    }
+
+    long long asignaciones = asignacionesGlobales;
+    long long tramas = sesion.obtenerPaquetesRecibidos() - tramasPrevias;
+
+    // Cada fragmento nuevo del mensaje son dos reservas: nodo y caracteres
+    long long esperadas = 2 * (ContabilidadMemoria::obtenerNodos(MEMORIA_MENSAJE) - fragmentosPrevios);
+
+    bool correcto = (tramas == (long long)ciclosMedidos * TRAMAS_CICLO &&
+                     sesion.obtenerTramasMalformadas() == 0 &&
+                     asignaciones == esperadas);
+    std::printf("%s: %lld tramas, %lld reservas globales (%lld por crecimiento del mensaje) -> %s\n",
+                nombre, tramas, asignaciones, esperadas, correcto ? "OK" : "FALLO");
+    return correcto;
+}
+
+int main()
+{
+    bool correcto = probarDecodificacionEstable("sin integridad", false);
+    correcto = probarDecodificacionEstable("con integridad", true) && correcto;
+    return correcto ? 0 : 1;
+}
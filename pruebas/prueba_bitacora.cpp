@@ -0,0 +1,161 @@
+/**
+ * @file prueba_bitacora.cpp
+ * @brief Prueba de reanudación tras matar el proceso que escribe la bitácora
+ * @author Tu Nombre
+ * @date 2024
+ * 
+ * Un proceso hijo decodifica "L,A", "M,3", "L,B" y "M,5" guardando
+ * instantáneas como lo hace el programa de consola (tras cada
+ * rotación y cada N tramas) y se mata con SIGKILL, sin destructores
+ * ni fflush al salir. El padre restaura la bitácora en una sesión
+ * nueva, sigue con "L,A" y compara con una decodificación sin
+ * interrupciones.
+ */
+
+#include "BitacoraEstado.h"
+#include "SesionDecodificacion.h"
+#include "PoliticaFinalizacion.h"
+#include "PaqueteBase.h"
+#include <cstdio>
+#include <cstring>
+#include <csignal>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/// Tramas que el hijo decodifica antes de morir (la última rotación
+/// guarda instantánea, así que todas quedan en la bitácora)
+static const char* const TRAMAS_PREVIAS[] = { "L,A", "M,3", "L,B", "M,5" };
+
+/// Tramas que el padre decodifica tras reanudar
+static const char* const TRAMAS_POSTERIORES[] = { "L,A" };
+
+/// Tramas entre instantáneas sin rotaciones (como el programa por defecto)
+static const int TRAMAS_POR_INSTANTANEA = 8;
+
+/**
+ * @class ObservadorBitacora
+ * @brief Guarda instantáneas con el mismo criterio que ObservadorConsola
+ */
+class ObservadorBitacora : public ObservadorSesion
+{
+private:
+    SesionDecodificacion* sesion;   ///< Sesión observada
+    BitacoraEstado* bitacora;       ///< Bitácora donde se guarda
+
+public:
+    ObservadorBitacora(SesionDecodificacion* sesionObservada, BitacoraEstado* bitacoraEstado)
+        : sesion(sesionObservada), bitacora(bitacoraEstado)
+    {
+    }
+
+    void alEjecutarPaquete(const PaqueteBase& paquete, int paquetesRecibidos)
+    {
+        char tipo = paquete.obtenerTipo();
+        if (tipo == 'M' || tipo == 'R' || tipo == 'S' ||
+            paquetesRecibidos % TRAMAS_POR_INSTANTANEA == 0)
+        {
+            bitacora->registrar(sesion->obtenerMensaje(), sesion->obtenerDisco(), paquetesRecibidos);
+        }
+    }
+};
+
+/**
+ * @brief Procesa una lista de tramas
+ * @param sesion Sesión que las decodifica
+ * @param tramas Líneas sin salto
+ * @param cantidad Número de líneas
+ */
+static void procesarTramas(SesionDecodificacion* sesion, const char* const* tramas, int cantidad)
+{
+    for (int indice = 0; indice < cantidad; indice++)
+    {
+        char linea[32];
+        std::strncpy(linea, tramas[indice], sizeof(linea) - 1);
+        linea[sizeof(linea) - 1] = '\0';
+        sesion->procesarLinea(linea);
+    }
+}
+
+/**
+ * @brief Copia el mensaje de una sesión a un buffer
+ * @param sesion Sesión
+ * @param destino Buffer de salida (con '\0')
+ * @param capacidad Tamaño del buffer
+ */
+static void copiarMensaje(SesionDecodificacion& sesion, char* destino, int capacidad)
+{
+    int copiados = sesion.obtenerMensaje().copiarDesde(0, destino, capacidad - 1);
+    destino[copiados] = '\0';
+}
+
+int main()
+{
+    char ruta[64];
+    std::snprintf(ruta, sizeof(ruta), "/tmp/prueba_bitacora_%d.bit", (int)getpid());
+    std::remove(ruta);
+
+    const int previas = (int)(sizeof(TRAMAS_PREVIAS) / sizeof(TRAMAS_PREVIAS[0]));
+    const int posteriores = (int)(sizeof(TRAMAS_POSTERIORES) / sizeof(TRAMAS_POSTERIORES[0]));
+
+    pid_t hijo = fork();
+    if (hijo < 0)
+    {
+        std::perror("fork");
+        return 1;
+    }
+    if (hijo == 0)
+    {
+        FinalizacionContinua politica;
+        SesionDecodificacion sesion(&politica, 1, false, false);
+        BitacoraEstado bitacora(ruta, 4);
+        bitacora.restaurar(&sesion.obtenerMensaje(), &sesion.obtenerDisco());
+        ObservadorBitacora observador(&sesion, &bitacora);
+        sesion.establecerObservador(&observador);
+
+        procesarTramas(&sesion, TRAMAS_PREVIAS, previas);
+
+        // Muerte abrupta: ni destructores ni vaciado de stdio
+        raise(SIGKILL);
+        _exit(2);
+    }
+
+    int estado = 0;
+    waitpid(hijo, &estado, 0);
+    if (!WIFSIGNALED(estado) || WTERMSIG(estado) != SIGKILL)
+    {
+        std::printf("El proceso hijo no murio por SIGKILL\n");
+        std::remove(ruta);
+        return 1;
+    }
+
+    // Reanudar desde la bitácora
+    FinalizacionContinua politica;
+    SesionDecodificacion reanudada(&politica, 1, false, false);
+    int paquetes;
+    {
+        BitacoraEstado bitacora(ruta, 4);
+        paquetes = bitacora.restaurar(&reanudada.obtenerMensaje(), &reanudada.obtenerDisco());
+        bitacora.descartar();
+    }
+    reanudada.establecerPaquetesRecibidos(paquetes);
+    int rotacionRestaurada = reanudada.obtenerDisco().obtenerDesplazamiento();
+    procesarTramas(&reanudada, TRAMAS_POSTERIORES, posteriores);
+
+    // Referencia: el mismo flujo sin interrupciones
+    SesionDecodificacion continua(&politica, 1, false, false);
+    procesarTramas(&continua, TRAMAS_PREVIAS, previas);
+    int rotacionEsperada = continua.obtenerDisco().obtenerDesplazamiento();
+    procesarTramas(&continua, TRAMAS_POSTERIORES, posteriores);
+
+    char mensajeReanudado[64];
+    char mensajeEsperado[64];
+    copiarMensaje(reanudada, mensajeReanudado, sizeof(mensajeReanudado));
+    copiarMensaje(continua, mensajeEsperado, sizeof(mensajeEsperado));
+
+    bool correcto = (paquetes == previas && rotacionRestaurada == rotacionEsperada &&
+                     std::strcmp(mensajeReanudado, mensajeEsperado) == 0);
+    std::printf("Restaurado: %d tramas, disco en +%d, mensaje \"%s\" (esperado %d, +%d, \"%s\") -> %s\n",
+                paquetes, rotacionRestaurada, mensajeReanudado,
+                previas, rotacionEsperada, mensajeEsperado, correcto ? "OK" : "FALLO");
+    return correcto ? 0 : 1;
+}
@@ -0,0 +1,175 @@
+/**
+ * @file prueba_cadena_rotores.cpp
+ * @brief Compara CadenaRotores con un recorrido ingenuo rotor por rotor
+ * @author Tu Nombre
+ * @date 2024
+ * 
+ * La referencia no usa tablas: guarda la posición de cada rotor y
+ * hace pasar cada letra por todos los cableados en orden, avanzando
+ * como un odómetro cuando corresponde. Se prueban todas las
+ * cantidades de rotores, con y sin avance, mezclando giros
+ * aleatorios (trama R) con letras, minúsculas y otros bytes.
+ */
+
+#include "CadenaRotores.h"
+#include <cstdio>
+
+/// Rotores como máximo en una cadena
+static const int MAXIMO_ROTORES = 6;
+
+/// Cableado de cada rotor; el 0 es el disco ordenado del protocolo
+static const char* const CABLEADOS[MAXIMO_ROTORES] = {
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZ",
+    "EKMFLGDQVZNTOWYHXUSPAIBRCJ",  // Enigma I
+    "AJDKSIRUXBLHWTMCQGZNPYFVOE",  // Enigma II
+    "BDFHJLCPRTXVZNYEIWGAKMUSQO",  // Enigma III
+    "ESOVPZJAYQUIRHXLNFTGKDCMWB",  // Enigma IV
+    "VZBRGITYUPSDNHLXAWMJQOFECK"   // Enigma V
+};
+
+/// Operaciones por combinación de rotores y avance
+static const int OPERACIONES = 60000;
+
+/**
+ * @class CadenaIngenua
+ * @brief Modelo de referencia sin tablas precalculadas
+ */
+class CadenaIngenua
+{
+private:
+    int cantidad;                       ///< Rotores en la cadena
+    bool avance;                        ///< Avance tipo odómetro activo
+    int posiciones[MAXIMO_ROTORES];     ///< Rotación de cada rotor en [0, 26)
+
+public:
+    CadenaIngenua(int cantidadRotores, bool avanceAutomatico)
+        : cantidad(cantidadRotores), avance(avanceAutomatico)
+    {
+        for (int indice = 0; indice < MAXIMO_ROTORES; indice++)
+        {
+            posiciones[indice] = 0;
+        }
+    }
+
+    void girar(int indice, int desplazamiento)
+    {
+        posiciones[indice] = ((posiciones[indice] + desplazamiento) % 26 + 26) % 26;
+    }
+
+    char cifrar(char caracter)
+    {
+        bool mayuscula = (caracter >= 'A' && caracter <= 'Z');
+        bool minuscula = (caracter >= 'a' && caracter <= 'z');
+        if (!mayuscula && !minuscula)
+            return caracter;
+
+        int letra = mayuscula ? caracter - 'A' : caracter - 'a';
+        for (int indice = 0; indice < cantidad; indice++)
+        {
+            letra = CABLEADOS[indice][(letra + posiciones[indice]) % 26] - 'A';
+        }
+
+        if (avance)
+        {
+            for (int indice = 0; indice < cantidad; indice++)
+            {
+                posiciones[indice] = (posiciones[indice] + 1) % 26;
+                if (posiciones[indice] != 0)
+                    break;
+            }
+        }
+        return (char)((mayuscula ? 'A' : 'a') + letra);
+    }
+
+    int posicion(int indice) const
+    {
+        return posiciones[indice];
+    }
+};
+
+/// Estado del generador pseudoaleatorio (reproducible entre ejecuciones)
+static unsigned int semilla = 12345u;
+
+/**
+ * @brief Generador congruencial lineal
+ * @param limite Cota superior exclusiva
+ * @return Número en [0, limite)
+ */
+static int aleatorio(int limite)
+{
+    semilla = semilla * 1103515245u + 12345u;
+    return (int)((semilla >> 8) % (unsigned int)limite);
+}
+
+/**
+ * @brief Ejecuta operaciones aleatorias sobre ambas cadenas
+ * @param cantidad Número de rotores
+ * @param avance true para activar el avance tipo odómetro
+ * @return true si las dos cadenas coinciden en todo momento
+ */
+static bool compararCadenas(int cantidad, bool avance)
+{
+    CadenaRotores cadena(cantidad, avance);
+    CadenaIngenua referencia(cantidad, avance);
+
+    for (int paso = 0; paso < OPERACIONES; paso++)
+    {
+        int operacion = aleatorio(100);
+        if (operacion < 3)
+        {
+            int indice = aleatorio(cantidad);
+            int desplazamiento = aleatorio(121) - 60;
+            cadena.girarRotor(indice, desplazamiento);
+            referencia.girar(indice, desplazamiento);
+        }
+        else
+        {
+            char caracter;
+            if (operacion < 60)
+                caracter = (char)('A' + aleatorio(26));
+            else if (operacion < 90)
+                caracter = (char)('a' + aleatorio(26));
+            else
+                caracter = (char)aleatorio(256);
+
+            char obtenido = cadena.obtenerCifrado(caracter);
+            char esperado = referencia.cifrar(caracter);
+            if (obtenido != esperado)
+            {
+                std::printf("%d rotores, avance %s, paso %d: byte %d -> %d (esperado %d)\n",
+                            cantidad, avance ? "si" : "no", paso,
+                            (unsigned char)caracter, (unsigned char)obtenido,
+                            (unsigned char)esperado);
+                return false;
+            }
+        }
+
+        for (int indice = 0; indice < cantidad; indice++)
+        {
+            if (cadena.obtenerDesplazamiento(indice) != referencia.posicion(indice))
+            {
+                std::printf("%d rotores, avance %s, paso %d: rotor %d en +%d (esperado +%d)\n",
+                            cantidad, avance ? "si" : "no", paso, indice,
+                            cadena.obtenerDesplazamiento(indice), referencia.posicion(indice));
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+int main()
+{
+    bool correcto = true;
+    for (int avance = 0; avance <= 1; avance++)
+    {
+        for (int cantidad = 1; cantidad <= MAXIMO_ROTORES; cantidad++)
+        {
+            bool coincide = compararCadenas(cantidad, avance != 0);
+            std::printf("%d rotores, avance %s: %s\n",
+                        cantidad, avance ? "si" : "no", coincide ? "OK" : "FALLO");
+            correcto = correcto && coincide;
+        }
+    }
+    return correcto ? 0 : 1;
+}
@@ -0,0 +1,258 @@
+/**
+ * @file prueba_ingesta.cpp
+ * @brief Prueba de extremo a extremo del modo servidor (--escuchar)
+ * @author Tu Nombre
+ * @date 2024
+ * 
+ * Arranca el decodificador escuchando en un socket Unix y después en
+ * un puerto TCP libre de 127.0.0.1, envía un flujo PRT-7 partido en
+ * varias escrituras (con una trama cortada entre dos de ellas),
+ * espera el resumen de la conexión y detiene el servidor con SIGTERM.
+ * El servidor debe salir con código 0 y haber decodificado "HOLA".
+ * 
+ * Uso: prueba_ingesta RUTA_DEL_DECODIFICADOR
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <csignal>
+#include <cerrno>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+/// Escrituras del cliente: "M,2" queda partida entre la primera y la segunda
+static const char* const ESCRITURAS[] = { "L,H\nM,", "2\nL,M\nL,J\n", "L,Y\nF,0\n" };
+
+/// Resumen esperado de la primera conexión ('M', 'J' e 'Y' con el disco en +2)
+static const char* const MENSAJE_ESPERADO = "[#1] >>> HOLA <<<";
+
+/// Tiempo máximo de espera de cada paso
+static const int ESPERA_MAXIMA_MS = 5000;
+
+/**
+ * @struct ServidorHijo
+ * @brief Decodificador lanzado en modo servidor
+ */
+struct ServidorHijo
+{
+    pid_t proceso;          ///< Proceso del decodificador
+    int salida;             ///< Extremo de lectura de su salida estándar
+    char texto[16384];      ///< Salida acumulada (con '\0')
+    int longitud;           ///< Bytes acumulados
+};
+
+/**
+ * @brief Lanza el decodificador con --escuchar
+ * @param servidor Recibe el proceso y su salida
+ * @param decodificador Ruta del ejecutable
+ * @param especificacion Valor de --escuchar
+ * @return false si no se pudo lanzar
+ */
+static bool lanzarServidor(ServidorHijo* servidor, const char* decodificador,
+                           const char* especificacion)
+{
+    int tuberia[2];
+    if (pipe(tuberia) != 0)
+        return false;
+
+    char opcion[160];
+    std::snprintf(opcion, sizeof(opcion), "--escuchar=%s", especificacion);
+
+    servidor->proceso = fork();
+    if (servidor->proceso < 0)
+        return false;
+    if (servidor->proceso == 0)
+    {
+        dup2(tuberia[1], STDOUT_FILENO);
+        dup2(tuberia[1], STDERR_FILENO);
+        close(tuberia[0]);
+        close(tuberia[1]);
+        execl(decodificador, decodificador, opcion, (char*)nullptr);
+        _exit(127);
+    }
+
+    close(tuberia[1]);
+    servidor->salida = tuberia[0];
+    servidor->texto[0] = '\0';
+    servidor->longitud = 0;
+    return true;
+}
+
+/**
+ * @brief Lee la salida del servidor hasta que aparezca un texto
+ * @param servidor Servidor lanzado
+ * @param buscado Texto esperado, o nullptr para leer hasta el fin
+ * @return true si el texto apareció antes del tiempo máximo
+ */
+static bool esperarTexto(ServidorHijo* servidor, const char* buscado)
+{
+    int esperado = 0;
+    while (buscado == nullptr || std::strstr(servidor->texto, buscado) == nullptr)
+    {
+        struct pollfd vigilado;
+        vigilado.fd = servidor->salida;
+        vigilado.events = POLLIN;
+        vigilado.revents = 0;
+        if (poll(&vigilado, 1, 100) < 0 && errno != EINTR)
+            return false;
+
+        if (vigilado.revents != 0)
+        {
+            int libre = (int)sizeof(servidor->texto) - 1 - servidor->longitud;
+            ssize_t leidos = read(servidor->salida, servidor->texto + servidor->longitud,
+                                  libre > 0 ? (size_t)libre : 0);
+            if (leidos <= 0)
+                return buscado == nullptr;
+            servidor->longitud += (int)leidos;
+            servidor->texto[servidor->longitud] = '\0';
+        }
+        else
+        {
+            esperado += 100;
+            if (esperado >= ESPERA_MAXIMA_MS)
+                return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Conecta con el servidor
+ * @param especificacion "unix:/ruta" o "tcp:127.0.0.1:PUERTO"
+ * @return Socket conectado, o -1 si falló
+ */
+static int conectar(const char* especificacion)
+{
+    int intentos = 0;
+    while (intentos++ < 50)
+    {
+        int descriptor = -1;
+        int resultado = -1;
+        if (std::strncmp(especificacion, "unix:", 5) == 0)
+        {
+            struct sockaddr_un direccion;
+            std::memset(&direccion, 0, sizeof(direccion));
+            direccion.sun_family = AF_UNIX;
+            std::strncpy(direccion.sun_path, especificacion + 5, sizeof(direccion.sun_path) - 1);
+            descriptor = socket(AF_UNIX, SOCK_STREAM, 0);
+            resultado = connect(descriptor, (struct sockaddr*)&direccion, sizeof(direccion));
+        }
+        else
+        {
+            const char* puerto = std::strrchr(especificacion, ':');
+            struct sockaddr_in direccion;
+            std::memset(&direccion, 0, sizeof(direccion));
+            direccion.sin_family = AF_INET;
+            direccion.sin_port = htons((unsigned short)std::atoi(puerto + 1));
+            direccion.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            descriptor = socket(AF_INET, SOCK_STREAM, 0);
+            resultado = connect(descriptor, (struct sockaddr*)&direccion, sizeof(direccion));
+        }
+        if (resultado == 0)
+            return descriptor;
+
+        close(descriptor);
+        usleep(100000);
+    }
+    return -1;
+}
+
+/**
+ * @brief Busca un puerto TCP libre en 127.0.0.1
+ * @return Puerto asignado por el núcleo, o -1 si falló
+ */
+static int buscarPuertoLibre()
+{
+    int descriptor = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in direccion;
+    std::memset(&direccion, 0, sizeof(direccion));
+    direccion.sin_family = AF_INET;
+    direccion.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    direccion.sin_port = 0;
+    socklen_t longitud = sizeof(direccion);
+    int puerto = -1;
+    if (bind(descriptor, (struct sockaddr*)&direccion, sizeof(direccion)) == 0 &&
+        getsockname(descriptor, (struct sockaddr*)&direccion, &longitud) == 0)
+    {
+        puerto = ntohs(direccion.sin_port);
+    }
+    close(descriptor);
+    return puerto;
+}
+
+/**
+ * @brief Envía el flujo a un servidor y comprueba el mensaje decodificado
+ * @param decodificador Ruta del ejecutable
+ * @param especificacion Valor de --escuchar
+ * @return true si el mensaje llegó completo y el servidor salió limpio
+ */
+static bool probarEspecificacion(const char* decodificador, const char* especificacion)
+{
+    ServidorHijo servidor;
+    if (!lanzarServidor(&servidor, decodificador, especificacion))
+    {
+        std::printf("%s: no se pudo lanzar el decodificador\n", especificacion);
+        return false;
+    }
+
+    bool correcto = esperarTexto(&servidor, "Escuchando en");
+    int cliente = correcto ? conectar(especificacion) : -1;
+    correcto = (cliente >= 0);
+
+    const int escrituras = (int)(sizeof(ESCRITURAS) / sizeof(ESCRITURAS[0]));
+    for (int indice = 0; correcto && indice < escrituras; indice++)
+    {
+        size_t longitud = std::strlen(ESCRITURAS[indice]);
+        correcto = (write(cliente, ESCRITURAS[indice], longitud) == (ssize_t)longitud);
+        usleep(20000);
+    }
+    if (cliente >= 0)
+        close(cliente);
+
+    bool mensaje = correcto && esperarTexto(&servidor, MENSAJE_ESPERADO);
+
+    // SIGTERM detiene el bucle: el servidor muestra los totales y sale con 0
+    kill(servidor.proceso, SIGTERM);
+    esperarTexto(&servidor, nullptr);
+    int estado = 0;
+    waitpid(servidor.proceso, &estado, 0);
+    close(servidor.salida);
+    bool salidaLimpia = WIFEXITED(estado) && WEXITSTATUS(estado) == 0;
+
+    bool resultado = mensaje && salidaLimpia;
+    std::printf("%s: mensaje %s, salida %s -> %s\n", especificacion,
+                mensaje ? "recibido" : "NO recibido",
+                salidaLimpia ? "limpia" : "anormal", resultado ? "OK" : "FALLO");
+    if (!resultado)
+    {
+        std::printf("--- salida del decodificador ---\n%s\n", servidor.texto);
+    }
+    return resultado;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        std::printf("Uso: %s RUTA_DEL_DECODIFICADOR\n", argv[0]);
+        return 1;
+    }
+
+    char especificacionUnix[96];
+    std::snprintf(especificacionUnix, sizeof(especificacionUnix),
+                  "unix:/tmp/prueba_ingesta_%d.sock", (int)getpid());
+    bool sobreUnix = probarEspecificacion(argv[1], especificacionUnix);
+
+    int puerto = buscarPuertoLibre();
+    char especificacionTcp[64];
+    std::snprintf(especificacionTcp, sizeof(especificacionTcp), "tcp:127.0.0.1:%d", puerto);
+    bool sobreTcp = (puerto > 0) && probarEspecificacion(argv[1], especificacionTcp);
+
+    return (sobreUnix && sobreTcp) ? 0 : 1;
+}
@@ -0,0 +1,70 @@
+/**
+ * @file prueba_integridad.cpp
+ * @brief Prueba de que una trama corrupta no se cuenta también como perdida
+ * @author Tu Nombre
+ * @date 2024
+ * 
+ * Envía tramas con sufijo de secuencia y CRC, dañando algunas y
+ * omitiendo otras, y compara el hueco informado tras cada trama
+ * válida con el número de tramas que realmente no llegaron.
+ */
+
+#include "ControlIntegridad.h"
+#include <cstdio>
+
+/**
+ * @struct CasoTrama
+ * @brief Trama enviada y veredicto esperado
+ */
+struct CasoTrama
+{
+    int secuencia;                  ///< Número de secuencia del sufijo
+    bool danada;                    ///< true para alterar el CRC
+    ResultadoIntegridad esperado;   ///< Veredicto esperado
+    int huecoEsperado;              ///< Tramas perdidas antes de esta
+};
+
+/// Secuencia 1 y 5 llegan dañadas; 3 y 6 no llegan nunca
+static const CasoTrama CASOS[] = {
+    { 0, false, INTEGRIDAD_VALIDA,   0 },
+    { 1, true,  INTEGRIDAD_CORRUPTA, 0 },
+    { 2, false, INTEGRIDAD_VALIDA,   0 },
+    { 4, false, INTEGRIDAD_VALIDA,   1 },
+    { 5, true,  INTEGRIDAD_CORRUPTA, 0 },
+    { 7, false, INTEGRIDAD_VALIDA,   1 },
+    { 8, false, INTEGRIDAD_VALIDA,   0 }
+};
+
+int main()
+{
+    ControlIntegridad control(false);
+    bool correcto = true;
+
+    const int cantidad = (int)(sizeof(CASOS) / sizeof(CASOS[0]));
+    for (int indice = 0; indice < cantidad; indice++)
+    {
+        const CasoTrama& caso = CASOS[indice];
+        char linea[32];
+        int longitud = std::snprintf(linea, sizeof(linea), "L,A,%d", caso.secuencia);
+        unsigned char crc = ControlIntegridad::calcularCrc(linea, longitud);
+        if (caso.danada)
+            crc ^= 0x01;
+        std::snprintf(linea + longitud, sizeof(linea) - longitud, "*%02X", crc);
+
+        ResultadoIntegridad resultado = control.verificar(linea);
+        int hueco = control.obtenerUltimoHueco();
+        if (resultado != caso.esperado || hueco != caso.huecoEsperado)
+        {
+            std::printf("Secuencia %d: veredicto %d, hueco %d (esperado %d, %d)\n",
+                        caso.secuencia, (int)resultado, hueco,
+                        (int)caso.esperado, caso.huecoEsperado);
+            correcto = false;
+        }
+    }
+
+    bool totales = (control.obtenerTramasCorruptas() == 2 && control.obtenerTramasPerdidas() == 2);
+    std::printf("Corruptas: %d, perdidas: %d (esperado 2 y 2) -> %s\n",
+                control.obtenerTramasCorruptas(), control.obtenerTramasPerdidas(),
+                (correcto && totales) ? "OK" : "FALLO");
+    return (correcto && totales) ? 0 : 1;
+}
@@ -0,0 +1,186 @@
+/**
+ * @file prueba_mensaje.cpp
+ * @brief Prueba aleatoria de MensajeDecodificado frente a std::string
+ * @author Tu Nombre
+ * @date 2024
+ * 
+ * Aplica la misma secuencia de inserciones, eliminaciones y
+ * reemplazos a un MensajeDecodificado y a un std::string, y compara
+ * el contenido. Tras cada operación comprueba además que el número
+ * de fragmentos no supera la cota que garantiza la fusión con los
+ * vecinos: dos fragmentos contiguos guardan más de media capacidad
+ * mínima, así que hay como mucho 2n / 33 + 1 fragmentos.
+ */
+
+#include "MensajeDecodificado.h"
+#include "ContabilidadMemoria.h"
+#include <cstdio>
+#include <string>
+
+/// Capacidad mínima de un fragmento (la misma que usa el mensaje)
+static const int CAPACIDAD_MINIMA = 64;
+
+/// Estado del generador pseudoaleatorio (reproducible entre ejecuciones)
+static unsigned int semilla = 2024u;
+
+/**
+ * @brief Generador congruencial lineal
+ * @param limite Cota superior exclusiva
+ * @return Número en [0, limite)
+ */
+static int aleatorio(int limite)
+{
+    semilla = semilla * 1103515245u + 12345u;
+    return (int)((semilla >> 8) % (unsigned int)limite);
+}
+
+/**
+ * @brief Máximo de fragmentos admitido para una longitud
+ * @param longitud Caracteres del mensaje
+ * @return Cota de fragmentos
+ */
+static long long cotaFragmentos(int longitud)
+{
+    return 2LL * longitud / (CAPACIDAD_MINIMA / 2 + 1) + 1;
+}
+
+/**
+ * @brief Compara el mensaje con la referencia y revisa la cota
+ * @param mensaje Mensaje probado
+ * @param referencia Contenido esperado
+ * @param fase Nombre de la fase, para el diagnóstico
+ * @param paso Operación recién aplicada
+ * @param completo true para comparar todos los caracteres
+ * @return true si todo coincide
+ */
+static bool verificar(const MensajeDecodificado& mensaje, const std::string& referencia,
+                      const char* fase, int paso, bool completo)
+{
+    int longitud = (int)referencia.size();
+    long long fragmentos = ContabilidadMemoria::obtenerNodos(MEMORIA_MENSAJE);
+    if (mensaje.obtenerLongitud() != longitud || fragmentos > cotaFragmentos(longitud))
+    {
+        std::printf("%s, paso %d: longitud %d con %lld fragmentos (esperado %d, como mucho %lld)\n",
+                    fase, paso, mensaje.obtenerLongitud(), fragmentos,
+                    longitud, cotaFragmentos(longitud));
+        return false;
+    }
+
+    if (longitud > 0)
+    {
+        int posicion = aleatorio(longitud);
+        if (mensaje.obtenerEn(posicion) != referencia[posicion])
+        {
+            std::printf("%s, paso %d: posicion %d distinta\n", fase, paso, posicion);
+            return false;
+        }
+    }
+
+    if (completo)
+    {
+        std::string copia(longitud, '\0');
+        int copiados = (longitud > 0) ? mensaje.copiarDesde(0, &copia[0], longitud) : 0;
+        if (copiados != longitud || copia != referencia)
+        {
+            std::printf("%s, paso %d: el contenido no coincide\n", fase, paso);
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Mezcla aleatoria de operaciones que hace crecer y encoger el mensaje
+ * @return true si el mensaje coincide en todo momento con la referencia
+ */
+static bool probarOperacionesAleatorias()
+{
+    MensajeDecodificado mensaje;
+    std::string referencia;
+
+    const int pasos = 200000;
+    for (int paso = 0; paso < pasos; paso++)
+    {
+        // Alternar tramos que crecen y tramos que encogen
+        bool creciendo = (paso / 20000) % 2 == 0;
+        int operacion = aleatorio(100);
+        int longitud = (int)referencia.size();
+        char caracter = (char)('a' + aleatorio(26));
+
+        if (operacion < 10)
+        {
+            mensaje.agregarCaracter(caracter);
+            referencia.push_back(caracter);
+        }
+        else if (operacion < (creciendo ? 60 : 35))
+        {
+            int posicion = aleatorio(longitud + 1);
+            mensaje.insertarEn(posicion, caracter);
+            referencia.insert(referencia.begin() + posicion, caracter);
+        }
+        else if (operacion < 90 && longitud > 0)
+        {
+            int posicion = aleatorio(longitud);
+            mensaje.eliminarEn(posicion);
+            referencia.erase(referencia.begin() + posicion);
+        }
+        else if (longitud > 0)
+        {
+            int posicion = aleatorio(longitud);
+            mensaje.reemplazarEn(posicion, caracter);
+            referencia[posicion] = caracter;
+        }
+
+        if (!verificar(mensaje, referencia, "aleatoria", paso, paso % 997 == 0))
+            return false;
+    }
+    return verificar(mensaje, referencia, "aleatoria", pasos, true);
+}
+
+/**
+ * @brief Vacía el mensaje de izquierda a derecha dejando un carácter de cada 64
+ * @return true si el mensaje coincide con la referencia y respeta la cota
+ * 
+ * Cada fragmento se queda casi vacío mientras su siguiente sigue
+ * lleno, así que solo la fusión con el fragmento anterior evita que
+ * quede un fragmento por carácter.
+ */
+static bool probarAclaradoPorLaIzquierda()
+{
+    MensajeDecodificado mensaje;
+    std::string referencia;
+
+    const int longitudInicial = 64 * 1024;
+    for (int indice = 0; indice < longitudInicial; indice++)
+    {
+        char caracter = (char)('A' + indice % 26);
+        mensaje.agregarCaracter(caracter);
+        referencia.push_back(caracter);
+    }
+
+    int posicion = 0;
+    for (int indice = 0; indice < longitudInicial; indice++)
+    {
+        if (indice % 64 == 63)
+        {
+            posicion++;
+            continue;
+        }
+        mensaje.eliminarEn(posicion);
+        referencia.erase(referencia.begin() + posicion);
+        if (!verificar(mensaje, referencia, "aclarado", indice, false))
+            return false;
+    }
+    return verificar(mensaje, referencia, "aclarado", longitudInicial, true);
+}
+
+int main()
+{
+    bool aleatoria = probarOperacionesAleatorias();
+    std::printf("Operaciones aleatorias: %s\n", aleatoria ? "OK" : "FALLO");
+
+    bool aclarado = probarAclaradoPorLaIzquierda();
+    std::printf("Aclarado por la izquierda: %s\n", aclarado ? "OK" : "FALLO");
+
+    return (aleatoria && aclarado) ? 0 : 1;
+}
@@ -0,0 +1,250 @@
+/**
+ * @file prueba_planificador.cpp
+ * @brief Compara el plan de PlanificadorTramas con una búsqueda exhaustiva
+ * @author Tu Nombre
+ * @date 2024
+ * 
+ * Para textos cortos la referencia prueba todas las particiones en
+ * bloques y todos los puntos de rotación, con las mismas reglas que
+ * el planificador: como mucho --bloque caracteres por trama, como
+ * mucho --rotar letras entre dos giros, la clave gira antes de la
+ * primera letra y, sin --integridad, ningún bloque termina en espacio
+ * ni (con tres o más caracteres) en '*' seguido de dos caracteres que
+ * podrían ser un CRC. El coste es el del modelo del planificador: el
+ * contenido es fijo, cada bloque cuesta 3 bytes y cada giro 4, más
+ * el sufijo de integridad. Además, las tramas generadas deben
+ * decodificarse al texto original.
+ */
+
+#include "PlanificadorTramas.h"
+#include "SesionDecodificacion.h"
+#include <cstdio>
+#include <cstring>
+
+/// Longitud máxima de los textos probados
+static const int LONGITUD_MAXIMA = 9;
+
+/// Textos aleatorios por cada política
+static const int TEXTOS_POR_POLITICA = 60;
+
+/// Caracteres de los textos: letras, espacio, '*' y otros símbolos
+static const char ALFABETO[] = "AB*1 z.";
+
+/// Clave sin letras repetidas seguidas, de modo que cada giro emite una trama M
+static const char CLAVE[] = "CXF";
+
+/// Coste de un texto que ninguna secuencia de tramas puede enviar
+static const long long SIN_PLAN = -1;
+
+/// Estado del generador pseudoaleatorio (reproducible entre ejecuciones)
+static unsigned int semilla = 4242u;
+
+/**
+ * @brief Generador congruencial lineal
+ * @param limite Cota superior exclusiva
+ * @return Número en [0, limite)
+ */
+static int aleatorio(int limite)
+{
+    semilla = semilla * 1103515245u + 12345u;
+    return (int)((semilla >> 8) % (unsigned int)limite);
+}
+
+static bool esLetra(char caracter)
+{
+    return (caracter >= 'A' && caracter <= 'Z') || (caracter >= 'a' && caracter <= 'z');
+}
+
+static bool puedeSerHexadecimal(char caracter)
+{
+    return (caracter >= '0' && caracter <= '9') || esLetra(caracter);
+}
+
+static int contarLetras(const char* texto, int inicio, int fin)
+{
+    int letras = 0;
+    for (int indice = inicio; indice < fin; indice++)
+    {
+        if (esLetra(texto[indice]))
+            letras++;
+    }
+    return letras;
+}
+
+/**
+ * @brief Indica si el receptor leería el bloque [inicio, fin) tal cual
+ * @param texto Texto claro
+ * @param inicio Primer carácter del bloque
+ * @param fin Posición siguiente al último carácter
+ * @param politica Política de codificación
+ * @return false si el bloque es demasiado largo o su final se malinterpreta
+ */
+static bool bloqueValido(const char* texto, int inicio, int fin, const PoliticaCodificacion& politica)
+{
+    if (fin - inicio > politica.longitudMaximaBloque)
+        return false;
+    if (politica.incluirIntegridad)
+        return true;
+
+    char ultimo = texto[fin - 1];
+    if (ultimo == ' ' || ultimo == '\t')
+        return false;
+    return !(fin - inicio >= 3 && texto[fin - 3] == '*' &&
+             puedeSerHexadecimal(texto[fin - 2]) && puedeSerHexadecimal(ultimo));
+}
+
+/**
+ * @brief Coste mínimo recorriendo todos los planes posibles
+ * @param texto Texto claro
+ * @param longitud Caracteres del texto (como mucho LONGITUD_MAXIMA)
+ * @param politica Política de codificación
+ * @return Coste del mejor plan, o SIN_PLAN si no hay ninguno válido
+ */
+static long long buscarCosteMinimo(const char* texto, int longitud, const PoliticaCodificacion& politica)
+{
+    long long sufijo = politica.incluirIntegridad ? 5 : 0;
+    bool conClave = (politica.clave != nullptr);
+    long long mejor = SIN_PLAN;
+
+    // Cada bit de cortes separa dos caracteres; cada bit de giros rota antes de un bloque
+    for (unsigned int cortes = 0; cortes < (1u << (longitud - 1)); cortes++)
+    {
+        int inicios[LONGITUD_MAXIMA + 1];
+        int bloques = 0;
+        inicios[bloques++] = 0;
+        for (int posicion = 1; posicion < longitud; posicion++)
+        {
+            if (cortes & (1u << (posicion - 1)))
+                inicios[bloques++] = posicion;
+        }
+        inicios[bloques] = longitud;
+
+        bool particionValida = true;
+        for (int bloque = 0; particionValida && bloque < bloques; bloque++)
+        {
+            particionValida = bloqueValido(texto, inicios[bloque], inicios[bloque + 1], politica);
+        }
+        if (!particionValida)
+            continue;
+
+        for (unsigned int giros = 0; giros < (1u << bloques); giros++)
+        {
+            bool planValido = true;
+            bool girado = false;
+            int letras = 0;
+            int rotaciones = 0;
+            for (int bloque = 0; planValido && bloque < bloques; bloque++)
+            {
+                if (giros & (1u << bloque))
+                {
+                    // Tras la última letra el planificador ya no gira
+                    planValido = contarLetras(texto, inicios[bloque], longitud) > 0;
+                    girado = true;
+                    letras = 0;
+                    rotaciones++;
+                }
+                int letrasBloque = contarLetras(texto, inicios[bloque], inicios[bloque + 1]);
+                letras += letrasBloque;
+                if (conClave && !girado && letrasBloque > 0)
+                    planValido = false;
+                if (politica.letrasPorRotacion > 0 && letras > politica.letrasPorRotacion)
+                    planValido = false;
+            }
+            if (!planValido)
+                continue;
+
+            long long coste = bloques * (3 + sufijo) + rotaciones * (4 + sufijo);
+            if (mejor == SIN_PLAN || coste < mejor)
+                mejor = coste;
+        }
+    }
+    return mejor;
+}
+
+/**
+ * @brief Codifica un texto y lo compara con la búsqueda exhaustiva
+ * @param texto Texto claro
+ * @param longitud Caracteres del texto
+ * @param politica Política de codificación
+ * @return true si el coste coincide y las tramas recuperan el texto
+ */
+static bool probarTexto(const char* texto, int longitud, const PoliticaCodificacion& politica)
+{
+    PlanificadorTramas planificador(politica, nullptr);
+    char tramas[1024];
+    long escritos = planificador.codificar(texto, (size_t)longitud, tramas, sizeof(tramas));
+    long long esperado = buscarCosteMinimo(texto, longitud, politica);
+
+    long long sufijo = politica.incluirIntegridad ? 5 : 0;
+    long long rotaciones = planificador.obtenerRotaciones();
+    long long bloques = planificador.obtenerTramas() - rotaciones;
+    long long obtenido = (escritos < 0) ? SIN_PLAN : bloques * (3 + sufijo) + rotaciones * (4 + sufijo);
+
+    bool recuperado = true;
+    if (escritos > 0)
+    {
+        PoliticaFinalizacion* politicaFin = crearPoliticaFinalizacion("continuo");
+        SesionDecodificacion sesion(politicaFin, 1, false, politica.incluirIntegridad);
+        sesion.decodificarBloque(tramas, (int)escritos);
+        char decodificado[LONGITUD_MAXIMA + 1];
+        const MensajeDecodificado& mensaje = sesion.obtenerMensaje();
+        recuperado = (mensaje.obtenerLongitud() == longitud &&
+                      mensaje.copiarDesde(0, decodificado, longitud) == longitud &&
+                      std::memcmp(decodificado, texto, (size_t)longitud) == 0);
+        delete politicaFin;
+    }
+
+    if (obtenido != esperado || !recuperado)
+    {
+        std::printf("\"%.*s\" con bloque %d, rotar %d, clave %s, integridad %s: coste %lld "
+                    "(esperado %lld)%s\n", longitud, texto, politica.longitudMaximaBloque,
+                    politica.letrasPorRotacion, politica.clave ? politica.clave : "no",
+                    politica.incluirIntegridad ? "si" : "no", obtenido, esperado,
+                    recuperado ? "" : ", el texto decodificado difiere");
+        return false;
+    }
+    return true;
+}
+
+int main()
+{
+    bool correcto = true;
+    int probados = 0;
+    for (int integridad = 0; integridad <= 1; integridad++)
+    {
+        for (int conClave = 0; conClave <= 1; conClave++)
+        {
+            for (int letrasPorRotacion = 0; letrasPorRotacion <= 3; letrasPorRotacion++)
+            {
+                for (int bloque = 1; bloque <= 4; bloque++)
+                {
+                    PoliticaCodificacion politica;
+                    politica.longitudMaximaBloque = bloque;
+                    politica.letrasPorRotacion = letrasPorRotacion;
+                    politica.clave = conClave ? CLAVE : nullptr;
+                    politica.incluirIntegridad = (integridad != 0);
+
+                    bool coincide = true;
+                    for (int caso = 0; caso < TEXTOS_POR_POLITICA; caso++)
+                    {
+                        char texto[LONGITUD_MAXIMA];
+                        int longitud = 1 + aleatorio(LONGITUD_MAXIMA);
+                        for (int indice = 0; indice < longitud; indice++)
+                        {
+                            texto[indice] = ALFABETO[aleatorio((int)sizeof(ALFABETO) - 1)];
+                        }
+                        coincide = probarTexto(texto, longitud, politica) && coincide;
+                        probados++;
+                    }
+
+                    std::printf("Bloque %d, rotar %d, clave %s, integridad %s: %s\n",
+                                bloque, letrasPorRotacion, conClave ? CLAVE : "no",
+                                integridad ? "si" : "no", coincide ? "OK" : "FALLO");
+                    correcto = correcto && coincide;
+                }
+            }
+        }
+    }
+    std::printf("Textos probados: %d -> %s\n", probados, correcto ? "OK" : "FALLO");
+    return correcto ? 0 : 1;
+}
@@ -0,0 +1,270 @@
+/**
+ * @file prueba_pty.cpp
+ * @brief Prueba de extremo a extremo del puerto serie sobre un pseudoterminal
+ * @author Tu Nombre
+ * @date 2024
+ * 
+ * Crea un pseudoterminal en modo crudo, arranca el decodificador con
+ * su extremo esclavo como puerto y escribe tramas PRT-7 por el
+ * maestro en varias escrituras separadas, como llegarían por una
+ * línea serie. Se prueban el bucle de eventos y --baja-latencia:
+ * en ambos el mensaje debe decodificarse, el histograma de latencia
+ * debe tener muestras y el proceso debe salir con código 0. Por
+ * último se comprueba que SIGTERM sin trama F detenga el bucle de
+ * eventos limpiamente.
+ * 
+ * Uso: prueba_pty RUTA_DEL_DECODIFICADOR
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <csignal>
+#include <cerrno>
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+/// Escrituras del transmisor simulado: "B,LA" queda partida entre dos de ellas
+static const char* const ESCRITURAS[] = { "L,H\nL,O\nB,", "LA\nM,1\n", "L,Z\nL,N\n" };
+
+/// Mensaje esperado ('Z' y 'N' con el disco en +1)
+static const char* const MENSAJE_ESPERADO = ">>> [H][O][L][A][A][O] <<<";
+
+/// Informe de latencia con al menos una muestra
+static const char* const LATENCIA_ESPERADA = "Latencia lectura -> decodificado (";
+
+/// Tiempo máximo de espera de cada paso
+static const int ESPERA_MAXIMA_MS = 5000;
+
+/**
+ * @struct DecodificadorHijo
+ * @brief Decodificador lanzado sobre el extremo esclavo del pseudoterminal
+ */
+struct DecodificadorHijo
+{
+    pid_t proceso;          ///< Proceso del decodificador
+    int maestro;            ///< Extremo maestro del pseudoterminal
+    int salida;             ///< Extremo de lectura de su salida estándar
+    char texto[16384];      ///< Salida acumulada (con '\0')
+    int longitud;           ///< Bytes acumulados
+};
+
+/**
+ * @brief Abre un pseudoterminal en modo crudo
+ * @param esclavo Recibe la ruta del extremo esclavo
+ * @param capacidad Tamaño de esclavo
+ * @return Descriptor del maestro, o -1 si falló
+ */
+static int abrirPseudoterminal(char* esclavo, size_t capacidad)
+{
+    int maestro = posix_openpt(O_RDWR | O_NOCTTY);
+    if (maestro < 0)
+        return -1;
+    const char* nombre = (grantpt(maestro) == 0 && unlockpt(maestro) == 0) ? ptsname(maestro) : nullptr;
+    if (nombre == nullptr)
+    {
+        close(maestro);
+        return -1;
+    }
+    std::snprintf(esclavo, capacidad, "%s", nombre);
+
+    // Sin eco ni traducción de saltos: la línea lleva los bytes tal cual
+    struct termios modo;
+    if (tcgetattr(maestro, &modo) == 0)
+    {
+        cfmakeraw(&modo);
+        tcsetattr(maestro, TCSANOW, &modo);
+    }
+    return maestro;
+}
+
+/**
+ * @brief Lanza el decodificador sobre un pseudoterminal nuevo
+ * @param hijo Recibe el proceso, el maestro y la salida
+ * @param decodificador Ruta del ejecutable
+ * @param opcion Opción adicional, o nullptr
+ * @return false si no se pudo lanzar
+ */
+static bool lanzarDecodificador(DecodificadorHijo* hijo, const char* decodificador, const char* opcion)
+{
+    char esclavo[128];
+    hijo->maestro = abrirPseudoterminal(esclavo, sizeof(esclavo));
+    int tuberia[2];
+    if (hijo->maestro < 0 || pipe(tuberia) != 0)
+        return false;
+
+    hijo->proceso = fork();
+    if (hijo->proceso < 0)
+        return false;
+    if (hijo->proceso == 0)
+    {
+        dup2(tuberia[1], STDOUT_FILENO);
+        dup2(tuberia[1], STDERR_FILENO);
+        close(tuberia[0]);
+        close(tuberia[1]);
+        close(hijo->maestro);
+        execl(decodificador, decodificador, esclavo, opcion, (char*)nullptr);
+        _exit(127);
+    }
+
+    close(tuberia[1]);
+    hijo->salida = tuberia[0];
+    hijo->texto[0] = '\0';
+    hijo->longitud = 0;
+    return true;
+}
+
+/**
+ * @brief Lee la salida del decodificador hasta que aparezca un texto
+ * @param hijo Decodificador lanzado
+ * @param buscado Texto esperado, o nullptr para leer hasta el fin
+ * @return true si el texto apareció antes del tiempo máximo
+ */
+static bool esperarTexto(DecodificadorHijo* hijo, const char* buscado)
+{
+    int esperado = 0;
+    while (buscado == nullptr || std::strstr(hijo->texto, buscado) == nullptr)
+    {
+        struct pollfd vigilado;
+        vigilado.fd = hijo->salida;
+        vigilado.events = POLLIN;
+        vigilado.revents = 0;
+        if (poll(&vigilado, 1, 100) < 0 && errno != EINTR)
+            return false;
+
+        if (vigilado.revents != 0)
+        {
+            int libre = (int)sizeof(hijo->texto) - 1 - hijo->longitud;
+            ssize_t leidos = read(hijo->salida, hijo->texto + hijo->longitud,
+                                  libre > 0 ? (size_t)libre : 0);
+            if (leidos <= 0)
+                return buscado == nullptr;
+            hijo->longitud += (int)leidos;
+            hijo->texto[hijo->longitud] = '\0';
+        }
+        else
+        {
+            esperado += 100;
+            if (esperado >= ESPERA_MAXIMA_MS)
+                return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Escribe las tramas por el maestro en varias escrituras
+ * @param hijo Decodificador lanzado
+ * @param cerrar true para terminar con una trama F
+ * @return false si falló una escritura
+ */
+static bool transmitir(DecodificadorHijo* hijo, bool cerrar)
+{
+    const int escrituras = (int)(sizeof(ESCRITURAS) / sizeof(ESCRITURAS[0]));
+    for (int indice = 0; indice < escrituras; indice++)
+    {
+        size_t longitud = std::strlen(ESCRITURAS[indice]);
+        if (write(hijo->maestro, ESCRITURAS[indice], longitud) != (ssize_t)longitud)
+            return false;
+        usleep(20000);
+    }
+    return !cerrar || write(hijo->maestro, "F,0\n", 4) == 4;
+}
+
+/**
+ * @brief Espera el fin del decodificador y libera sus descriptores
+ * @param hijo Decodificador lanzado
+ * @return true si salió con código 0
+ */
+static bool recogerDecodificador(DecodificadorHijo* hijo)
+{
+    esperarTexto(hijo, nullptr);
+    int estado = 0;
+    waitpid(hijo->proceso, &estado, 0);
+    close(hijo->salida);
+    close(hijo->maestro);
+    return WIFEXITED(estado) && WEXITSTATUS(estado) == 0;
+}
+
+/**
+ * @brief Transmite un mensaje completo y revisa el resumen
+ * @param decodificador Ruta del ejecutable
+ * @param opcion Opción adicional, o nullptr para el bucle de eventos
+ * @return true si el mensaje y la latencia aparecieron y la salida fue limpia
+ */
+static bool probarTransmision(const char* decodificador, const char* opcion)
+{
+    const char* nombre = (opcion != nullptr) ? opcion : "bucle de eventos";
+    DecodificadorHijo hijo;
+    if (!lanzarDecodificador(&hijo, decodificador, opcion))
+    {
+        std::printf("%s: no se pudo lanzar el decodificador\n", nombre);
+        return false;
+    }
+
+    bool enviado = esperarTexto(&hijo, "Esperando transmision") && transmitir(&hijo, true);
+    bool mensaje = enviado && esperarTexto(&hijo, MENSAJE_ESPERADO);
+    bool latencia = mensaje && std::strstr(hijo.texto, LATENCIA_ESPERADA) != nullptr;
+    if (!mensaje)
+        kill(hijo.proceso, SIGTERM);
+    bool salidaLimpia = recogerDecodificador(&hijo);
+
+    bool resultado = mensaje && latencia && salidaLimpia;
+    std::printf("%s: mensaje %s, latencia %s, salida %s -> %s\n", nombre,
+                mensaje ? "recibido" : "NO recibido", latencia ? "medida" : "NO medida",
+                salidaLimpia ? "limpia" : "anormal", resultado ? "OK" : "FALLO");
+    if (!resultado)
+    {
+        std::printf("--- salida del decodificador ---\n%s\n", hijo.texto);
+    }
+    return resultado;
+}
+
+/**
+ * @brief Detiene con SIGTERM una recepción sin trama F
+ * @param decodificador Ruta del ejecutable
+ * @return true si el decodificador conservó el mensaje y salió con 0
+ */
+static bool probarInterrupcion(const char* decodificador)
+{
+    DecodificadorHijo hijo;
+    if (!lanzarDecodificador(&hijo, decodificador, nullptr))
+    {
+        std::printf("SIGTERM: no se pudo lanzar el decodificador\n");
+        return false;
+    }
+
+    bool enviado = esperarTexto(&hijo, "Esperando transmision") && transmitir(&hijo, false);
+    usleep(200000);
+    kill(hijo.proceso, SIGTERM);
+    bool interrumpido = enviado && esperarTexto(&hijo, MENSAJE_ESPERADO) &&
+                        std::strstr(hijo.texto, "Recepcion interrumpida") != nullptr;
+    bool salidaLimpia = recogerDecodificador(&hijo);
+
+    bool resultado = interrumpido && salidaLimpia;
+    std::printf("SIGTERM sin trama F: %s, salida %s -> %s\n",
+                interrumpido ? "mensaje conservado" : "mensaje NO conservado",
+                salidaLimpia ? "limpia" : "anormal", resultado ? "OK" : "FALLO");
+    if (!resultado)
+    {
+        std::printf("--- salida del decodificador ---\n%s\n", hijo.texto);
+    }
+    return resultado;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        std::printf("Uso: %s RUTA_DEL_DECODIFICADOR\n", argv[0]);
+        return 1;
+    }
+
+    bool bucle = probarTransmision(argv[1], nullptr);
+    bool bajaLatencia = probarTransmision(argv[1], "--baja-latencia");
+    bool interrupcion = probarInterrupcion(argv[1]);
+    return (bucle && bajaLatencia && interrupcion) ? 0 : 1;
+}
@@ -0,0 +1,68 @@
+#!/bin/sh
+# Compilación optimizada con LTO y PGO, y comparación de rendimiento.
+#
+# Uso: scripts/pgo.sh [opciones extra de cmake]
+#   PRT7_MARCH=native scripts/pgo.sh
+#   scripts/pgo.sh -DPRT7_ESTANDAR_CXX=17
+#
+# 1. Compila la referencia (preset "release").
+# 2. Compila el binario instrumentado (preset "pgo-generar") y lo
+#    entrena con una carga sintética distinta de la de medición.
+# 3. Recompila con LTO y los perfiles (preset "pgo-usar").
+# 4. Mide ambos con banco_decodificacion e informa la mejora.
+#
+# El decodificador optimizado queda en compilacion/pgo-usar/.
+
+set -e
+
+raiz=$(cd "$(dirname "$0")/.." && pwd)
+cd "$raiz"
+
+extra="$*"
+if [ -n "$PRT7_MARCH" ]; then
+    extra="$extra -DPRT7_MARCH=$PRT7_MARCH"
+fi
+
+perfiles="$raiz/compilacion/perfiles"
+tramas=${TRAMAS:-2000000}
+
+compilar() {
+    # $extra se expande sin comillas a propósito: son varias opciones
+    cmake --preset "$1" $extra >/dev/null
+    cmake --build --preset "$1" -j >/dev/null
+}
+
+echo "== Referencia (Release)"
+compilar release
+
+echo "== Fase 1: binario instrumentado"
+rm -rf "$perfiles"
+compilar pgo-generar
+
+echo "== Entrenamiento con carga sintetica"
+entrenador=compilacion/pgo-generar/banco_decodificacion
+"$entrenador" --tramas=500000 --repeticiones=2 --semilla=11 >/dev/null
+"$entrenador" --tramas=500000 --repeticiones=2 --semilla=12 --integridad >/dev/null
+"$entrenador" --tramas=200000 --repeticiones=1 --semilla=13 --rotores=3 >/dev/null
+
+# Clang deja perfiles crudos que hay que combinar
+if ls "$perfiles"/*.profraw >/dev/null 2>&1; then
+    llvm-profdata merge -output="$perfiles/prt7.profdata" "$perfiles"/*.profraw
+fi
+
+echo "== Fase 2: LTO con perfiles"
+compilar pgo-usar
+
+medir() {
+    "$1" --tramas="$tramas" --repeticiones=5 $2 | sed -n 's/^tramas\/s: //p'
+}
+
+echo
+printf '%-22s %14s %14s %8s\n' "Carga" "Release" "LTO+PGO" "Mejora"
+for carga in "" "--integridad"; do
+    antes=$(medir compilacion/release/banco_decodificacion "$carga")
+    despues=$(medir compilacion/pgo-usar/banco_decodificacion "$carga")
+    mejora=$(awk -v a="$antes" -v d="$despues" 'BEGIN { printf "%+.1f%%", (d - a) * 100.0 / a }')
+    printf '%-22s %14s %14s %8s\n' "${carga:-sin integridad}" "$antes" "$despues" "$mejora"
+done
+echo "(tramas por segundo, mejor de 5 repeticiones de $tramas tramas)"
@@ -0,0 +1,152 @@
+/**
+ * @file AnalizadorTramas.cpp
+ * @brief Implementación del análisis de líneas del protocolo PRT-7
+ * @author Tu Nombre
+ * @date 2024
+ */
+
+#include "AnalizadorTramas.h"
+#include "PaqueteCaracter.h"
+#include "PaqueteRotacion.h"
+#include "PaqueteFinalizacion.h"
+#include "PaqueteRotor.h"
+#include "PaqueteSincronizacion.h"
+#include "PaqueteBloque.h"
+#include <cstdlib>
+#include <cstring>
+
+void eliminarEspaciosFinales(char* texto)
+{
+    int longitud = 0;
+    while (texto[longitud] != '\0')
+    {
+        longitud++;
+    }
+    
+    if (longitud == 0)
+        return;
+    
+    longitud--;
+    while (longitud >= 0 && 
+           (texto[longitud] == ' ' || texto[longitud] == '\t' ||
+            texto[longitud] == '\r' || texto[longitud] == '\n'))
+    {
+        texto[longitud] = '\0';
+        longitud--;
+    }
+}
+
+PaqueteBase* analizarPaquete(const char* lineaTexto)
+{
+    // Validar entrada
+    if (lineaTexto == nullptr || lineaTexto[0] == '\0')
+    {
+        return nullptr;
+    }
+
+    // Copiar a buffer de trabajo
+    char bufferTrabajo[128];
+    int indice = 0;
+    while (lineaTexto[indice] != '\0' && indice < 127)
+    {
+        bufferTrabajo[indice] = lineaTexto[indice];
+        indice++;
+    }
+    bufferTrabajo[indice] = '\0';
+
+    // Verificar longitud mínima
+    if (indice < 3)
+    {
+        return nullptr;
+    }
+
+    // Extraer tipo de paquete
+    char tipoPaquete = bufferTrabajo[0];
+    
+    // Buscar separador
+    int posicionSeparador = buscarCaracter(bufferTrabajo, ',');
+    
+    if (posicionSeparador == -1 || posicionSeparador >= indice - 1)
+    {
+        return nullptr;
+    }
+
+    // Extraer contenido después del separador
+    const char* contenido = &bufferTrabajo[posicionSeparador + 1];
+
+    // Crear paquete según tipo
+    if (tipoPaquete == 'L' || tipoPaquete == 'l')
+    {
+        // Paquete de carácter
+        if (contenido[0] != '\0')
+        {
+            return new PaqueteCaracter(contenido[0]);
+        }
+    }
+    else if (tipoPaquete == 'M' || tipoPaquete == 'm')
+    {
+        // Paquete de rotación
+        int valorRotacion = convertirAEntero(contenido);
+        return new PaqueteRotacion(valorRotacion);
+    }
+    else if (tipoPaquete == 'F' || tipoPaquete == 'f')
+    {
+        // Paquete de fin de mensaje
+        return new PaqueteFinalizacion(convertirAEntero(contenido));
+    }
+    else if (tipoPaquete == 'R' || tipoPaquete == 'r')
+    {
+        // Paquete de rotación dirigida: "R,<rotor>,<n>"
+        int posicionSegundo = buscarCaracter(contenido, ',');
+        if (posicionSegundo > 0 && contenido[posicionSegundo + 1] != '\0')
+        {
+            int indiceRotor = convertirAEntero(contenido);
+            int valorRotacion = convertirAEntero(&contenido[posicionSegundo + 1]);
+            return new PaqueteRotor(indiceRotor, valorRotacion);
+        }
+    }
+    else if (tipoPaquete == 'S' || tipoPaquete == 's')
+    {
+        // Paquete de sincronización con la rotación absoluta: un valor
+        // ilegible no puede tomarse como 0, porque rebobinaría el disco
+        if (esEnteroDecimal(contenido))
+        {
+            return new PaqueteSincronizacion(convertirAEntero(contenido));
+        }
+    }
+    else if (tipoPaquete == 'B' || tipoPaquete == 'b')
+    {
+        // Paquete de bloque: todo lo que sigue a la primera coma
+        int longitudBloque = indice - (posicionSeparador + 1);
+        if (lineaTexto[indice] == '\0' && longitudBloque <= LONGITUD_MAXIMA_BLOQUE)
+        {
+            return new PaqueteBloque(contenido, longitudBloque);
+        }
+    }
+
+    return nullptr;
+}
+
+bool analizarAnuncioPerfil(const char* lineaTexto, long* velocidad, 
+                           bool* controlFlujo, int* rafaga)
+{
+    if (std::strncmp(lineaTexto, "#PRT7,PERFIL,", 13) != 0)
+    {
+        return false;
+    }
+
+    const char* campo = lineaTexto + 13;
+    *velocidad = std::atol(campo);
+
+    int separador = buscarCaracter(campo, ',');
+    if (*velocidad <= 0 || separador < 0)
+    {
+        return false;
+    }
+    campo += separador + 1;
+    *controlFlujo = (convertirAEntero(campo) != 0);
+
+    separador = buscarCaracter(campo, ',');
+    *rafaga = (separador < 0) ? 0 : convertirAEntero(campo + separador + 1);
+    return true;
+}
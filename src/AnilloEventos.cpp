@@ -0,0 +1,131 @@
+/**
+ * @file AnilloEventos.cpp
+ * @brief Implementación del lado escritor del anillo de eventos
+ * @author Tu Nombre
+ * @date 2024
+ */
+
+#include "AnilloEventos.h"
+#include "ContabilidadMemoria.h"
+#include <cstdio>
+#include <cstring>
+#include <new>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+unsigned long long instanteAnillo()
+{
+#ifndef _WIN32
+    struct timespec ahora;
+    clock_gettime(CLOCK_MONOTONIC, &ahora);
+    return (unsigned long long)ahora.tv_sec * 1000000000ULL + (unsigned long long)ahora.tv_nsec;
+#else
+    return 0;
+#endif
+}
+
+AnilloEventos::AnilloEventos(const char* nombreObjeto, unsigned int capacidadRanuras)
+{
+    std::snprintf(nombre, sizeof(nombre), "%s", nombreObjeto);
+    cabecera = nullptr;
+    ranuras = nullptr;
+    siguiente = 0;
+    tamano = 0;
+
+    unsigned int capacidad = 2;
+    while (capacidad < capacidadRanuras && capacidad < (1u << 30))
+    {
+        capacidad *= 2;
+    }
+    mascara = capacidad - 1;
+
+#ifndef _WIN32
+    // Un objeto abandonado por una ejecución anterior se reemplaza
+    shm_unlink(nombre);
+    int descriptor = shm_open(nombre, O_RDWR | O_CREAT | O_EXCL, 0644);
+    if (descriptor < 0)
+        return;
+
+    unsigned long long bytes = sizeof(CabeceraAnillo) + (unsigned long long)capacidad * sizeof(RanuraAnillo);
+    void* memoria = MAP_FAILED;
+    if (ftruncate(descriptor, (off_t)bytes) == 0)
+    {
+        memoria = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+    }
+    close(descriptor);
+    if (memoria == MAP_FAILED)
+    {
+        shm_unlink(nombre);
+        return;
+    }
+    tamano = bytes;
+
+    // ftruncate() deja el objeto en ceros: todas las ranuras vacías
+    cabecera = new (memoria) CabeceraAnillo;
+    std::strcpy(cabecera->marca, "PRT7ANI");
+    cabecera->version = VERSION_ANILLO;
+    cabecera->capacidad = capacidad;
+    cabecera->publicados.store(0, std::memory_order_relaxed);
+    ranuras = (RanuraAnillo*)((char*)memoria + sizeof(CabeceraAnillo));
+
+    ContabilidadMemoria::registrarReserva(MEMORIA_ENTRADA_SALIDA, (size_t)tamano, 1);
+#else
+    (void)capacidadRanuras;
+#endif
+}
+
+AnilloEventos::~AnilloEventos()
+{
+#ifndef _WIN32
+    if (cabecera != nullptr)
+    {
+        ContabilidadMemoria::registrarLiberacion(MEMORIA_ENTRADA_SALIDA, (size_t)tamano, 1);
+        munmap(cabecera, tamano);
+        shm_unlink(nombre);
+    }
+#endif
+}
+
+bool AnilloEventos::estaOperativo() const
+{
+    return cabecera != nullptr;
+}
+
+void AnilloEventos::publicar(char tipo, char caracter, int valor, int paquete)
+{
+    if (cabecera == nullptr)
+        return;
+
+    unsigned long long secuencia = siguiente++;
+    RanuraAnillo& ranura = ranuras[secuencia & mascara];
+
+    // Un lector que copie la ranura ahora verá cambiar su secuencia
+    ranura.secuencia.store(RANURA_OCUPADA, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    ranura.instante.store(instanteAnillo(), std::memory_order_relaxed);
+    ranura.numeros.store((unsigned long long)(unsigned int)paquete |
+                         ((unsigned long long)(unsigned int)valor << 32),
+                         std::memory_order_relaxed);
+    ranura.simbolos.store((unsigned long long)(unsigned char)tipo |
+                          ((unsigned long long)(unsigned char)caracter << 8),
+                          std::memory_order_relaxed);
+
+    ranura.secuencia.store(secuencia + 1, std::memory_order_release);
+    cabecera->publicados.store(secuencia + 1, std::memory_order_release);
+}
+
+unsigned long long AnilloEventos::obtenerPublicados() const
+{
+    return siguiente;
+}
+
+unsigned int AnilloEventos::obtenerCapacidad() const
+{
+    return (unsigned int)(mascara + 1);
+}
@@ -0,0 +1,300 @@
+/**
+ * @file ArchivadorTramas.cpp
+ * @brief Implementación del archivador de tramas
+ * @author Tu Nombre
+ * @date 2024
+ */
+
+#include "ArchivadorTramas.h"
+#include "PaqueteBloque.h"
+#include "PaqueteRotor.h"
+#include "ContabilidadMemoria.h"
+#include <cstring>
+#include <new>
+
+/// Cuerpo reservado al crear el archivador
+const size_t CAPACIDAD_INICIAL_CUERPO = 64 * 1024;
+
+/// Bytes que puede ocupar una trama en el cuerpo (bloque B completo y su tramo)
+const size_t MAXIMA_TRAMA_ARCHIVO = LONGITUD_MAXIMA_BLOQUE + 16;
+
+ArchivadorTramas::ArchivadorTramas(const char* ruta, SesionDecodificacion* sesionObservada,
+                                   ObservadorSesion* observadorSiguiente)
+{
+    sesion = sesionObservada;
+    siguiente = observadorSiguiente;
+    operativo = false;
+    cuerpo = nullptr;
+    capacidadCuerpo = 0;
+    bytesCuerpo = 0;
+    inicioTramo = 0;
+    tipoTramo = -1;
+    tramasTramo = 0;
+    rotacionVigente = sesion->obtenerDisco().obtenerDesplazamiento();
+
+    std::memset(&bloque, 0, sizeof(bloque));
+    bloque.rotacionInicial = (unsigned char)rotacionVigente;
+    bloque.rotacionFinal = (unsigned char)rotacionVigente;
+
+    std::memset(&cabecera, 0, sizeof(cabecera));
+    std::strcpy(cabecera.marca, "PRT7ARC");
+    cabecera.version = 1;
+
+    archivo = std::fopen(ruta, "wb");
+    if (archivo == nullptr)
+        return;
+
+    cuerpo = new (std::nothrow) unsigned char[CAPACIDAD_INICIAL_CUERPO];
+    if (cuerpo == nullptr)
+        return;
+    capacidadCuerpo = CAPACIDAD_INICIAL_CUERPO;
+    ContabilidadMemoria::registrarReserva(MEMORIA_ENTRADA_SALIDA, capacidadCuerpo, 1);
+
+    // Los totales se completan al cerrar
+    operativo = (std::fwrite(&cabecera, sizeof(cabecera), 1, archivo) == 1);
+}
+
+ArchivadorTramas::~ArchivadorTramas()
+{
+    cerrar();
+    if (cuerpo != nullptr)
+    {
+        ContabilidadMemoria::registrarLiberacion(MEMORIA_ENTRADA_SALIDA, capacidadCuerpo, 1);
+        delete[] cuerpo;
+    }
+}
+
+bool ArchivadorTramas::estaOperativo() const
+{
+    return operativo;
+}
+
+bool ArchivadorTramas::reservarCuerpo(size_t cantidad)
+{
+    if (bytesCuerpo + cantidad <= capacidadCuerpo)
+        return true;
+
+    size_t nuevaCapacidad = capacidadCuerpo * 2;
+    while (nuevaCapacidad < bytesCuerpo + cantidad)
+    {
+        nuevaCapacidad *= 2;
+    }
+    unsigned char* ampliado = new (std::nothrow) unsigned char[nuevaCapacidad];
+    if (ampliado == nullptr)
+        return false;
+
+    std::memcpy(ampliado, cuerpo, bytesCuerpo);
+    ContabilidadMemoria::registrarLiberacion(MEMORIA_ENTRADA_SALIDA, capacidadCuerpo, 1);
+    ContabilidadMemoria::registrarReserva(MEMORIA_ENTRADA_SALIDA, nuevaCapacidad, 1);
+    delete[] cuerpo;
+    cuerpo = ampliado;
+    capacidadCuerpo = nuevaCapacidad;
+    return true;
+}
+
+void ArchivadorTramas::agregarEntero(int valor)
+{
+    // Zigzag: los giros cortos de cualquier signo ocupan un byte
+    unsigned int codigo = (valor < 0) ? ((unsigned int)(-(valor + 1)) << 1) | 1u
+                                      : (unsigned int)valor << 1;
+    while (codigo >= 0x80)
+    {
+        cuerpo[bytesCuerpo++] = (unsigned char)(codigo | 0x80);
+        codigo >>= 7;
+    }
+    cuerpo[bytesCuerpo++] = (unsigned char)codigo;
+}
+
+void ArchivadorTramas::abrirTrama(int codigo)
+{
+    if (codigo == tipoTramo && tramasTramo < MAXIMO_TRAMO_ARCHIVO)
+    {
+        // La cantidad del tramo vive en los 5 bits bajos de su byte
+        cuerpo[inicioTramo]++;
+        tramasTramo++;
+    }
+    else
+    {
+        inicioTramo = bytesCuerpo;
+        cuerpo[bytesCuerpo++] = (unsigned char)(codigo << 5);
+        tipoTramo = codigo;
+        tramasTramo = 1;
+    }
+    bloque.tramas++;
+}
+
+void ArchivadorTramas::cerrarBloque()
+{
+    if (bloque.tramas == 0)
+        return;
+
+    bloque.bytesCuerpo = (unsigned int)bytesCuerpo;
+    if (std::fwrite(&bloque, sizeof(bloque), 1, archivo) != 1 ||
+        std::fwrite(cuerpo, 1, bytesCuerpo, archivo) != bytesCuerpo)
+    {
+        operativo = false;
+    }
+    cabecera.bloques++;
+    cabecera.tramas += bloque.tramas;
+    cabecera.caracteres += bloque.caracteres;
+
+    // El bloque siguiente parte de la rotación en que terminó este
+    bytesCuerpo = 0;
+    tipoTramo = -1;
+    tramasTramo = 0;
+    std::memset(&bloque, 0, sizeof(bloque));
+    bloque.rotacionInicial = (unsigned char)rotacionVigente;
+    bloque.rotacionFinal = (unsigned char)rotacionVigente;
+}
+
+bool ArchivadorTramas::cerrar()
+{
+    if (archivo == nullptr)
+        return operativo;
+
+    if (operativo)
+    {
+        cerrarBloque();
+        if (std::fseek(archivo, 0, SEEK_SET) != 0 ||
+            std::fwrite(&cabecera, sizeof(cabecera), 1, archivo) != 1)
+        {
+            operativo = false;
+        }
+    }
+    if (std::fclose(archivo) != 0)
+    {
+        operativo = false;
+    }
+    archivo = nullptr;
+    return operativo;
+}
+
+long long ArchivadorTramas::obtenerTramas() const
+{
+    return cabecera.tramas + bloque.tramas;
+}
+
+int ArchivadorTramas::obtenerBloques() const
+{
+    return (int)cabecera.bloques;
+}
+
+void ArchivadorTramas::alEjecutarPaquete(const PaqueteBase& paquete, int paquetesRecibidos)
+{
+    if (operativo && archivo != nullptr)
+    {
+        if (!reservarCuerpo(MAXIMA_TRAMA_ARCHIVO))
+        {
+            operativo = false;
+        }
+    }
+
+    if (operativo && archivo != nullptr)
+    {
+        switch (paquete.obtenerTipo())
+        {
+        case 'L':
+            abrirTrama(ARCHIVO_CARACTER);
+            cuerpo[bytesCuerpo++] = (unsigned char)paquete.obtenerValor();
+            bloque.caracteres++;
+            break;
+
+        case 'B':
+        {
+            const PaqueteBloque& paqueteBloque = static_cast<const PaqueteBloque&>(paquete);
+            int longitud = paqueteBloque.obtenerValor();
+            abrirTrama(ARCHIVO_BLOQUE);
+            cuerpo[bytesCuerpo++] = (unsigned char)longitud;
+            std::memcpy(&cuerpo[bytesCuerpo], paqueteBloque.obtenerTextoTransportado(), longitud);
+            bytesCuerpo += longitud;
+            bloque.caracteres += longitud;
+            break;
+        }
+
+        case 'M':
+            abrirTrama(ARCHIVO_ROTACION);
+            agregarEntero(paquete.obtenerValor());
+            break;
+
+        case 'S':
+            abrirTrama(ARCHIVO_SINCRONIZACION);
+            agregarEntero(paquete.obtenerValor());
+            break;
+
+        case 'R':
+            abrirTrama(ARCHIVO_ROTOR);
+            agregarEntero(static_cast<const PaqueteRotor&>(paquete).obtenerIndiceRotor());
+            agregarEntero(paquete.obtenerValor());
+            break;
+
+        case 'F':
+            abrirTrama(ARCHIVO_FIN);
+            break;
+
+        default:
+            break;
+        }
+
+        rotacionVigente = sesion->obtenerDisco().obtenerDesplazamiento();
+        bloque.rotacionFinal = (unsigned char)rotacionVigente;
+        if (bloque.tramas >= (unsigned int)TRAMAS_POR_BLOQUE_ARCHIVO)
+        {
+            cerrarBloque();
+        }
+    }
+
+    if (siguiente != nullptr)
+    {
+        siguiente->alEjecutarPaquete(paquete, paquetesRecibidos);
+    }
+}
+
+void ArchivadorTramas::alDescartarLinea(const char* linea, bool corrupta)
+{
+    if (siguiente != nullptr)
+    {
+        siguiente->alDescartarLinea(linea, corrupta);
+    }
+}
+
+void ArchivadorTramas::alDetectarHueco(int tramasPerdidas)
+{
+    if (siguiente != nullptr)
+    {
+        siguiente->alDetectarHueco(tramasPerdidas);
+    }
+}
+
+void ArchivadorTramas::alResincronizar(int rotacionPrevia, int rotacionActual, int caracteresAfectados)
+{
+    if (siguiente != nullptr)
+    {
+        siguiente->alResincronizar(rotacionPrevia, rotacionActual, caracteresAfectados);
+    }
+}
+
+bool ArchivadorTramas::alAnunciarPerfil(long velocidad, bool controlFlujo, int rafaga)
+{
+    if (siguiente != nullptr)
+    {
+        return siguiente->alAnunciarPerfil(velocidad, controlFlujo, rafaga);
+    }
+    return false;
+}
+
+void ArchivadorTramas::alRepetirCiclo(const char* texto, int longitud, int repeticiones)
+{
+    operativo = false;
+    if (siguiente != nullptr)
+    {
+        siguiente->alRepetirCiclo(texto, longitud, repeticiones);
+    }
+}
+
+void ArchivadorTramas::alCompletarTransmision(bool porInactividad)
+{
+    if (siguiente != nullptr)
+    {
+        siguiente->alCompletarTransmision(porInactividad);
+    }
+}
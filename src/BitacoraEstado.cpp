@@ -0,0 +1,208 @@
+/**
+ * @file BitacoraEstado.cpp
+ * @brief Implementación de la bitácora incremental de estado
+ * @author Tu Nombre
+ * @date 2024
+ */
+
+#include "BitacoraEstado.h"
+#include "MensajeDecodificado.h"
+#include "DiscoRotatorio.h"
+#include <cstring>
+#include <cstdio>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+/// Marca que identifica el inicio de cada registro ("P7SN")
+static const unsigned int MARCA_INSTANTANEA = 0x4E533750u;
+
+/// Máximo de caracteres que se guardan en un solo registro
+static const int MAXIMO_COLA = 4096;
+
+BitacoraEstado::BitacoraEstado(const char* ruta, int registrosPorLote)
+{
+    std::strncpy(rutaArchivo, ruta, sizeof(rutaArchivo) - 1);
+    rutaArchivo[sizeof(rutaArchivo) - 1] = '\0';
+    archivo = nullptr;
+    caracteresPersistidos = 0;
+    registrosPendientes = 0;
+    registrosPorSincronizacion = (registrosPorLote > 0) ? registrosPorLote : 1;
+}
+
+BitacoraEstado::~BitacoraEstado()
+{
+    if (archivo != nullptr)
+    {
+        sincronizar();
+        std::fclose(archivo);
+    }
+}
+
+unsigned int BitacoraEstado::calcularSuma(const CabeceraInstantanea& cabecera, const char* cola)
+{
+    unsigned int suma = 2166136261u;
+    const int campos[4] = {
+        cabecera.desplazamiento, cabecera.paquetesRecibidos,
+        cabecera.longitudMensaje, cabecera.longitudCola
+    };
+
+    const unsigned char* bytes = (const unsigned char*)campos;
+    for (size_t i = 0; i < sizeof(campos); i++)
+    {
+        suma = (suma ^ bytes[i]) * 16777619u;
+    }
+    for (int i = 0; i < cabecera.longitudCola; i++)
+    {
+        suma = (suma ^ (unsigned char)cola[i]) * 16777619u;
+    }
+    return suma;
+}
+
+int BitacoraEstado::restaurar(MensajeDecodificado* mensaje, DiscoRotatorio* disco)
+{
+    int paquetesRestaurados = 0;
+    long longitudValida = 0;
+    bool registroIncompleto = false;
+
+    std::FILE* lectura = std::fopen(rutaArchivo, "rb");
+    if (lectura != nullptr)
+    {
+        char cola[MAXIMO_COLA];
+        CabeceraInstantanea cabecera;
+
+        while (std::fread(&cabecera, sizeof(cabecera), 1, lectura) == 1)
+        {
+            // Validar cabecera, cola y continuidad con el mensaje actual
+            if (cabecera.marca != MARCA_INSTANTANEA ||
+                cabecera.longitudCola < 0 || cabecera.longitudCola > MAXIMO_COLA ||
+                std::fread(cola, 1, cabecera.longitudCola, lectura) != (size_t)cabecera.longitudCola ||
+                cabecera.suma != calcularSuma(cabecera, cola) ||
+                cabecera.longitudMensaje != mensaje->obtenerLongitud() + cabecera.longitudCola)
+            {
+                registroIncompleto = true;
+                break;
+            }
+
+            for (int i = 0; i < cabecera.longitudCola; i++)
+            {
+                mensaje->agregarCaracter(cola[i]);
+            }
+            disco->girar(cabecera.desplazamiento - disco->obtenerDesplazamiento());
+            paquetesRestaurados = cabecera.paquetesRecibidos;
+            longitudValida = std::ftell(lectura);
+        }
+
+        // Una cabecera truncada al final también cuenta como incompleta
+        if (!registroIncompleto && std::ftell(lectura) != longitudValida)
+        {
+            registroIncompleto = true;
+        }
+        std::fclose(lectura);
+    }
+
+    if (registroIncompleto)
+    {
+        recortarArchivo(longitudValida);
+    }
+
+    caracteresPersistidos = mensaje->obtenerLongitud();
+    archivo = std::fopen(rutaArchivo, "ab");
+    return paquetesRestaurados;
+}
+
+void BitacoraEstado::recortarArchivo(long longitudValida)
+{
+#ifdef _WIN32
+    std::FILE* escritura = std::fopen(rutaArchivo, "r+b");
+    if (escritura != nullptr)
+    {
+        _chsize(_fileno(escritura), longitudValida);
+        std::fclose(escritura);
+    }
+#else
+    if (truncate(rutaArchivo, (off_t)longitudValida) != 0)
+    {
+        // Si no se puede recortar, empezar una bitácora nueva
+        std::remove(rutaArchivo);
+    }
+#endif
+}
+
+bool BitacoraEstado::registrar(const MensajeDecodificado& mensaje, const DiscoRotatorio& disco,
+                               int paquetesRecibidos)
+{
+    if (archivo == nullptr)
+        return false;
+
+    int longitudActual = mensaje.obtenerLongitud();
+    int pendientes = longitudActual - caracteresPersistidos;
+    char cola[MAXIMO_COLA];
+
+    // Un registro por bloque de caracteres nuevos (normalmente uno solo)
+    do
+    {
+        int longitudCola = mensaje.copiarDesde(caracteresPersistidos, cola, MAXIMO_COLA);
+
+        CabeceraInstantanea cabecera;
+        cabecera.marca = MARCA_INSTANTANEA;
+        cabecera.desplazamiento = disco.obtenerDesplazamiento();
+        cabecera.paquetesRecibidos = paquetesRecibidos;
+        cabecera.longitudMensaje = caracteresPersistidos + longitudCola;
+        cabecera.longitudCola = longitudCola;
+        cabecera.suma = calcularSuma(cabecera, cola);
+
+        if (std::fwrite(&cabecera, sizeof(cabecera), 1, archivo) != 1 ||
+            std::fwrite(cola, 1, longitudCola, archivo) != (size_t)longitudCola)
+        {
+            return false;
+        }
+
+        caracteresPersistidos += longitudCola;
+        pendientes -= longitudCola;
+        registrosPendientes++;
+    } while (pendientes > 0);
+
+    // Entregar el registro al sistema ya: si el proceso muere, lo que
+    // quede en el buffer de stdio se pierde; el fsync sí se agrupa
+    if (std::fflush(archivo) != 0)
+        return false;
+
+    if (registrosPendientes >= registrosPorSincronizacion)
+    {
+        sincronizar();
+    }
+    return true;
+}
+
+void BitacoraEstado::sincronizar()
+{
+    if (archivo == nullptr)
+        return;
+
+    std::fflush(archivo);
+#ifdef _WIN32
+    _commit(_fileno(archivo));
+#else
+    fsync(fileno(archivo));
+#endif
+    registrosPendientes = 0;
+}
+
+void BitacoraEstado::descartar()
+{
+    if (archivo != nullptr)
+    {
+        std::fclose(archivo);
+        archivo = nullptr;
+    }
+    std::remove(rutaArchivo);
+}
+
+bool BitacoraEstado::estaOperativa() const
+{
+    return archivo != nullptr;
+}
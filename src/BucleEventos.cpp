@@ -0,0 +1,220 @@
+/**
+ * @file BucleEventos.cpp
+ * @brief Implementación del bucle de eventos con epoll
+ * @author Tu Nombre
+ * @date 2024
+ */
+
+#include "BucleEventos.h"
+#include <chrono>
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+/// Eventos atendidos en cada llamada a epoll_wait
+static const int EVENTOS_POR_ESPERA = 64;
+
+BucleEventos::BucleEventos()
+{
+#ifdef __linux__
+    descriptorEpoll = epoll_create1(EPOLL_CLOEXEC);
+#else
+    descriptorEpoll = -1;
+#endif
+    capacidadRegistros = 8;
+    registros = new RegistroFuente*[capacidadRegistros];
+    cantidadRegistros = 0;
+    detenido = 0;
+}
+
+BucleEventos::~BucleEventos()
+{
+    for (int indice = 0; indice < cantidadRegistros; indice++)
+    {
+        delete registros[indice];
+    }
+    delete[] registros;
+
+#ifdef __linux__
+    if (descriptorEpoll >= 0)
+    {
+        close(descriptorEpoll);
+    }
+#endif
+}
+
+long long BucleEventos::instanteActual()
+{
+    return (long long)std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool BucleEventos::agregarFuente(FuenteEventos* fuente, bool disparoPorFlanco)
+{
+#ifdef __linux__
+    if (descriptorEpoll < 0 || fuente == nullptr)
+        return false;
+
+    // Ampliar el arreglo de registros si está lleno
+    if (cantidadRegistros == capacidadRegistros)
+    {
+        RegistroFuente** ampliado = new RegistroFuente*[capacidadRegistros * 2];
+        for (int indice = 0; indice < cantidadRegistros; indice++)
+        {
+            ampliado[indice] = registros[indice];
+        }
+        delete[] registros;
+        registros = ampliado;
+        capacidadRegistros *= 2;
+    }
+
+    RegistroFuente* registro = new RegistroFuente;
+    registro->fuente = fuente;
+    registro->descriptor = fuente->obtenerDescriptor();
+    registro->ultimaActividad = instanteActual();
+
+    struct epoll_event evento;
+    evento.events = EPOLLIN | EPOLLRDHUP;
+    if (disparoPorFlanco)
+    {
+        evento.events |= EPOLLET;
+    }
+    evento.data.ptr = registro;
+    if (epoll_ctl(descriptorEpoll, EPOLL_CTL_ADD, registro->descriptor, &evento) != 0)
+    {
+        delete registro;
+        return false;
+    }
+
+    registros[cantidadRegistros++] = registro;
+    return true;
+#else
+    (void)fuente;
+    (void)disparoPorFlanco;
+    return false;
+#endif
+}
+
+void BucleEventos::eliminarFuente(FuenteEventos* fuente)
+{
+    for (int indice = 0; indice < cantidadRegistros; indice++)
+    {
+        if (registros[indice]->fuente == fuente)
+        {
+#ifdef __linux__
+            epoll_ctl(descriptorEpoll, EPOLL_CTL_DEL, registros[indice]->descriptor, nullptr);
+#endif
+            // El registro se libera más tarde: puede haber eventos
+            // pendientes del mismo lote que todavía lo referencian
+            registros[indice]->fuente = nullptr;
+            return;
+        }
+    }
+}
+
+void BucleEventos::purgarRetiradas()
+{
+    int destino = 0;
+    for (int indice = 0; indice < cantidadRegistros; indice++)
+    {
+        if (registros[indice]->fuente == nullptr)
+        {
+            delete registros[indice];
+        }
+        else
+        {
+            registros[destino++] = registros[indice];
+        }
+    }
+    cantidadRegistros = destino;
+}
+
+int BucleEventos::calcularEspera(long long ahora) const
+{
+    long long espera = -1;
+    for (int indice = 0; indice < cantidadRegistros; indice++)
+    {
+        const RegistroFuente* registro = registros[indice];
+        if (registro->fuente == nullptr)
+            continue;
+
+        long limite = registro->fuente->obtenerLimiteInactividad();
+        if (limite < 0)
+            continue;
+
+        long long restante = registro->ultimaActividad + limite - ahora;
+        if (restante < 0)
+            restante = 0;
+        if (espera < 0 || restante < espera)
+            espera = restante;
+    }
+    return (int)espera;
+}
+
+void BucleEventos::ejecutar()
+{
+#ifdef __linux__
+    struct epoll_event eventos[EVENTOS_POR_ESPERA];
+    detenido = 0;
+
+    while (!detenido && cantidadRegistros > 0)
+    {
+        int listos = epoll_wait(descriptorEpoll, eventos, EVENTOS_POR_ESPERA,
+                                calcularEspera(instanteActual()));
+        if (listos < 0 && errno != EINTR)
+        {
+            break;
+        }
+
+        long long ahora = instanteActual();
+
+        // Etapa de lectura: despachar las fuentes con datos
+        for (int indice = 0; indice < listos; indice++)
+        {
+            RegistroFuente* registro = (RegistroFuente*)eventos[indice].data.ptr;
+            if (registro->fuente == nullptr)
+                continue;
+
+            registro->ultimaActividad = ahora;
+            if (!registro->fuente->alRecibirDatos())
+            {
+                eliminarFuente(registro->fuente);
+            }
+        }
+
+        // Avisar a las fuentes cuyo tiempo de inactividad venció
+        for (int indice = 0; indice < cantidadRegistros; indice++)
+        {
+            RegistroFuente* registro = registros[indice];
+            if (registro->fuente == nullptr)
+                continue;
+
+            long limite = registro->fuente->obtenerLimiteInactividad();
+            long inactivo = (long)(ahora - registro->ultimaActividad);
+            if (limite >= 0 && inactivo >= limite)
+            {
+                registro->ultimaActividad = ahora;
+                if (!registro->fuente->alAgotarInactividad(inactivo))
+                {
+                    eliminarFuente(registro->fuente);
+                }
+            }
+        }
+
+        purgarRetiradas();
+    }
+#endif
+}
+
+void BucleEventos::detener()
+{
+    detenido = 1;
+}
+
+bool BucleEventos::estaOperativo() const
+{
+    return descriptorEpoll >= 0;
+}
@@ -0,0 +1,259 @@
+/**
+ * @file CacheCiclos.cpp
+ * @brief Implementación del reconocimiento de ciclos repetidos
+ * @author Tu Nombre
+ * @date 2024
+ */
+
+#include "CacheCiclos.h"
+#include "ContabilidadMemoria.h"
+
+/// Base del hash polinómico que encadena las tramas de un ciclo
+static const unsigned long long BASE_HUELLA = 0x9E3779B97F4A7C15ULL;
+
+/**
+ * @brief Huella de una trama (FNV-1a de 64 bits)
+ * @param texto Trama terminada en '\0'
+ * @return Huella de la trama
+ */
+static unsigned long long huellaTrama(const char* texto)
+{
+    unsigned long long valor = 0xCBF29CE484222325ULL;
+    for (int indice = 0; texto[indice] != '\0'; indice++)
+    {
+        valor ^= (unsigned char)texto[indice];
+        valor *= 0x100000001B3ULL;
+    }
+    return valor;
+}
+
+CacheCiclos::CacheCiclos(int ciclosMaximos, int tramasMaximas)
+{
+    maximoCiclos = (ciclosMaximos > 0) ? ciclosMaximos : 1;
+    maximoTramas = (tramasMaximas > 0) ? tramasMaximas : 1;
+    ciclos = new CicloConocido*[maximoCiclos];
+    cantidadCiclos = 0;
+    candidatos = new int[maximoCiclos];
+    ContabilidadMemoria::registrarReserva(MEMORIA_CACHE,
+        (sizeof(CicloConocido*) + sizeof(int)) * maximoCiclos, 0);
+    cantidadCandidatos = 0;
+
+    enCurso = crearCiclo();
+    enCursoValido = true;
+    huella = 0;
+    tramasCiclo = 0;
+    caracteresOmitidos = 0;
+    repeticionesTotales = 0;
+    omitidosTotales = 0;
+}
+
+CacheCiclos::~CacheCiclos()
+{
+    for (int indice = 0; indice < cantidadCiclos; indice++)
+    {
+        liberarCiclo(ciclos[indice]);
+    }
+    delete[] ciclos;
+    delete[] candidatos;
+    ContabilidadMemoria::registrarLiberacion(MEMORIA_CACHE,
+        (sizeof(CicloConocido*) + sizeof(int)) * maximoCiclos, 0);
+    liberarCiclo(enCurso);
+}
+
+CicloConocido* CacheCiclos::crearCiclo()
+{
+    CicloConocido* ciclo = new CicloConocido;
+    ciclo->capacidadTramas = 16;
+    ciclo->prefijos = new unsigned long long[ciclo->capacidadTramas];
+    ciclo->cantidadTramas = 0;
+    ciclo->capacidadTexto = 16;
+    ciclo->texto = new char[ciclo->capacidadTexto];
+    ciclo->longitudTexto = 0;
+    ciclo->desplazamientoInicial = 0;
+    ciclo->repeticiones = 1;
+    ContabilidadMemoria::registrarReserva(MEMORIA_CACHE, sizeof(CicloConocido) +
+        ciclo->capacidadTramas * sizeof(unsigned long long) + ciclo->capacidadTexto, 1);
+    return ciclo;
+}
+
+void CacheCiclos::liberarCiclo(CicloConocido* ciclo)
+{
+    ContabilidadMemoria::registrarLiberacion(MEMORIA_CACHE, sizeof(CicloConocido) +
+        ciclo->capacidadTramas * sizeof(unsigned long long) + ciclo->capacidadTexto, 1);
+    delete[] ciclo->prefijos;
+    delete[] ciclo->texto;
+    delete ciclo;
+}
+
+void CacheCiclos::anotarPrefijo(unsigned long long valor)
+{
+    if (!enCursoValido)
+        return;
+    if (enCurso->cantidadTramas == maximoTramas)
+    {
+        // Demasiado largo para recordarlo: se decodifica sin caché
+        enCursoValido = false;
+        return;
+    }
+
+    if (enCurso->cantidadTramas == enCurso->capacidadTramas)
+    {
+        int capacidad = enCurso->capacidadTramas * 2;
+        unsigned long long* ampliado = new unsigned long long[capacidad];
+        for (int indice = 0; indice < enCurso->cantidadTramas; indice++)
+        {
+            ampliado[indice] = enCurso->prefijos[indice];
+        }
+        delete[] enCurso->prefijos;
+        ContabilidadMemoria::registrarReserva(MEMORIA_CACHE,
+            (capacidad - enCurso->capacidadTramas) * sizeof(unsigned long long), 0);
+        enCurso->prefijos = ampliado;
+        enCurso->capacidadTramas = capacidad;
+    }
+    enCurso->prefijos[enCurso->cantidadTramas++] = valor;
+}
+
+void CacheCiclos::iniciarCiclo(int desplazamiento)
+{
+    huella = 0;
+    tramasCiclo = 0;
+    caracteresOmitidos = 0;
+
+    enCurso->cantidadTramas = 0;
+    enCurso->longitudTexto = 0;
+    enCurso->desplazamientoInicial = desplazamiento;
+    enCurso->repeticiones = 1;
+    enCursoValido = true;
+
+    // Solo un ciclo que partió de la misma rotación puede repetirse
+    cantidadCandidatos = 0;
+    for (int indice = 0; indice < cantidadCiclos; indice++)
+    {
+        if (ciclos[indice]->desplazamientoInicial == desplazamiento)
+        {
+            candidatos[cantidadCandidatos++] = indice;
+        }
+    }
+}
+
+bool CacheCiclos::registrarTrama(const char* texto, const char** pendientes, int* cantidadPendientes)
+{
+    *pendientes = nullptr;
+    *cantidadPendientes = 0;
+
+    int posicion = tramasCiclo++;
+    huella = huella * BASE_HUELLA + huellaTrama(texto);
+
+    if (cantidadCandidatos > 0)
+    {
+        // Todos los candidatos vivos comparten el prefijo recibido
+        CicloConocido* referencia = ciclos[candidatos[0]];
+
+        int vivos = 0;
+        for (int indice = 0; indice < cantidadCandidatos; indice++)
+        {
+            CicloConocido* ciclo = ciclos[candidatos[indice]];
+            if (ciclo->cantidadTramas > posicion && ciclo->prefijos[posicion] == huella)
+            {
+                candidatos[vivos++] = candidatos[indice];
+            }
+        }
+        cantidadCandidatos = vivos;
+        if (cantidadCandidatos > 0)
+            return true;
+
+        // La especulación falló: el prefijo pasa a decodificarse como nuevo
+        for (int indice = 0; indice < posicion; indice++)
+        {
+            anotarPrefijo(referencia->prefijos[indice]);
+        }
+        for (int indice = 0; indice < caracteresOmitidos; indice++)
+        {
+            registrarCaracter(referencia->texto[indice]);
+        }
+        *pendientes = referencia->texto;
+        *cantidadPendientes = caracteresOmitidos;
+        omitidosTotales -= caracteresOmitidos;
+        caracteresOmitidos = 0;
+    }
+
+    anotarPrefijo(huella);
+    return false;
+}
+
+void CacheCiclos::registrarCaracter(char caracter)
+{
+    if (!enCursoValido)
+        return;
+
+    if (enCurso->longitudTexto == enCurso->capacidadTexto)
+    {
+        int capacidad = enCurso->capacidadTexto * 2;
+        char* ampliado = new char[capacidad];
+        for (int indice = 0; indice < enCurso->longitudTexto; indice++)
+        {
+            ampliado[indice] = enCurso->texto[indice];
+        }
+        delete[] enCurso->texto;
+        ContabilidadMemoria::registrarReserva(MEMORIA_CACHE, capacidad - enCurso->capacidadTexto, 0);
+        enCurso->texto = ampliado;
+        enCurso->capacidadTexto = capacidad;
+    }
+    enCurso->texto[enCurso->longitudTexto++] = caracter;
+}
+
+void CacheCiclos::omitirCaracter()
+{
+    caracteresOmitidos++;
+    omitidosTotales++;
+}
+
+const CicloConocido* CacheCiclos::cerrarCiclo()
+{
+    // Los ciclos recordados terminan en su única trama F, así que un
+    // candidato vivo tras la F tiene exactamente las tramas recibidas
+    CicloConocido* repetido = nullptr;
+    for (int indice = 0; indice < cantidadCandidatos && repetido == nullptr; indice++)
+    {
+        if (ciclos[candidatos[indice]]->cantidadTramas == tramasCiclo)
+        {
+            repetido = ciclos[candidatos[indice]];
+        }
+    }
+    cantidadCandidatos = 0;
+
+    if (repetido != nullptr)
+    {
+        repetido->repeticiones++;
+        repeticionesTotales++;
+        return repetido;
+    }
+
+    // Ciclo nuevo: recordarlo si cabe, cediendo el registro en curso
+    if (enCursoValido && tramasCiclo > 0 && cantidadCiclos < maximoCiclos)
+    {
+        ciclos[cantidadCiclos++] = enCurso;
+        enCurso = crearCiclo();
+    }
+    return nullptr;
+}
+
+bool CacheCiclos::estaEspeculando() const
+{
+    return cantidadCandidatos > 0;
+}
+
+int CacheCiclos::obtenerCiclosDistintos() const
+{
+    return cantidadCiclos;
+}
+
+int CacheCiclos::obtenerRepeticiones() const
+{
+    return repeticionesTotales;
+}
+
+long long CacheCiclos::obtenerCaracteresOmitidos() const
+{
+    return omitidosTotales;
+}
@@ -0,0 +1,146 @@
+/**
+ * @file CadenaRotores.cpp
+ * @brief Implementación de la cadena de discos rotatorios
+ * @author Tu Nombre
+ * @date 2024
+ */
+
+#include "CadenaRotores.h"
+#include "ContabilidadMemoria.h"
+
+/// Máximo de rotores admitidos en una cadena
+static const int MAXIMO_ROTORES = 6;
+
+/// Cableados de los rotores posteriores al disco principal
+static const char* const CABLEADOS_ROTORES[MAXIMO_ROTORES - 1] = {
+    "EKMFLGDQVZNTOWYHXUSPAIBRCJ",  // Enigma I
+    "AJDKSIRUXBLHWTMCQGZNPYFVOE",  // Enigma II
+    "BDFHJLCPRTXVZNYEIWGAKMUSQO",  // Enigma III
+    "ESOVPZJAYQUIRHXLNFTGKDCMWB",  // Enigma IV
+    "VZBRGITYUPSDNHLXAWMJQOFECK"   // Enigma V
+};
+
+CadenaRotores::CadenaRotores(int cantidad, bool avanzar)
+{
+    if (cantidad < 1)
+        cantidad = 1;
+    if (cantidad > MAXIMO_ROTORES)
+        cantidad = MAXIMO_ROTORES;
+
+    cantidadRotores = cantidad;
+    avanceAutomatico = avanzar;
+
+    rotores = new DiscoRotatorio*[cantidadRotores];
+    ContabilidadMemoria::registrarReserva(MEMORIA_DISCO,
+        (sizeof(DiscoRotatorio*) + sizeof(DiscoRotatorio)) * cantidadRotores, 0);
+    rotores[0] = new DiscoRotatorio();
+    for (int indice = 1; indice < cantidadRotores; indice++)
+    {
+        rotores[indice] = new DiscoRotatorio(CABLEADOS_ROTORES[indice - 1]);
+    }
+
+    // Los bytes no alfabéticos atraviesan la cadena sin cambios
+    for (int byte = 0; byte < 256; byte++)
+    {
+        tablaCompuesta[byte] = (unsigned char)byte;
+    }
+
+    recomponerPosterior();
+    recomponerTabla();
+}
+
+CadenaRotores::~CadenaRotores()
+{
+    for (int indice = 0; indice < cantidadRotores; indice++)
+    {
+        delete rotores[indice];
+    }
+    delete[] rotores;
+    ContabilidadMemoria::registrarLiberacion(MEMORIA_DISCO,
+        (sizeof(DiscoRotatorio*) + sizeof(DiscoRotatorio)) * cantidadRotores, 0);
+}
+
+void CadenaRotores::recomponerPosterior()
+{
+    for (int letra = 0; letra < 26; letra++)
+    {
+        char simbolo = (char)('A' + letra);
+        for (int indice = 1; indice < cantidadRotores; indice++)
+        {
+            simbolo = rotores[indice]->obtenerCifrado(simbolo);
+        }
+        composicionPosterior[letra] = (unsigned char)simbolo;
+    }
+}
+
+void CadenaRotores::recomponerTabla()
+{
+    DiscoRotatorio* principal = rotores[0];
+    for (int letra = 0; letra < 26; letra++)
+    {
+        char intermedio = principal->obtenerCifrado((char)('A' + letra));
+        unsigned char resultado = composicionPosterior[intermedio - 'A'];
+        tablaCompuesta['A' + letra] = resultado;
+        tablaCompuesta['a' + letra] = (unsigned char)(resultado - 'A' + 'a');
+    }
+}
+
+void CadenaRotores::avanzar()
+{
+    // Odómetro: cada rotor que completa una vuelta arrastra al siguiente
+    int indice = 0;
+    bool acarreo = true;
+    while (acarreo && indice < cantidadRotores)
+    {
+        rotores[indice]->girar(1);
+        acarreo = (rotores[indice]->obtenerDesplazamiento() == 0);
+        indice++;
+    }
+
+    // Solo recomponer los rotores posteriores si alguno se movió
+    if (indice > 1)
+    {
+        recomponerPosterior();
+    }
+    recomponerTabla();
+}
+
+bool CadenaRotores::girarRotor(int indice, int desplazamiento)
+{
+    if (indice < 0 || indice >= cantidadRotores)
+        return false;
+
+    rotores[indice]->girar(desplazamiento);
+    if (indice > 0)
+    {
+        recomponerPosterior();
+    }
+    recomponerTabla();
+    return true;
+}
+
+char CadenaRotores::obtenerCifrado(char caracterOriginal)
+{
+    unsigned char byte = (unsigned char)caracterOriginal;
+    char resultado = (char)tablaCompuesta[byte];
+
+    // Solo las letras hacen avanzar la cadena
+    if (avanceAutomatico &&
+        ((byte >= 'A' && byte <= 'Z') || (byte >= 'a' && byte <= 'z')))
+    {
+        avanzar();
+    }
+    return resultado;
+}
+
+int CadenaRotores::obtenerCantidadRotores() const
+{
+    return cantidadRotores;
+}
+
+int CadenaRotores::obtenerDesplazamiento(int indice) const
+{
+    if (indice < 0 || indice >= cantidadRotores)
+        return 0;
+    return rotores[indice]->obtenerDesplazamiento();
+}
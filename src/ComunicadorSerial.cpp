@@ -7,10 +7,67 @@
 
 #include "ComunicadorSerial.h"
 #include <iostream>
+#include <cstring>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <termios.h>
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+#include <linux/serial.h>
+#endif
+
+/// Velocidades que prueba detectarVelocidad(), de mayor a menor
+static const long VELOCIDADES_CONOCIDAS[] = {
+    2000000, 1000000, 500000, 230400, 115200, 57600, 19200, 9600
+};
+
+#ifndef _WIN32
+/**
+ * @brief Traduce baudios a la constante de termios
+ * @param velocidad Baudios
+ * @param constante Recibe el valor speed_t correspondiente
+ * @return false si el sistema no define esa velocidad
+ */
+static bool convertirVelocidad(long velocidad, speed_t* constante)
+{
+    switch (velocidad)
+    {
+    case 9600:    *constante = B9600;    return true;
+    case 19200:   *constante = B19200;   return true;
+    case 38400:   *constante = B38400;   return true;
+    case 57600:   *constante = B57600;   return true;
+    case 115200:  *constante = B115200;  return true;
+    case 230400:  *constante = B230400;  return true;
+#ifdef B500000
+    case 500000:  *constante = B500000;  return true;
+#endif
+#ifdef B921600
+    case 921600:  *constante = B921600;  return true;
+#endif
+#ifdef B1000000
+    case 1000000: *constante = B1000000; return true;
+#endif
+#ifdef B2000000
+    case 2000000: *constante = B2000000; return true;
+#endif
+    default:
+        return false;
+    }
+}
+#endif
 
 ComunicadorSerial::ComunicadorSerial(const char* nombrePuerto)
 {
     conexionActiva = false;
+    velocidadActual = 9600;
+    controlFlujo = false;
+    bajaLatencia = false;
 
 #ifdef _WIN32
     // Construir nombre completo del puerto (ej: \\.\COM3)
@@ -60,6 +117,40 @@ ComunicadorSerial::ComunicadorSerial(const char* nombrePuerto)
 
     conexionActiva = true;
     std::cout << "Conexion establecida en " << nombrePuerto << std::endl;
+#else
+    // Construir ruta del dispositivo (ej: ttyUSB0 -> /dev/ttyUSB0)
+    char nombreCompleto[256];
+    if (nombrePuerto[0] == '/')
+    {
+        std::strncpy(nombreCompleto, nombrePuerto, sizeof(nombreCompleto) - 1);
+        nombreCompleto[sizeof(nombreCompleto) - 1] = '\0';
+    }
+    else
+    {
+        std::strcpy(nombreCompleto, "/dev/");
+        std::strncat(nombreCompleto, nombrePuerto, sizeof(nombreCompleto) - 6);
+    }
+
+    // Abrir sin bloqueo y sin convertirlo en terminal de control
+    descriptorPuerto = open(nombreCompleto, O_RDWR | O_NOCTTY | O_NONBLOCK);
+    if (descriptorPuerto < 0)
+    {
+        std::cout << "Error: No se pudo abrir " << nombreCompleto << std::endl;
+        return;
+    }
+
+    if (!configurarParametros())
+    {
+        close(descriptorPuerto);
+        descriptorPuerto = -1;
+        return;
+    }
+
+    // Limpiar buffers residuales
+    tcflush(descriptorPuerto, TCIOFLUSH);
+
+    conexionActiva = true;
+    std::cout << "Conexion establecida en " << nombreCompleto << std::endl;
 #endif
 }
 
@@ -70,6 +161,11 @@ ComunicadorSerial::~ComunicadorSerial()
     {
         CloseHandle(manejadorPuerto);
     }
+#else
+    if (conexionActiva)
+    {
+        close(descriptorPuerto);
+    }
 #endif
 }
 
@@ -87,11 +183,15 @@ bool ComunicadorSerial::configurarParametros()
     }
 
     // Establecer parámetros del protocolo PRT-7
-    parametrosSerial.BaudRate = CBR_9600;     // 9600 baudios
+    parametrosSerial.BaudRate = (DWORD)velocidadActual;  // 9600 baudios por defecto
     parametrosSerial.ByteSize = 8;            // 8 bits de datos
     parametrosSerial.StopBits = ONESTOPBIT;   // 1 bit de parada
     parametrosSerial.Parity = NOPARITY;       // Sin paridad
 
+    // Control de flujo por hardware opcional
+    parametrosSerial.fOutxCtsFlow = controlFlujo ? TRUE : FALSE;
+    parametrosSerial.fRtsControl = controlFlujo ? RTS_CONTROL_HANDSHAKE : RTS_CONTROL_ENABLE;
+
     if (!SetCommState(manejadorPuerto, &parametrosSerial))
     {
         std::cout << "Error al configurar parametros" << std::endl;
@@ -100,9 +200,19 @@ bool ComunicadorSerial::configurarParametros()
 
     // Configurar timeouts para lectura no bloqueante
     COMMTIMEOUTS tiempos = {0};
-    tiempos.ReadIntervalTimeout = 50;
-    tiempos.ReadTotalTimeoutConstant = 200;
-    tiempos.ReadTotalTimeoutMultiplier = 10;
+    if (bajaLatencia)
+    {
+        // MAXDWORD/0/0: ReadFile vuelve al instante con lo que haya
+        tiempos.ReadIntervalTimeout = MAXDWORD;
+        tiempos.ReadTotalTimeoutConstant = 0;
+        tiempos.ReadTotalTimeoutMultiplier = 0;
+    }
+    else
+    {
+        tiempos.ReadIntervalTimeout = 50;
+        tiempos.ReadTotalTimeoutConstant = 200;
+        tiempos.ReadTotalTimeoutMultiplier = 10;
+    }
 
     if (!SetCommTimeouts(manejadorPuerto, &tiempos))
     {
@@ -112,7 +222,51 @@ bool ComunicadorSerial::configurarParametros()
 
     return true;
 #else
-    return false;
+    struct termios parametrosSerial;
+    if (tcgetattr(descriptorPuerto, &parametrosSerial) != 0)
+    {
+        std::cout << "Error al obtener configuracion del puerto" << std::endl;
+        return false;
+    }
+
+    // Modo crudo: sin eco, sin edición de línea ni traducción de bytes
+    speed_t constanteVelocidad;
+    if (!convertirVelocidad(velocidadActual, &constanteVelocidad))
+    {
+        std::cout << "Velocidad no soportada: " << velocidadActual << std::endl;
+        return false;
+    }
+    cfmakeraw(&parametrosSerial);
+    cfsetispeed(&parametrosSerial, constanteVelocidad);
+    cfsetospeed(&parametrosSerial, constanteVelocidad);
+    parametrosSerial.c_cflag &= ~(PARENB | CSTOPB | CSIZE);
+    parametrosSerial.c_cflag |= CS8 | CLOCAL | CREAD;   // 8N1
+
+    // Control de flujo por hardware opcional
+#ifdef CRTSCTS
+    if (controlFlujo)
+    {
+        parametrosSerial.c_cflag |= CRTSCTS;
+    }
+    else
+    {
+        parametrosSerial.c_cflag &= ~CRTSCTS;
+    }
+#endif
+
+    // Lecturas inmediatas: el bucle de eventos decide cuándo leer. Con
+    // VMIN=0 Linux devuelve 0 (como un cierre) al leer sin datos aunque
+    // el descriptor sea no bloqueante; con VMIN=1 devuelve EAGAIN
+    parametrosSerial.c_cc[VMIN] = 1;
+    parametrosSerial.c_cc[VTIME] = 0;
+
+    if (tcsetattr(descriptorPuerto, TCSANOW, &parametrosSerial) != 0)
+    {
+        std::cout << "Error al configurar parametros" << std::endl;
+        return false;
+    }
+
+    return true;
 #endif
 }
 
@@ -172,7 +326,46 @@ bool ComunicadorSerial::capturarLinea(char* buffer, int tamanioBuffer)
     buffer[posicionActual] = '\0';
     return (posicionActual > 0);
 #else
-    return false;
+    if (!conexionActiva)
+        return false;
+
+    int posicionActual = 0;
+    bool lineaCompleta = false;
+
+    // Leer carácter por carácter; esperar como máximo 200 ms por byte,
+    // igual que el timeout total configurado en Windows
+    while (posicionActual < tamanioBuffer - 1 && !lineaCompleta)
+    {
+        struct pollfd espera;
+        espera.fd = descriptorPuerto;
+        espera.events = POLLIN;
+        if (poll(&espera, 1, 200) <= 0)
+        {
+            break;
+        }
+
+        char simboloLeido;
+        if (read(descriptorPuerto, &simboloLeido, 1) != 1)
+        {
+            break;
+        }
+
+        if (simboloLeido == '\r')
+        {
+            continue;
+        }
+        if (simboloLeido == '\n')
+        {
+            lineaCompleta = (posicionActual > 0);
+        }
+        else
+        {
+            buffer[posicionActual++] = simboloLeido;
+        }
+    }
+
+    buffer[posicionActual] = '\0';
+    return (posicionActual > 0);
 #endif
 }
 
@@ -180,3 +373,139 @@ bool ComunicadorSerial::estaOperativo()
 {
     return conexionActiva;
 }
+
+int ComunicadorSerial::leerDisponible(char* destino, int capacidad)
+{
+    if (!conexionActiva)
+        return -1;
+
+#ifdef _WIN32
+    DWORD cantidadLeida = 0;
+    if (!ReadFile(manejadorPuerto, destino, (DWORD)capacidad, &cantidadLeida, NULL))
+    {
+        return -1;
+    }
+    return (int)cantidadLeida;
+#else
+    ssize_t cantidadLeida = read(descriptorPuerto, destino, (size_t)capacidad);
+    if (cantidadLeida < 0)
+    {
+        return (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) ? 0 : -1;
+    }
+    if (cantidadLeida == 0)
+    {
+        // El otro extremo cerró el dispositivo (por ejemplo, un pty)
+        return -1;
+    }
+    return (int)cantidadLeida;
+#endif
+}
+
+int ComunicadorSerial::obtenerDescriptor() const
+{
+#ifdef _WIN32
+    return -1;
+#else
+    return conexionActiva ? descriptorPuerto : -1;
+#endif
+}
+
+bool ComunicadorSerial::configurarPerfil(long velocidad, bool usarControlFlujo)
+{
+    if (!conexionActiva)
+        return false;
+
+    long velocidadAnterior = velocidadActual;
+    bool controlAnterior = controlFlujo;
+    velocidadActual = velocidad;
+    controlFlujo = usarControlFlujo;
+
+    if (!configurarParametros())
+    {
+        // Conservar el perfil que sí funcionaba
+        velocidadActual = velocidadAnterior;
+        controlFlujo = controlAnterior;
+        configurarParametros();
+        return false;
+    }
+
+    // Lo recibido hasta ahora usaba el perfil anterior
+#ifdef _WIN32
+    PurgeComm(manejadorPuerto, PURGE_RXCLEAR);
+#else
+    tcflush(descriptorPuerto, TCIFLUSH);
+#endif
+    return true;
+}
+
+long ComunicadorSerial::obtenerVelocidad() const
+{
+    return velocidadActual;
+}
+
+bool ComunicadorSerial::activarBajaLatencia()
+{
+    if (!conexionActiva)
+        return false;
+
+    bajaLatencia = true;
+    if (!configurarParametros())
+    {
+        bajaLatencia = false;
+        configurarParametros();
+        return false;
+    }
+
+#ifdef __linux__
+    // Opcional: solo los controladores de UART y USB-serie lo implementan
+    struct serial_struct serie;
+    if (ioctl(descriptorPuerto, TIOCGSERIAL, &serie) == 0)
+    {
+        serie.flags |= ASYNC_LOW_LATENCY;
+        ioctl(descriptorPuerto, TIOCSSERIAL, &serie);
+    }
+#endif
+    return true;
+}
+
+long ComunicadorSerial::detectarVelocidad(char* primeraLinea, int tamanioBuffer)
+{
+    int cantidadVelocidades = sizeof(VELOCIDADES_CONOCIDAS) / sizeof(VELOCIDADES_CONOCIDAS[0]);
+
+    for (int i = 0; i < cantidadVelocidades; i++)
+    {
+        if (!configurarPerfil(VELOCIDADES_CONOCIDAS[i], controlFlujo))
+        {
+            continue;
+        }
+
+        // Unas pocas líneas bastan: a la velocidad equivocada solo llega ruido
+        for (int intento = 0; intento < 4; intento++)
+        {
+            if (!capturarLinea(primeraLinea, tamanioBuffer))
+            {
+                break;
+            }
+
+            bool esTrama = (primeraLinea[0] != '\0' && primeraLinea[1] == ',');
+            bool esAnuncio = (std::strncmp(primeraLinea, "#PRT7,", 6) == 0);
+            bool imprimible = true;
+            for (int j = 0; primeraLinea[j] != '\0'; j++)
+            {
+                if (primeraLinea[j] < ' ' || primeraLinea[j] > '~')
+                {
+                    imprimible = false;
+                }
+            }
+
+            if (imprimible && (esTrama || esAnuncio))
+            {
+                return VELOCIDADES_CONOCIDAS[i];
+            }
+        }
+    }
+
+    primeraLinea[0] = '\0';
+    configurarPerfil(9600, controlFlujo);
+    return 0;
+}
@@ -0,0 +1,84 @@
+/**
+ * @file ContabilidadMemoria.cpp
+ * @brief Implementación de la contabilidad de memoria
+ * @author Tu Nombre
+ * @date 2024
+ */
+
+#include "ContabilidadMemoria.h"
+
+ContadorMemoria ContabilidadMemoria::contadores[TOTAL_CATEGORIAS_MEMORIA];
+ContadorMemoria ContabilidadMemoria::total;
+
+void ContabilidadMemoria::actualizarPico(std::atomic<long long>& pico, long long valor)
+{
+    long long anterior = pico.load(std::memory_order_relaxed);
+    while (valor > anterior &&
+           !pico.compare_exchange_weak(anterior, valor, std::memory_order_relaxed))
+    {
+        // compare_exchange_weak recarga 'anterior' al fallar
+    }
+}
+
+void ContabilidadMemoria::registrarReserva(CategoriaMemoria categoria, size_t bytes, int nodos)
+{
+    ContadorMemoria& contador = contadores[categoria];
+    long long cantidad = (long long)bytes;
+
+    actualizarPico(contador.picoBytes, contador.bytes.fetch_add(cantidad, std::memory_order_relaxed) + cantidad);
+    actualizarPico(contador.picoNodos, contador.nodos.fetch_add(nodos, std::memory_order_relaxed) + nodos);
+    actualizarPico(total.picoBytes, total.bytes.fetch_add(cantidad, std::memory_order_relaxed) + cantidad);
+    actualizarPico(total.picoNodos, total.nodos.fetch_add(nodos, std::memory_order_relaxed) + nodos);
+}
+
+void ContabilidadMemoria::registrarLiberacion(CategoriaMemoria categoria, size_t bytes, int nodos)
+{
+    ContadorMemoria& contador = contadores[categoria];
+    contador.bytes.fetch_sub((long long)bytes, std::memory_order_relaxed);
+    contador.nodos.fetch_sub(nodos, std::memory_order_relaxed);
+    total.bytes.fetch_sub((long long)bytes, std::memory_order_relaxed);
+    total.nodos.fetch_sub(nodos, std::memory_order_relaxed);
+}
+
+long long ContabilidadMemoria::obtenerBytes(CategoriaMemoria categoria)
+{
+    return contadores[categoria].bytes.load(std::memory_order_relaxed);
+}
+
+long long ContabilidadMemoria::obtenerPicoBytes(CategoriaMemoria categoria)
+{
+    return contadores[categoria].picoBytes.load(std::memory_order_relaxed);
+}
+
+long long ContabilidadMemoria::obtenerNodos(CategoriaMemoria categoria)
+{
+    return contadores[categoria].nodos.load(std::memory_order_relaxed);
+}
+
+long long ContabilidadMemoria::obtenerPicoNodos(CategoriaMemoria categoria)
+{
+    return contadores[categoria].picoNodos.load(std::memory_order_relaxed);
+}
+
+long long ContabilidadMemoria::obtenerBytesTotales()
+{
+    return total.bytes.load(std::memory_order_relaxed);
+}
+
+long long ContabilidadMemoria::obtenerPicoBytesTotales()
+{
+    return total.picoBytes.load(std::memory_order_relaxed);
+}
+
+const char* ContabilidadMemoria::obtenerNombre(CategoriaMemoria categoria)
+{
+    switch (categoria)
+    {
+        case MEMORIA_DISCO:          return "disco";
+        case MEMORIA_MENSAJE:        return "mensaje";
+        case MEMORIA_PAQUETES:       return "paquetes";
+        case MEMORIA_ENTRADA_SALIDA: return "entrada/salida";
+        case MEMORIA_CACHE:          return "cache de ciclos";
+        default:                     return "desconocida";
+    }
+}
@@ -0,0 +1,241 @@
+/**
+ * @file ControlIntegridad.cpp
+ * @brief Implementación de la verificación de secuencia y CRC
+ * @author Tu Nombre
+ * @date 2024
+ */
+
+#include "ControlIntegridad.h"
+
+/**
+ * @brief Convierte un dígito hexadecimal
+ * @param digito Carácter '0'-'9', 'A'-'F' o 'a'-'f'
+ * @return Valor del dígito, o -1 si no es hexadecimal
+ */
+static int valorHexadecimal(char digito)
+{
+    if (digito >= '0' && digito <= '9')
+        return digito - '0';
+    if (digito >= 'A' && digito <= 'F')
+        return digito - 'A' + 10;
+    if (digito >= 'a' && digito <= 'f')
+        return digito - 'a' + 10;
+    return -1;
+}
+
+/**
+ * @struct TablaCrc
+ * @brief Resultado del CRC-8 (polinomio 0x07) para cada byte posible
+ */
+struct TablaCrc
+{
+    unsigned char valores[256];  ///< CRC de un byte partiendo de ese valor
+
+    TablaCrc()
+    {
+        for (int byte = 0; byte < 256; byte++)
+        {
+            unsigned char crc = (unsigned char)byte;
+            for (int bit = 0; bit < 8; bit++)
+            {
+                crc = (crc & 0x80) ? (unsigned char)((crc << 1) ^ 0x07) : (unsigned char)(crc << 1);
+            }
+            valores[byte] = crc;
+        }
+    }
+};
+
+/**
+ * @brief Tabla compartida del CRC-8
+ * @return Tabla creada en el primer uso
+ */
+static const TablaCrc& tablaCrc()
+{
+    static const TablaCrc tabla;
+    return tabla;
+}
+
+ControlIntegridad::ControlIntegridad(bool sufijoObligatorio)
+{
+    exigirSufijo = sufijoObligatorio;
+    secuenciaEsperada = -1;
+    ultimoHueco = 0;
+    corruptasPendientes = 0;
+    sincronizacionIncierta = false;
+    caracteresInciertos = 0;
+    tramasVerificadas = 0;
+    tramasCorruptas = 0;
+    tramasPerdidas = 0;
+    caracteresAfectados = 0;
+    resincronizaciones = 0;
+}
+
+ResultadoIntegridad ControlIntegridad::verificar(char* linea)
+{
+    ultimoHueco = 0;
+
+    int longitud = 0;
+    while (linea[longitud] != '\0')
+    {
+        longitud++;
+    }
+
+    // El sufijo termina en "*XX"; un '*' en otra posición es contenido
+    int valorAlto = (longitud >= 3) ? valorHexadecimal(linea[longitud - 2]) : -1;
+    int valorBajo = (longitud >= 3) ? valorHexadecimal(linea[longitud - 1]) : -1;
+    if (longitud < 3 || linea[longitud - 3] != '*' || valorAlto < 0 || valorBajo < 0)
+    {
+        if (exigirSufijo)
+        {
+            tramasCorruptas++;
+            corruptasPendientes++;
+            sincronizacionIncierta = true;
+            return INTEGRIDAD_CORRUPTA;
+        }
+        return INTEGRIDAD_SIN_SUFIJO;
+    }
+
+    int finCuerpo = longitud - 3;
+    if (calcularCrc(linea, finCuerpo) != (unsigned char)(valorAlto * 16 + valorBajo))
+    {
+        tramasCorruptas++;
+        corruptasPendientes++;
+        sincronizacionIncierta = true;
+        return INTEGRIDAD_CORRUPTA;
+    }
+
+    // La secuencia es el último campo antes del '*'
+    int inicioSecuencia = finCuerpo;
+    while (inicioSecuencia > 0 && linea[inicioSecuencia - 1] != ',')
+    {
+        inicioSecuencia--;
+    }
+    int secuencia = 0;
+    for (int i = inicioSecuencia; i < finCuerpo; i++)
+    {
+        if (linea[i] < '0' || linea[i] > '9')
+        {
+            // CRC correcto pero sin secuencia: trama mal construida
+            tramasCorruptas++;
+            corruptasPendientes++;
+            return INTEGRIDAD_CORRUPTA;
+        }
+        secuencia = secuencia * 10 + (linea[i] - '0');
+    }
+    // El cuerpo conserva al menos "X,<valor>" antes de la secuencia
+    bool cuerpoCompleto = false;
+    for (int i = 0; i + 1 < inicioSecuencia; i++)
+    {
+        if (linea[i] == ',')
+        {
+            cuerpoCompleto = true;
+        }
+    }
+    if (!cuerpoCompleto || inicioSecuencia == finCuerpo || secuencia > 255)
+    {
+        tramasCorruptas++;
+        corruptasPendientes++;
+        return INTEGRIDAD_CORRUPTA;
+    }
+
+    // Comparar con la secuencia esperada (módulo 256). Las tramas
+    // descartadas por corruptas ocupaban números del hueco: ya se
+    // contaron como corruptas y no se cuentan también como perdidas
+    if (secuenciaEsperada >= 0 && secuencia != secuenciaEsperada)
+    {
+        int hueco = (secuencia - secuenciaEsperada + 256) % 256 - corruptasPendientes;
+        if (hueco > 0)
+        {
+            ultimoHueco = hueco;
+            tramasPerdidas += ultimoHueco;
+            sincronizacionIncierta = true;
+        }
+    }
+    secuenciaEsperada = (secuencia + 1) % 256;
+    corruptasPendientes = 0;
+    tramasVerificadas++;
+
+    // Un transmisor con sufijo lo envía siempre: su ausencia es un daño
+    exigirSufijo = true;
+
+    // Dejar solo el cuerpo de la trama
+    linea[inicioSecuencia - 1] = '\0';
+    return INTEGRIDAD_VALIDA;
+}
+
+int ControlIntegridad::obtenerUltimoHueco() const
+{
+    return ultimoHueco;
+}
+
+void ControlIntegridad::registrarCaracter()
+{
+    if (sincronizacionIncierta)
+    {
+        caracteresInciertos++;
+    }
+}
+
+int ControlIntegridad::registrarSincronizacion(int desplazamientoPrevio, 
+                                               int desplazamientoSincronizado)
+{
+    int afectados = 0;
+    if (desplazamientoPrevio != desplazamientoSincronizado)
+    {
+        // El disco estaba desfasado desde la primera pérdida
+        afectados = caracteresInciertos;
+        caracteresAfectados += afectados;
+        resincronizaciones++;
+    }
+
+    sincronizacionIncierta = false;
+    caracteresInciertos = 0;
+    return afectados;
+}
+
+bool ControlIntegridad::estaIncierto() const
+{
+    return sincronizacionIncierta;
+}
+
+int ControlIntegridad::obtenerCaracteresInciertos() const
+{
+    return caracteresInciertos;
+}
+
+int ControlIntegridad::obtenerTramasVerificadas() const
+{
+    return tramasVerificadas;
+}
+
+int ControlIntegridad::obtenerTramasCorruptas() const
+{
+    return tramasCorruptas;
+}
+
+int ControlIntegridad::obtenerTramasPerdidas() const
+{
+    return tramasPerdidas;
+}
+
+int ControlIntegridad::obtenerCaracteresAfectados() const
+{
+    return caracteresAfectados;
+}
+
+int ControlIntegridad::obtenerResincronizaciones() const
+{
+    return resincronizaciones;
+}
+
+unsigned char ControlIntegridad::calcularCrc(const char* texto, int longitud)
+{
+    // Un byte por consulta: los ocho pasos del polinomio ya están en la tabla
+    const unsigned char* valores = tablaCrc().valores;
+    unsigned char crc = 0;
+    for (int i = 0; i < longitud; i++)
+    {
+        crc = valores[crc ^ (unsigned char)texto[i]];
+    }
+    return crc;
+}
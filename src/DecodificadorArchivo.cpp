@@ -0,0 +1,341 @@
+/**
+ * @file DecodificadorArchivo.cpp
+ * @brief Implementación del decodificador paralelo de archivos de tramas
+ * @author Tu Nombre
+ * @date 2024
+ */
+
+#include "DecodificadorArchivo.h"
+#include "ContabilidadMemoria.h"
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <new>
+#include <thread>
+
+/**
+ * @brief Lee un entero en varint zigzag
+ * @param cursor Posición de lectura (avanza)
+ * @param fin Fin del cuerpo
+ * @param valor Entero leído
+ * @return false si el varint se sale del cuerpo o es demasiado largo
+ */
+static bool leerEntero(const unsigned char*& cursor, const unsigned char* fin, int& valor)
+{
+    unsigned int codigo = 0;
+    for (int desplazamiento = 0; desplazamiento < 35; desplazamiento += 7)
+    {
+        if (cursor >= fin)
+            return false;
+        unsigned char byteLeido = *cursor++;
+        codigo |= (unsigned int)(byteLeido & 0x7F) << desplazamiento;
+        if ((byteLeido & 0x80) == 0)
+        {
+            valor = (codigo & 1u) ? -(int)(codigo >> 1) - 1 : (int)(codigo >> 1);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Estado compartido por los hilos de decodificar()
+ */
+struct TrabajoArchivo
+{
+    std::atomic<int> siguienteBloque; ///< Próximo bloque sin asignar
+    std::atomic<bool> fallo;          ///< Algún bloque no coincidió con su cabecera
+};
+
+DecodificadorArchivo::DecodificadorArchivo(const char* ruta)
+{
+    datos = nullptr;
+    longitudDatos = 0;
+    inicioBloques = nullptr;
+    salidaBloques = nullptr;
+    rotacionFinal = 0;
+    valido = false;
+    std::memset(&cabecera, 0, sizeof(cabecera));
+
+    std::FILE* archivo = std::fopen(ruta, "rb");
+    if (archivo == nullptr)
+        return;
+
+    long longitud = -1;
+    if (std::fseek(archivo, 0, SEEK_END) == 0)
+    {
+        longitud = std::ftell(archivo);
+    }
+    if (longitud < (long)sizeof(CabeceraArchivo) || std::fseek(archivo, 0, SEEK_SET) != 0)
+    {
+        std::fclose(archivo);
+        return;
+    }
+
+    datos = new (std::nothrow) unsigned char[longitud];
+    if (datos == nullptr)
+    {
+        std::fclose(archivo);
+        return;
+    }
+    longitudDatos = (size_t)longitud;
+    ContabilidadMemoria::registrarReserva(MEMORIA_ENTRADA_SALIDA, longitudDatos, 1);
+
+    bool leido = (std::fread(datos, 1, longitudDatos, archivo) == longitudDatos);
+    std::fclose(archivo);
+    if (!leido)
+        return;
+
+    std::memcpy(&cabecera, datos, sizeof(cabecera));
+    if (std::strncmp(cabecera.marca, "PRT7ARC", sizeof(cabecera.marca)) != 0 ||
+        cabecera.version != 1)
+    {
+        return;
+    }
+
+    int bloques = (int)cabecera.bloques;
+    if (bloques < 0)
+        return;
+    inicioBloques = new (std::nothrow) size_t[bloques + 1];
+    salidaBloques = new (std::nothrow) long long[bloques + 1];
+    if (inicioBloques == nullptr || salidaBloques == nullptr)
+        return;
+    ContabilidadMemoria::registrarReserva(MEMORIA_ENTRADA_SALIDA,
+                                          (bloques + 1) * (sizeof(size_t) + sizeof(long long)), 2);
+
+    // Solo se recorren las cabeceras: la salida de cada bloque es la
+    // suma de los caracteres de los anteriores
+    size_t posicion = sizeof(CabeceraArchivo);
+    long long caracteres = 0;
+    long long tramas = 0;
+    rotacionFinal = 0;
+    for (int i = 0; i < bloques; i++)
+    {
+        CabeceraBloqueArchivo bloque;
+        if (longitudDatos - posicion < sizeof(bloque))
+            return;
+        std::memcpy(&bloque, datos + posicion, sizeof(bloque));
+        if (longitudDatos - posicion - sizeof(bloque) < bloque.bytesCuerpo ||
+            bloque.rotacionInicial >= 26 || bloque.rotacionFinal >= 26)
+        {
+            return;
+        }
+
+        inicioBloques[i] = posicion;
+        salidaBloques[i] = caracteres;
+        caracteres += bloque.caracteres;
+        tramas += bloque.tramas;
+        rotacionFinal = bloque.rotacionFinal;
+        posicion += sizeof(bloque) + bloque.bytesCuerpo;
+    }
+    inicioBloques[bloques] = posicion;
+    salidaBloques[bloques] = caracteres;
+
+    valido = (posicion == longitudDatos && caracteres == cabecera.caracteres &&
+              tramas == cabecera.tramas);
+}
+
+DecodificadorArchivo::~DecodificadorArchivo()
+{
+    if (inicioBloques != nullptr && salidaBloques != nullptr)
+    {
+        ContabilidadMemoria::registrarLiberacion(MEMORIA_ENTRADA_SALIDA,
+                                                 (cabecera.bloques + 1) * (sizeof(size_t) + sizeof(long long)), 2);
+    }
+    delete[] inicioBloques;
+    delete[] salidaBloques;
+    if (datos != nullptr)
+    {
+        ContabilidadMemoria::registrarLiberacion(MEMORIA_ENTRADA_SALIDA, longitudDatos, 1);
+        delete[] datos;
+    }
+}
+
+bool DecodificadorArchivo::estaOperativo() const
+{
+    return valido;
+}
+
+bool DecodificadorArchivo::esArchivoTramas(const char* ruta)
+{
+    std::FILE* archivo = std::fopen(ruta, "rb");
+    if (archivo == nullptr)
+        return false;
+
+    char marca[8];
+    bool coincide = (std::fread(marca, sizeof(marca), 1, archivo) == 1 &&
+                     std::memcmp(marca, "PRT7ARC", sizeof(marca)) == 0);
+    std::fclose(archivo);
+    return coincide;
+}
+
+bool DecodificadorArchivo::decodificarBloque(int indice, char* destino, DiscoRotatorio* disco) const
+{
+    CabeceraBloqueArchivo bloque;
+    std::memcpy(&bloque, datos + inicioBloques[indice], sizeof(bloque));
+
+    const unsigned char* cursor = datos + inicioBloques[indice] + sizeof(bloque);
+    const unsigned char* fin = cursor + bloque.bytesCuerpo;
+    char* salida = destino + salidaBloques[indice];
+    char* finSalida = salida + bloque.caracteres;
+    unsigned int tramas = 0;
+
+    disco->establecerDesplazamiento(bloque.rotacionInicial);
+    while (cursor < fin)
+    {
+        int codigo = *cursor >> 5;
+        int cantidad = (*cursor & 0x1F) + 1;
+        cursor++;
+        tramas += cantidad;
+
+        switch (codigo)
+        {
+        case ARCHIVO_CARACTER:
+            // Un tramo de letras sueltas se traduce de una vez
+            if (fin - cursor < cantidad || finSalida - salida < cantidad)
+                return false;
+            disco->traducir((const char*)cursor, salida, cantidad);
+            cursor += cantidad;
+            salida += cantidad;
+            break;
+
+        case ARCHIVO_BLOQUE:
+            for (int i = 0; i < cantidad; i++)
+            {
+                if (cursor >= fin)
+                    return false;
+                int longitud = *cursor++;
+                if (fin - cursor < longitud || finSalida - salida < longitud)
+                    return false;
+                disco->traducir((const char*)cursor, salida, longitud);
+                cursor += longitud;
+                salida += longitud;
+            }
+            break;
+
+        case ARCHIVO_ROTACION:
+        case ARCHIVO_SINCRONIZACION:
+            for (int i = 0; i < cantidad; i++)
+            {
+                int valor;
+                if (!leerEntero(cursor, fin, valor))
+                    return false;
+                if (codigo == ARCHIVO_ROTACION)
+                    disco->girar(valor);
+                else
+                    disco->establecerDesplazamiento(valor);
+            }
+            break;
+
+        case ARCHIVO_ROTOR:
+            for (int i = 0; i < cantidad; i++)
+            {
+                int rotor;
+                int valor;
+                if (!leerEntero(cursor, fin, rotor) || !leerEntero(cursor, fin, valor))
+                    return false;
+                // Con un solo disco, R solo mueve el rotor 0
+                if (rotor == 0)
+                    disco->girar(valor);
+            }
+            break;
+
+        case ARCHIVO_FIN:
+            break;
+
+        default:
+            return false;
+        }
+    }
+
+    return tramas == bloque.tramas && salida == finSalida &&
+           disco->obtenerDesplazamiento() == bloque.rotacionFinal;
+}
+
+long long DecodificadorArchivo::decodificar(char* destino, int hilos) const
+{
+    if (!valido)
+        return -1;
+
+    int bloques = (int)cabecera.bloques;
+    if (hilos <= 0)
+    {
+        hilos = (int)std::thread::hardware_concurrency();
+    }
+    if (hilos > bloques)
+    {
+        hilos = bloques;
+    }
+    if (hilos < 1)
+    {
+        hilos = 1;
+    }
+
+    TrabajoArchivo trabajo;
+    trabajo.siguienteBloque.store(0);
+    trabajo.fallo.store(false);
+
+    // Cada hilo toma el siguiente bloque libre con su propio disco
+    auto trabajar = [this, destino, bloques, &trabajo]()
+    {
+        DiscoRotatorio disco;
+        int indice;
+        while (!trabajo.fallo.load(std::memory_order_relaxed) &&
+               (indice = trabajo.siguienteBloque.fetch_add(1)) < bloques)
+        {
+            if (!decodificarBloque(indice, destino, &disco))
+            {
+                trabajo.fallo.store(true);
+            }
+        }
+    };
+
+    std::thread* auxiliares = nullptr;
+    int lanzados = 0;
+    if (hilos > 1)
+    {
+        auxiliares = new (std::nothrow) std::thread[hilos - 1];
+        if (auxiliares != nullptr)
+        {
+            for (; lanzados < hilos - 1; lanzados++)
+            {
+                auxiliares[lanzados] = std::thread(trabajar);
+            }
+        }
+    }
+
+    // El hilo llamador también trabaja
+    trabajar();
+    for (int i = 0; i < lanzados; i++)
+    {
+        auxiliares[i].join();
+    }
+    delete[] auxiliares;
+
+    return trabajo.fallo.load() ? -1 : cabecera.caracteres;
+}
+
+int DecodificadorArchivo::obtenerBloques() const
+{
+    return (int)cabecera.bloques;
+}
+
+long long DecodificadorArchivo::obtenerTramas() const
+{
+    return cabecera.tramas;
+}
+
+long long DecodificadorArchivo::obtenerCaracteres() const
+{
+    return cabecera.caracteres;
+}
+
+long long DecodificadorArchivo::obtenerBytesArchivo() const
+{
+    return (long long)longitudDatos;
+}
+
+int DecodificadorArchivo::obtenerRotacionFinal() const
+{
+    return rotacionFinal;
+}
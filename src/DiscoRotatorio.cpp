@@ -6,16 +6,134 @@
  */
 
 #include "DiscoRotatorio.h"
+#include "ContabilidadMemoria.h"
+
+// Un disco movido conserva una tabla válida: traducir con él no
+// desreferencia un puntero nulo, solo devuelve los bytes sin cambios
+const unsigned char DiscoRotatorio::tablaIdentidad[256] = {
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+    16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31,
+    32, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47,
+    48, 49, 50, 51, 52, 53, 54, 55, 56, 57, 58, 59, 60, 61, 62, 63,
+    64, 65, 66, 67, 68, 69, 70, 71, 72, 73, 74, 75, 76, 77, 78, 79,
+    80, 81, 82, 83, 84, 85, 86, 87, 88, 89, 90, 91, 92, 93, 94, 95,
+    96, 97, 98, 99, 100, 101, 102, 103, 104, 105, 106, 107, 108, 109, 110, 111,
+    112, 113, 114, 115, 116, 117, 118, 119, 120, 121, 122, 123, 124, 125, 126, 127,
+    128, 129, 130, 131, 132, 133, 134, 135, 136, 137, 138, 139, 140, 141, 142, 143,
+    144, 145, 146, 147, 148, 149, 150, 151, 152, 153, 154, 155, 156, 157, 158, 159,
+    160, 161, 162, 163, 164, 165, 166, 167, 168, 169, 170, 171, 172, 173, 174, 175,
+    176, 177, 178, 179, 180, 181, 182, 183, 184, 185, 186, 187, 188, 189, 190, 191,
+    192, 193, 194, 195, 196, 197, 198, 199, 200, 201, 202, 203, 204, 205, 206, 207,
+    208, 209, 210, 211, 212, 213, 214, 215, 216, 217, 218, 219, 220, 221, 222, 223,
+    224, 225, 226, 227, 228, 229, 230, 231, 232, 233, 234, 235, 236, 237, 238, 239,
+    240, 241, 242, 243, 244, 245, 246, 247, 248, 249, 250, 251, 252, 253, 254, 255
+};
 
 DiscoRotatorio::DiscoRotatorio()
+{
+    inicializar(nullptr);
+}
+
+DiscoRotatorio::DiscoRotatorio(const char* cableadoDisco)
+{
+    inicializar(cableadoDisco);
+}
+
+void DiscoRotatorio::inicializar(const char* cableadoDisco)
 {
     posicionCero = nullptr;
     tamanoAlfabeto = 26;
+    desplazamientoActual = 0;
+    tablasTraduccion = nullptr;
+    tablaActiva = tablaIdentidad;
+
+    // Validar que el cableado sea una permutación de A-Z
+    bool cableadoValido = (cableadoDisco != nullptr);
+    bool letraUsada[26] = {false};
+    for (int indice = 0; cableadoValido && indice < tamanoAlfabeto; indice++)
+    {
+        char letra = cableadoDisco[indice];
+        if (letra < 'A' || letra > 'Z' || letraUsada[letra - 'A'])
+        {
+            cableadoValido = false;
+        }
+        else
+        {
+            letraUsada[letra - 'A'] = true;
+        }
+    }
+    if (cableadoValido && cableadoDisco[tamanoAlfabeto] != '\0')
+    {
+        cableadoValido = false;
+    }
+
+    for (int indice = 0; indice < tamanoAlfabeto; indice++)
+    {
+        cableado[indice] = cableadoValido ? cableadoDisco[indice] : (char)('A' + indice);
+    }
+    cableado[tamanoAlfabeto] = '\0';
+
     construirDisco();
+    construirTablas();
 }
 
 DiscoRotatorio::~DiscoRotatorio()
 {
+    liberarDisco();
+}
+
+DiscoRotatorio::DiscoRotatorio(DiscoRotatorio&& otro)
+{
+    posicionCero = nullptr;
+    tablasTraduccion = nullptr;
+    transferirDesde(otro);
+}
+
+DiscoRotatorio& DiscoRotatorio::operator=(DiscoRotatorio&& otro)
+{
+    if (this != &otro)
+    {
+        liberarDisco();
+        transferirDesde(otro);
+    }
+    return *this;
+}
+
+DiscoRotatorio DiscoRotatorio::clonar() const
+{
+    DiscoRotatorio copia(cableado);
+    copia.girar(desplazamientoActual);
+    return copia;
+}
+
+void DiscoRotatorio::transferirDesde(DiscoRotatorio& otro)
+{
+    posicionCero = otro.posicionCero;
+    tamanoAlfabeto = otro.tamanoAlfabeto;
+    desplazamientoActual = otro.desplazamientoActual;
+    for (int indice = 0; indice <= tamanoAlfabeto; indice++)
+    {
+        cableado[indice] = otro.cableado[indice];
+    }
+    tablasTraduccion = otro.tablasTraduccion;
+    tablaActiva = otro.tablaActiva;
+
+    otro.posicionCero = nullptr;
+    otro.desplazamientoActual = 0;
+    otro.tablasTraduccion = nullptr;
+    otro.tablaActiva = tablaIdentidad;
+}
+
+void DiscoRotatorio::liberarDisco()
+{
+    if (tablasTraduccion != nullptr)
+    {
+        ContabilidadMemoria::registrarLiberacion(MEMORIA_DISCO, (size_t)tamanoAlfabeto * 256, 1);
+    }
+    delete[] tablasTraduccion;
+    tablasTraduccion = nullptr;
+    tablaActiva = tablaIdentidad;
+
     if (posicionCero == nullptr)
         return;
 
@@ -31,9 +149,11 @@ DiscoRotatorio::~DiscoRotatorio()
     while (nodoActual != nullptr)
     {
         ElementoDisco* siguienteNodo = nodoActual->adelante;
+        ContabilidadMemoria::registrarLiberacion(MEMORIA_DISCO, sizeof(ElementoDisco), 1);
         delete nodoActual;
         nodoActual = siguienteNodo;
     }
+    posicionCero = nullptr;
 }
 
 void DiscoRotatorio::construirDisco()
@@ -41,11 +161,12 @@ void DiscoRotatorio::construirDisco()
     ElementoDisco* primerElemento = nullptr;
     ElementoDisco* elementoAnterior = nullptr;
 
-    // Crear los 26 elementos (A-Z)
+    // Crear los 26 elementos según el cableado (A-Z por defecto)
     for (int indice = 0; indice < tamanoAlfabeto; indice++)
     {
         ElementoDisco* nuevoElemento = new ElementoDisco;
-        nuevoElemento->simbolo = 'A' + indice;
+        ContabilidadMemoria::registrarReserva(MEMORIA_DISCO, sizeof(ElementoDisco), 1);
+        nuevoElemento->simbolo = cableado[indice];
         nuevoElemento->adelante = nullptr;
         nuevoElemento->atras = elementoAnterior;
 
@@ -72,9 +193,42 @@ void DiscoRotatorio::construirDisco()
     }
 }
 
+void DiscoRotatorio::construirTablas()
+{
+    tablasTraduccion = new unsigned char[tamanoAlfabeto][256];
+    ContabilidadMemoria::registrarReserva(MEMORIA_DISCO, (size_t)tamanoAlfabeto * 256, 1);
+
+    ElementoDisco* inicioRotacion = posicionCero;
+    for (int rotacion = 0; rotacion < tamanoAlfabeto; rotacion++)
+    {
+        unsigned char* tabla = tablasTraduccion[rotacion];
+
+        // Los bytes no alfabéticos se traducen a sí mismos
+        for (int byte = 0; byte < 256; byte++)
+        {
+            tabla[byte] = (unsigned char)byte;
+        }
+
+        // Recorrer el disco desde la posición cero de esta rotación
+        ElementoDisco* elementoActual = inicioRotacion;
+        for (int posicion = 0; posicion < tamanoAlfabeto; posicion++)
+        {
+            char simbolo = elementoActual->simbolo;
+            tabla['A' + posicion] = (unsigned char)simbolo;
+            tabla['a' + posicion] = (unsigned char)(simbolo - 'A' + 'a');
+            elementoActual = elementoActual->adelante;
+        }
+
+        inicioRotacion = inicioRotacion->adelante;
+    }
+
+    tablaActiva = tablasTraduccion[desplazamientoActual];
+}
+
 void DiscoRotatorio::girar(int desplazamiento)
 {
-    if (posicionCero == nullptr)
+    // Un disco movido ya no tiene tablas
+    if (tablasTraduccion == nullptr)
         return;
 
     // Normalizar el desplazamiento al rango [0, tamanoAlfabeto)
@@ -86,48 +240,27 @@ void DiscoRotatorio::girar(int desplazamiento)
         desplazamiento = tamanoAlfabeto + desplazamiento;
     }
 
-    // Mover el puntero posicionCero
-    for (int paso = 0; paso < desplazamiento; paso++)
-    {
-        posicionCero = posicionCero->adelante;
-    }
+    // La rotación solo elige tabla; la lista no se recorre
+    desplazamientoActual = (desplazamientoActual + desplazamiento) % tamanoAlfabeto;
+    tablaActiva = tablasTraduccion[desplazamientoActual];
 }
 
-char DiscoRotatorio::obtenerCifrado(char caracterOriginal)
+int DiscoRotatorio::obtenerDesplazamiento() const
 {
-    // Caracteres no alfabéticos se retornan sin cambios
-    if ((caracterOriginal < 'A' || caracterOriginal > 'Z') && 
-        (caracterOriginal < 'a' || caracterOriginal > 'z'))
-    {
-        return caracterOriginal;
-    }
-
-    // Manejar minúsculas
-    bool eraMinuscula = false;
-    if (caracterOriginal >= 'a' && caracterOriginal <= 'z')
-    {
-        caracterOriginal = caracterOriginal - 'a' + 'A';  // Convertir a mayúscula
-        eraMinuscula = true;
-    }
-
-    // Calcular la posición del carácter en el alfabeto (0-25)
-    int posicionCaracter = caracterOriginal - 'A';
-
-    // Navegar hasta el elemento correspondiente
-    ElementoDisco* elementoBuscado = posicionCero;
-    for (int contador = 0; contador < posicionCaracter; contador++)
-    {
-        elementoBuscado = elementoBuscado->adelante;
-    }
+    return desplazamientoActual;
+}
 
-    // El carácter cifrado es el símbolo en ese elemento
-    char resultado = elementoBuscado->simbolo;
+void DiscoRotatorio::establecerDesplazamiento(int desplazamiento)
+{
+    // girar() normaliza el desplazamiento relativo
+    girar(desplazamiento - desplazamientoActual);
+}
 
-    // Restaurar minúscula si era necesario
-    if (eraMinuscula)
+void DiscoRotatorio::traducir(const char* origen, char* destino, size_t cantidad) const
+{
+    const unsigned char* tabla = tablaActiva;
+    for (size_t indice = 0; indice < cantidad; indice++)
     {
-        resultado = resultado - 'A' + 'a';
+        destino[indice] = (char)tabla[(unsigned char)origen[indice]];
     }
-
-    return resultado;
 }
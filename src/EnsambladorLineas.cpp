@@ -0,0 +1,105 @@
+/**
+ * @file EnsambladorLineas.cpp
+ * @brief Implementación del ensamblador de líneas
+ * @author Tu Nombre
+ * @date 2024
+ */
+
+#include "EnsambladorLineas.h"
+#include "ContabilidadMemoria.h"
+#include <cstring>
+
+EnsambladorLineas::EnsambladorLineas(int tamanoMaximo)
+{
+    capacidad = (tamanoMaximo > 16) ? tamanoMaximo : 16;
+    almacen = new char[capacidad + 1];
+    ContabilidadMemoria::registrarReserva(MEMORIA_ENTRADA_SALIDA, capacidad + 1, 1);
+    inicioPendiente = 0;
+    finDatos = 0;
+    lineasDescartadas = 0;
+}
+
+EnsambladorLineas::~EnsambladorLineas()
+{
+    ContabilidadMemoria::registrarLiberacion(MEMORIA_ENTRADA_SALIDA, capacidad + 1, 1);
+    delete[] almacen;
+}
+
+char* EnsambladorLineas::reservarEspacio(int* disponible)
+{
+    // Mover los bytes pendientes al inicio para liberar espacio
+    if (inicioPendiente > 0)
+    {
+        std::memmove(almacen, almacen + inicioPendiente, finDatos - inicioPendiente);
+        finDatos -= inicioPendiente;
+        inicioPendiente = 0;
+    }
+
+    // Una línea que ocupa todo el almacén sin terminar se descarta
+    if (finDatos == capacidad)
+    {
+        finDatos = 0;
+        lineasDescartadas++;
+    }
+
+    *disponible = capacidad - finDatos;
+    return almacen + finDatos;
+}
+
+void EnsambladorLineas::confirmar(int cantidad)
+{
+    finDatos += cantidad;
+}
+
+void EnsambladorLineas::agregar(const char* datos, int cantidad)
+{
+    while (cantidad > 0)
+    {
+        int disponible = 0;
+        char* destino = reservarEspacio(&disponible);
+        int tramo = (cantidad < disponible) ? cantidad : disponible;
+        std::memcpy(destino, datos, tramo);
+        confirmar(tramo);
+        datos += tramo;
+        cantidad -= tramo;
+    }
+}
+
+char* EnsambladorLineas::extraerLinea()
+{
+    while (inicioPendiente < finDatos)
+    {
+        char* inicioLinea = almacen + inicioPendiente;
+        char* finLinea = (char*)std::memchr(inicioLinea, '\n', finDatos - inicioPendiente);
+        if (finLinea == nullptr)
+        {
+            return nullptr;
+        }
+
+        inicioPendiente = (int)(finLinea - almacen) + 1;
+
+        // Terminar la línea en su sitio y quitar el retorno de carro
+        *finLinea = '\0';
+        if (finLinea > inicioLinea && finLinea[-1] == '\r')
+        {
+            finLinea[-1] = '\0';
+        }
+
+        if (inicioLinea[0] != '\0')
+        {
+            return inicioLinea;
+        }
+    }
+    return nullptr;
+}
+
+void EnsambladorLineas::descartarPendiente()
+{
+    inicioPendiente = 0;
+    finDatos = 0;
+}
+
+int EnsambladorLineas::obtenerLineasDescartadas() const
+{
+    return lineasDescartadas;
+}
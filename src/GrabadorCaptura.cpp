@@ -0,0 +1,235 @@
+/**
+ * @file GrabadorCaptura.cpp
+ * @brief Implementación del grabador de capturas
+ * @author Tu Nombre
+ * @date 2024
+ */
+
+#include "GrabadorCaptura.h"
+#include "ContabilidadMemoria.h"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef _WIN32
+#include <malloc.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+/// Alineación exigida por O_DIRECT en la mayoría de dispositivos
+const int ALINEACION_BLOQUE = 4096;
+
+/// Tamaño del lote de escritura
+const int TAMANO_LOTE = 64 * 1024;
+
+GrabadorCaptura::GrabadorCaptura(const char* ruta, const char* nombrePuerto, bool intentarDirecto)
+{
+    lote = nullptr;
+    capacidadLote = TAMANO_LOTE;
+    ocupado = 0;
+    accesoDirecto = false;
+    operativo = false;
+    bytesEscritos = 0;
+    registrosGrabados = 0;
+    ultimoVaciado = instanteActual();
+
+#ifdef _WIN32
+    (void)intentarDirecto;
+    archivo = std::fopen(ruta, "wb");
+    if (archivo == nullptr)
+        return;
+    lote = (char*)_aligned_malloc(capacidadLote, ALINEACION_BLOQUE);
+#else
+    descriptor = -1;
+#ifdef O_DIRECT
+    if (intentarDirecto)
+    {
+        // tmpfs y otros sistemas rechazan O_DIRECT: se reintenta sin él
+        descriptor = open(ruta, O_WRONLY | O_CREAT | O_TRUNC | O_DIRECT, 0644);
+        accesoDirecto = (descriptor >= 0);
+    }
+#else
+    (void)intentarDirecto;
+#endif
+    if (descriptor < 0)
+    {
+        descriptor = open(ruta, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    }
+    if (descriptor < 0)
+        return;
+
+    void* memoria = nullptr;
+    if (posix_memalign(&memoria, ALINEACION_BLOQUE, capacidadLote) == 0)
+    {
+        lote = (char*)memoria;
+    }
+#endif
+    if (lote == nullptr)
+        return;
+    ContabilidadMemoria::registrarReserva(MEMORIA_ENTRADA_SALIDA, capacidadLote, 1);
+
+    // La cabecera del archivo es el inicio del primer lote
+    CabeceraCaptura cabecera;
+    std::memset(&cabecera, 0, sizeof(cabecera));
+    std::strcpy(cabecera.marca, "PRT7CAP");
+    cabecera.version = 1;
+    std::strncpy(cabecera.nombrePuerto, nombrePuerto, sizeof(cabecera.nombrePuerto) - 1);
+    std::memcpy(lote, &cabecera, sizeof(cabecera));
+    ocupado = sizeof(cabecera);
+
+    operativo = true;
+}
+
+GrabadorCaptura::~GrabadorCaptura()
+{
+    if (operativo)
+    {
+        vaciar();
+#if !defined(_WIN32) && defined(O_DIRECT)
+        // La cola no ocupa un bloque completo: se escribe sin O_DIRECT
+        if (accesoDirecto && ocupado > 0)
+        {
+            fcntl(descriptor, F_SETFL, fcntl(descriptor, F_GETFL) & ~O_DIRECT);
+        }
+#endif
+        escribirLote(ocupado);
+    }
+
+    if (lote != nullptr)
+    {
+        ContabilidadMemoria::registrarLiberacion(MEMORIA_ENTRADA_SALIDA, capacidadLote, 1);
+    }
+
+#ifdef _WIN32
+    if (archivo != nullptr)
+    {
+        std::fclose(archivo);
+    }
+    _aligned_free(lote);
+#else
+    if (descriptor >= 0)
+    {
+        close(descriptor);
+    }
+    std::free(lote);
+#endif
+}
+
+bool GrabadorCaptura::escribirLote(int cantidad)
+{
+    int escritos = 0;
+    while (escritos < cantidad)
+    {
+#ifdef _WIN32
+        int resultado = (int)std::fwrite(lote + escritos, 1, cantidad - escritos, archivo);
+        if (resultado <= 0)
+#else
+        int resultado = (int)write(descriptor, lote + escritos, cantidad - escritos);
+        if (resultado <= 0)
+#endif
+        {
+            operativo = false;
+            return false;
+        }
+        escritos += resultado;
+    }
+
+    bytesEscritos += cantidad;
+
+    // Conservar lo que no se escribió al inicio del lote
+    std::memmove(lote, lote + cantidad, ocupado - cantidad);
+    ocupado -= cantidad;
+    return true;
+}
+
+bool GrabadorCaptura::estaOperativo() const
+{
+    return operativo;
+}
+
+char* GrabadorCaptura::reservarRegistro(int* disponible)
+{
+    // Garantizar espacio para la cabecera y al menos un bloque de carga
+    if (capacidadLote - ocupado < TAMANO_CABECERA_REGISTRO + ALINEACION_BLOQUE)
+    {
+        vaciar();
+    }
+
+    int libre = capacidadLote - ocupado - TAMANO_CABECERA_REGISTRO;
+    if (libre < 0)
+    {
+        libre = 0;
+    }
+    *disponible = (libre < MAXIMA_CARGA_REGISTRO) ? libre : MAXIMA_CARGA_REGISTRO;
+    return lote + ocupado + TAMANO_CABECERA_REGISTRO;
+}
+
+void GrabadorCaptura::confirmarRegistro(int cantidad, unsigned short puerto)
+{
+    if (!operativo || cantidad <= 0)
+        return;
+
+    unsigned long long instante = instanteActual();
+    unsigned short longitud = (unsigned short)cantidad;
+    char* cabecera = lote + ocupado;
+    std::memcpy(cabecera, &instante, 8);
+    std::memcpy(cabecera + 8, &puerto, 2);
+    std::memcpy(cabecera + 10, &longitud, 2);
+
+    ocupado += TAMANO_CABECERA_REGISTRO + cantidad;
+    registrosGrabados++;
+}
+
+void GrabadorCaptura::registrar(const char* datos, int cantidad, unsigned short puerto)
+{
+    while (operativo && cantidad > 0)
+    {
+        int disponible = 0;
+        char* destino = reservarRegistro(&disponible);
+        int tramo = (cantidad < disponible) ? cantidad : disponible;
+        std::memcpy(destino, datos, tramo);
+        confirmarRegistro(tramo, puerto);
+        datos += tramo;
+        cantidad -= tramo;
+    }
+}
+
+bool GrabadorCaptura::vaciar()
+{
+    if (!operativo)
+        return false;
+
+    // Solo bloques completos: el archivo sigue alineado para O_DIRECT
+    int completos = ocupado - (ocupado % ALINEACION_BLOQUE);
+    if (completos == 0)
+        return true;
+    return escribirLote(completos);
+}
+
+bool GrabadorCaptura::vaciarPeriodico()
+{
+    unsigned long long ahora = instanteActual();
+    if (ahora - ultimoVaciado < (unsigned long long)INTERVALO_VACIADO_CAPTURA_MS * 1000000ULL)
+        return operativo;
+
+    ultimoVaciado = ahora;
+    return vaciar();
+}
+
+int GrabadorCaptura::obtenerRegistros() const
+{
+    return registrosGrabados;
+}
+
+long long GrabadorCaptura::obtenerBytesEscritos() const
+{
+    return bytesEscritos;
+}
+
+unsigned long long GrabadorCaptura::instanteActual()
+{
+    return (unsigned long long)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
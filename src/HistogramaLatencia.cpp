@@ -0,0 +1,110 @@
+/**
+ * @file HistogramaLatencia.cpp
+ * @brief Implementación del histograma de latencias
+ * @author Tu Nombre
+ * @date 2024
+ */
+
+#include "HistogramaLatencia.h"
+#include <cstring>
+
+/**
+ * @brief Posición del bit más alto
+ * @param valor Entero distinto de cero
+ * @return Exponente de la mayor potencia de dos que no supera a valor
+ */
+static int obtenerExponente(unsigned long long valor)
+{
+    int exponente = 0;
+    while (valor >>= 1)
+    {
+        exponente++;
+    }
+    return exponente;
+}
+
+HistogramaLatencia::HistogramaLatencia()
+{
+    reiniciar();
+}
+
+int HistogramaLatencia::obtenerCubeta(unsigned long long nanosegundos)
+{
+    if (nanosegundos < (unsigned long long)LATENCIAS_EXACTAS)
+        return (int)nanosegundos;
+
+    // Los 5 bits que siguen al más alto eligen la cubeta dentro de la octava
+    int exponente = obtenerExponente(nanosegundos);
+    int fraccion = (int)(nanosegundos >> (exponente - 5)) - CUBETAS_POR_OCTAVA;
+    return LATENCIAS_EXACTAS + (exponente - 6) * CUBETAS_POR_OCTAVA + fraccion;
+}
+
+unsigned long long HistogramaLatencia::obtenerLimiteCubeta(int cubeta)
+{
+    if (cubeta < LATENCIAS_EXACTAS)
+        return (unsigned long long)cubeta;
+
+    int exponente = (cubeta - LATENCIAS_EXACTAS) / CUBETAS_POR_OCTAVA + 6;
+    unsigned long long fraccion = (unsigned long long)((cubeta - LATENCIAS_EXACTAS) % CUBETAS_POR_OCTAVA +
+                                                       CUBETAS_POR_OCTAVA);
+    return ((fraccion + 1) << (exponente - 5)) - 1;
+}
+
+void HistogramaLatencia::registrar(unsigned long long nanosegundos)
+{
+    cuentas[obtenerCubeta(nanosegundos)]++;
+    muestras++;
+    suma += nanosegundos;
+    if (nanosegundos > maximo)
+    {
+        maximo = nanosegundos;
+    }
+}
+
+void HistogramaLatencia::reiniciar()
+{
+    std::memset(cuentas, 0, sizeof(cuentas));
+    muestras = 0;
+    maximo = 0;
+    suma = 0;
+}
+
+unsigned long long HistogramaLatencia::obtenerPercentil(double fraccion) const
+{
+    if (muestras == 0)
+        return 0;
+
+    // Muestras que deben quedar en o por debajo del percentil
+    unsigned long long objetivo = (unsigned long long)(fraccion * (double)muestras);
+    if (objetivo < 1)
+    {
+        objetivo = 1;
+    }
+
+    unsigned long long acumuladas = 0;
+    for (int cubeta = 0; cubeta < TOTAL_CUBETAS_LATENCIA; cubeta++)
+    {
+        acumuladas += cuentas[cubeta];
+        if (acumuladas >= objetivo)
+        {
+            unsigned long long limite = obtenerLimiteCubeta(cubeta);
+            return (limite < maximo) ? limite : maximo;
+        }
+    }
+    return maximo;
+}
+
+unsigned long long HistogramaLatencia::obtenerMuestras() const
+{
+    return muestras;
+}
+
+unsigned long long HistogramaLatencia::obtenerMaximo() const
+{
+    return maximo;
+}
+
+unsigned long long HistogramaLatencia::obtenerMedia() const
+{
+    return (muestras == 0) ? 0 : suma / muestras;
+}
@@ -0,0 +1,144 @@
+/**
+ * @file LectorAnillo.cpp
+ * @brief Implementación del lado lector del anillo de eventos
+ * @author Tu Nombre
+ * @date 2024
+ */
+
+#include "LectorAnillo.h"
+#include <cstring>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+LectorAnillo::LectorAnillo(const char* nombreObjeto)
+{
+    cabecera = nullptr;
+    ranuras = nullptr;
+    capacidad = 0;
+    esperado = 0;
+    perdidos = 0;
+    tamano = 0;
+
+#ifndef _WIN32
+    int descriptor = shm_open(nombreObjeto, O_RDONLY, 0);
+    if (descriptor < 0)
+        return;
+
+    struct stat estado;
+    void* memoria = MAP_FAILED;
+    if (fstat(descriptor, &estado) == 0 && estado.st_size >= (off_t)sizeof(CabeceraAnillo))
+    {
+        tamano = (unsigned long long)estado.st_size;
+        memoria = mmap(nullptr, tamano, PROT_READ, MAP_SHARED, descriptor, 0);
+    }
+    close(descriptor);
+    if (memoria == MAP_FAILED)
+        return;
+
+    const CabeceraAnillo* candidata = (const CabeceraAnillo*)memoria;
+    unsigned long long esperadoTamano = sizeof(CabeceraAnillo) +
+        (unsigned long long)candidata->capacidad * sizeof(RanuraAnillo);
+    if (std::strcmp(candidata->marca, "PRT7ANI") != 0 ||
+        candidata->version != VERSION_ANILLO || candidata->capacidad == 0 ||
+        esperadoTamano != tamano)
+    {
+        munmap(memoria, tamano);
+        return;
+    }
+
+    cabecera = candidata;
+    ranuras = (const RanuraAnillo*)((const char*)memoria + sizeof(CabeceraAnillo));
+    capacidad = cabecera->capacidad;
+    esperado = cabecera->publicados.load(std::memory_order_acquire);
+#else
+    (void)nombreObjeto;
+#endif
+}
+
+LectorAnillo::~LectorAnillo()
+{
+#ifndef _WIN32
+    if (cabecera != nullptr)
+    {
+        munmap((void*)cabecera, tamano);
+    }
+#endif
+}
+
+bool LectorAnillo::estaOperativo() const
+{
+    return cabecera != nullptr;
+}
+
+void LectorAnillo::recuperarAtraso()
+{
+    // Saltar a la mitad más reciente deja margen antes de la próxima vuelta
+    unsigned long long publicados = cabecera->publicados.load(std::memory_order_acquire);
+    unsigned long long destino = (publicados > capacidad / 2) ? publicados - capacidad / 2 : 0;
+    if (destino > esperado)
+    {
+        perdidos += destino - esperado;
+        esperado = destino;
+    }
+}
+
+int LectorAnillo::leer(EventoDecodificado* destino, int maximo)
+{
+    if (cabecera == nullptr)
+        return 0;
+
+    int leidos = 0;
+    while (leidos < maximo)
+    {
+        const RanuraAnillo& ranura = ranuras[esperado & (capacidad - 1)];
+        unsigned long long secuencia = ranura.secuencia.load(std::memory_order_acquire);
+
+        if (secuencia == esperado + 1)
+        {
+            unsigned long long instante = ranura.instante.load(std::memory_order_relaxed);
+            unsigned long long numeros = ranura.numeros.load(std::memory_order_relaxed);
+            unsigned long long simbolos = ranura.simbolos.load(std::memory_order_relaxed);
+
+            // Seqlock: si el escritor tocó la ranura durante la copia, se descarta
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (ranura.secuencia.load(std::memory_order_relaxed) == secuencia)
+            {
+                EventoDecodificado& evento = destino[leidos++];
+                evento.secuencia = esperado;
+                evento.instante = instante;
+                evento.paquete = (int)(unsigned int)(numeros & 0xFFFFFFFFULL);
+                evento.valor = (int)(unsigned int)(numeros >> 32);
+                evento.tipo = (char)(simbolos & 0xFF);
+                evento.caracter = (char)((simbolos >> 8) & 0xFF);
+                esperado++;
+                continue;
+            }
+        }
+        else if (secuencia < esperado + 1 ||
+                 (secuencia == RANURA_OCUPADA &&
+                  cabecera->publicados.load(std::memory_order_acquire) < esperado + capacidad))
+        {
+            // Todavía no publicado (o publicándose en esta misma vuelta)
+            break;
+        }
+
+        // La ranura ya pertenece a una vuelta posterior
+        recuperarAtraso();
+    }
+    return leidos;
+}
+
+unsigned long long LectorAnillo::obtenerPerdidos() const
+{
+    return perdidos;
+}
+
+unsigned long long LectorAnillo::obtenerPublicados() const
+{
+    return (cabecera != nullptr) ? cabecera->publicados.load(std::memory_order_acquire) : 0;
+}
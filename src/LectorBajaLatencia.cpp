@@ -0,0 +1,171 @@
+/**
+ * @file LectorBajaLatencia.cpp
+ * @brief Implementación del hilo lector en espera activa
+ * @author Tu Nombre
+ * @date 2024
+ */
+
+#include "LectorBajaLatencia.h"
+#include "ContabilidadMemoria.h"
+#include <chrono>
+#include <new>
+
+#ifdef _WIN32
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+LectorBajaLatencia::LectorBajaLatencia(Transporte* medio, int nucleo, bool cederAlEsperar)
+    : transporte(medio), nucleoLector(nucleo), ceder(cederAlEsperar), tramos(nullptr), iniciado(false),
+      escritos(0), leidos(0), detenido(false), cerrado(false), arranque(0), esperasAnilloLleno(0)
+{
+    tramos = new (std::nothrow) TramoLectura[TRAMOS_LECTOR];
+    if (tramos != nullptr)
+    {
+        ContabilidadMemoria::registrarReserva(MEMORIA_ENTRADA_SALIDA,
+                                              TRAMOS_LECTOR * sizeof(TramoLectura), 1);
+    }
+}
+
+LectorBajaLatencia::~LectorBajaLatencia()
+{
+    detener();
+    if (tramos != nullptr)
+    {
+        ContabilidadMemoria::registrarLiberacion(MEMORIA_ENTRADA_SALIDA,
+                                                 TRAMOS_LECTOR * sizeof(TramoLectura), 1);
+        delete[] tramos;
+    }
+}
+
+bool LectorBajaLatencia::iniciar()
+{
+    if (tramos == nullptr || iniciado)
+        return false;
+
+    hilo = std::thread(&LectorBajaLatencia::leer, this);
+    iniciado = true;
+
+    // El hilo se fija a su núcleo antes de la primera lectura
+    int estado;
+    while ((estado = arranque.load(std::memory_order_acquire)) == 0)
+    {
+        std::this_thread::yield();
+    }
+    if (estado < 0)
+    {
+        detener();
+        return false;
+    }
+    return true;
+}
+
+void LectorBajaLatencia::detener()
+{
+    if (!iniciado)
+        return;
+
+    detenido.store(true, std::memory_order_relaxed);
+    hilo.join();
+    iniciado = false;
+}
+
+void LectorBajaLatencia::leer()
+{
+    if (!fijarNucleo(nucleoLector))
+    {
+        arranque.store(-1, std::memory_order_release);
+        return;
+    }
+    arranque.store(1, std::memory_order_release);
+
+    while (!detenido.load(std::memory_order_relaxed))
+    {
+        unsigned int posicion = escritos.load(std::memory_order_relaxed);
+        if (posicion - leidos.load(std::memory_order_acquire) == TRAMOS_LECTOR)
+        {
+            // El decodificador no da abasto: esperar sin leer
+            esperasAnilloLleno.fetch_add(1, std::memory_order_relaxed);
+            if (ceder)
+            {
+                std::this_thread::yield();
+            }
+            continue;
+        }
+
+        TramoLectura& tramo = tramos[posicion & (TRAMOS_LECTOR - 1)];
+        int cantidad = transporte->leerDisponible(tramo.datos, CAPACIDAD_TRAMO_LECTOR);
+        if (cantidad < 0)
+        {
+            cerrado.store(true, std::memory_order_release);
+            return;
+        }
+        if (cantidad == 0)
+        {
+            if (ceder)
+            {
+                std::this_thread::yield();
+            }
+            continue;
+        }
+
+        tramo.instante = instanteActual();
+        tramo.longitud = cantidad;
+        escritos.store(posicion + 1, std::memory_order_release);
+    }
+}
+
+const TramoLectura* LectorBajaLatencia::siguienteTramo()
+{
+    unsigned int posicion = leidos.load(std::memory_order_relaxed);
+    if (posicion == escritos.load(std::memory_order_acquire))
+        return nullptr;
+    return &tramos[posicion & (TRAMOS_LECTOR - 1)];
+}
+
+void LectorBajaLatencia::liberarTramo()
+{
+    leidos.store(leidos.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+bool LectorBajaLatencia::estaCerrado() const
+{
+    // Lo publicado antes del cierre sigue en el anillo
+    return cerrado.load(std::memory_order_acquire) &&
+           leidos.load(std::memory_order_relaxed) == escritos.load(std::memory_order_acquire);
+}
+
+long long LectorBajaLatencia::obtenerEsperasAnilloLleno() const
+{
+    return esperasAnilloLleno.load(std::memory_order_relaxed);
+}
+
+bool LectorBajaLatencia::fijarNucleo(int nucleo)
+{
+    if (nucleo < 0)
+        return true;
+
+#ifdef _WIN32
+    if (nucleo >= (int)(sizeof(DWORD_PTR) * 8))
+        return false;
+    return SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1 << nucleo) != 0;
+#elif defined(__linux__)
+    if (nucleo >= CPU_SETSIZE)
+        return false;
+    cpu_set_t nucleos;
+    CPU_ZERO(&nucleos);
+    CPU_SET(nucleo, &nucleos);
+    return pthread_setaffinity_np(pthread_self(), sizeof(nucleos), &nucleos) == 0;
+#else
+    // Sin afinidad de hilos (macOS): el hilo queda donde lo ponga el planificador
+    return true;
+#endif
+}
+
+long long LectorBajaLatencia::instanteActual()
+{
+    return (long long)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
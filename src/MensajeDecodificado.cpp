@@ -6,64 +6,479 @@
  */
 
 #include "MensajeDecodificado.h"
-#include <iostream>
+#include "ContabilidadMemoria.h"
+#include <cstring>
+
+/// Capacidad mínima de un fragmento
+static const int CAPACIDAD_MINIMA = 64;
+
+// =====================================================
+// ITERADOR
+// =====================================================
+
+IteradorMensaje::IteradorMensaje(FragmentoMensaje* inicial, int posicion)
+{
+    fragmento = inicial;
+    desplazamiento = posicion;
+}
+
+bool IteradorMensaje::esValido() const
+{
+    return fragmento != nullptr;
+}
+
+char IteradorMensaje::obtenerCaracter() const
+{
+    return fragmento->caracteres[desplazamiento];
+}
+
+void IteradorMensaje::establecerCaracter(char nuevoCaracter)
+{
+    fragmento->caracteres[desplazamiento] = nuevoCaracter;
+}
+
+void IteradorMensaje::avanzar()
+{
+    desplazamiento++;
+    if (desplazamiento >= fragmento->cantidad)
+    {
+        fragmento = fragmento->proximo;
+        desplazamiento = 0;
+    }
+}
+
+void IteradorMensaje::retroceder()
+{
+    desplazamiento--;
+    if (desplazamiento < 0)
+    {
+        fragmento = fragmento->previo;
+        desplazamiento = (fragmento != nullptr) ? fragmento->cantidad - 1 : 0;
+    }
+}
+
+// =====================================================
+// MENSAJE
+// =====================================================
 
 MensajeDecodificado::MensajeDecodificado()
 {
     inicio = nullptr;
     final = nullptr;
     longitudTotal = 0;
+    cantidadFragmentos = 0;
+    fragmentoCursor = nullptr;
+    inicioCursor = 0;
 }
 
 MensajeDecodificado::~MensajeDecodificado()
+{
+    liberarFragmentos();
+}
+
+MensajeDecodificado::MensajeDecodificado(MensajeDecodificado&& otro)
+{
+    inicio = otro.inicio;
+    final = otro.final;
+    longitudTotal = otro.longitudTotal;
+    cantidadFragmentos = otro.cantidadFragmentos;
+    fragmentoCursor = otro.fragmentoCursor;
+    inicioCursor = otro.inicioCursor;
+
+    // Dejar el origen vacío para que su destructor no libere nada
+    otro.inicio = nullptr;
+    otro.final = nullptr;
+    otro.longitudTotal = 0;
+    otro.cantidadFragmentos = 0;
+    otro.fragmentoCursor = nullptr;
+    otro.inicioCursor = 0;
+}
+
+MensajeDecodificado& MensajeDecodificado::operator=(MensajeDecodificado&& otro)
+{
+    if (this != &otro)
+    {
+        liberarFragmentos();
+
+        inicio = otro.inicio;
+        final = otro.final;
+        longitudTotal = otro.longitudTotal;
+        cantidadFragmentos = otro.cantidadFragmentos;
+        fragmentoCursor = otro.fragmentoCursor;
+        inicioCursor = otro.inicioCursor;
+
+        otro.inicio = nullptr;
+        otro.final = nullptr;
+        otro.longitudTotal = 0;
+        otro.cantidadFragmentos = 0;
+        otro.fragmentoCursor = nullptr;
+        otro.inicioCursor = 0;
+    }
+    return *this;
+}
+
+MensajeDecodificado MensajeDecodificado::clonar() const
+{
+    MensajeDecodificado copia;
+    FragmentoMensaje* fragmentoActual = inicio;
+
+    // Copiar tramo a tramo en fragmentos del tamaño adecuado
+    while (fragmentoActual != nullptr)
+    {
+        for (int indice = 0; indice < fragmentoActual->cantidad; indice++)
+        {
+            copia.agregarCaracter(fragmentoActual->caracteres[indice]);
+        }
+        fragmentoActual = fragmentoActual->proximo;
+    }
+
+    return copia;
+}
+
+void MensajeDecodificado::liberarFragmentos()
 {
     FragmentoMensaje* fragmentoActual = inicio;
-    
+
     // Recorrer y eliminar cada nodo
     while (fragmentoActual != nullptr)
     {
         FragmentoMensaje* fragmentoTemporal = fragmentoActual;
         fragmentoActual = fragmentoActual->proximo;
+        ContabilidadMemoria::registrarLiberacion(MEMORIA_MENSAJE,
+            sizeof(FragmentoMensaje) + fragmentoTemporal->capacidad, 1);
+        delete[] fragmentoTemporal->caracteres;
         delete fragmentoTemporal;
     }
+
+    inicio = nullptr;
+    final = nullptr;
+    longitudTotal = 0;
+    cantidadFragmentos = 0;
+    fragmentoCursor = nullptr;
+    inicioCursor = 0;
+}
+
+int MensajeDecodificado::calcularCapacidad() const
+{
+    int capacidad = CAPACIDAD_MINIMA;
+    while ((long long)capacidad * capacidad < (long long)longitudTotal)
+    {
+        capacidad *= 2;
+    }
+    return capacidad;
 }
 
-void MensajeDecodificado::agregarCaracter(char nuevoCaracter)
+FragmentoMensaje* MensajeDecodificado::crearFragmento(FragmentoMensaje* anterior, int capacidad)
 {
-    // Crear nuevo fragmento
     FragmentoMensaje* nuevoFragmento = new FragmentoMensaje;
-    nuevoFragmento->caracter = nuevoCaracter;
-    nuevoFragmento->proximo = nullptr;
-    nuevoFragmento->previo = final;
+    nuevoFragmento->caracteres = new char[capacidad];
+    ContabilidadMemoria::registrarReserva(MEMORIA_MENSAJE, sizeof(FragmentoMensaje) + capacidad, 1);
+    nuevoFragmento->cantidad = 0;
+    nuevoFragmento->capacidad = capacidad;
+    nuevoFragmento->previo = anterior;
+    nuevoFragmento->proximo = (anterior != nullptr) ? anterior->proximo : inicio;
 
-    // Enlazar con el final actual
-    if (final != nullptr)
+    // Enlazar con los vecinos
+    if (nuevoFragmento->proximo != nullptr)
     {
-        final->proximo = nuevoFragmento;
+        nuevoFragmento->proximo->previo = nuevoFragmento;
+    }
+    else
+    {
+        final = nuevoFragmento;
+    }
+
+    if (anterior != nullptr)
+    {
+        anterior->proximo = nuevoFragmento;
     }
     else
     {
-        // Lista vacía: este es el primer elemento
         inicio = nuevoFragmento;
     }
 
-    // Actualizar el puntero final
-    final = nuevoFragmento;
-    longitudTotal++;
+    cantidadFragmentos++;
+    return nuevoFragmento;
 }
 
-void MensajeDecodificado::mostrarMensaje()
+void MensajeDecodificado::eliminarFragmento(FragmentoMensaje* fragmento)
 {
+    if (fragmento->previo != nullptr)
+    {
+        fragmento->previo->proximo = fragmento->proximo;
+    }
+    else
+    {
+        inicio = fragmento->proximo;
+    }
+
+    if (fragmento->proximo != nullptr)
+    {
+        fragmento->proximo->previo = fragmento->previo;
+    }
+    else
+    {
+        final = fragmento->previo;
+    }
+
+    if (fragmentoCursor == fragmento)
+    {
+        fragmentoCursor = nullptr;
+    }
+
+    ContabilidadMemoria::registrarLiberacion(MEMORIA_MENSAJE,
+        sizeof(FragmentoMensaje) + fragmento->capacidad, 1);
+    delete[] fragmento->caracteres;
+    delete fragmento;
+    cantidadFragmentos--;
+}
+
+FragmentoMensaje* MensajeDecodificado::localizar(int posicion, int* inicioFragmento) const
+{
+    // Elegir el punto de partida más cercano: inicio, final o cursor
     FragmentoMensaje* fragmentoActual = inicio;
-    
-    while (fragmentoActual != nullptr)
+    int inicioActual = 0;
+    int distancia = posicion;
+
+    int inicioFinal = longitudTotal - final->cantidad;
+    if (longitudTotal - posicion < distancia)
     {
-        std::cout << "[" << fragmentoActual->caracter << "]";
+        fragmentoActual = final;
+        inicioActual = inicioFinal;
+        distancia = longitudTotal - posicion;
+    }
+
+    if (fragmentoCursor != nullptr)
+    {
+        int distanciaCursor = posicion - inicioCursor;
+        if (distanciaCursor < 0)
+            distanciaCursor = -distanciaCursor;
+        if (distanciaCursor < distancia)
+        {
+            fragmentoActual = fragmentoCursor;
+            inicioActual = inicioCursor;
+        }
+    }
+
+    // Avanzar o retroceder hasta el fragmento que contiene la posición
+    while (posicion >= inicioActual + fragmentoActual->cantidad)
+    {
+        inicioActual += fragmentoActual->cantidad;
         fragmentoActual = fragmentoActual->proximo;
     }
+    while (posicion < inicioActual)
+    {
+        fragmentoActual = fragmentoActual->previo;
+        inicioActual -= fragmentoActual->cantidad;
+    }
+
+    *inicioFragmento = inicioActual;
+    return fragmentoActual;
+}
+
+void MensajeDecodificado::agregarEnFragmentoNuevo(char nuevoCaracter)
+{
+    // El último fragmento está lleno (o no existe)
+    crearFragmento(final, calcularCapacidad());
+
+    final->caracteres[final->cantidad++] = nuevoCaracter;
+    longitudTotal++;
+}
+
+bool MensajeDecodificado::insertarEn(int posicion, char nuevoCaracter)
+{
+    if (posicion < 0 || posicion > longitudTotal)
+        return false;
+
+    if (posicion == longitudTotal)
+    {
+        agregarCaracter(nuevoCaracter);
+        return true;
+    }
+
+    int inicioFragmento = 0;
+    FragmentoMensaje* fragmento = localizar(posicion, &inicioFragmento);
+
+    // Dividir el fragmento por la mitad si no queda espacio
+    if (fragmento->cantidad == fragmento->capacidad)
+    {
+        int capacidadNueva = calcularCapacidad();
+        if (capacidadNueva < fragmento->capacidad)
+            capacidadNueva = fragmento->capacidad;
+
+        FragmentoMensaje* mitad = crearFragmento(fragmento, capacidadNueva);
+        int mover = fragmento->cantidad / 2;
+        int conservar = fragmento->cantidad - mover;
+        std::memcpy(mitad->caracteres, fragmento->caracteres + conservar, mover);
+        mitad->cantidad = mover;
+        fragmento->cantidad = conservar;
+
+        if (posicion >= inicioFragmento + conservar)
+        {
+            inicioFragmento += conservar;
+            fragmento = mitad;
+        }
+    }
+
+    // Desplazar el resto del tramo y escribir el carácter
+    int desplazamiento = posicion - inicioFragmento;
+    std::memmove(fragmento->caracteres + desplazamiento + 1,
+                 fragmento->caracteres + desplazamiento,
+                 fragmento->cantidad - desplazamiento);
+    fragmento->caracteres[desplazamiento] = nuevoCaracter;
+    fragmento->cantidad++;
+    longitudTotal++;
+
+    fragmentoCursor = fragmento;
+    inicioCursor = inicioFragmento;
+    return true;
+}
+
+bool MensajeDecodificado::eliminarEn(int posicion)
+{
+    if (posicion < 0 || posicion >= longitudTotal)
+        return false;
+
+    int inicioFragmento = 0;
+    FragmentoMensaje* fragmento = localizar(posicion, &inicioFragmento);
+
+    int desplazamiento = posicion - inicioFragmento;
+    std::memmove(fragmento->caracteres + desplazamiento,
+                 fragmento->caracteres + desplazamiento + 1,
+                 fragmento->cantidad - desplazamiento - 1);
+    fragmento->cantidad--;
+    longitudTotal--;
+
+    if (fragmento->cantidad == 0)
+    {
+        // Al quitar el fragmento vacío quedan contiguos sus dos vecinos
+        FragmentoMensaje* anterior = fragmento->previo;
+        eliminarFragmento(fragmento);
+        fragmentoCursor = nullptr;
+        if (anterior != nullptr)
+        {
+            int inicioAnterior = inicioFragmento - anterior->cantidad;
+            FragmentoMensaje* fusionado = fusionarConSiguiente(anterior);
+            fragmentoCursor = (fusionado != nullptr) ? fusionado : anterior;
+            inicioCursor = inicioAnterior;
+        }
+        return true;
+    }
+
+    // Fusionar con los vecinos si quedaron casi vacíos: así dos
+    // fragmentos contiguos nunca ocupan menos de media capacidad y el
+    // número de fragmentos sigue siendo O(√n)
+    if (fragmento->previo != nullptr)
+    {
+        int inicioAnterior = inicioFragmento - fragmento->previo->cantidad;
+        FragmentoMensaje* fusionado = fusionarConSiguiente(fragmento->previo);
+        if (fusionado != nullptr)
+        {
+            fragmento = fusionado;
+            inicioFragmento = inicioAnterior;
+        }
+    }
+    FragmentoMensaje* fusionado = fusionarConSiguiente(fragmento);
+    if (fusionado != nullptr)
+    {
+        fragmento = fusionado;
+    }
+
+    fragmentoCursor = fragmento;
+    inicioCursor = inicioFragmento;
+    return true;
+}
+
+FragmentoMensaje* MensajeDecodificado::fusionarConSiguiente(FragmentoMensaje* izquierdo)
+{
+    FragmentoMensaje* derecho = izquierdo->proximo;
+    if (derecho == nullptr)
+        return nullptr;
+
+    int total = izquierdo->cantidad + derecho->cantidad;
+    if (total <= izquierdo->capacidad / 2)
+    {
+        // Añadir el tramo derecho al final del izquierdo
+        std::memcpy(izquierdo->caracteres + izquierdo->cantidad,
+                    derecho->caracteres, derecho->cantidad);
+        izquierdo->cantidad = total;
+        eliminarFragmento(derecho);
+        return izquierdo;
+    }
+    if (total <= derecho->capacidad / 2)
+    {
+        // Anteponer el tramo izquierdo al derecho
+        std::memmove(derecho->caracteres + izquierdo->cantidad,
+                     derecho->caracteres, derecho->cantidad);
+        std::memcpy(derecho->caracteres, izquierdo->caracteres, izquierdo->cantidad);
+        derecho->cantidad = total;
+        eliminarFragmento(izquierdo);
+        return derecho;
+    }
+    return nullptr;
+}
+
+bool MensajeDecodificado::reemplazarEn(int posicion, char nuevoCaracter)
+{
+    if (posicion < 0 || posicion >= longitudTotal)
+        return false;
+
+    int inicioFragmento = 0;
+    FragmentoMensaje* fragmento = localizar(posicion, &inicioFragmento);
+    fragmento->caracteres[posicion - inicioFragmento] = nuevoCaracter;
+
+    fragmentoCursor = fragmento;
+    inicioCursor = inicioFragmento;
+    return true;
+}
+
+char MensajeDecodificado::obtenerEn(int posicion) const
+{
+    if (posicion < 0 || posicion >= longitudTotal)
+        return '\0';
+
+    int inicioFragmento = 0;
+    FragmentoMensaje* fragmento = localizar(posicion, &inicioFragmento);
+    return fragmento->caracteres[posicion - inicioFragmento];
+}
+
+IteradorMensaje MensajeDecodificado::iteradorInicio() const
+{
+    return IteradorMensaje(inicio, 0);
+}
+
+IteradorMensaje MensajeDecodificado::iteradorFinal() const
+{
+    return IteradorMensaje(final, (final != nullptr) ? final->cantidad - 1 : 0);
 }
 
 int MensajeDecodificado::obtenerLongitud() const
 {
     return longitudTotal;
 }
+
+int MensajeDecodificado::copiarDesde(int posicion, char* destino, int cantidad) const
+{
+    if (posicion < 0 || posicion >= longitudTotal || cantidad <= 0)
+    {
+        return 0;
+    }
+
+    int inicioFragmento = 0;
+    FragmentoMensaje* fragmentoActual = localizar(posicion, &inicioFragmento);
+    int desplazamiento = posicion - inicioFragmento;
+
+    // Copiar hacia adelante tramo a tramo
+    int copiados = 0;
+    while (fragmentoActual != nullptr && copiados < cantidad)
+    {
+        int disponibles = fragmentoActual->cantidad - desplazamiento;
+        int tramo = (cantidad - copiados < disponibles) ? cantidad - copiados : disponibles;
+        std::memcpy(destino + copiados, fragmentoActual->caracteres + desplazamiento, tramo);
+        copiados += tramo;
+        desplazamiento = 0;
+        fragmentoActual = fragmentoActual->proximo;
+    }
+
+    return copiados;
+}
@@ -0,0 +1,65 @@
+/**
+ * @file PaqueteBloque.cpp
+ * @brief Implementación del paquete de carga de bloque
+ * @author Tu Nombre
+ * @date 2024
+ */
+
+#include "PaqueteBloque.h"
+#include <cstdio>
+#include <cstring>
+
+PaqueteBloque::PaqueteBloque(const char* texto, int cantidad)
+{
+    longitud = (cantidad < LONGITUD_MAXIMA_BLOQUE) ? cantidad : LONGITUD_MAXIMA_BLOQUE;
+    std::memcpy(textoTransportado, texto, longitud);
+    std::memcpy(textoDecodificado, texto, longitud);
+    textoTransportado[longitud] = '\0';
+    textoDecodificado[longitud] = '\0';
+}
+
+void PaqueteBloque::ejecutar(MensajeDecodificado* mensaje, DiscoRotatorio* disco)
+{
+    disco->traducir(textoTransportado, textoDecodificado, (size_t)longitud);
+    for (int indice = 0; indice < longitud; indice++)
+    {
+        mensaje->agregarCaracter(textoDecodificado[indice]);
+    }
+}
+
+void PaqueteBloque::ejecutarEnCadena(MensajeDecodificado* mensaje, CadenaRotores* cadena)
+{
+    for (int indice = 0; indice < longitud; indice++)
+    {
+        textoDecodificado[indice] = cadena->obtenerCifrado(textoTransportado[indice]);
+        mensaje->agregarCaracter(textoDecodificado[indice]);
+    }
+}
+
+int PaqueteBloque::describir(char* destino, int capacidad) const
+{
+    // Los bloques largos se resumen para no desbordar la línea de consola
+    return ajustarDescripcion(std::snprintf(destino, capacidad,
+        "Paquete recibido: [B,%d] -> Procesando... -> Bloque decodificado como \"%.48s%s\".",
+        longitud, textoDecodificado, (longitud > 48) ? "..." : ""), capacidad);
+}
+
+char PaqueteBloque::obtenerTipo() const
+{
+    return 'B';
+}
+
+int PaqueteBloque::obtenerValor() const
+{
+    return longitud;
+}
+
+const char* PaqueteBloque::obtenerTextoTransportado() const
+{
+    return textoTransportado;
+}
+
+const char* PaqueteBloque::obtenerTextoDecodificado() const
+{
+    return textoDecodificado;
+}
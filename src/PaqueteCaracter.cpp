@@ -6,27 +6,47 @@
  */
 
 #include "PaqueteCaracter.h"
-#include <iostream>
+#include <cstdio>
 
 PaqueteCaracter::PaqueteCaracter(char simbolo)
 {
     caracterTransportado = simbolo;
+    caracterDecodificado = simbolo;
 }
 
 void PaqueteCaracter::ejecutar(MensajeDecodificado* mensaje, DiscoRotatorio* disco)
 {
     // Paso 1: Obtener el carácter decodificado usando el disco
-    char caracterDecodificado = disco->obtenerCifrado(caracterTransportado);
+    caracterDecodificado = disco->obtenerCifrado(caracterTransportado);
 
     // Paso 2: Agregar al mensaje
     mensaje->agregarCaracter(caracterDecodificado);
+}
+
+void PaqueteCaracter::ejecutarEnCadena(MensajeDecodificado* mensaje, CadenaRotores* cadena)
+{
+    caracterDecodificado = cadena->obtenerCifrado(caracterTransportado);
+    mensaje->agregarCaracter(caracterDecodificado);
+}
+
+int PaqueteCaracter::describir(char* destino, int capacidad) const
+{
+    return ajustarDescripcion(std::snprintf(destino, capacidad,
+        "Paquete recibido: [L,%c] -> Procesando... -> Simbolo '%c' decodificado como '%c'.",
+        caracterTransportado, caracterTransportado, caracterDecodificado), capacidad);
+}
 
-    // Paso 3: Mostrar información de progreso
-    std::cout << "Paquete recibido: [L," << caracterTransportado 
-              << "] -> Procesando... -> Simbolo '" 
-              << caracterTransportado << "' decodificado como '" 
-              << caracterDecodificado << "'. Mensaje: ";
-    
-    mensaje->mostrarMensaje();
-    std::cout << std::endl;
+char PaqueteCaracter::obtenerTipo() const
+{
+    return 'L';
+}
+
+int PaqueteCaracter::obtenerValor() const
+{
+    return caracterTransportado;
+}
+
+char PaqueteCaracter::obtenerCaracterDecodificado() const
+{
+    return caracterDecodificado;
 }
@@ -0,0 +1,44 @@
+/**
+ * @file PaqueteFinalizacion.cpp
+ * @brief Implementación del paquete de fin de mensaje
+ * @author Tu Nombre
+ * @date 2024
+ */
+
+#include "PaqueteFinalizacion.h"
+#include <cstdio>
+
+PaqueteFinalizacion::PaqueteFinalizacion(int codigo)
+{
+    codigoFinalizacion = codigo;
+}
+
+void PaqueteFinalizacion::ejecutar(MensajeDecodificado* mensaje, DiscoRotatorio* disco)
+{
+    // La trama de fin no altera el estado de decodificación
+    (void)mensaje;
+    (void)disco;
+}
+
+void PaqueteFinalizacion::ejecutarEnCadena(MensajeDecodificado* mensaje, CadenaRotores* cadena)
+{
+    (void)mensaje;
+    (void)cadena;
+}
+
+int PaqueteFinalizacion::describir(char* destino, int capacidad) const
+{
+    return ajustarDescripcion(std::snprintf(destino, capacidad,
+        "Paquete recibido: [F,%d] -> Fin de mensaje senalizado por el transmisor.",
+        codigoFinalizacion), capacidad);
+}
+
+char PaqueteFinalizacion::obtenerTipo() const
+{
+    return 'F';
+}
+
+int PaqueteFinalizacion::obtenerValor() const
+{
+    return codigoFinalizacion;
+}
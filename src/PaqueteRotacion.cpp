@@ -6,25 +6,46 @@
  */
 
 #include "PaqueteRotacion.h"
-#include <iostream>
+#include <cstdio>
 
 PaqueteRotacion::PaqueteRotacion(int grados)
 {
     cantidadRotacion = grados;
+    aplicadoEnCadena = false;
 }
 
 void PaqueteRotacion::ejecutar(MensajeDecodificado* mensaje, DiscoRotatorio* disco)
 {
     // Aplicar la rotación al disco
     disco->girar(cantidadRotacion);
+    aplicadoEnCadena = false;
 
-    // Mostrar información de depuración
-    std::cout << "Paquete recibido: [M," << cantidadRotacion 
-              << "] -> Procesando... -> GIRANDO DISCO "
-              << (cantidadRotacion >= 0 ? "+" : "") << cantidadRotacion 
-              << "." << std::endl << std::endl;
-    
     // Nota: El parámetro 'mensaje' no se usa en rotaciones,
     // pero está presente por la interfaz PaqueteBase
     (void)mensaje;  // Evitar warning de parámetro no usado
 }
+
+void PaqueteRotacion::ejecutarEnCadena(MensajeDecodificado* mensaje, CadenaRotores* cadena)
+{
+    // Las tramas MAP siempre actúan sobre el disco principal
+    cadena->girarRotor(0, cantidadRotacion);
+    aplicadoEnCadena = true;
+    (void)mensaje;
+}
+
+int PaqueteRotacion::describir(char* destino, int capacidad) const
+{
+    return ajustarDescripcion(std::snprintf(destino, capacidad,
+        "Paquete recibido: [M,%d] -> Procesando... -> GIRANDO %s %+d.",
+        cantidadRotacion, aplicadoEnCadena ? "ROTOR 0" : "DISCO", cantidadRotacion), capacidad);
+}
+
+char PaqueteRotacion::obtenerTipo() const
+{
+    return 'M';
+}
+
+int PaqueteRotacion::obtenerValor() const
+{
+    return cantidadRotacion;
+}
@@ -0,0 +1,69 @@
+/**
+ * @file PaqueteRotor.cpp
+ * @brief Implementación del paquete de rotación dirigida
+ * @author Tu Nombre
+ * @date 2024
+ */
+
+#include "PaqueteRotor.h"
+#include <cstdio>
+
+PaqueteRotor::PaqueteRotor(int rotor, int grados)
+{
+    indiceRotor = rotor;
+    cantidadRotacion = grados;
+    aplicadoEnCadena = false;
+    rotorGirado = false;
+}
+
+void PaqueteRotor::ejecutar(MensajeDecodificado* mensaje, DiscoRotatorio* disco)
+{
+    rotorGirado = (indiceRotor == 0);
+    aplicadoEnCadena = false;
+    if (rotorGirado)
+    {
+        disco->girar(cantidadRotacion);
+    }
+    (void)mensaje;
+}
+
+void PaqueteRotor::ejecutarEnCadena(MensajeDecodificado* mensaje, CadenaRotores* cadena)
+{
+    rotorGirado = cadena->girarRotor(indiceRotor, cantidadRotacion);
+    aplicadoEnCadena = true;
+    (void)mensaje;
+}
+
+int PaqueteRotor::describir(char* destino, int capacidad) const
+{
+    if (!rotorGirado)
+    {
+        return ajustarDescripcion(std::snprintf(destino, capacidad,
+            "Paquete recibido: [R,%d,%d] -> Procesando... -> Rotor inexistente, ignorado.",
+            indiceRotor, cantidadRotacion), capacidad);
+    }
+    if (!aplicadoEnCadena)
+    {
+        return ajustarDescripcion(std::snprintf(destino, capacidad,
+            "Paquete recibido: [R,%d,%d] -> Procesando... -> GIRANDO DISCO %+d.",
+            indiceRotor, cantidadRotacion, cantidadRotacion), capacidad);
+    }
+    return ajustarDescripcion(std::snprintf(destino, capacidad,
+        "Paquete recibido: [R,%d,%d] -> Procesando... -> GIRANDO ROTOR %d %+d.",
+        indiceRotor, cantidadRotacion, indiceRotor, cantidadRotacion), capacidad);
+}
+
+char PaqueteRotor::obtenerTipo() const
+{
+    return 'R';
+}
+
+int PaqueteRotor::obtenerValor() const
+{
+    return cantidadRotacion;
+}
+
+int PaqueteRotor::obtenerIndiceRotor() const
+{
+    return indiceRotor;
+}
@@ -0,0 +1,49 @@
+/**
+ * @file PaqueteSincronizacion.cpp
+ * @brief Implementación del paquete de sincronización
+ * @author Tu Nombre
+ * @date 2024
+ */
+
+#include "PaqueteSincronizacion.h"
+#include <cstdio>
+
+PaqueteSincronizacion::PaqueteSincronizacion(int rotacion)
+{
+    rotacionAbsoluta = rotacion;
+    rotacionAplicada = 0;
+    aplicadoEnCadena = false;
+}
+
+void PaqueteSincronizacion::ejecutar(MensajeDecodificado* mensaje, DiscoRotatorio* disco)
+{
+    disco->establecerDesplazamiento(rotacionAbsoluta);
+    rotacionAplicada = disco->obtenerDesplazamiento();
+    aplicadoEnCadena = false;
+    (void)mensaje;
+}
+
+void PaqueteSincronizacion::ejecutarEnCadena(MensajeDecodificado* mensaje, CadenaRotores* cadena)
+{
+    cadena->girarRotor(0, rotacionAbsoluta - cadena->obtenerDesplazamiento(0));
+    rotacionAplicada = cadena->obtenerDesplazamiento(0);
+    aplicadoEnCadena = true;
+    (void)mensaje;
+}
+
+int PaqueteSincronizacion::describir(char* destino, int capacidad) const
+{
+    return ajustarDescripcion(std::snprintf(destino, capacidad,
+        "Paquete recibido: [S,%d] -> Procesando... -> %s SINCRONIZADO EN +%d.",
+        rotacionAbsoluta, aplicadoEnCadena ? "ROTOR 0" : "DISCO", rotacionAplicada), capacidad);
+}
+
+char PaqueteSincronizacion::obtenerTipo() const
+{
+    return 'S';
+}
+
+int PaqueteSincronizacion::obtenerValor() const
+{
+    return rotacionAbsoluta;
+}
@@ -0,0 +1,616 @@
+/**
+ * @file PlanificadorTramas.cpp
+ * @brief Implementación del codificador de tramas PRT-7
+ * @author Tu Nombre
+ * @date 2024
+ */
+
+#include "PlanificadorTramas.h"
+#include "PaqueteBloque.h"
+#include "DiscoRotatorio.h"
+#include "ControlIntegridad.h"
+
+/// Bytes máximos del sufijo ",255*FF"
+static const size_t LONGITUD_SUFIJO = 7;
+
+/**
+ * @brief Escribe un entero en decimal sin terminador
+ * @param destino Posición de escritura
+ * @param valor Número a escribir (puede ser negativo)
+ * @return Caracteres escritos
+ */
+static int escribirEntero(char* destino, int valor)
+{
+    int escritos = 0;
+    if (valor < 0)
+    {
+        destino[escritos++] = '-';
+        valor = -valor;
+    }
+    char cifras[12];
+    int cantidad = 0;
+    do
+    {
+        cifras[cantidad++] = (char)('0' + valor % 10);
+        valor /= 10;
+    } while (valor > 0);
+    while (cantidad > 0)
+    {
+        destino[escritos++] = cifras[--cantidad];
+    }
+    return escritos;
+}
+
+/// Coste de un plan que no puede completarse
+static const long long COSTE_IMPOSIBLE = 1LL << 60;
+
+/// Posiciones que resume cada entrada de mejorDeGrupo
+static const size_t TAMANO_GRUPO = 32;
+
+/// Tipos de final de bloque en cada posición
+static const unsigned char FIN_INVALIDO = 0;    ///< Ningún bloque termina aquí
+static const unsigned char FIN_LIBRE = 1;       ///< Cualquier bloque puede terminar aquí
+static const unsigned char FIN_SOLO_CORTO = 2;  ///< Solo un bloque de uno o dos caracteres
+
+/**
+ * @brief Indica si un carácter podría llegar como dígito del CRC
+ * @param caracter Carácter claro
+ * @return true para 0-9 y para cualquier letra (alguna rotación la
+ *         cifra como A-F)
+ */
+static bool puedeSerHexadecimal(char caracter)
+{
+    return (caracter >= '0' && caracter <= '9') ||
+           (caracter >= 'A' && caracter <= 'Z') ||
+           (caracter >= 'a' && caracter <= 'z');
+}
+
+/**
+ * @brief Indica si el receptor recortaría el carácter al final de la línea
+ * @param caracter Byte a comprobar
+ * @return true para espacio y tabulador
+ */
+static bool esEspacio(unsigned char caracter)
+{
+    return caracter == ' ' || caracter == '\t';
+}
+
+PoliticaCodificacion::PoliticaCodificacion()
+{
+    longitudMaximaBloque = LONGITUD_MAXIMA_BLOQUE;
+    letrasPorRotacion = 0;
+    clave = nullptr;
+    incluirIntegridad = false;
+    intervaloSincronizacion = 0;
+}
+
+PlanificadorTramas::PlanificadorTramas(const PoliticaCodificacion& politicaCodificacion,
+                                       const char* cableadoDisco)
+    : politica(politicaCodificacion)
+{
+    if (politica.longitudMaximaBloque < 1)
+        politica.longitudMaximaBloque = 1;
+    if (politica.longitudMaximaBloque > LONGITUD_MAXIMA_BLOQUE)
+        politica.longitudMaximaBloque = LONGITUD_MAXIMA_BLOQUE;
+    if (politica.letrasPorRotacion < 0)
+        politica.letrasPorRotacion = 0;
+    if (politica.intervaloSincronizacion < 0)
+        politica.intervaloSincronizacion = 0;
+
+    longitudClave = 0;
+    for (int indice = 0; politica.clave != nullptr && politica.clave[indice] != '\0' &&
+                         longitudClave < 64; indice++)
+    {
+        char letra = politica.clave[indice];
+        if (letra >= 'A' && letra <= 'Z')
+            rotacionesClave[longitudClave++] = letra - 'A';
+        else if (letra >= 'a' && letra <= 'z')
+            rotacionesClave[longitudClave++] = letra - 'a';
+    }
+    politica.clave = nullptr;
+
+    // Invertir las tablas del propio disco: vale para cualquier cableado
+    DiscoRotatorio disco(cableadoDisco);
+    for (int desplazamiento = 0; desplazamiento < 26; desplazamiento++)
+    {
+        disco.establecerDesplazamiento(desplazamiento);
+        for (int byte = 0; byte < 256; byte++)
+        {
+            unsigned char cifrado = (unsigned char)disco.obtenerCifrado((char)byte);
+            inversas[desplazamiento][cifrado] = (unsigned char)byte;
+        }
+    }
+    for (int byte = 0; byte < 256; byte++)
+    {
+        esLetra[byte] = (byte >= 'A' && byte <= 'Z') || (byte >= 'a' && byte <= 'z');
+    }
+
+    indiceClave = 0;
+    rotacion = 0;
+    letrasDesdeRotacion = 0;
+    rotacionPendiente = (longitudClave > 0);
+    secuencia = 0;
+    tramasDesdeSincronizacion = 0;
+    tramasEmitidas = 0;
+    rotacionesEmitidas = 0;
+    posicionError = -1;
+
+    // Pesos por trama: el contenido de los bloques es fijo y no cuenta.
+    // Con sincronización se mide en 1/N bytes para repartir la trama S
+    long long sufijo = politica.incluirIntegridad ? 5 : 0;
+    long long escala = 1;
+    long long sincronizacion = 0;
+    if (politica.intervaloSincronizacion > 0)
+    {
+        escala = politica.intervaloSincronizacion;
+        sincronizacion = 5 + sufijo;
+    }
+    costeBloque = (3 + sufijo) * escala + sincronizacion;
+    costeRotacion = (4 + sufijo) * escala + sincronizacion;
+
+    tipoFin = nullptr;
+    ultimoFinLibre = nullptr;
+    siguienteFinCorto = nullptr;
+    letrasHasta = nullptr;
+    posicionLetras = nullptr;
+    costeDesde = nullptr;
+    costeCorte = nullptr;
+    siguienteRotacion = nullptr;
+    mejorDeGrupo = nullptr;
+    alcancesTramo = nullptr;
+    capacidadTrabajo = 0;
+}
+
+PlanificadorTramas::~PlanificadorTramas()
+{
+    delete[] tipoFin;
+    delete[] ultimoFinLibre;
+    delete[] siguienteFinCorto;
+    delete[] letrasHasta;
+    delete[] posicionLetras;
+    delete[] costeDesde;
+    delete[] costeCorte;
+    delete[] siguienteRotacion;
+    delete[] mejorDeGrupo;
+    delete[] alcancesTramo;
+}
+
+size_t PlanificadorTramas::calcularCapacidadNecesaria(size_t longitud) const
+{
+    // Peor caso por carácter: una trama L, un giro y dos sincronizaciones
+    size_t sufijo = politica.incluirIntegridad ? LONGITUD_SUFIJO : 0;
+    size_t porCaracter = 4 + sufijo;
+    if (politica.letrasPorRotacion > 0 || longitudClave > 0)
+        porCaracter += 6 + sufijo;
+    if (politica.intervaloSincronizacion > 0)
+        porCaracter += 2 * (5 + sufijo);
+    return longitud * porCaracter + 64;
+}
+
+size_t PlanificadorTramas::completarTrama(char* trama, int longitudCuerpo)
+{
+    int longitud = longitudCuerpo;
+    if (politica.incluirIntegridad)
+    {
+        static const char HEXADECIMAL[] = "0123456789ABCDEF";
+        trama[longitud++] = ',';
+        longitud += escribirEntero(&trama[longitud], secuencia);
+        unsigned char crc = ControlIntegridad::calcularCrc(trama, longitud);
+        trama[longitud++] = '*';
+        trama[longitud++] = HEXADECIMAL[crc >> 4];
+        trama[longitud++] = HEXADECIMAL[crc & 0x0F];
+        secuencia = (secuencia + 1) % 256;
+    }
+    trama[longitud++] = '\n';
+    tramasEmitidas++;
+    return (size_t)longitud;
+}
+
+size_t PlanificadorTramas::contarTrama(char* destino)
+{
+    if (politica.intervaloSincronizacion == 0)
+        return 0;
+
+    tramasDesdeSincronizacion++;
+    if (tramasDesdeSincronizacion < politica.intervaloSincronizacion)
+        return 0;
+
+    tramasDesdeSincronizacion = 0;
+    destino[0] = 'S';
+    destino[1] = ',';
+    return completarTrama(destino, 2 + escribirEntero(&destino[2], rotacion));
+}
+
+size_t PlanificadorTramas::rotar(char* destino)
+{
+    int objetivo = (rotacion + 1) % 26;
+    if (longitudClave > 0)
+    {
+        objetivo = rotacionesClave[indiceClave];
+        indiceClave = (indiceClave + 1) % longitudClave;
+    }
+    rotacionPendiente = false;
+    letrasDesdeRotacion = 0;
+    if (objetivo == rotacion)
+        return 0;
+
+    // Entre avanzar y retroceder gana el valor de menos dígitos
+    int avance = (objetivo - rotacion + 26) % 26;
+    int retroceso = 26 - avance;
+    int digitosAvance = (avance < 10) ? 1 : 2;
+    int digitosRetroceso = (retroceso < 10) ? 2 : 3;
+    int giro = avance;
+    if (digitosRetroceso < digitosAvance ||
+        (digitosRetroceso == digitosAvance && retroceso < avance))
+    {
+        giro = -retroceso;
+    }
+
+    destino[0] = 'M';
+    destino[1] = ',';
+    size_t escritos = completarTrama(destino, 2 + escribirEntero(&destino[2], giro));
+    rotacion = objetivo;
+    rotacionesEmitidas++;
+    return escritos + contarTrama(destino + escritos);
+}
+
+long PlanificadorTramas::validar(const char* texto, size_t longitud) const
+{
+    size_t inicioEspacios = 0;
+    size_t espacios = 0;
+    for (size_t indice = 0; indice < longitud; indice++)
+    {
+        char caracter = texto[indice];
+        if (caracter == '\n' || caracter == '\r' || caracter == '\0')
+            return (long)indice;
+
+        if (politica.incluirIntegridad)
+            continue;
+
+        // Sin sufijo, cada racha de espacios debe caber en un bloque
+        // junto con el carácter que la cierra
+        if (esEspacio((unsigned char)caracter))
+        {
+            if (espacios == 0)
+                inicioEspacios = indice;
+            espacios++;
+            if (espacios >= (size_t)politica.longitudMaximaBloque)
+                return (long)inicioEspacios;
+        }
+        else
+        {
+            espacios = 0;
+        }
+    }
+    if (espacios > 0)
+        return (long)inicioEspacios;
+    return -1;
+}
+
+void PlanificadorTramas::prepararTablas(const char* texto, size_t longitud)
+{
+    if (longitud + 1 > capacidadTrabajo)
+    {
+        delete[] tipoFin;
+        delete[] ultimoFinLibre;
+        delete[] siguienteFinCorto;
+        delete[] letrasHasta;
+        delete[] posicionLetras;
+        delete[] costeDesde;
+        delete[] costeCorte;
+        delete[] siguienteRotacion;
+        delete[] mejorDeGrupo;
+        delete[] alcancesTramo;
+        capacidadTrabajo = (longitud + 1 > 2 * capacidadTrabajo) ? longitud + 1 : 2 * capacidadTrabajo;
+        tipoFin = new unsigned char[capacidadTrabajo];
+        ultimoFinLibre = new size_t[capacidadTrabajo];
+        siguienteFinCorto = new size_t[capacidadTrabajo + 1];
+        letrasHasta = new size_t[capacidadTrabajo];
+        posicionLetras = new size_t[capacidadTrabajo];
+        costeDesde = new long long[capacidadTrabajo];
+        costeCorte = new long long[capacidadTrabajo];
+        siguienteRotacion = new size_t[capacidadTrabajo];
+        mejorDeGrupo = new size_t[capacidadTrabajo / TAMANO_GRUPO + 1];
+        alcancesTramo = new size_t[capacidadTrabajo];
+    }
+
+    tipoFin[0] = FIN_INVALIDO;
+    ultimoFinLibre[0] = 0;
+    letrasHasta[0] = 0;
+    size_t ultimoLibre = 0;
+    size_t letras = 0;
+    for (size_t fin = 1; fin <= longitud; fin++)
+    {
+        unsigned char caracter = (unsigned char)texto[fin - 1];
+        unsigned char tipo = FIN_LIBRE;
+        if (!politica.incluirIntegridad)
+        {
+            if (esEspacio(caracter))
+                tipo = FIN_INVALIDO;
+            else if (fin >= 3 && texto[fin - 3] == '*' &&
+                     puedeSerHexadecimal(texto[fin - 2]) && puedeSerHexadecimal(caracter))
+                tipo = FIN_SOLO_CORTO;
+        }
+        tipoFin[fin] = tipo;
+        if (tipo == FIN_LIBRE)
+            ultimoLibre = fin;
+        ultimoFinLibre[fin] = ultimoLibre;
+        if (esLetra[caracter])
+            posicionLetras[letras++] = fin - 1;
+        letrasHasta[fin] = letras;
+    }
+
+    siguienteFinCorto[longitud + 1] = longitud + 1;
+    for (size_t fin = longitud + 1; fin-- > 0;)
+    {
+        siguienteFinCorto[fin] = (tipoFin[fin] == FIN_SOLO_CORTO) ? fin : siguienteFinCorto[fin + 1];
+    }
+}
+
+size_t PlanificadorTramas::avanzar(size_t desde, size_t tope) const
+{
+    size_t maximo = desde + (size_t)politica.longitudMaximaBloque;
+    if (maximo > tope)
+        maximo = tope;
+    size_t lejano = (ultimoFinLibre[maximo] > desde) ? ultimoFinLibre[maximo] : desde;
+
+    // Un final "*XX" solo lo alcanza un bloque de uno o dos caracteres
+    size_t corto = desde + ((politica.longitudMaximaBloque < 2) ? 1 : 2);
+    if (corto > tope)
+        corto = tope;
+    for (size_t fin = corto; fin > lejano; fin--)
+    {
+        if (tipoFin[fin] == FIN_SOLO_CORTO)
+            return fin;
+    }
+    return lejano;
+}
+
+void PlanificadorTramas::fijarCosteCorte(size_t posicion, long long coste)
+{
+    // Los costes se fijan de derecha a izquierda: ante empate gana el ya fijado
+    costeCorte[posicion] = coste;
+    size_t* mejor = &mejorDeGrupo[posicion / TAMANO_GRUPO];
+    if (coste < costeCorte[*mejor])
+        *mejor = posicion;
+}
+
+size_t PlanificadorTramas::buscarMejorCorte(size_t desde, size_t hasta) const
+{
+    size_t mejor = hasta;
+    size_t posicion = hasta + 1;
+    while (posicion > desde)
+    {
+        size_t candidato;
+        if (posicion % TAMANO_GRUPO == 0 && posicion - TAMANO_GRUPO >= desde)
+        {
+            posicion -= TAMANO_GRUPO;
+            candidato = mejorDeGrupo[posicion / TAMANO_GRUPO];
+        }
+        else
+        {
+            candidato = --posicion;
+        }
+        if (costeCorte[candidato] < costeCorte[mejor])
+            mejor = candidato;
+    }
+    return mejor;
+}
+
+long long PlanificadorTramas::evaluarTramo(size_t inicio, size_t longitud, size_t presupuesto,
+                                           size_t* mejorFin)
+{
+    size_t letrasRestantes = letrasHasta[longitud] - letrasHasta[inicio];
+    size_t limite = (presupuesto < letrasRestantes) ? posicionLetras[letrasHasta[inicio] + presupuesto]
+                                                    : longitud;
+
+    // Con k bloques se llega a cualquier final libre hasta el alcance k:
+    // el bloque que llegó hasta allí también podía detenerse antes
+    long long mejor = COSTE_IMPOSIBLE;
+    *mejorFin = longitud;
+    size_t capas = 0;
+    alcancesTramo[0] = inicio;
+    while (alcancesTramo[capas] < limite)
+    {
+        size_t alcance = avanzar(alcancesTramo[capas], limite);
+        if (alcance == alcancesTramo[capas])
+            break;
+        size_t fin = buscarMejorCorte(alcancesTramo[capas] + 1, alcance);
+        alcancesTramo[++capas] = alcance;
+        long long coste = (long long)capas * costeBloque + costeCorte[fin];
+        if (costeCorte[fin] < COSTE_IMPOSIBLE && coste <= mejor)
+        {
+            mejor = coste;
+            *mejorFin = fin;
+        }
+    }
+
+    // Los finales "*XX" se cierran con un bloque corto tras el mejor camino
+    size_t corto = (politica.longitudMaximaBloque < 2) ? 1 : 2;
+    size_t capa = 0;
+    for (size_t fin = siguienteFinCorto[inicio + 1]; fin <= limite; fin = siguienteFinCorto[fin + 1])
+    {
+        if (costeDesde[fin] >= COSTE_IMPOSIBLE)
+            continue;
+        size_t previo = (fin - inicio > corto) ? fin - corto : inicio;
+        while (capa <= capas && alcancesTramo[capa] < previo)
+        {
+            capa++;
+        }
+        if (capa > capas)
+            break;
+
+        long long coste = (long long)(capa + 1) * costeBloque + costeDesde[fin];
+        if (letrasHasta[longitud] > letrasHasta[fin])
+            coste += costeRotacion;
+        if (coste < mejor || (coste == mejor && fin > *mejorFin))
+        {
+            mejor = coste;
+            *mejorFin = fin;
+        }
+    }
+    return mejor;
+}
+
+size_t PlanificadorTramas::escribirBloque(const char* texto, size_t inicio, size_t fin, char* destino)
+{
+    destino[0] = (fin - inicio == 1) ? 'L' : 'B';
+    destino[1] = ',';
+    const unsigned char* tabla = inversas[rotacion];
+    int cuerpo = 2;
+    for (size_t indice = inicio; indice < fin; indice++)
+    {
+        destino[cuerpo++] = (char)tabla[(unsigned char)texto[indice]];
+    }
+    size_t escritos = completarTrama(destino, cuerpo);
+    return escritos + contarTrama(destino + escritos);
+}
+
+size_t PlanificadorTramas::escribirTramo(const char* texto, size_t inicio, size_t fin, char* destino)
+{
+    // Ante un final "*XX" el último bloque es corto
+    size_t corte = fin;
+    if (tipoFin[fin] == FIN_SOLO_CORTO)
+    {
+        size_t corto = (politica.longitudMaximaBloque < 2) ? 1 : 2;
+        corte = (fin - inicio > corto) ? fin - corto : inicio;
+    }
+
+    char* escritura = destino;
+    size_t posicion = inicio;
+    while (posicion < corte)
+    {
+        size_t siguiente = avanzar(posicion, corte);
+        escritura += escribirBloque(texto, posicion, siguiente, escritura);
+        posicion = siguiente;
+    }
+    if (corte < fin)
+        escritura += escribirBloque(texto, corte, fin, escritura);
+
+    letrasDesdeRotacion += (int)(letrasHasta[fin] - letrasHasta[inicio]);
+    return (size_t)(escritura - destino);
+}
+
+long PlanificadorTramas::codificar(const char* texto, size_t longitud, char* destino, size_t capacidad)
+{
+    posicionError = validar(texto, longitud);
+    if (posicionError >= 0 || capacidad < calcularCapacidadNecesaria(longitud))
+        return -1;
+    if (longitud == 0)
+        return 0;
+
+    prepararTablas(texto, longitud);
+    bool hayLetras = letrasHasta[longitud] > 0;
+    size_t finInicial = longitud;
+    bool girarAntes = hayLetras && rotacionPendiente;
+
+    // Sin límite de letras basta un único tramo hasta el final
+    if (politica.letrasPorRotacion > 0)
+    {
+        size_t presupuesto = (size_t)politica.letrasPorRotacion;
+        for (size_t posicion = 0; posicion <= longitud; posicion++)
+        {
+            costeCorte[posicion] = COSTE_IMPOSIBLE;
+            costeDesde[posicion] = COSTE_IMPOSIBLE;
+        }
+        for (size_t grupo = 0; grupo <= longitud / TAMANO_GRUPO; grupo++)
+        {
+            mejorDeGrupo[grupo] = grupo * TAMANO_GRUPO;
+        }
+
+        // Coste mínimo desde cada posición suponiendo que allí se acaba de girar
+        costeDesde[longitud] = 0;
+        if (tipoFin[longitud] == FIN_LIBRE)
+            fijarCosteCorte(longitud, 0);
+        for (size_t inicio = longitud; inicio-- > 1;)
+        {
+            if (tipoFin[inicio] == FIN_INVALIDO)
+                continue;
+            costeDesde[inicio] = evaluarTramo(inicio, longitud, presupuesto, &siguienteRotacion[inicio]);
+            if (tipoFin[inicio] == FIN_LIBRE && costeDesde[inicio] < COSTE_IMPOSIBLE)
+            {
+                long long giro = (letrasHasta[longitud] > letrasHasta[inicio]) ? costeRotacion : 0;
+                fijarCosteCorte(inicio, costeDesde[inicio] + giro);
+            }
+        }
+        costeDesde[0] = evaluarTramo(0, longitud, presupuesto, &siguienteRotacion[0]);
+
+        // Continuar con las letras que quedan de la rotación actual o girar ya
+        finInicial = siguienteRotacion[0];
+        long long coste = costeDesde[0];
+        if (girarAntes)
+        {
+            coste += costeRotacion;
+        }
+        else if (hayLetras && letrasDesdeRotacion > 0)
+        {
+            size_t quedan = (size_t)(politica.letrasPorRotacion - letrasDesdeRotacion);
+            size_t finSeguir = longitud;
+            long long seguir = (quedan > 0) ? evaluarTramo(0, longitud, quedan, &finSeguir)
+                                            : COSTE_IMPOSIBLE;
+            girarAntes = costeRotacion + costeDesde[0] < seguir;
+            if (girarAntes)
+            {
+                coste += costeRotacion;
+            }
+            else
+            {
+                coste = seguir;
+                finInicial = finSeguir;
+            }
+        }
+        if (coste >= COSTE_IMPOSIBLE)
+        {
+            posicionError = 0;
+            return -1;
+        }
+    }
+
+    char* escritura = destino;
+    if (girarAntes)
+        escritura += rotar(escritura);
+    size_t posicion = 0;
+    size_t fin = finInicial;
+    while (true)
+    {
+        escritura += escribirTramo(texto, posicion, fin, escritura);
+        posicion = fin;
+        if (posicion == longitud)
+            break;
+        if (letrasHasta[longitud] > letrasHasta[posicion])
+            escritura += rotar(escritura);
+        fin = siguienteRotacion[posicion];
+    }
+    return (long)(escritura - destino);
+}
+
+long PlanificadorTramas::cerrar(char* destino, size_t capacidad)
+{
+    if (capacidad < 16)
+        return -1;
+
+    destino[0] = 'F';
+    destino[1] = ',';
+    destino[2] = '0';
+    return (long)completarTrama(destino, 3);
+}
+
+int PlanificadorTramas::obtenerRotacion() const
+{
+    return rotacion;
+}
+
+long long PlanificadorTramas::obtenerTramas() const
+{
+    return tramasEmitidas;
+}
+
+long long PlanificadorTramas::obtenerRotaciones() const
+{
+    return rotacionesEmitidas;
+}
+
+long PlanificadorTramas::obtenerPosicionError() const
+{
+    return posicionError;
+}
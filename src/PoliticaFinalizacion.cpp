@@ -0,0 +1,136 @@
+/**
+ * @file PoliticaFinalizacion.cpp
+ * @brief Implementación de las políticas de fin de transmisión
+ * @author Tu Nombre
+ * @date 2024
+ */
+
+#include "PoliticaFinalizacion.h"
+#include "AnalizadorTramas.h"
+#include <cstring>
+#include <cstdlib>
+
+bool FinalizacionPorTrama::evaluarTrama(const PaqueteBase& paquete, int paquetesRecibidos)
+{
+    (void)paquetesRecibidos;
+    return paquete.obtenerTipo() == 'F';
+}
+
+FinalizacionPorInactividad::FinalizacionPorInactividad(long limite)
+{
+    limiteMilisegundos = limite;
+}
+
+bool FinalizacionPorInactividad::evaluarTrama(const PaqueteBase& paquete, int paquetesRecibidos)
+{
+    (void)paquete;
+    (void)paquetesRecibidos;
+    return false;
+}
+
+bool FinalizacionPorInactividad::evaluarInactividad(long milisegundosInactivo)
+{
+    return milisegundosInactivo >= limiteMilisegundos;
+}
+
+long FinalizacionPorInactividad::obtenerLimiteInactividad() const
+{
+    return limiteMilisegundos;
+}
+
+FinalizacionPorConteo::FinalizacionPorConteo(int total)
+{
+    totalEsperado = total;
+}
+
+bool FinalizacionPorConteo::evaluarTrama(const PaqueteBase& paquete, int paquetesRecibidos)
+{
+    (void)paquete;
+    return paquetesRecibidos >= totalEsperado;
+}
+
+FinalizacionPorCentinela::FinalizacionPorCentinela(char tipo, int valor)
+{
+    tipoCentinela = tipo;
+    valorCentinela = valor;
+}
+
+bool FinalizacionPorCentinela::evaluarTrama(const PaqueteBase& paquete, int paquetesRecibidos)
+{
+    (void)paquetesRecibidos;
+    return paquete.obtenerTipo() == tipoCentinela &&
+           paquete.obtenerValor() == valorCentinela;
+}
+
+bool FinalizacionContinua::evaluarTrama(const PaqueteBase& paquete, int paquetesRecibidos)
+{
+    (void)paquete;
+    (void)paquetesRecibidos;
+    return false;
+}
+
+PoliticaFinalizacion* crearPoliticaFinalizacion(const char* especificacion)
+{
+    if (especificacion == nullptr)
+        return nullptr;
+
+    // Separar nombre y argumento opcional ("nombre:argumento")
+    const char* argumento = std::strchr(especificacion, ':');
+    size_t longitudNombre = (argumento != nullptr)
+        ? (size_t)(argumento - especificacion)
+        : std::strlen(especificacion);
+    if (argumento != nullptr)
+        argumento++;
+
+    if (std::strncmp(especificacion, "trama", longitudNombre) == 0 &&
+        longitudNombre == 5)
+    {
+        return new FinalizacionPorTrama();
+    }
+    if (std::strncmp(especificacion, "continuo", longitudNombre) == 0 &&
+        longitudNombre == 8)
+    {
+        return new FinalizacionContinua();
+    }
+    if (argumento == nullptr || argumento[0] == '\0')
+        return nullptr;
+
+    if (std::strncmp(especificacion, "inactividad", longitudNombre) == 0 &&
+        longitudNombre == 11)
+    {
+        if (!esEnteroDecimal(argumento))
+            return nullptr;
+        long limite = std::atol(argumento);
+        return (limite > 0) ? new FinalizacionPorInactividad(limite) : nullptr;
+    }
+    if (std::strncmp(especificacion, "conteo", longitudNombre) == 0 &&
+        longitudNombre == 6)
+    {
+        if (!esEnteroDecimal(argumento))
+            return nullptr;
+        int total = convertirAEntero(argumento);
+        return (total > 0) ? new FinalizacionPorConteo(total) : nullptr;
+    }
+    if (std::strncmp(especificacion, "centinela", longitudNombre) == 0 &&
+        longitudNombre == 9)
+    {
+        // Formato "T,V": tipo de trama y valor exacto
+        if (argumento[1] != ',')
+            return nullptr;
+        char tipo = argumento[0];
+        if (tipo >= 'a' && tipo <= 'z')
+            tipo = tipo - 'a' + 'A';
+        if (tipo == 'L')
+        {
+            // El valor de L es el carácter mismo
+            if (argumento[2] == '\0' || argumento[3] != '\0')
+                return nullptr;
+            return new FinalizacionPorCentinela(tipo, (int)argumento[2]);
+        }
+        if (!esEnteroDecimal(&argumento[2]))
+            return nullptr;
+        return new FinalizacionPorCentinela(tipo, convertirAEntero(&argumento[2]));
+    }
+
+    return nullptr;
+}
@@ -0,0 +1,100 @@
+/**
+ * @file PublicadorEventos.cpp
+ * @brief Implementación del publicador de eventos
+ * @author Tu Nombre
+ * @date 2024
+ */
+
+#include "PublicadorEventos.h"
+#include "PaqueteCaracter.h"
+#include "PaqueteBloque.h"
+
+PublicadorEventos::PublicadorEventos(AnilloEventos* anilloEventos, ObservadorSesion* observadorSiguiente)
+{
+    anillo = anilloEventos;
+    siguiente = observadorSiguiente;
+    ultimoPaquete = 0;
+}
+
+void PublicadorEventos::alEjecutarPaquete(const PaqueteBase& paquete, int paquetesRecibidos)
+{
+    char tipo = paquete.obtenerTipo();
+    ultimoPaquete = paquetesRecibidos;
+    if (tipo == 'B')
+    {
+        // Los lectores reciben las letras de un bloque como tramas L sueltas
+        const PaqueteBloque& bloque = static_cast<const PaqueteBloque&>(paquete);
+        const char* transportado = bloque.obtenerTextoTransportado();
+        const char* decodificado = bloque.obtenerTextoDecodificado();
+        for (int indice = 0; indice < bloque.obtenerValor(); indice++)
+        {
+            anillo->publicar('L', decodificado[indice], (unsigned char)transportado[indice],
+                             paquetesRecibidos);
+        }
+    }
+    else
+    {
+        char caracter = '\0';
+        if (tipo == 'L')
+        {
+            caracter = static_cast<const PaqueteCaracter&>(paquete).obtenerCaracterDecodificado();
+        }
+        anillo->publicar(tipo, caracter, paquete.obtenerValor(), paquetesRecibidos);
+    }
+
+    if (siguiente != nullptr)
+    {
+        siguiente->alEjecutarPaquete(paquete, paquetesRecibidos);
+    }
+}
+
+void PublicadorEventos::alDescartarLinea(const char* linea, bool corrupta)
+{
+    if (siguiente != nullptr)
+    {
+        siguiente->alDescartarLinea(linea, corrupta);
+    }
+}
+
+void PublicadorEventos::alDetectarHueco(int tramasPerdidas)
+{
+    anillo->publicar('H', '\0', tramasPerdidas, ultimoPaquete);
+    if (siguiente != nullptr)
+    {
+        siguiente->alDetectarHueco(tramasPerdidas);
+    }
+}
+
+void PublicadorEventos::alResincronizar(int rotacionPrevia, int rotacionActual, int caracteresAfectados)
+{
+    anillo->publicar('Y', '\0', rotacionActual, ultimoPaquete);
+    if (siguiente != nullptr)
+    {
+        siguiente->alResincronizar(rotacionPrevia, rotacionActual, caracteresAfectados);
+    }
+}
+
+bool PublicadorEventos::alAnunciarPerfil(long velocidad, bool controlFlujo, int rafaga)
+{
+    if (siguiente == nullptr)
+        return false;
+    return siguiente->alAnunciarPerfil(velocidad, controlFlujo, rafaga);
+}
+
+void PublicadorEventos::alRepetirCiclo(const char* texto, int longitud, int repeticiones)
+{
+    anillo->publicar('C', '\0', repeticiones, ultimoPaquete);
+    if (siguiente != nullptr)
+    {
+        siguiente->alRepetirCiclo(texto, longitud, repeticiones);
+    }
+}
+
+void PublicadorEventos::alCompletarTransmision(bool porInactividad)
+{
+    anillo->publicar('X', '\0', porInactividad ? 1 : 0, ultimoPaquete);
+    if (siguiente != nullptr)
+    {
+        siguiente->alCompletarTransmision(porInactividad);
+    }
+}
@@ -0,0 +1,65 @@
+/**
+ * @file ReproductorCaptura.cpp
+ * @brief Implementación del lector de capturas
+ * @author Tu Nombre
+ * @date 2024
+ */
+
+#include "ReproductorCaptura.h"
+#include <cstring>
+
+ReproductorCaptura::ReproductorCaptura(const char* ruta)
+{
+    valido = false;
+    std::memset(&cabecera, 0, sizeof(cabecera));
+
+    archivo = std::fopen(ruta, "rb");
+    if (archivo == nullptr)
+        return;
+
+    if (std::fread(&cabecera, sizeof(cabecera), 1, archivo) == 1 &&
+        std::strcmp(cabecera.marca, "PRT7CAP") == 0 && cabecera.version == 1)
+    {
+        cabecera.nombrePuerto[sizeof(cabecera.nombrePuerto) - 1] = '\0';
+        valido = true;
+    }
+}
+
+ReproductorCaptura::~ReproductorCaptura()
+{
+    if (archivo != nullptr)
+    {
+        std::fclose(archivo);
+    }
+}
+
+bool ReproductorCaptura::estaOperativo() const
+{
+    return valido;
+}
+
+const char* ReproductorCaptura::obtenerNombrePuerto() const
+{
+    return cabecera.nombrePuerto;
+}
+
+int ReproductorCaptura::leerRegistro(char* destino, unsigned long long* instante, 
+                                     unsigned short* puerto)
+{
+    if (!valido)
+        return -1;
+
+    char cabeceraRegistro[TAMANO_CABECERA_REGISTRO];
+    if (std::fread(cabeceraRegistro, TAMANO_CABECERA_REGISTRO, 1, archivo) != 1)
+        return -1;
+
+    unsigned short longitud;
+    std::memcpy(instante, cabeceraRegistro, 8);
+    std::memcpy(puerto, cabeceraRegistro + 8, 2);
+    std::memcpy(&longitud, cabeceraRegistro + 10, 2);
+
+    // Un registro cortado marca el final de la captura
+    if (std::fread(destino, 1, longitud, archivo) != longitud)
+        return -1;
+    return (int)longitud;
+}
@@ -0,0 +1,134 @@
+/**
+ * @file ReservaBloques.cpp
+ * @brief Implementación de la reserva de bloques de tamaño fijo
+ * @author Tu Nombre
+ * @date 2024
+ */
+
+#include "ReservaBloques.h"
+#include "ContabilidadMemoria.h"
+#include <new>
+
+ReservaBloques* ReservaBloques::primeraReserva = nullptr;
+
+ReservaBloques::ReservaBloques(size_t tamano, int porLote)
+{
+    // Cada bloque debe poder alojar el enlace de la lista libre
+    // y respetar la alineación de punteros
+    const size_t alineacion = sizeof(void*);
+    if (tamano < sizeof(BloqueLibre))
+    {
+        tamano = sizeof(BloqueLibre);
+    }
+    tamanoBloque = (tamano + alineacion - 1) / alineacion * alineacion;
+
+    bloquesPorLote = (porLote > 0) ? porLote : 1;
+    listaLibre = nullptr;
+    lotes = nullptr;
+    bloquesEnUso = 0;
+    reservasSistema = 0;
+
+    siguienteReserva = primeraReserva;
+    primeraReserva = this;
+}
+
+ReservaBloques::~ReservaBloques()
+{
+    ReservaBloques** enlace = &primeraReserva;
+    while (*enlace != nullptr && *enlace != this)
+    {
+        enlace = &(*enlace)->siguienteReserva;
+    }
+    if (*enlace == this)
+    {
+        *enlace = siguienteReserva;
+    }
+
+    LoteBloques* loteActual = lotes;
+    while (loteActual != nullptr)
+    {
+        LoteBloques* loteSiguiente = loteActual->siguiente;
+        ContabilidadMemoria::registrarLiberacion(MEMORIA_PAQUETES, calcularTamanoLote(), bloquesPorLote);
+        ::operator delete(loteActual);
+        loteActual = loteSiguiente;
+    }
+}
+
+size_t ReservaBloques::calcularTamanoLote() const
+{
+    // El encabezado del lote ocupa el primer bloque para mantener
+    // la alineación del resto
+    size_t encabezado = (sizeof(LoteBloques) + tamanoBloque - 1) / tamanoBloque * tamanoBloque;
+    return encabezado + tamanoBloque * bloquesPorLote;
+}
+
+void ReservaBloques::crearLote()
+{
+    size_t encabezado = calcularTamanoLote() - tamanoBloque * bloquesPorLote;
+    char* memoria = (char*)::operator new(calcularTamanoLote());
+    reservasSistema++;
+    ContabilidadMemoria::registrarReserva(MEMORIA_PAQUETES, calcularTamanoLote(), bloquesPorLote);
+
+    LoteBloques* nuevoLote = (LoteBloques*)memoria;
+    nuevoLote->siguiente = lotes;
+    lotes = nuevoLote;
+
+    // Enlazar todos los bloques del lote en la lista libre
+    char* bloque = memoria + encabezado;
+    for (int indice = 0; indice < bloquesPorLote; indice++)
+    {
+        BloqueLibre* libre = (BloqueLibre*)bloque;
+        libre->siguiente = listaLibre;
+        listaLibre = libre;
+        bloque += tamanoBloque;
+    }
+}
+
+void* ReservaBloques::obtener()
+{
+    if (listaLibre == nullptr)
+    {
+        crearLote();
+    }
+
+    BloqueLibre* bloque = listaLibre;
+    listaLibre = bloque->siguiente;
+    bloquesEnUso++;
+    return bloque;
+}
+
+void ReservaBloques::liberar(void* bloque)
+{
+    if (bloque == nullptr)
+        return;
+
+    BloqueLibre* libre = (BloqueLibre*)bloque;
+    libre->siguiente = listaLibre;
+    listaLibre = libre;
+    bloquesEnUso--;
+}
+
+size_t ReservaBloques::obtenerTamanoBloque() const
+{
+    return tamanoBloque;
+}
+
+int ReservaBloques::obtenerBloquesEnUso() const
+{
+    return bloquesEnUso;
+}
+
+int ReservaBloques::obtenerReservasSistema() const
+{
+    return reservasSistema;
+}
+
+int ReservaBloques::obtenerReservasSistemaTotales()
+{
+    int total = 0;
+    for (ReservaBloques* reserva = primeraReserva; reserva != nullptr; reserva = reserva->siguienteReserva)
+    {
+        total += reserva->reservasSistema;
+    }
+    return total;
+}
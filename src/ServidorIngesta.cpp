@@ -0,0 +1,255 @@
+/**
+ * @file ServidorIngesta.cpp
+ * @brief Implementación del servidor de ingesta por sockets
+ * @author Tu Nombre
+ * @date 2024
+ */
+
+#include "ServidorIngesta.h"
+#include "AnalizadorTramas.h"
+#include <cstdio>
+#include <cstring>
+
+#ifdef __linux__
+#include <cerrno>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+/// Conexiones que el núcleo mantiene en espera de accept()
+static const int COLA_ESCUCHA = 128;
+
+ConexionSocket::ConexionSocket(int descriptorAceptado, const char* descripcionOrigen)
+{
+    descriptor = descriptorAceptado;
+    std::snprintf(origen, sizeof(origen), "%s", descripcionOrigen);
+}
+
+ConexionSocket::~ConexionSocket()
+{
+#ifdef __linux__
+    if (descriptor >= 0)
+    {
+        close(descriptor);
+    }
+#endif
+}
+
+int ConexionSocket::leerDisponible(char* destino, int capacidad)
+{
+#ifdef __linux__
+    if (descriptor < 0)
+        return -1;
+
+    ssize_t cantidadLeida = recv(descriptor, destino, (size_t)capacidad, 0);
+    if (cantidadLeida < 0)
+    {
+        return (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) ? 0 : -1;
+    }
+    if (cantidadLeida == 0)
+    {
+        // El otro extremo cerró la conexión
+        return -1;
+    }
+    return (int)cantidadLeida;
+#else
+    (void)destino;
+    (void)capacidad;
+    return -1;
+#endif
+}
+
+int ConexionSocket::obtenerDescriptor() const
+{
+    return descriptor;
+}
+
+bool ConexionSocket::estaOperativo()
+{
+    return descriptor >= 0;
+}
+
+const char* ConexionSocket::obtenerOrigen() const
+{
+    return origen;
+}
+
+ServidorIngesta::ServidorIngesta(const char* especificacion, ReceptorConexiones* receptorConexiones)
+{
+    descriptorEscucha = -1;
+    rutaUnix[0] = '\0';
+    receptor = receptorConexiones;
+    conexionesAceptadas = 0;
+
+    if (std::strncmp(especificacion, "unix:", 5) == 0)
+    {
+        escucharUnix(especificacion + 5);
+    }
+    else if (std::strncmp(especificacion, "tcp:", 4) == 0)
+    {
+        // "tcp:PUERTO" o "tcp:DIRECCION:PUERTO"
+        const char* resto = especificacion + 4;
+        const char* separador = std::strrchr(resto, ':');
+        if (separador == nullptr)
+        {
+            escucharTcp(nullptr, convertirAEntero(resto));
+        }
+        else
+        {
+            char direccion[64];
+            int longitud = (int)(separador - resto);
+            if (longitud < (int)sizeof(direccion))
+            {
+                std::memcpy(direccion, resto, longitud);
+                direccion[longitud] = '\0';
+                escucharTcp(direccion, convertirAEntero(separador + 1));
+            }
+        }
+    }
+}
+
+ServidorIngesta::~ServidorIngesta()
+{
+#ifdef __linux__
+    if (descriptorEscucha >= 0)
+    {
+        close(descriptorEscucha);
+    }
+    if (rutaUnix[0] != '\0')
+    {
+        unlink(rutaUnix);
+    }
+#endif
+}
+
+bool ServidorIngesta::escucharTcp(const char* direccion, int puerto)
+{
+#ifdef __linux__
+    if (puerto <= 0 || puerto > 65535)
+        return false;
+
+    struct sockaddr_in local;
+    std::memset(&local, 0, sizeof(local));
+    local.sin_family = AF_INET;
+    local.sin_port = htons((unsigned short)puerto);
+    local.sin_addr.s_addr = htonl(INADDR_ANY);
+    if (direccion != nullptr && inet_pton(AF_INET, direccion, &local.sin_addr) != 1)
+        return false;
+
+    int descriptor = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (descriptor < 0)
+        return false;
+
+    // Reiniciar el servidor no debe esperar a que expire TIME_WAIT
+    int activar = 1;
+    setsockopt(descriptor, SOL_SOCKET, SO_REUSEADDR, &activar, sizeof(activar));
+
+    // Antes de listen(): la escala de ventana se negocia en el SYN
+    int tamano = TAMANO_RECEPCION_SOCKET;
+    setsockopt(descriptor, SOL_SOCKET, SO_RCVBUF, &tamano, sizeof(tamano));
+
+    if (bind(descriptor, (struct sockaddr*)&local, sizeof(local)) != 0 ||
+        listen(descriptor, COLA_ESCUCHA) != 0)
+    {
+        close(descriptor);
+        return false;
+    }
+
+    descriptorEscucha = descriptor;
+    return true;
+#else
+    (void)direccion;
+    (void)puerto;
+    return false;
+#endif
+}
+
+bool ServidorIngesta::escucharUnix(const char* ruta)
+{
+#ifdef __linux__
+    struct sockaddr_un local;
+    std::memset(&local, 0, sizeof(local));
+    local.sun_family = AF_UNIX;
+    if (ruta[0] == '\0' || std::strlen(ruta) >= sizeof(local.sun_path))
+        return false;
+    std::strcpy(local.sun_path, ruta);
+
+    int descriptor = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (descriptor < 0)
+        return false;
+
+    int tamano = TAMANO_RECEPCION_SOCKET;
+    setsockopt(descriptor, SOL_SOCKET, SO_RCVBUF, &tamano, sizeof(tamano));
+
+    // Un socket abandonado por una ejecución anterior impediría bind()
+    unlink(ruta);
+    if (bind(descriptor, (struct sockaddr*)&local, sizeof(local)) != 0 ||
+        listen(descriptor, COLA_ESCUCHA) != 0)
+    {
+        close(descriptor);
+        return false;
+    }
+
+    std::strcpy(rutaUnix, ruta);
+    descriptorEscucha = descriptor;
+    return true;
+#else
+    (void)ruta;
+    return false;
+#endif
+}
+
+bool ServidorIngesta::estaOperativo() const
+{
+    return descriptorEscucha >= 0;
+}
+
+int ServidorIngesta::obtenerConexionesAceptadas() const
+{
+    return conexionesAceptadas;
+}
+
+int ServidorIngesta::obtenerDescriptor() const
+{
+    return descriptorEscucha;
+}
+
+bool ServidorIngesta::alRecibirDatos()
+{
+#ifdef __linux__
+    while (true)
+    {
+        struct sockaddr_storage remoto;
+        socklen_t longitudRemoto = sizeof(remoto);
+        int descriptor = accept4(descriptorEscucha, (struct sockaddr*)&remoto, &longitudRemoto,
+                                 SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (descriptor < 0)
+        {
+            // EAGAIN: no quedan conexiones pendientes; otros errores
+            // (por ejemplo EMFILE) se reintentan en el próximo aviso
+            return true;
+        }
+
+        char origen[128];
+        if (remoto.ss_family == AF_INET)
+        {
+            struct sockaddr_in* direccion = (struct sockaddr_in*)&remoto;
+            char texto[INET_ADDRSTRLEN];
+            inet_ntop(AF_INET, &direccion->sin_addr, texto, sizeof(texto));
+            std::snprintf(origen, sizeof(origen), "%s:%d", texto, ntohs(direccion->sin_port));
+        }
+        else
+        {
+            std::snprintf(origen, sizeof(origen), "%s", rutaUnix);
+        }
+
+        conexionesAceptadas++;
+        receptor->alAceptarConexion(new ConexionSocket(descriptor, origen));
+    }
+#else
+    return true;
+#endif
+}
@@ -0,0 +1,351 @@
+/**
+ * @file SesionDecodificacion.cpp
+ * @brief Implementación del núcleo de decodificación de un canal
+ * @author Tu Nombre
+ * @date 2024
+ */
+
+#include "SesionDecodificacion.h"
+#include "AnalizadorTramas.h"
+#include "PaqueteBloque.h"
+#include <cstring>
+
+/// Longitud máxima de línea más datos en tránsito del ensamblador
+static const int CAPACIDAD_ENSAMBLADOR = 512;
+
+SesionDecodificacion::SesionDecodificacion(PoliticaFinalizacion* politica, int cantidadRotores,
+                                           bool avanceRotores, bool exigirIntegridad)
+    : integridad(exigirIntegridad), ensamblador(CAPACIDAD_ENSAMBLADOR)
+{
+    cadena = nullptr;
+    if (cantidadRotores > 1 || avanceRotores)
+    {
+        cadena = new CadenaRotores(cantidadRotores, avanceRotores);
+    }
+    politicaFin = politica;
+    observador = &observadorNulo;
+    cache = nullptr;
+
+    transmisionCompleta = false;
+    paquetesRecibidos = 0;
+    cambiosPerfil = 0;
+    bytesRecibidos = 0;
+    bytesUtiles = 0;
+    tramasMalformadas = 0;
+    lineasIgnoradas = 0;
+}
+
+SesionDecodificacion::~SesionDecodificacion()
+{
+    delete cadena;
+    delete cache;
+}
+
+bool SesionDecodificacion::activarDeduplicacion(int maximoCiclos, int maximoTramas)
+{
+    if (cadena != nullptr)
+        return false;
+
+    delete cache;
+    cache = new CacheCiclos(maximoCiclos, maximoTramas);
+    cache->iniciarCiclo(disco.obtenerDesplazamiento());
+    return true;
+}
+
+const CacheCiclos* SesionDecodificacion::obtenerCache() const
+{
+    return cache;
+}
+
+bool SesionDecodificacion::registrarEnCache(const char* texto)
+{
+    const char* pendientes;
+    int cantidadPendientes;
+    bool especulando = cache->registrarTrama(texto, &pendientes, &cantidadPendientes);
+    for (int indice = 0; indice < cantidadPendientes; indice++)
+    {
+        mensaje.agregarCaracter(pendientes[indice]);
+    }
+    return especulando;
+}
+
+void SesionDecodificacion::establecerObservador(ObservadorSesion* nuevoObservador)
+{
+    observador = (nuevoObservador != nullptr) ? nuevoObservador : &observadorNulo;
+}
+
+void SesionDecodificacion::procesarLinea(char* linea)
+{
+    // Limpiar espacios
+    int inicio = eliminarEspaciosIniciales(linea);
+    eliminarEspaciosFinales(&linea[inicio]);
+
+    // Ignorar líneas vacías
+    if (linea[inicio] == '\0')
+        return;
+
+    // Anuncio de perfil: el transmisor cambia de velocidad tras enviarlo
+    long velocidadAnunciada;
+    bool controlFlujoAnunciado;
+    int rafagaAnunciada;
+    if (analizarAnuncioPerfil(&linea[inicio], &velocidadAnunciada,
+                              &controlFlujoAnunciado, &rafagaAnunciada))
+    {
+        if (observador->alAnunciarPerfil(velocidadAnunciada, controlFlujoAnunciado,
+                                         rafagaAnunciada))
+        {
+            // Lo que siga en el almacén se leyó con el perfil anterior
+            cambiosPerfil++;
+            ensamblador.descartarPendiente();
+        }
+        return;
+    }
+
+    // Verificar secuencia y CRC en las líneas con forma de trama
+    if (linea[inicio + 1] == ',')
+    {
+        if (integridad.verificar(&linea[inicio]) == INTEGRIDAD_CORRUPTA)
+        {
+            observador->alDescartarLinea(&linea[inicio], true);
+            return;
+        }
+        if (integridad.obtenerUltimoHueco() > 0)
+        {
+            observador->alDetectarHueco(integridad.obtenerUltimoHueco());
+        }
+    }
+
+    // Analizar y crear paquete
+    PaqueteBase* paqueteActual = analizarPaquete(&linea[inicio]);
+
+    if (paqueteActual == nullptr)
+    {
+        // Reportar solo errores de paquetes aparentemente válidos
+        if (esTipoTrama(linea[inicio]))
+        {
+            tramasMalformadas++;
+            observador->alDescartarLinea(&linea[inicio], false);
+        }
+        else
+        {
+            lineasIgnoradas++;
+        }
+        return;
+    }
+
+    // Estadísticas del enlace
+    ultimaTrama = std::chrono::steady_clock::now();
+    if (bytesUtiles == 0)
+    {
+        primeraTrama = ultimaTrama;
+    }
+    bytesUtiles += (long long)std::strlen(&linea[inicio]) + 1;
+
+    // Dentro de un ciclo conocido las letras ya están decodificadas
+    char tipo = paqueteActual->obtenerTipo();
+    int caracteresTrama = (tipo == 'L') ? 1 : (tipo == 'B') ? paqueteActual->obtenerValor() : 0;
+    bool cicloConocido = (cache != nullptr && registrarEnCache(&linea[inicio]));
+
+    // Ejecutar paquete (polimorfismo)
+    int rotacionPrevia;
+    int rotacionActual;
+    if (cicloConocido && caracteresTrama > 0)
+    {
+        for (int indice = 0; indice < caracteresTrama; indice++)
+        {
+            cache->omitirCaracter();
+        }
+        rotacionPrevia = disco.obtenerDesplazamiento();
+        rotacionActual = rotacionPrevia;
+    }
+    else if (cadena != nullptr)
+    {
+        rotacionPrevia = cadena->obtenerDesplazamiento(0);
+        paqueteActual->ejecutarEnCadena(&mensaje, cadena);
+        rotacionActual = cadena->obtenerDesplazamiento(0);
+    }
+    else
+    {
+        rotacionPrevia = disco.obtenerDesplazamiento();
+        paqueteActual->ejecutar(&mensaje, &disco);
+        rotacionActual = disco.obtenerDesplazamiento();
+    }
+    paquetesRecibidos++;
+
+    if (cache != nullptr && !cicloConocido && caracteresTrama > 0)
+    {
+        char recientes[LONGITUD_MAXIMA_BLOQUE];
+        int copiados = mensaje.copiarDesde(mensaje.obtenerLongitud() - caracteresTrama,
+                                           recientes, caracteresTrama);
+        for (int indice = 0; indice < copiados; indice++)
+        {
+            cache->registrarCaracter(recientes[indice]);
+        }
+    }
+
+    if (cache != nullptr && tipo == 'F')
+    {
+        // Fin de ciclo: informar la repetición en lugar de la trama
+        const CicloConocido* repetido = cache->cerrarCiclo();
+        cache->iniciarCiclo(disco.obtenerDesplazamiento());
+        if (repetido != nullptr)
+        {
+            observador->alRepetirCiclo(repetido->texto, repetido->longitudTexto,
+                                       repetido->repeticiones);
+        }
+        else
+        {
+            observador->alEjecutarPaquete(*paqueteActual, paquetesRecibidos);
+        }
+    }
+    else if (!cicloConocido)
+    {
+        observador->alEjecutarPaquete(*paqueteActual, paquetesRecibidos);
+    }
+
+    // Medir el alcance de las pérdidas
+    for (int indice = 0; indice < caracteresTrama; indice++)
+    {
+        integridad.registrarCaracter();
+    }
+    if (tipo == 'S')
+    {
+        int afectados = integridad.registrarSincronizacion(rotacionPrevia, rotacionActual);
+        if (rotacionPrevia != rotacionActual)
+        {
+            observador->alResincronizar(rotacionPrevia, rotacionActual, afectados);
+        }
+    }
+
+    // Verificar condición de finalización sobre el paquete ya analizado
+    if (politicaFin->evaluarTrama(*paqueteActual, paquetesRecibidos))
+    {
+        transmisionCompleta = true;
+        observador->alCompletarTransmision(false);
+    }
+
+    // Liberar memoria del paquete
+    delete paqueteActual;
+}
+
+void SesionDecodificacion::procesarLineasCompletas()
+{
+    char* linea = ensamblador.extraerLinea();
+    while (linea != nullptr && !transmisionCompleta)
+    {
+        procesarLinea(linea);
+        linea = ensamblador.extraerLinea();
+    }
+}
+
+void SesionDecodificacion::decodificarBloque(const char* datos, int cantidad)
+{
+    while (cantidad > 0 && !transmisionCompleta)
+    {
+        int disponible = 0;
+        char* destino = ensamblador.reservarEspacio(&disponible);
+        int tramo = (cantidad < disponible) ? cantidad : disponible;
+        std::memcpy(destino, datos, tramo);
+        confirmarRecepcion(tramo);
+        datos += tramo;
+        cantidad -= tramo;
+    }
+}
+
+char* SesionDecodificacion::reservarEspacio(int* disponible)
+{
+    return ensamblador.reservarEspacio(disponible);
+}
+
+void SesionDecodificacion::confirmarRecepcion(int cantidad)
+{
+    bytesRecibidos += cantidad;
+    ensamblador.confirmar(cantidad);
+    procesarLineasCompletas();
+}
+
+void SesionDecodificacion::procesarInactividad(long milisegundosInactivo)
+{
+    if (!transmisionCompleta && politicaFin->evaluarInactividad(milisegundosInactivo))
+    {
+        transmisionCompleta = true;
+        observador->alCompletarTransmision(true);
+    }
+}
+
+bool SesionDecodificacion::estaCompleta() const
+{
+    return transmisionCompleta;
+}
+
+long SesionDecodificacion::obtenerLimiteInactividad() const
+{
+    return politicaFin->obtenerLimiteInactividad();
+}
+
+MensajeDecodificado& SesionDecodificacion::obtenerMensaje()
+{
+    return mensaje;
+}
+
+const MensajeDecodificado& SesionDecodificacion::obtenerMensaje() const
+{
+    return mensaje;
+}
+
+DiscoRotatorio& SesionDecodificacion::obtenerDisco()
+{
+    return disco;
+}
+
+const CadenaRotores* SesionDecodificacion::obtenerCadena() const
+{
+    return cadena;
+}
+
+const ControlIntegridad& SesionDecodificacion::obtenerIntegridad() const
+{
+    return integridad;
+}
+
+int SesionDecodificacion::obtenerPaquetesRecibidos() const
+{
+    return paquetesRecibidos;
+}
+
+void SesionDecodificacion::establecerPaquetesRecibidos(int cantidad)
+{
+    paquetesRecibidos = cantidad;
+}
+
+int SesionDecodificacion::obtenerCambiosPerfil() const
+{
+    return cambiosPerfil;
+}
+
+long long SesionDecodificacion::obtenerBytesRecibidos() const
+{
+    return bytesRecibidos;
+}
+
+long long SesionDecodificacion::obtenerBytesUtiles() const
+{
+    return bytesUtiles;
+}
+
+int SesionDecodificacion::obtenerTramasMalformadas() const
+{
+    return tramasMalformadas + ensamblador.obtenerLineasDescartadas();
+}
+
+int SesionDecodificacion::obtenerLineasIgnoradas() const
+{
+    return lineasIgnoradas;
+}
+
+double SesionDecodificacion::obtenerSegundosActivos() const
+{
+    if (bytesUtiles == 0)
+        return 0.0;
+    return std::chrono::duration<double>(ultimaTrama - primeraTrama).count();
+}
@@ -8,205 +8,1006 @@
  * mediante un protocolo de ensamblaje dinámico desde Arduino.
  */
 
-#include "PaqueteBase.h"
-#include "PaqueteCaracter.h"
-#include "PaqueteRotacion.h"
-#include "DiscoRotatorio.h"
-#include "MensajeDecodificado.h"
+#include "ReservaBloques.h"
+#include "SesionDecodificacion.h"
+#include "AnalizadorTramas.h"
 #include "ComunicadorSerial.h"
+#include "BitacoraEstado.h"
+#include "GrabadorCaptura.h"
+#include "ReproductorCaptura.h"
+#include "ArchivadorTramas.h"
+#include "DecodificadorArchivo.h"
+#include "BucleEventos.h"
+#include "ServidorIngesta.h"
+#include "PublicadorEventos.h"
+#include "ContabilidadMemoria.h"
+#include "LectorBajaLatencia.h"
+#include "HistogramaLatencia.h"
 #include <iostream>
 #include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <csignal>
+#include <thread>
 
 // =====================================================
-// FUNCIONES AUXILIARES DE PARSEO
+// SALIDA POR CONSOLA
 // =====================================================
 
 /**
- * @brief Elimina espacios en blanco al inicio de una cadena
- * @param texto Cadena a procesar
- * @return Índice del primer carácter no blanco
+ * @brief Muestra el mensaje con cada carácter entre corchetes
+ * @param mensaje Mensaje a mostrar
  */
-int eliminarEspaciosIniciales(const char* texto)
+void mostrarMensaje(const MensajeDecodificado& mensaje)
 {
-    int indice = 0;
-    while (texto[indice] == ' ' || texto[indice] == '\t')
+    for (IteradorMensaje iterador = mensaje.iteradorInicio(); iterador.esValido(); iterador.avanzar())
     {
-        indice++;
+        std::cout << "[" << iterador.obtenerCaracter() << "]";
     }
-    return indice;
 }
 
 /**
- * @brief Elimina espacios y saltos de línea al final de una cadena
- * @param texto Cadena a modificar (se modifica in-place)
+ * @class ObservadorConsola
+ * @brief Presenta en consola los sucesos de la sesión
+ * 
+ * Además de mostrar el progreso guarda las instantáneas de la
+ * bitácora y aplica al puerto los perfiles que anuncia el
+ * transmisor. Cuando los eventos se publican en memoria compartida
+ * no se muestra cada trama, solo las incidencias.
  */
-void eliminarEspaciosFinales(char* texto)
+class ObservadorConsola : public ObservadorSesion
 {
-    int longitud = 0;
-    while (texto[longitud] != '\0')
+private:
+    SesionDecodificacion* sesion;     ///< Sesión observada
+    ComunicadorSerial* comunicador;   ///< Puerto al que aplicar anuncios de perfil (o nullptr)
+    BitacoraEstado* bitacora;         ///< Bitácora de instantáneas (o nullptr)
+    int tramasPorInstantanea;         ///< Frecuencia de las instantáneas
+    bool mostrarTramas;               ///< false para omitir el detalle de cada trama
+
+public:
+    ObservadorConsola(SesionDecodificacion* sesionObservada, ComunicadorSerial* puerto,
+                      BitacoraEstado* bitacoraEstado, int frecuenciaInstantaneas,
+                      bool detallarTramas)
+        : sesion(sesionObservada), comunicador(puerto), bitacora(bitacoraEstado),
+          tramasPorInstantanea(frecuenciaInstantaneas), mostrarTramas(detallarTramas)
     {
-        longitud++;
     }
-    
-    if (longitud == 0)
-        return;
-    
-    longitud--;
-    while (longitud >= 0 && 
-           (texto[longitud] == ' ' || texto[longitud] == '\t' ||
-            texto[longitud] == '\r' || texto[longitud] == '\n'))
+
+    void alEjecutarPaquete(const PaqueteBase& paquete, int paquetesRecibidos)
     {
-        texto[longitud] = '\0';
-        longitud--;
+        char tipo = paquete.obtenerTipo();
+        if (mostrarTramas)
+        {
+            char descripcion[160];
+            paquete.describir(descripcion, sizeof(descripcion));
+            std::cout << descripcion;
+
+            if (tipo == 'L' || tipo == 'B')
+            {
+                std::cout << " Mensaje: ";
+                mostrarMensaje(sesion->obtenerMensaje());
+                std::cout << std::endl;
+            }
+            else if (tipo == 'F')
+            {
+                std::cout << std::endl;
+            }
+            else
+            {
+                std::cout << std::endl << std::endl;
+            }
+        }
+
+        // Guardar instantánea tras cada rotación y cada N tramas
+        if (bitacora != nullptr &&
+            (tipo == 'M' || tipo == 'R' || tipo == 'S' ||
+             paquetesRecibidos % tramasPorInstantanea == 0))
+        {
+            bitacora->registrar(sesion->obtenerMensaje(), sesion->obtenerDisco(), 
+                                paquetesRecibidos);
+        }
+    }
+
+    void alDescartarLinea(const char* linea, bool corrupta)
+    {
+        if (corrupta)
+        {
+            std::cout << "Trama corrupta descartada: [" << linea << "]" << std::endl;
+        }
+        else
+        {
+            std::cout << "Paquete malformado detectado: [" << linea << "]" << std::endl;
+        }
+    }
+
+    void alDetectarHueco(int tramasPerdidas)
+    {
+        std::cout << ">>> Hueco en la secuencia: " << tramasPerdidas
+                  << " tramas perdidas. <<<" << std::endl;
+    }
+
+    void alResincronizar(int rotacionPrevia, int rotacionActual, int caracteresAfectados)
+    {
+        std::cout << ">>> Disco resincronizado: +" << rotacionPrevia << " -> +" 
+                  << rotacionActual << ", " << caracteresAfectados 
+                  << " caracteres afectados. <<<" << std::endl;
     }
-}
+
+    bool alAnunciarPerfil(long velocidad, bool controlFlujo, int rafaga)
+    {
+        if (comunicador == nullptr)
+        {
+            // Reproducción: los bytes grabados ya llegaron con el perfil nuevo
+            std::cout << "Perfil de transporte grabado: " << velocidad 
+                      << " baudios." << std::endl;
+            return false;
+        }
+        if (!comunicador->configurarPerfil(velocidad, controlFlujo))
+        {
+            std::cout << "Perfil anunciado no soportado: " << velocidad << " baudios" << std::endl;
+            return false;
+        }
+        std::cout << "Perfil de transporte: " << velocidad << " baudios"
+                  << (controlFlujo ? ", RTS/CTS" : "")
+                  << ", rafagas de " << rafaga << " tramas." << std::endl;
+        return true;
+    }
+
+    void alRepetirCiclo(const char* texto, int longitud, int repeticiones)
+    {
+        std::cout << ">>> Mensaje repetido x" << repeticiones << ": ";
+        std::cout.write(texto, longitud);
+        std::cout << " <<<" << std::endl;
+    }
+
+    void alCompletarTransmision(bool porInactividad)
+    {
+        std::cout << std::endl 
+                  << (porInactividad ? ">>> Tiempo de inactividad agotado. <<<"
+                                     : ">>> Indicador de finalizacion detectado. <<<")
+                  << std::endl;
+    }
+};
+
+// =====================================================
+// FUENTES DE DATOS
+// =====================================================
 
 /**
- * @brief Busca la posición de un carácter en una cadena
- * @param texto Cadena donde buscar
- * @param objetivo Carácter a buscar
- * @return Índice del carácter, o -1 si no se encuentra
+ * @class FuenteTransporte
+ * @brief Canal del bucle de eventos que decodifica un transporte
+ * 
+ * Encadena las etapas leer -> entramar -> decodificar -> emitir cada
+ * vez que el núcleo avisa que el transporte tiene bytes. Lee hasta
+ * agotar el descriptor, así que admite el disparo por flanco.
+ * 
+ * Con grabación, el bucle avisa además cada INTERVALO_VACIADO_CAPTURA_MS
+ * sin datos para que los bloques completos lleguen al archivo aunque
+ * el lote no se llene; la inactividad se acumula entre avisos para
+ * que la política de fin siga viendo el tiempo real sin datos.
+ * 
+ * Con histograma, cada lectura se mide igual que en el modo de baja
+ * latencia: desde que read() devolvió los bytes hasta que la sesión
+ * terminó de decodificarlos.
  */
-int buscarCaracter(const char* texto, char objetivo)
+class FuenteTransporte : public FuenteEventos
 {
-    int indice = 0;
-    while (texto[indice] != '\0')
+protected:
+    Transporte* transporte;           ///< Medio de entrada
+    SesionDecodificacion* sesion;     ///< Etapas de entramado y decodificación
+    GrabadorCaptura* grabador;        ///< Grabación de los bytes crudos (o nullptr)
+    BucleEventos* bucle;              ///< Bucle a detener al terminar
+    HistogramaLatencia* histograma;   ///< Latencia de cada lectura (o nullptr)
+    long inactividadAcumulada;        ///< Milisegundos sin datos desde la última lectura
+
+    /**
+     * @brief Aviso de que el canal deja de leer
+     * @param transporteCerrado true si el otro extremo cerró o falló
+     */
+    virtual void alTerminar(bool transporteCerrado)
     {
-        if (texto[indice] == objetivo)
+        if (transporteCerrado)
         {
-            return indice;
+            std::cout << std::endl << ">>> Puerto cerrado. <<<" << std::endl;
         }
-        indice++;
+        bucle->detener();
     }
-    return -1;
-}
+
+    /**
+     * @brief Registra la latencia de una lectura ya decodificada
+     * @param instanteLectura Instante en que read() devolvió los bytes
+     */
+    void registrarLatencia(long long instanteLectura)
+    {
+        if (histograma != nullptr)
+        {
+            histograma->registrar((unsigned long long)(LectorBajaLatencia::instanteActual() - instanteLectura));
+        }
+    }
+
+public:
+    FuenteTransporte(Transporte* medio, SesionDecodificacion* sesionCanal,
+                     GrabadorCaptura* grabadorCaptura, BucleEventos* bucleEventos,
+                     HistogramaLatencia* histogramaLatencia)
+        : transporte(medio), sesion(sesionCanal), grabador(grabadorCaptura),
+          bucle(bucleEventos), histograma(histogramaLatencia), inactividadAcumulada(0)
+    {
+    }
+
+    int obtenerDescriptor() const
+    {
+        return transporte->obtenerDescriptor();
+    }
+
+    bool alRecibirDatos()
+    {
+        int leidos;
+        do
+        {
+            int disponible = 0;
+            if (grabador != nullptr && grabador->estaOperativo())
+            {
+                // Leer directamente en el lote del grabador y entramar desde ahí
+                char* destino = grabador->reservarRegistro(&disponible);
+                leidos = transporte->leerDisponible(destino, disponible);
+                if (leidos > 0)
+                {
+                    long long instanteLectura = LectorBajaLatencia::instanteActual();
+                    grabador->confirmarRegistro(leidos, 0);
+                    sesion->decodificarBloque(destino, leidos);
+                    registrarLatencia(instanteLectura);
+                }
+            }
+            else
+            {
+                // Leer directamente en el almacén del ensamblador
+                char* destino = sesion->reservarEspacio(&disponible);
+                leidos = transporte->leerDisponible(destino, disponible);
+                if (leidos > 0)
+                {
+                    long long instanteLectura = LectorBajaLatencia::instanteActual();
+                    sesion->confirmarRecepcion(leidos);
+                    registrarLatencia(instanteLectura);
+                }
+            }
+        } while (leidos > 0 && !sesion->estaCompleta());
+        inactividadAcumulada = 0;
+
+        if (grabador != nullptr)
+        {
+            grabador->vaciarPeriodico();
+        }
+
+        if (leidos < 0 || sesion->estaCompleta())
+        {
+            alTerminar(leidos < 0);
+            return false;
+        }
+        return true;
+    }
+
+    long obtenerLimiteInactividad() const
+    {
+        long limite = sesion->obtenerLimiteInactividad();
+        if (grabador == nullptr)
+            return limite;
+
+        // Avisar a tiempo de vaciar la captura sin pasarse del límite de la política
+        long restante = (limite >= 0) ? limite - inactividadAcumulada : INTERVALO_VACIADO_CAPTURA_MS;
+        if (restante < 0)
+            restante = 0;
+        return (restante < INTERVALO_VACIADO_CAPTURA_MS) ? restante : INTERVALO_VACIADO_CAPTURA_MS;
+    }
+
+    bool alAgotarInactividad(long milisegundosInactivo)
+    {
+        inactividadAcumulada += milisegundosInactivo;
+        if (grabador != nullptr)
+        {
+            grabador->vaciar();
+        }
+        if (sesion->obtenerLimiteInactividad() < 0)
+            return true;
+
+        sesion->procesarInactividad(inactividadAcumulada);
+        if (sesion->estaCompleta())
+        {
+            alTerminar(false);
+            return false;
+        }
+        return true;
+    }
+};
+
+// =====================================================
+// SERVIDOR DE INGESTA
+// =====================================================
 
 /**
- * @brief Convierte una cadena a número entero (similar a atoi)
- * @param texto Cadena numérica a convertir
- * @return Valor entero
+ * @struct ConfiguracionCanal
+ * @brief Opciones de decodificación que comparten todas las conexiones
  */
-int convertirAEntero(const char* texto)
+struct ConfiguracionCanal
 {
-    int resultado = 0;
-    int signo = 1;
-    int indice = 0;
-    
-    // Manejar signo negativo
-    if (texto[0] == '-')
+    const char* especificacionFin;    ///< Política de fin de cada conexión
+    int cantidadRotores;              ///< Rotores de la cadena
+    bool avanceRotores;               ///< Avance tipo odómetro
+    bool exigirIntegridad;            ///< Sufijo de integridad obligatorio
+    int ciclosDeduplicacion;          ///< Ciclos recordados (0 = sin deduplicar)
+};
+
+/**
+ * @class ObservadorConexion
+ * @brief Informa los sucesos anómalos de una conexión
+ * 
+ * Con muchas conexiones simultáneas no se muestra cada trama: solo
+ * las incidencias, precedidas del número de conexión.
+ */
+class ObservadorConexion : public ObservadorSesion
+{
+private:
+    int numero;                       ///< Número de la conexión
+    Transporte* transporte;           ///< Conexión observada
+
+public:
+    ObservadorConexion(int numeroConexion, Transporte* conexion)
+        : numero(numeroConexion), transporte(conexion)
     {
-        signo = -1;
-        indice = 1;
     }
-    else if (texto[0] == '+')
+
+    void alDescartarLinea(const char* linea, bool corrupta)
     {
-        indice = 1;
+        std::cout << "[#" << numero << "] " << (corrupta ? "Trama corrupta descartada: ["
+                                                         : "Paquete malformado detectado: [")
+                  << linea << "]" << std::endl;
     }
-    
-    // Convertir dígitos
-    while (texto[indice] >= '0' && texto[indice] <= '9')
+
+    void alDetectarHueco(int tramasPerdidas)
     {
-        resultado = resultado * 10 + (texto[indice] - '0');
-        indice++;
+        std::cout << "[#" << numero << "] >>> Hueco en la secuencia: " << tramasPerdidas
+                  << " tramas perdidas. <<<" << std::endl;
+    }
+
+    void alResincronizar(int rotacionPrevia, int rotacionActual, int caracteresAfectados)
+    {
+        std::cout << "[#" << numero << "] >>> Disco resincronizado: +" << rotacionPrevia
+                  << " -> +" << rotacionActual << ", " << caracteresAfectados
+                  << " caracteres afectados. <<<" << std::endl;
+    }
+
+    bool alAnunciarPerfil(long velocidad, bool controlFlujo, int rafaga)
+    {
+        (void)rafaga;
+        // El enlace serial lo configura el servidor de terminales
+        return transporte->configurarPerfil(velocidad, controlFlujo);
     }
-    
-    return resultado * signo;
-}
+
+    void alRepetirCiclo(const char* texto, int longitud, int repeticiones)
+    {
+        (void)texto;
+        (void)longitud;
+        std::cout << "[#" << numero << "] >>> Mensaje repetido x" << repeticiones
+                  << " <<<" << std::endl;
+    }
+};
 
 /**
- * @brief Analiza y crea un paquete desde una línea del protocolo
- * @param lineaTexto Línea recibida (formato: "L,X" o "M,N")
- * @return Puntero al paquete creado, o nullptr si hay error
+ * @class CanalConexion
+ * @brief Conexión aceptada con su propia sesión de decodificación
  * 
- * Formatos válidos:
- * - "L,A" -> Paquete de carácter con 'A'
- * - "M,5" -> Paquete de rotación +5
- * - "M,-3" -> Paquete de rotación -3
+ * Cada conexión es un flujo PRT-7 independiente: su disco, su
+ * mensaje y su política de fin no se comparten con las demás.
  */
-PaqueteBase* analizarPaquete(const char* lineaTexto)
+class CanalConexion : public FuenteTransporte
 {
-    // Validar entrada
-    if (lineaTexto == nullptr || lineaTexto[0] == '\0')
+private:
+    ConexionSocket* conexion;         ///< Socket de la conexión
+    PoliticaFinalizacion* politica;   ///< Política propia de la conexión
+    SesionDecodificacion sesionPropia; ///< Decodificación de la conexión
+    ObservadorConexion observador;    ///< Informe de incidencias
+    int numero;                       ///< Número de la conexión
+    bool terminado;                   ///< true si ya no se lee
+
+    void alTerminar(bool transporteCerrado)
     {
-        return nullptr;
+        terminado = true;
+
+        const MensajeDecodificado& mensaje = sesionPropia.obtenerMensaje();
+        std::cout << "[#" << numero << "] " << conexion->obtenerOrigen()
+                  << (transporteCerrado ? " cerrada: " : " completa: ")
+                  << sesionPropia.obtenerPaquetesRecibidos() << " tramas, "
+                  << mensaje.obtenerLongitud() << " caracteres";
+        double segundos = sesionPropia.obtenerSegundosActivos();
+        if (segundos > 0.0)
+        {
+            std::cout << ", " << (long long)(sesionPropia.obtenerPaquetesRecibidos() / segundos)
+                      << " tramas/s";
+        }
+        std::cout << std::endl;
+
+        // El mensaje completo puede ser enorme: basta el comienzo
+        std::cout << "[#" << numero << "] >>> ";
+        int mostrados = 0;
+        for (IteradorMensaje iterador = mensaje.iteradorInicio();
+             iterador.esValido() && mostrados < 64; iterador.avanzar(), mostrados++)
+        {
+            std::cout << iterador.obtenerCaracter();
+        }
+        std::cout << (mostrados < mensaje.obtenerLongitud() ? "..." : "") << " <<<" << std::endl;
     }
 
-    // Copiar a buffer de trabajo
-    char bufferTrabajo[128];
-    int indice = 0;
-    while (lineaTexto[indice] != '\0' && indice < 127)
+public:
+    CanalConexion(ConexionSocket* conexionAceptada, PoliticaFinalizacion* politicaFin,
+                  const ConfiguracionCanal& configuracion, int numeroConexion)
+        : FuenteTransporte(conexionAceptada, &sesionPropia, nullptr, nullptr, nullptr),
+          conexion(conexionAceptada), politica(politicaFin),
+          sesionPropia(politicaFin, configuracion.cantidadRotores,
+                       configuracion.avanceRotores, configuracion.exigirIntegridad),
+          observador(numeroConexion, conexionAceptada), numero(numeroConexion),
+          terminado(false)
     {
-        bufferTrabajo[indice] = lineaTexto[indice];
-        indice++;
+        if (configuracion.ciclosDeduplicacion > 0)
+        {
+            sesionPropia.activarDeduplicacion(configuracion.ciclosDeduplicacion, 4096);
+        }
+        sesionPropia.establecerObservador(&observador);
+    }
+
+    ~CanalConexion()
+    {
+        delete conexion;
+        delete politica;
     }
-    bufferTrabajo[indice] = '\0';
 
-    // Verificar longitud mínima
-    if (indice < 3)
+    /**
+     * @brief Indica si la conexión ya terminó
+     * @return true si se cerró o completó su transmisión
+     */
+    bool haTerminado() const
     {
-        return nullptr;
+        return terminado;
+    }
+
+    /**
+     * @brief Da por terminada una conexión que sigue abierta al salir
+     */
+    void cerrar()
+    {
+        if (!terminado)
+        {
+            alTerminar(true);
+        }
     }
 
-    // Extraer tipo de paquete
-    char tipoPaquete = bufferTrabajo[0];
-    
-    // Buscar separador
-    int posicionSeparador = buscarCaracter(bufferTrabajo, ',');
-    
-    if (posicionSeparador == -1 || posicionSeparador >= indice - 1)
+    /**
+     * @brief Obtiene la sesión de la conexión
+     * @return Sesión de decodificación
+     */
+    const SesionDecodificacion& obtenerSesion() const
     {
-        return nullptr;
+        return sesionPropia;
     }
+};
+
+/**
+ * @class ServidorConsola
+ * @brief Crea un canal por cada conexión aceptada y lleva los totales
+ */
+class ServidorConsola : public ReceptorConexiones
+{
+private:
+    ConfiguracionCanal configuracion; ///< Opciones de cada canal
+    BucleEventos* bucle;              ///< Bucle donde se registran los canales
+    CanalConexion** canales;          ///< Canales vivos o pendientes de liberar
+    int cantidadCanales;              ///< Canales en el arreglo
+    int capacidadCanales;             ///< Tamaño del arreglo
+    int conexionesAtendidas;          ///< Conexiones aceptadas hasta ahora
+    long long tramasTotales;          ///< Tramas de los canales ya liberados
+    long long bytesTotales;           ///< Bytes de los canales ya liberados
 
-    // Extraer contenido después del separador
-    const char* contenido = &bufferTrabajo[posicionSeparador + 1];
+    /**
+     * @brief Suma los totales de un canal y lo libera
+     * @param canal Canal terminado y retirado del bucle
+     */
+    void liberarCanal(CanalConexion* canal)
+    {
+        tramasTotales += canal->obtenerSesion().obtenerPaquetesRecibidos();
+        bytesTotales += canal->obtenerSesion().obtenerBytesRecibidos();
+        delete canal;
+    }
 
-    // Crear paquete según tipo
-    if (tipoPaquete == 'L' || tipoPaquete == 'l')
+    /**
+     * @brief Libera los canales que ya terminaron
+     * 
+     * El bucle los retiró al terminar; liberarlos aquí evita que un
+     * canal se destruya dentro de su propio aviso.
+     */
+    void purgarTerminados()
     {
-        // Paquete de carácter
-        if (contenido[0] != '\0')
+        int destino = 0;
+        for (int indice = 0; indice < cantidadCanales; indice++)
         {
-            return new PaqueteCaracter(contenido[0]);
+            if (canales[indice]->haTerminado())
+            {
+                liberarCanal(canales[indice]);
+            }
+            else
+            {
+                canales[destino++] = canales[indice];
+            }
         }
+        cantidadCanales = destino;
     }
-    else if (tipoPaquete == 'M' || tipoPaquete == 'm')
+
+public:
+    ServidorConsola(const ConfiguracionCanal& opciones, BucleEventos* bucleEventos)
+        : configuracion(opciones), bucle(bucleEventos)
+    {
+        capacidadCanales = 8;
+        canales = new CanalConexion*[capacidadCanales];
+        cantidadCanales = 0;
+        conexionesAtendidas = 0;
+        tramasTotales = 0;
+        bytesTotales = 0;
+    }
+
+    ~ServidorConsola()
     {
-        // Paquete de rotación
-        int valorRotacion = convertirAEntero(contenido);
-        return new PaqueteRotacion(valorRotacion);
+        cerrarCanales();
+        delete[] canales;
     }
 
-    return nullptr;
+    void alAceptarConexion(ConexionSocket* conexion)
+    {
+        purgarTerminados();
+
+        if (cantidadCanales == capacidadCanales)
+        {
+            CanalConexion** ampliado = new CanalConexion*[capacidadCanales * 2];
+            for (int indice = 0; indice < cantidadCanales; indice++)
+            {
+                ampliado[indice] = canales[indice];
+            }
+            delete[] canales;
+            canales = ampliado;
+            capacidadCanales *= 2;
+        }
+
+        // La especificación ya se validó al arrancar
+        PoliticaFinalizacion* politica = crearPoliticaFinalizacion(configuracion.especificacionFin);
+        CanalConexion* canal = new CanalConexion(conexion, politica, configuracion,
+                                                 ++conexionesAtendidas);
+        std::cout << "[#" << conexionesAtendidas << "] Conexion desde "
+                  << conexion->obtenerOrigen() << std::endl;
+
+        // Disparo por flanco: el canal lee hasta agotar el socket
+        if (!bucle->agregarFuente(canal, true))
+        {
+            delete canal;
+            return;
+        }
+        canales[cantidadCanales++] = canal;
+    }
+
+    /**
+     * @brief Muestra los totales de todas las conexiones
+     * 
+     * Se llama después de liberar los canales, cuando los totales
+     * ya incluyen a todos.
+     */
+    void mostrarTotales() const
+    {
+        std::cout << "Conexiones atendidas: " << conexionesAtendidas
+                  << ", tramas: " << tramasTotales
+                  << ", bytes: " << bytesTotales << std::endl;
+    }
+
+    /**
+     * @brief Cierra y libera los canales que siguen abiertos
+     */
+    void cerrarCanales()
+    {
+        for (int indice = 0; indice < cantidadCanales; indice++)
+        {
+            canales[indice]->cerrar();
+            liberarCanal(canales[indice]);
+        }
+        cantidadCanales = 0;
+    }
+};
+
+/// Bucle que detienen SIGINT y SIGTERM (o nullptr)
+static BucleEventos* bucleInterrumpible = nullptr;
+
+/// SIGINT o SIGTERM recibida mientras se atendía la entrada
+static volatile std::sig_atomic_t salidaSolicitada = 0;
+
+/**
+ * @brief Manejador de SIGINT y SIGTERM
+ * @param senal Señal recibida
+ * 
+ * Solo detiene el bucle o marca la salida: los destructores (captura,
+ * bitácora, archivo de tramas) corren después, al volver al flujo normal.
+ */
+static void solicitarSalida(int senal)
+{
+    (void)senal;
+    salidaSolicitada = 1;
+    if (bucleInterrumpible != nullptr)
+    {
+        bucleInterrumpible->detener();
+    }
 }
 
 /**
- * @brief Detecta si una línea es un patrón de finalización
- * @param lineaTexto Línea a verificar
- * @return true si es patrón de fin (M con valor negativo)
+ * @brief Instala el manejador de SIGINT y SIGTERM
+ * @param bucle Bucle a detener, o nullptr si el llamador consulta salidaSolicitada
  */
-bool esIndicadorFinalizacion(const char* lineaTexto)
+static void capturarSenalesSalida(BucleEventos* bucle)
 {
-    if (lineaTexto == nullptr || lineaTexto[0] == '\0')
-        return false;
+    salidaSolicitada = 0;
+    bucleInterrumpible = bucle;
+    std::signal(SIGINT, solicitarSalida);
+    std::signal(SIGTERM, solicitarSalida);
+}
+
+/**
+ * @brief Restituye el comportamiento por defecto de SIGINT y SIGTERM
+ */
+static void liberarSenalesSalida()
+{
+    std::signal(SIGINT, SIG_DFL);
+    std::signal(SIGTERM, SIG_DFL);
+    bucleInterrumpible = nullptr;
+}
+
+/**
+ * @brief Recibe flujos PRT-7 por sockets hasta SIGINT o SIGTERM
+ * @param especificacion "tcp:[DIRECCION:]PUERTO" o "unix:/ruta"
+ * @param configuracion Opciones de decodificación de cada conexión
+ * @return 0 si el servidor se detuvo normalmente, 1 si no pudo escuchar
+ */
+int atenderConexiones(const char* especificacion, const ConfiguracionCanal& configuracion)
+{
+    BucleEventos bucle;
+    ServidorConsola receptor(configuracion, &bucle);
+    ServidorIngesta servidor(especificacion, &receptor);
+    if (!bucle.estaOperativo() || !servidor.estaOperativo() ||
+        !bucle.agregarFuente(&servidor, false))
+    {
+        std::cout << "ERROR: No se pudo escuchar en " << especificacion << std::endl;
+        return 1;
+    }
+
+    std::cout << "Escuchando en " << especificacion
+              << ". Ctrl+C para terminar." << std::endl << std::endl;
+
+    capturarSenalesSalida(&bucle);
+    bucle.ejecutar();
+    liberarSenalesSalida();
+
+    receptor.cerrarCanales();
+    std::cout << std::endl << "---" << std::endl;
+    receptor.mostrarTotales();
+    return 0;
+}
 
-    // Debe ser tipo M
-    if (lineaTexto[0] != 'M' && lineaTexto[0] != 'm')
+/**
+ * @brief Entrega a la sesión una línea leída con capturarLinea()
+ * @param sesion Sesión del canal
+ * @param grabador Grabación de los bytes crudos (o nullptr)
+ * @param linea Línea sin salto de línea, con espacio para restituirlo
+ * 
+ * capturarLinea() ya quitó el salto de línea; se restituye para que
+ * la captura y el entramado reciban la línea completa.
+ */
+void entregarLineaLeida(SesionDecodificacion* sesion, GrabadorCaptura* grabador, char* linea)
+{
+    int longitud = (int)std::strlen(linea);
+    linea[longitud] = '\n';
+    if (grabador != nullptr)
+    {
+        grabador->registrar(linea, longitud + 1, 0);
+        grabador->vaciarPeriodico();
+    }
+    sesion->decodificarBloque(linea, longitud + 1);
+}
+
+/**
+ * @brief Decodifica una captura grabada en lugar del puerto
+ * @param sesion Sesión del canal
+ * @param reproductor Captura abierta
+ * @param rapido true para no esperar entre registros
+ * 
+ * Los bytes pasan por las mismas etapas que los del puerto. La
+ * inactividad se mide con los instantes grabados, de modo que la
+ * política de fin se comporta igual a velocidad original o rápida.
+ */
+void reproducirCaptura(SesionDecodificacion* sesion, ReproductorCaptura* reproductor, bool rapido)
+{
+    char* carga = new char[MAXIMA_CARGA_REGISTRO];
+    ContabilidadMemoria::registrarReserva(MEMORIA_ENTRADA_SALIDA, MAXIMA_CARGA_REGISTRO, 1);
+    unsigned long long instante = 0;
+    unsigned long long instanteInicial = 0;
+    unsigned long long instanteAnterior = 0;
+    unsigned short puerto = 0;
+    std::chrono::steady_clock::time_point inicioReal = std::chrono::steady_clock::now();
+    bool primerRegistro = true;
+
+    while (!sesion->estaCompleta())
+    {
+        int cantidad = reproductor->leerRegistro(carga, &instante, &puerto);
+        if (cantidad < 0)
+        {
+            std::cout << std::endl << ">>> Fin de la captura. <<<" << std::endl;
+            break;
+        }
+
+        if (primerRegistro)
+        {
+            instanteInicial = instante;
+            primerRegistro = false;
+        }
+        else
+        {
+            sesion->procesarInactividad((long)((instante - instanteAnterior) / 1000000ULL));
+            if (sesion->estaCompleta())
+                break;
+        }
+        instanteAnterior = instante;
+
+        // Respetar el ritmo original de llegada
+        if (!rapido)
+        {
+            std::this_thread::sleep_until(inicioReal + 
+                std::chrono::nanoseconds(instante - instanteInicial));
+        }
+
+        sesion->decodificarBloque(carga, cantidad);
+    }
+
+    ContabilidadMemoria::registrarLiberacion(MEMORIA_ENTRADA_SALIDA, MAXIMA_CARGA_REGISTRO, 1);
+    delete[] carga;
+}
+
+/**
+ * @brief Decodifica el puerto en espera activa, con el lector en otro hilo
+ * @param sesion Sesión del canal
+ * @param comunicador Puerto configurado con activarBajaLatencia()
+ * @param grabador Grabación de los bytes crudos (o nullptr)
+ * @param nucleoLector Núcleo del hilo lector (-1 = sin fijar)
+ * @param nucleoDecodificador Núcleo de este hilo (-1 = sin fijar)
+ * @param histograma Recibe la latencia de cada lectura
+ * @return false si no se pudo arrancar el lector o fijar los núcleos
+ * 
+ * La latencia va desde que read() devolvió los bytes hasta que la
+ * sesión terminó de decodificarlos (mensaje actualizado y
+ * observadores avisados).
+ */
+bool decodificarBajaLatencia(SesionDecodificacion* sesion, ComunicadorSerial* comunicador,
+                             GrabadorCaptura* grabador, int nucleoLector, int nucleoDecodificador,
+                             HistogramaLatencia* histograma)
+{
+    if (!LectorBajaLatencia::fijarNucleo(nucleoDecodificador))
+    {
+        std::cout << "ERROR: No se pudo fijar el decodificador al nucleo "
+                  << nucleoDecodificador << std::endl;
         return false;
+    }
 
-    // Buscar coma
-    int posicionComa = buscarCaracter(lineaTexto, ',');
-    if (posicionComa == -1)
+    // Dos hilos en espera activa sobre un mismo núcleo se turnan por
+    // rebanadas del planificador (milisegundos) si no ceden
+    bool compartenNucleo = std::thread::hardware_concurrency() < 2 ||
+                           (nucleoLector >= 0 && nucleoLector == nucleoDecodificador);
+    LectorBajaLatencia lector(comunicador, nucleoLector, compartenNucleo);
+    if (!lector.iniciar())
+    {
+        std::cout << "ERROR: No se pudo iniciar el lector en el nucleo " << nucleoLector << std::endl;
         return false;
+    }
+
+    long limiteInactividad = sesion->obtenerLimiteInactividad();
+    long long ultimaLectura = LectorBajaLatencia::instanteActual();
+    while (!sesion->estaCompleta() && !salidaSolicitada)
+    {
+        const TramoLectura* tramo = lector.siguienteTramo();
+        if (tramo == nullptr)
+        {
+            if (grabador != nullptr && grabador->estaOperativo())
+            {
+                grabador->vaciarPeriodico();
+            }
+            if (lector.estaCerrado())
+            {
+                std::cout << std::endl << ">>> Puerto cerrado. <<<" << std::endl;
+                break;
+            }
+            if (limiteInactividad >= 0)
+            {
+                long inactivo = (long)((LectorBajaLatencia::instanteActual() - ultimaLectura) / 1000000);
+                if (inactivo >= limiteInactividad)
+                {
+                    sesion->procesarInactividad(inactivo);
+                }
+            }
+            if (compartenNucleo)
+            {
+                std::this_thread::yield();
+            }
+            continue;
+        }
+
+        if (grabador != nullptr && grabador->estaOperativo())
+        {
+            grabador->registrar(tramo->datos, tramo->longitud, 0);
+            grabador->vaciarPeriodico();
+        }
+        sesion->decodificarBloque(tramo->datos, tramo->longitud);
+        histograma->registrar((unsigned long long)(LectorBajaLatencia::instanteActual() - tramo->instante));
+        ultimaLectura = tramo->instante;
+        lector.liberarTramo();
+    }
+
+    lector.detener();
+    if (lector.obtenerEsperasAnilloLleno() > 0)
+    {
+        std::cout << "Esperas del lector con el anillo lleno: "
+                  << lector.obtenerEsperasAnilloLleno() << std::endl;
+    }
+    return true;
+}
+
+/**
+ * @brief Muestra los percentiles de latencia de lectura a decodificado
+ * @param histograma Latencias registradas
+ */
+void mostrarLatencias(const HistogramaLatencia& histograma)
+{
+    if (histograma.obtenerMuestras() == 0)
+    {
+        std::cout << "Latencia lectura -> decodificado: sin muestras" << std::endl;
+        return;
+    }
+    std::cout << "Latencia lectura -> decodificado (" << histograma.obtenerMuestras()
+              << " lecturas): p50 " << histograma.obtenerPercentil(0.50)
+              << " ns, p99 " << histograma.obtenerPercentil(0.99)
+              << " ns, p99.9 " << histograma.obtenerPercentil(0.999)
+              << " ns, max " << histograma.obtenerMaximo()
+              << " ns, media " << histograma.obtenerMedia() << " ns" << std::endl;
+}
+
+/**
+ * @brief Decodifica un archivo de tramas en lugar del puerto
+ * @param sesion Sesión de un disco
+ * @param decodificador Archivo abierto
+ * @return false si un bloque del archivo está dañado
+ * 
+ * Los bloques se decodifican en paralelo, sin pasar por el análisis
+ * de tramas; el mensaje y el disco de la sesión quedan como si las
+ * tramas archivadas se hubieran recibido.
+ */
+bool reproducirArchivo(SesionDecodificacion* sesion, const DecodificadorArchivo* decodificador)
+{
+    long long caracteres = decodificador->obtenerCaracteres();
+    char* texto = new char[caracteres > 0 ? caracteres : 1];
+    ContabilidadMemoria::registrarReserva(MEMORIA_ENTRADA_SALIDA, (size_t)caracteres, 1);
+
+    std::chrono::steady_clock::time_point inicio = std::chrono::steady_clock::now();
+    bool correcto = (decodificador->decodificar(texto, 0) == caracteres);
+    double segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+
+    if (correcto)
+    {
+        MensajeDecodificado& mensaje = sesion->obtenerMensaje();
+        for (long long indice = 0; indice < caracteres; indice++)
+        {
+            mensaje.agregarCaracter(texto[indice]);
+        }
+        sesion->obtenerDisco().establecerDesplazamiento(decodificador->obtenerRotacionFinal());
+        sesion->establecerPaquetesRecibidos(sesion->obtenerPaquetesRecibidos() +
+                                            (int)decodificador->obtenerTramas());
+        std::cout << "Archivo decodificado: " << decodificador->obtenerTramas() << " tramas en "
+                  << decodificador->obtenerBloques() << " bloques, " << caracteres
+                  << " caracteres en " << segundos * 1000.0 << " ms" << std::endl;
+    }
+
+    ContabilidadMemoria::registrarLiberacion(MEMORIA_ENTRADA_SALIDA, (size_t)caracteres, 1);
+    delete[] texto;
+    return correcto;
+}
+
+/**
+ * @brief Muestra el rendimiento del enlace al terminar
+ * @param sesion Sesión del canal
+ * @param comunicador Puerto usado (o nullptr al reproducir)
+ * 
+ * El goodput cuenta solo los bytes de tramas válidas entre la
+ * primera y la última; la tasa de error compara las tramas
+ * malformadas con el total de tramas reconocibles.
+ */
+void mostrarEstadisticasEnlace(const SesionDecodificacion& sesion, const ComunicadorSerial* comunicador)
+{
+    if (comunicador != nullptr)
+    {
+        std::cout << "Velocidad del enlace: " << comunicador->obtenerVelocidad() 
+                  << " baudios" << std::endl;
+    }
+    std::cout << "Bytes recibidos: " << sesion.obtenerBytesRecibidos() 
+              << " (utiles: " << sesion.obtenerBytesUtiles() << ")" << std::endl;
+
+    double segundos = sesion.obtenerSegundosActivos();
+    if (sesion.obtenerBytesUtiles() > 0 && segundos > 0.0)
+    {
+        std::cout << "Goodput: " << (long long)(sesion.obtenerBytesUtiles() / segundos) << " B/s, "
+                  << (long long)(sesion.obtenerPaquetesRecibidos() / segundos) << " tramas/s" << std::endl;
+    }
+
+    int tramasMalformadas = sesion.obtenerTramasMalformadas();
+    int tramasReconocibles = sesion.obtenerPaquetesRecibidos() + tramasMalformadas;
+    if (tramasReconocibles > 0)
+    {
+        std::cout << "Tasa de error: " << tramasMalformadas << "/" << tramasReconocibles
+                  << " (" << (100.0 * tramasMalformadas / tramasReconocibles) << "%)"
+                  << ", lineas ignoradas: " << sesion.obtenerLineasIgnoradas() << std::endl;
+    }
 
-    // Verificar signo negativo después de la coma
-    int indice = posicionComa + 1;
-    while (lineaTexto[indice] == ' ' || lineaTexto[indice] == '\t')
+    const ControlIntegridad& integridad = sesion.obtenerIntegridad();
+    if (integridad.obtenerTramasVerificadas() > 0 || integridad.obtenerTramasCorruptas() > 0)
     {
-        indice++;
+        std::cout << "Integridad: " << integridad.obtenerTramasVerificadas() << " verificadas, "
+                  << integridad.obtenerTramasCorruptas() << " corruptas, "
+                  << integridad.obtenerTramasPerdidas() << " perdidas" << std::endl;
+        std::cout << "Resincronizaciones: " << integridad.obtenerResincronizaciones()
+                  << ", caracteres afectados: " << integridad.obtenerCaracteresAfectados();
+        if (integridad.estaIncierto())
+        {
+            std::cout << " (+" << integridad.obtenerCaracteresInciertos() << " sin verificar)";
+        }
+        std::cout << std::endl;
     }
 
-    return (lineaTexto[indice] == '-');
+    const CacheCiclos* cache = sesion.obtenerCache();
+    if (cache != nullptr)
+    {
+        std::cout << "Ciclos distintos: " << cache->obtenerCiclosDistintos()
+                  << ", repetidos: " << cache->obtenerRepeticiones()
+                  << ", caracteres sin decodificar: " << cache->obtenerCaracteresOmitidos()
+                  << std::endl;
+    }
+}
+
+/**
+ * @brief Muestra la memoria usada por cada estructura
+ * @param sesion Sesión del canal
+ * 
+ * Para el mensaje se indica además el costo por carácter, que
+ * incluye los enlaces y la capacidad libre de los fragmentos.
+ */
+void mostrarUsoMemoria(const SesionDecodificacion& sesion)
+{
+    std::cout << "Memoria (actual / pico):" << std::endl;
+    for (int indice = 0; indice < TOTAL_CATEGORIAS_MEMORIA; indice++)
+    {
+        CategoriaMemoria categoria = (CategoriaMemoria)indice;
+        if (ContabilidadMemoria::obtenerPicoBytes(categoria) == 0)
+            continue;
+
+        std::cout << "  " << ContabilidadMemoria::obtenerNombre(categoria) << ": "
+                  << ContabilidadMemoria::obtenerBytes(categoria) << " / "
+                  << ContabilidadMemoria::obtenerPicoBytes(categoria) << " bytes, "
+                  << ContabilidadMemoria::obtenerNodos(categoria) << " / "
+                  << ContabilidadMemoria::obtenerPicoNodos(categoria) << " nodos";
+
+        int longitud = sesion.obtenerMensaje().obtenerLongitud();
+        if (categoria == MEMORIA_MENSAJE && longitud > 0)
+        {
+            std::cout << " (" << (double)ContabilidadMemoria::obtenerBytes(categoria) / longitud
+                      << " bytes por caracter)";
+        }
+        std::cout << std::endl;
+    }
+    std::cout << "  total: " << ContabilidadMemoria::obtenerBytesTotales() << " / "
+              << ContabilidadMemoria::obtenerPicoBytesTotales() << " bytes" << std::endl;
 }
 
 // =====================================================
@@ -215,9 +1016,70 @@ bool esIndicadorFinalizacion(const char* lineaTexto)
 
 /**
  * @brief Punto de entrada del programa
+ * @param argc Cantidad de argumentos
+ * @param argv Argumentos: [PUERTO] [--fin=POLITICA] [--instantanea=RUTA[:N]]
+ *             [--rotores=N] [--avance] [--velocidad=BAUD|auto] [--flujo=rtscts]
+ *             [--integridad] [--grabar=RUTA] [--reproducir=RUTA[:rapido]]
+ *             [--deduplicar[=N]] [--escuchar=tcp:[DIR:]PUERTO|unix:RUTA]
+ *             [--publicar=/NOMBRE[:RANURAS]] [--archivar=RUTA]
+ *             [--baja-latencia[=LECTOR,DECODIFICADOR]]
  * @return 0 si la ejecución fue exitosa, 1 en caso de error
+ * 
+ * Políticas de fin disponibles: "trama" (por defecto, espera una
+ * trama F), "inactividad:MS", "conteo:N", "centinela:T,V" y
+ * "continuo".
+ * 
+ * Con --instantanea el estado se guarda tras cada rotación y cada
+ * N tramas (8 por defecto) y se restaura al iniciar.
+ * 
+ * Con --rotores=N (N > 1) se decodifica con una cadena de discos;
+ * --avance activa el avance tipo odómetro tras cada letra.
+ * 
+ * El puerto abre a 9600 baudios y adopta el perfil que anuncie el
+ * transmisor ("#PRT7,PERFIL,..."). --velocidad fija otro perfil de
+ * partida; "auto" lo busca entre las velocidades conocidas cuando
+ * el anuncio ya se perdió.
+ * 
+ * Las tramas con sufijo ",<seq>*<CRC>" se verifican siempre; con
+ * --integridad el sufijo es obligatorio desde la primera trama.
+ * 
+ * --grabar guarda los bytes crudos del puerto con su instante de
+ * llegada; --reproducir decodifica una captura en lugar del puerto,
+ * al ritmo original o, con ":rapido", tan rápido como sea posible.
+ * 
+ * --archivar guarda las tramas ejecutadas en un archivo comprimido
+ * por bloques (ver ArchivadorTramas); solo con un disco y sin
+ * --deduplicar. --reproducir reconoce esos archivos y los decodifica
+ * en paralelo, un bloque por hilo, sin rearmar las tramas; como
+ * ninguna trama pasa por la sesión, no se combinan con --publicar,
+ * --instantanea ni --deduplicar.
+ * 
+ * --baja-latencia lee el puerto en espera activa desde un hilo
+ * propio (ver LectorBajaLatencia) y decodifica también en espera
+ * activa, opcionalmente con cada hilo fijado al núcleo indicado.
+ * Ocupa dos núcleos enteros y no se detalla cada trama en consola.
+ * Al terminar, tanto este modo como el bucle de eventos muestran los
+ * percentiles p50/p99/p99.9 de la latencia desde la lectura hasta el
+ * carácter decodificado, de modo que ambos caminos se comparan con
+ * la misma medida.
+ * 
+ * --deduplicar recuerda hasta N ciclos distintos (32 por defecto),
+ * cada uno terminado en una trama F; los ciclos repetidos se
+ * reconocen al llegar y solo se informa "repetido xN". Tiene
+ * sentido con --fin=continuo.
+ * 
+ * --escuchar recibe flujos por sockets en lugar del puerto serial
+ * (por ejemplo, reenviados por un servidor de terminales). Cada
+ * conexión se decodifica con su propia sesión y solo se informan
+ * sus incidencias y su resumen al cerrar; el servidor sigue
+ * aceptando conexiones hasta Ctrl+C.
+ * 
+ * --publicar escribe cada carácter y cada suceso de trama en un
+ * anillo de memoria compartida (ver LectorAnillo) en lugar de
+ * detallar cada trama en consola. El anillo existe mientras dura
+ * la ejecución.
  */
-int main()
+int main(int argc, char* argv[])
 {
     // Encabezado del sistema
     std::cout << "========================================" << std::endl;
@@ -225,102 +1087,570 @@ int main()
     std::cout << "  Protocolo de Transmision Rotatorio" << std::endl;
     std::cout << "========================================" << std::endl << std::endl;
 
-    // Solicitar puerto de comunicación
-    char identificadorPuerto[32];
-    std::cout << "Ingrese el identificador del puerto (ejemplo: COM3): ";
-    std::cin >> identificadorPuerto;
+    // Procesar argumentos de línea de comandos
+    char identificadorPuerto[128];
+    identificadorPuerto[0] = '\0';
+    const char* especificacionFin = "trama";
+    char rutaInstantanea[256];
+    rutaInstantanea[0] = '\0';
+    int tramasPorInstantanea = 8;
+    int cantidadRotores = 1;
+    bool avanceRotores = false;
+    long velocidadInicial = 9600;
+    bool detectarVelocidad = false;
+    bool controlFlujo = false;
+    bool exigirIntegridad = false;
+    int ciclosDeduplicacion = 0;
+    const char* rutaGrabacion = nullptr;
+    const char* rutaArchivo = nullptr;
+    char rutaReproduccion[256];
+    rutaReproduccion[0] = '\0';
+    bool reproduccionRapida = false;
+    const char* especificacionEscucha = nullptr;
+    char nombrePublicacion[64];
+    nombrePublicacion[0] = '\0';
+    unsigned int ranurasPublicacion = CAPACIDAD_ANILLO;
+    bool bajaLatencia = false;
+    int nucleoLector = -1;
+    int nucleoDecodificador = -1;
 
-    std::cout << std::endl << "Iniciando sistema. Estableciendo conexion con " 
-              << identificadorPuerto << "..." << std::endl;
+    for (int i = 1; i < argc; i++)
+    {
+        if (std::strncmp(argv[i], "--fin=", 6) == 0)
+        {
+            especificacionFin = argv[i] + 6;
+        }
+        else if (std::strncmp(argv[i], "--rotores=", 10) == 0)
+        {
+            cantidadRotores = convertirAEntero(argv[i] + 10);
+        }
+        else if (std::strcmp(argv[i], "--avance") == 0)
+        {
+            avanceRotores = true;
+        }
+        else if (std::strncmp(argv[i], "--velocidad=", 12) == 0)
+        {
+            detectarVelocidad = (std::strcmp(argv[i] + 12, "auto") == 0);
+            if (!detectarVelocidad)
+            {
+                velocidadInicial = std::atol(argv[i] + 12);
+            }
+        }
+        else if (std::strcmp(argv[i], "--flujo=rtscts") == 0)
+        {
+            controlFlujo = true;
+        }
+        else if (std::strcmp(argv[i], "--deduplicar") == 0)
+        {
+            ciclosDeduplicacion = 32;
+        }
+        else if (std::strncmp(argv[i], "--deduplicar=", 13) == 0)
+        {
+            ciclosDeduplicacion = convertirAEntero(argv[i] + 13);
+            if (ciclosDeduplicacion < 1)
+            {
+                ciclosDeduplicacion = 1;
+            }
+        }
+        else if (std::strcmp(argv[i], "--integridad") == 0)
+        {
+            exigirIntegridad = true;
+        }
+        else if (std::strncmp(argv[i], "--grabar=", 9) == 0)
+        {
+            rutaGrabacion = argv[i] + 9;
+        }
+        else if (std::strncmp(argv[i], "--archivar=", 11) == 0)
+        {
+            rutaArchivo = argv[i] + 11;
+        }
+        else if (std::strcmp(argv[i], "--baja-latencia") == 0)
+        {
+            bajaLatencia = true;
+        }
+        else if (std::strncmp(argv[i], "--baja-latencia=", 16) == 0)
+        {
+            // Formato LECTOR,DECODIFICADOR (núcleos)
+            bajaLatencia = true;
+            nucleoLector = convertirAEntero(argv[i] + 16);
+            const char* separador = std::strchr(argv[i] + 16, ',');
+            if (separador != nullptr)
+            {
+                nucleoDecodificador = convertirAEntero(separador + 1);
+            }
+        }
+        else if (std::strncmp(argv[i], "--reproducir=", 13) == 0)
+        {
+            // Formato RUTA[:rapido]
+            std::strncpy(rutaReproduccion, argv[i] + 13, sizeof(rutaReproduccion) - 1);
+            rutaReproduccion[sizeof(rutaReproduccion) - 1] = '\0';
+            char* separador = std::strrchr(rutaReproduccion, ':');
+            if (separador != nullptr && std::strcmp(separador + 1, "rapido") == 0)
+            {
+                reproduccionRapida = true;
+                *separador = '\0';
+            }
+        }
+        else if (std::strncmp(argv[i], "--escuchar=", 11) == 0)
+        {
+            especificacionEscucha = argv[i] + 11;
+        }
+        else if (std::strncmp(argv[i], "--publicar=", 11) == 0)
+        {
+            // Formato /NOMBRE[:RANURAS]
+            std::strncpy(nombrePublicacion, argv[i] + 11, sizeof(nombrePublicacion) - 1);
+            nombrePublicacion[sizeof(nombrePublicacion) - 1] = '\0';
+            char* separador = std::strrchr(nombrePublicacion, ':');
+            if (separador != nullptr && separador[1] >= '0' && separador[1] <= '9')
+            {
+                ranurasPublicacion = (unsigned int)convertirAEntero(separador + 1);
+                *separador = '\0';
+            }
+        }
+        else if (std::strncmp(argv[i], "--instantanea=", 14) == 0)
+        {
+            // Formato RUTA[:N]; el sufijo numérico es opcional
+            std::strncpy(rutaInstantanea, argv[i] + 14, sizeof(rutaInstantanea) - 1);
+            rutaInstantanea[sizeof(rutaInstantanea) - 1] = '\0';
+            char* separador = std::strrchr(rutaInstantanea, ':');
+            if (separador != nullptr && separador[1] >= '0' && separador[1] <= '9')
+            {
+                tramasPorInstantanea = convertirAEntero(separador + 1);
+                *separador = '\0';
+            }
+            if (tramasPorInstantanea < 1)
+            {
+                tramasPorInstantanea = 1;
+            }
+        }
+        else
+        {
+            std::strncpy(identificadorPuerto, argv[i], sizeof(identificadorPuerto) - 1);
+            identificadorPuerto[sizeof(identificadorPuerto) - 1] = '\0';
+        }
+    }
 
-    // Establecer conexión serial
-    ComunicadorSerial comunicador(identificadorPuerto);
+    PoliticaFinalizacion* politicaFin = crearPoliticaFinalizacion(especificacionFin);
+    if (politicaFin == nullptr)
+    {
+        std::cout << "ERROR: Politica de finalizacion invalida: " 
+                  << especificacionFin << std::endl;
+        return 1;
+    }
 
-    if (!comunicador.estaOperativo())
+    // La bitácora solo conoce el estado de un disco
+    bool usarCadena = (cantidadRotores > 1 || avanceRotores);
+    if (usarCadena && rutaInstantanea[0] != '\0')
     {
-        std::cout << std::endl << "ERROR: Imposible establecer conexion." << std::endl;
-        std::cout << "Verificaciones necesarias:" << std::endl;
-        std::cout << "  1. Arduino conectado fisicamente" << std::endl;
-        std::cout << "  2. Puerto correcto seleccionado" << std::endl;
-        std::cout << "  3. Puerto disponible (no usado por otro programa)" << std::endl;
-        std::cout << "  4. Drivers USB instalados" << std::endl;
+        std::cout << "ERROR: --instantanea no admite cadenas de rotores" << std::endl;
+        delete politicaFin;
         return 1;
     }
 
-    std::cout << "Conexion exitosa. Esperando transmision de paquetes..." 
-              << std::endl << std::endl;
+    // Con avance, el resultado de cada letra depende de las anteriores
+    if (usarCadena && ciclosDeduplicacion > 0)
+    {
+        std::cout << "ERROR: --deduplicar no admite cadenas de rotores" << std::endl;
+        delete politicaFin;
+        return 1;
+    }
+
+    // El archivo guarda el efecto de cada trama sobre un solo disco
+    if (rutaArchivo != nullptr && (usarCadena || ciclosDeduplicacion > 0))
+    {
+        std::cout << "ERROR: --archivar no admite cadenas de rotores ni --deduplicar" << std::endl;
+        delete politicaFin;
+        return 1;
+    }
+
+    // Servidor de ingesta: una sesión por conexión en lugar del puerto
+    if (especificacionEscucha != nullptr)
+    {
+        if (rutaInstantanea[0] != '\0' || rutaGrabacion != nullptr ||
+            rutaReproduccion[0] != '\0' || nombrePublicacion[0] != '\0' ||
+            rutaArchivo != nullptr || bajaLatencia)
+        {
+            std::cout << "ERROR: --escuchar no admite --instantanea, --grabar, "
+                      << "--reproducir, --publicar, --archivar ni --baja-latencia" << std::endl;
+            delete politicaFin;
+            return 1;
+        }
 
-    // Inicializar estructuras de datos
-    MensajeDecodificado mensajeFinal;
-    DiscoRotatorio discoCifrado;
+        ConfiguracionCanal configuracion;
+        configuracion.especificacionFin = especificacionFin;
+        configuracion.cantidadRotores = cantidadRotores;
+        configuracion.avanceRotores = avanceRotores;
+        configuracion.exigirIntegridad = exigirIntegridad;
+        configuracion.ciclosDeduplicacion = ciclosDeduplicacion;
 
-    // Variables de control
-    char bufferLectura[128];
-    bool transmisionCompleta = false;
-    int paquetesRecibidos = 0;
-    const int MINIMO_PAQUETES = 8;  // Mínimo para considerar mensaje válido
+        // Cada conexión crea su propia política; esta solo validó la especificación
+        delete politicaFin;
+        return atenderConexiones(especificacionEscucha, configuracion);
+    }
 
-    // Bucle principal de procesamiento
-    while (!transmisionCompleta)
+    // La espera activa solo tiene sentido sobre el puerto
+    if (bajaLatencia && rutaReproduccion[0] != '\0')
     {
-        if (comunicador.capturarLinea(bufferLectura, 128))
+        std::cout << "ERROR: --baja-latencia no admite --reproducir" << std::endl;
+        delete politicaFin;
+        return 1;
+    }
+
+    // Abrir el archivo o la captura a reproducir, o el puerto de comunicación
+    DecodificadorArchivo* decodificadorArchivo = nullptr;
+    ReproductorCaptura* reproductor = nullptr;
+    ComunicadorSerial* comunicador = nullptr;
+    char primeraLinea[128];
+    primeraLinea[0] = '\0';
+
+    if (rutaReproduccion[0] != '\0' && DecodificadorArchivo::esArchivoTramas(rutaReproduccion))
+    {
+        // El archivo se decodifica por bloques, sin pasar trama a trama
+        // por el observador ni por la política de fin
+        if (usarCadena || rutaArchivo != nullptr || nombrePublicacion[0] != '\0' ||
+            rutaInstantanea[0] != '\0' || ciclosDeduplicacion > 0)
+        {
+            std::cout << "ERROR: Un archivo de tramas se reproduce con un disco y sin "
+                      << "--archivar, --publicar, --instantanea ni --deduplicar" << std::endl;
+            delete politicaFin;
+            return 1;
+        }
+        decodificadorArchivo = new DecodificadorArchivo(rutaReproduccion);
+        if (!decodificadorArchivo->estaOperativo())
+        {
+            std::cout << "ERROR: Archivo de tramas invalido: " << rutaReproduccion << std::endl;
+            delete decodificadorArchivo;
+            delete politicaFin;
+            return 1;
+        }
+        std::cout << "Reproduciendo archivo de tramas (" << decodificadorArchivo->obtenerBytesArchivo()
+                  << " bytes, " << decodificadorArchivo->obtenerBloques() << " bloques)..."
+                  << std::endl << std::endl;
+    }
+    else if (rutaReproduccion[0] != '\0')
+    {
+        reproductor = new ReproductorCaptura(rutaReproduccion);
+        if (!reproductor->estaOperativo())
         {
-            // Limpiar espacios
-            int inicio = eliminarEspaciosIniciales(bufferLectura);
-            eliminarEspaciosFinales(&bufferLectura[inicio]);
+            std::cout << "ERROR: Captura invalida: " << rutaReproduccion << std::endl;
+            delete reproductor;
+            delete politicaFin;
+            return 1;
+        }
+        std::cout << "Reproduciendo captura de " << reproductor->obtenerNombrePuerto()
+                  << (reproduccionRapida ? " (modo rapido)" : "") << "..." 
+                  << std::endl << std::endl;
+    }
+    else
+    {
+        // Solicitar puerto de comunicación si no se indicó como argumento
+        if (identificadorPuerto[0] == '\0')
+        {
+            std::cout << "Ingrese el identificador del puerto (ejemplo: COM3): ";
+            std::cin >> identificadorPuerto;
+        }
 
-            // Ignorar líneas vacías
-            if (bufferLectura[inicio] == '\0')
-                continue;
+        std::cout << std::endl << "Iniciando sistema. Estableciendo conexion con " 
+                  << identificadorPuerto << "..." << std::endl;
 
-            // Analizar y crear paquete
-            PaqueteBase* paqueteActual = analizarPaquete(&bufferLectura[inicio]);
+        // Establecer conexión serial
+        comunicador = new ComunicadorSerial(identificadorPuerto);
+
+        if (!comunicador->estaOperativo())
+        {
+            std::cout << std::endl << "ERROR: Imposible establecer conexion." << std::endl;
+            std::cout << "Verificaciones necesarias:" << std::endl;
+            std::cout << "  1. Arduino conectado fisicamente" << std::endl;
+            std::cout << "  2. Puerto correcto seleccionado" << std::endl;
+            std::cout << "  3. Puerto disponible (no usado por otro programa)" << std::endl;
+            std::cout << "  4. Drivers USB instalados" << std::endl;
+            delete comunicador;
+            delete politicaFin;
+            return 1;
+        }
 
-            if (paqueteActual != nullptr)
+        // Perfil de transporte de partida
+        if (detectarVelocidad)
+        {
+            std::cout << "Detectando velocidad del transmisor..." << std::endl;
+            long velocidadDetectada = comunicador->detectarVelocidad(primeraLinea, 128);
+            if (velocidadDetectada > 0)
+            {
+                std::cout << "Velocidad detectada: " << velocidadDetectada << " baudios" << std::endl;
+            }
+            else
             {
-                // Ejecutar paquete (polimorfismo)
-                paqueteActual->ejecutar(&mensajeFinal, &discoCifrado);
-                paquetesRecibidos++;
+                std::cout << "Sin tramas legibles; se usaran 9600 baudios" << std::endl;
+            }
+        }
+        else if ((velocidadInicial != 9600 || controlFlujo) &&
+                 !comunicador->configurarPerfil(velocidadInicial, controlFlujo))
+        {
+            std::cout << "ERROR: Perfil no soportado: " << velocidadInicial << " baudios" << std::endl;
+            delete comunicador;
+            delete politicaFin;
+            return 1;
+        }
+
+        if (bajaLatencia)
+        {
+            if (!comunicador->activarBajaLatencia())
+            {
+                std::cout << "ERROR: No se pudo configurar el puerto para baja latencia" << std::endl;
+                delete comunicador;
+                delete politicaFin;
+                return 1;
+            }
+            std::cout << "Modo de baja latencia: lector en nucleo " << nucleoLector
+                      << ", decodificador en nucleo " << nucleoDecodificador
+                      << " (-1 = sin fijar)." << std::endl;
+            if (std::thread::hardware_concurrency() < 2)
+            {
+                std::cout << "AVISO: un solo nucleo; lector y decodificador se turnan." << std::endl;
+            }
+        }
+
+        std::cout << "Conexion exitosa. Esperando transmision de paquetes..." 
+                  << std::endl << std::endl;
+    }
+
+    // Grabar lo que llegue por el puerto
+    GrabadorCaptura* grabador = nullptr;
+    if (rutaGrabacion != nullptr && comunicador != nullptr)
+    {
+        grabador = new GrabadorCaptura(rutaGrabacion, identificadorPuerto, true);
+        if (!grabador->estaOperativo())
+        {
+            std::cout << "ERROR: No se pudo crear la captura " << rutaGrabacion << std::endl;
+            delete grabador;
+            delete comunicador;
+            delete politicaFin;
+            return 1;
+        }
+    }
+
+    // Inicializar la sesión de decodificación
+    SesionDecodificacion sesion(politicaFin, cantidadRotores, avanceRotores, exigirIntegridad);
+    if (sesion.obtenerCadena() != nullptr)
+    {
+        std::cout << "Cadena de " << sesion.obtenerCadena()->obtenerCantidadRotores() 
+                  << " rotores" << (avanceRotores ? " con avance automatico" : "")
+                  << "." << std::endl << std::endl;
+    }
+
+    // Reanudar desde la última instantánea si se solicitó
+    BitacoraEstado* bitacora = nullptr;
+    if (rutaInstantanea[0] != '\0')
+    {
+        bitacora = new BitacoraEstado(rutaInstantanea, 4);
+        sesion.establecerPaquetesRecibidos(
+            bitacora->restaurar(&sesion.obtenerMensaje(), &sesion.obtenerDisco()));
+        if (sesion.obtenerPaquetesRecibidos() > 0)
+        {
+            std::cout << "Estado restaurado: " << sesion.obtenerPaquetesRecibidos() 
+                      << " paquetes, disco en +" << sesion.obtenerDisco().obtenerDesplazamiento()
+                      << ", mensaje: ";
+            mostrarMensaje(sesion.obtenerMensaje());
+            std::cout << std::endl << std::endl;
+        }
+    }
 
-                // Verificar condición de finalización
-                if (esIndicadorFinalizacion(&bufferLectura[inicio]) && 
-                    paquetesRecibidos >= MINIMO_PAQUETES)
+    // Los ciclos se cuentan desde la rotación restaurada
+    if (ciclosDeduplicacion > 0)
+    {
+        sesion.activarDeduplicacion(ciclosDeduplicacion, 4096);
+    }
+
+    // Publicar en memoria compartida para otros procesos
+    AnilloEventos* anillo = nullptr;
+    if (nombrePublicacion[0] != '\0')
+    {
+        anillo = new AnilloEventos(nombrePublicacion, ranurasPublicacion);
+        if (!anillo->estaOperativo())
+        {
+            std::cout << "ERROR: No se pudo crear el anillo " << nombrePublicacion << std::endl;
+            delete anillo;
+            delete bitacora;
+            delete grabador;
+            delete politicaFin;
+            delete comunicador;
+            delete reproductor;
+            delete decodificadorArchivo;
+            return 1;
+        }
+        std::cout << "Publicando eventos en " << nombrePublicacion << " ("
+                  << anillo->obtenerCapacidad() << " ranuras)." << std::endl << std::endl;
+    }
+
+    // Escribir cada trama en consola dominaría la latencia medida
+    ObservadorConsola observador(&sesion, comunicador, bitacora, tramasPorInstantanea,
+                                 anillo == nullptr && !bajaLatencia);
+    PublicadorEventos publicador(anillo, &observador);
+    ObservadorSesion* observadorSesion = &observador;
+    if (anillo != nullptr)
+    {
+        observadorSesion = &publicador;
+    }
+
+    // El archivo empieza en la rotación vigente (restaurada o inicial)
+    ArchivadorTramas* archivador = nullptr;
+    if (rutaArchivo != nullptr)
+    {
+        archivador = new ArchivadorTramas(rutaArchivo, &sesion, observadorSesion);
+        if (!archivador->estaOperativo())
+        {
+            std::cout << "ERROR: No se pudo crear el archivo " << rutaArchivo << std::endl;
+            delete archivador;
+            delete anillo;
+            delete bitacora;
+            delete grabador;
+            delete politicaFin;
+            delete comunicador;
+            delete reproductor;
+            return 1;
+        }
+        observadorSesion = archivador;
+    }
+    sesion.establecerObservador(observadorSesion);
+
+    // La línea usada para detectar la velocidad también es una trama
+    if (primeraLinea[0] != '\0')
+    {
+        entregarLineaLeida(&sesion, grabador, primeraLinea);
+    }
+
+    BucleEventos bucle;
+    HistogramaLatencia histograma;
+    bool latenciaMedida = bajaLatencia;
+    if (decodificadorArchivo != nullptr)
+    {
+        if (!reproducirArchivo(&sesion, decodificadorArchivo))
+        {
+            std::cout << "ERROR: Bloque danado en " << rutaReproduccion << std::endl;
+        }
+    }
+    else if (reproductor != nullptr)
+    {
+        reproducirCaptura(&sesion, reproductor, reproduccionRapida);
+    }
+    else if (bajaLatencia)
+    {
+        capturarSenalesSalida(nullptr);
+        if (!decodificarBajaLatencia(&sesion, comunicador, grabador, nucleoLector,
+                                     nucleoDecodificador, &histograma))
+        {
+            std::cout << "La transmision no se decodifico." << std::endl;
+        }
+        liberarSenalesSalida();
+    }
+    else if (bucle.estaOperativo() && comunicador->obtenerDescriptor() >= 0)
+    {
+        // Bucle dirigido por eventos: el proceso duerme hasta que
+        // llegan bytes o vence el tiempo de inactividad
+        FuenteTransporte fuentePuerto(comunicador, &sesion, grabador, &bucle, &histograma);
+        latenciaMedida = true;
+        bucle.agregarFuente(&fuentePuerto, false);
+        capturarSenalesSalida(&bucle);
+        bucle.ejecutar();
+        liberarSenalesSalida();
+    }
+    else
+    {
+        // Lectura por líneas con timeouts del puerto (Windows)
+        char bufferLectura[128];
+        std::chrono::steady_clock::time_point ultimaTrama = std::chrono::steady_clock::now();
+
+        capturarSenalesSalida(nullptr);
+        while (!sesion.estaCompleta() && !salidaSolicitada)
+        {
+            if (!comunicador->capturarLinea(bufferLectura, 128))
+            {
+                // Sin datos: consultar a la política por inactividad
+                sesion.procesarInactividad((long)std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::steady_clock::now() - ultimaTrama).count());
+                if (grabador != nullptr)
                 {
-                    std::cout << std::endl 
-                              << ">>> Indicador de finalizacion detectado. <<<" 
-                              << std::endl;
-                    transmisionCompleta = true;
+                    grabador->vaciar();
                 }
-
-                // Liberar memoria del paquete
-                delete paqueteActual;
             }
             else
             {
-                // Reportar solo errores de paquetes aparentemente válidos
-                char primerCaracter = bufferLectura[inicio];
-                if (primerCaracter == 'L' || primerCaracter == 'l' ||
-                    primerCaracter == 'M' || primerCaracter == 'm')
-                {
-                    std::cout << "Paquete malformado detectado: [" 
-                              << &bufferLectura[inicio] << "]" << std::endl;
-                }
+                ultimaTrama = std::chrono::steady_clock::now();
+                entregarLineaLeida(&sesion, grabador, bufferLectura);
             }
         }
+        liberarSenalesSalida();
+    }
+
+    if (salidaSolicitada)
+    {
+        std::cout << std::endl << ">>> Recepcion interrumpida. <<<" << std::endl;
+    }
+
+    // Una transmisión terminada no debe reanudarse en la siguiente ejecución
+    if (bitacora != nullptr)
+    {
+        if (sesion.estaCompleta())
+        {
+            bitacora->descartar();
+        }
+        delete bitacora;
+    }
+
+    if (grabador != nullptr)
+    {
+        std::cout << std::endl << "Captura grabada: " << grabador->obtenerRegistros() 
+                  << " registros." << std::endl;
+        delete grabador;
+    }
+
+    if (archivador != nullptr)
+    {
+        long long tramasArchivadas = archivador->obtenerTramas();
+        if (archivador->cerrar())
+        {
+            std::cout << std::endl << "Archivo de tramas: " << tramasArchivadas << " tramas en "
+                      << archivador->obtenerBloques() << " bloques." << std::endl;
+        }
+        else
+        {
+            std::cout << std::endl << "ERROR: El archivo " << rutaArchivo
+                      << " quedo incompleto." << std::endl;
+        }
     }
 
     // Presentar resultados
     std::cout << std::endl << "---" << std::endl;
     std::cout << "Transmision finalizada." << std::endl;
-    std::cout << "Total de paquetes procesados: " << paquetesRecibidos << std::endl;
-    std::cout << "Longitud del mensaje: " << mensajeFinal.obtenerLongitud() 
+    std::cout << "Total de paquetes procesados: " << sesion.obtenerPaquetesRecibidos() << std::endl;
+    std::cout << "Longitud del mensaje: " << sesion.obtenerMensaje().obtenerLongitud() 
               << " caracteres" << std::endl;
+    std::cout << "Lotes de memoria para paquetes: "
+              << ReservaBloques::obtenerReservasSistemaTotales() << std::endl;
+    mostrarEstadisticasEnlace(sesion, comunicador);
+    if (latenciaMedida)
+    {
+        mostrarLatencias(histograma);
+    }
+    if (anillo != nullptr)
+    {
+        std::cout << "Eventos publicados: " << anillo->obtenerPublicados()
+                  << " en " << nombrePublicacion << std::endl;
+    }
+    mostrarUsoMemoria(sesion);
     std::cout << std::endl << "MENSAJE SECRETO DECODIFICADO:" << std::endl;
     std::cout << ">>> ";
-    mensajeFinal.mostrarMensaje();
+    mostrarMensaje(sesion.obtenerMensaje());
     std::cout << " <<<" << std::endl;
     std::cout << "---" << std::endl << std::endl;
     std::cout << "Liberando recursos... Sistema terminado correctamente." << std::endl;
 
+    delete archivador;
+    delete anillo;
+    delete politicaFin;
+    delete comunicador;
+    delete reproductor;
+    delete decodificadorArchivo;
+
     return 0;
 }